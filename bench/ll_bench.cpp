@@ -0,0 +1,450 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <list>
+#include <random>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__has_include)
+#if __has_include(<boost/intrusive/list.hpp>)
+#include <boost/intrusive/list.hpp>
+#define LL_BENCH_BOOST 1
+#endif
+#endif
+
+#include "../ll.h"
+
+//
+// LL2 against std::list (and boost::intrusive::list when its headers are found) for add head/tail, InsertBefore,
+//  Remove, traversal, Combine, Clear and Sort, over list sizes from 10 up, with the items linked either in memory
+//  order or in a shuffled order
+//
+// Usage: ll_bench [cItemMax]      (default 100000, sizes go up by 10x from 10, e.g. 10000000 for the full range)
+// Build: g++ -std=c++11 -O2 bench/ll_bench.cpp -o ll_bench
+//
+// Reports ns per item (per Combine call for combine), plus last-level cache misses per item when perf_event_open is
+//  available. std::list allocates its nodes as they are added, so its add rows include malloc and its nodes are only
+//  shuffled for the rows that start from a filled list (they are spliced into shuffled order).
+//
+
+struct Item
+{
+    uint64_t key;
+
+    DefineLL2Node(Item);
+    LL2Node node;
+
+#if LL_BENCH_BOOST
+    boost::intrusive::list_member_hook<> hook;
+#endif
+};
+
+DefineLL2(Item, node, Items);
+
+static bool IsKeyLess(const Item * pA, const Item * pB)
+{
+    return pA->key < pB->key;
+}
+
+// NOTE - Accumulates time (and cache misses, if the counter could be opened) over any number of Begin/End pairs
+struct Timer
+{
+    int fdPerf = -1;
+    double sec = 0;
+    uint64_t cMiss = 0;
+    std::chrono::steady_clock::time_point start;
+
+    Timer()
+    {
+#if defined(__linux__)
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fdPerf = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+
+    ~Timer()
+    {
+#if defined(__linux__)
+        if (fdPerf >= 0) close(fdPerf);
+#endif
+    }
+
+    bool HasMisses() const { return fdPerf >= 0; }
+
+    void Begin()
+    {
+#if defined(__linux__)
+        if (fdPerf >= 0)
+        {
+            ioctl(fdPerf, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fdPerf, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+        start = std::chrono::steady_clock::now();
+    }
+
+    void End()
+    {
+        sec += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+#if defined(__linux__)
+        if (fdPerf >= 0)
+        {
+            ioctl(fdPerf, PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t cMissRun = 0;
+            if (read(fdPerf, &cMissRun, sizeof(cMissRun)) == sizeof(cMissRun)) cMiss += cMissRun;
+        }
+#endif
+    }
+};
+
+enum OP
+{
+    OP_AddTail,
+    OP_AddHead,
+    OP_InsertBefore,
+    OP_Remove,
+    OP_Traverse,
+    OP_Combine,
+    OP_Clear,
+    OP_Sort,
+
+    OP_Max
+};
+
+static const char * s_apChzOp[OP_Max] = { "add tail", "add head", "insert before", "remove", "traverse", "combine", "clear", "sort" };
+
+struct Result
+{
+    double ns;
+    double cMissPerOp;         // < 0 if unavailable
+};
+
+// NOTE - Each adapter links items given by index into aItem. Fill/Empty are the untimed setup and teardown.
+
+struct LlAdapter
+{
+    Item * aItem;
+    LL2Type(Items) list = {};
+    LL2Type(Items) list2 = {};
+
+    explicit LlAdapter(Item * aItem_) : aItem(aItem_) {}
+
+    void Fill(const uint32_t * aiItem, size_t ciItem)
+    {
+        for (size_t i = 0; i < ciItem; i++) LL2AddTail(Item, list, &aItem[aiItem[i]]);
+    }
+
+    void Empty()
+    {
+        LL2Clear(Item, list);
+        LL2Clear(Item, list2);
+    }
+
+    void AddTail(uint32_t iItem) { LL2AddTail(Item, list, &aItem[iItem]); }
+    void AddHead(uint32_t iItem) { LL2AddHead(Item, list, &aItem[iItem]); }
+    void InsertBefore(uint32_t iItem, uint32_t iItemNext) { LL2InsertBefore(Item, list, &aItem[iItem], &aItem[iItemNext]); }
+    void Remove(uint32_t iItem) { LL2Remove(Item, list, &aItem[iItem]); }
+
+    void FillSecond(const uint32_t * aiItem, size_t ciItem)
+    {
+        for (size_t i = 0; i < ciItem; i++) LL2AddTail(Item, list2, &aItem[aiItem[i]]);
+    }
+
+    uint64_t Traverse()
+    {
+        uint64_t sum = 0;
+        ForLL2(Item, pItem, list) sum += pItem->key;
+        return sum;
+    }
+
+    void Combine()
+    {
+        LL2Combine_(Item, &list.pHead, &list.pTail, &list2.pHead, &list2.pTail, list.offset);
+    }
+
+    void Clear() { LL2Clear(Item, list); }
+    void Sort() { LL2Sort(Item, list, IsKeyLess); }
+};
+
+struct StdAdapter
+{
+    Item * aItem;
+    std::list<Item> list;
+    std::list<Item> list2;
+    std::vector<std::list<Item>::iterator> aIt;
+
+    explicit StdAdapter(Item * aItem_, size_t cItem) : aItem(aItem_), aIt(cItem) {}
+
+    // NOTE - Allocates the nodes in index order, then splices them into list order, so the nodes are laid out
+    //  the same way as the intrusive items are
+    void FillInto(std::list<Item> & listDst, const uint32_t * aiItem, size_t ciItem)
+    {
+        std::vector<uint32_t> aiSorted(aiItem, aiItem + ciItem);
+        std::sort(aiSorted.begin(), aiSorted.end());
+
+        std::list<Item> listStaging;
+        for (uint32_t iItem : aiSorted) aIt[iItem] = listStaging.insert(listStaging.end(), aItem[iItem]);
+        for (size_t i = 0; i < ciItem; i++) listDst.splice(listDst.end(), listStaging, aIt[aiItem[i]]);
+    }
+
+    void Fill(const uint32_t * aiItem, size_t ciItem) { FillInto(list, aiItem, ciItem); }
+    void FillSecond(const uint32_t * aiItem, size_t ciItem) { FillInto(list2, aiItem, ciItem); }
+
+    void Empty()
+    {
+        list.clear();
+        list2.clear();
+    }
+
+    void AddTail(uint32_t iItem) { aIt[iItem] = list.insert(list.end(), aItem[iItem]); }
+    void AddHead(uint32_t iItem) { aIt[iItem] = list.insert(list.begin(), aItem[iItem]); }
+    void InsertBefore(uint32_t iItem, uint32_t iItemNext) { aIt[iItem] = list.insert(aIt[iItemNext], aItem[iItem]); }
+    void Remove(uint32_t iItem) { list.erase(aIt[iItem]); }
+
+    uint64_t Traverse()
+    {
+        uint64_t sum = 0;
+        for (const Item & item : list) sum += item.key;
+        return sum;
+    }
+
+    void Combine() { list.splice(list.end(), list2); }
+    void Clear() { list.clear(); }
+    void Sort() { list.sort([](const Item & a, const Item & b) { return a.key < b.key; }); }
+};
+
+#if LL_BENCH_BOOST
+typedef boost::intrusive::list<
+            Item,
+            boost::intrusive::member_hook<Item, boost::intrusive::list_member_hook<>, &Item::hook>,
+            boost::intrusive::constant_time_size<false>> BoostList;
+
+struct BoostAdapter
+{
+    Item * aItem;
+    BoostList list;
+    BoostList list2;
+
+    explicit BoostAdapter(Item * aItem_) : aItem(aItem_) {}
+
+    void Fill(const uint32_t * aiItem, size_t ciItem)
+    {
+        for (size_t i = 0; i < ciItem; i++) list.push_back(aItem[aiItem[i]]);
+    }
+
+    void FillSecond(const uint32_t * aiItem, size_t ciItem)
+    {
+        for (size_t i = 0; i < ciItem; i++) list2.push_back(aItem[aiItem[i]]);
+    }
+
+    void Empty()
+    {
+        list.clear();
+        list2.clear();
+    }
+
+    void AddTail(uint32_t iItem) { list.push_back(aItem[iItem]); }
+    void AddHead(uint32_t iItem) { list.push_front(aItem[iItem]); }
+    void InsertBefore(uint32_t iItem, uint32_t iItemNext) { list.insert(list.iterator_to(aItem[iItemNext]), aItem[iItem]); }
+    void Remove(uint32_t iItem) { list.erase(list.iterator_to(aItem[iItem])); }
+
+    uint64_t Traverse()
+    {
+        uint64_t sum = 0;
+        for (const Item & item : list) sum += item.key;
+        return sum;
+    }
+
+    void Combine() { list.splice(list.end(), list2); }
+    void Clear() { list.clear(); }
+    void Sort() { list.sort([](const Item & a, const Item & b) { return a.key < b.key; }); }
+};
+#endif
+
+static volatile uint64_t s_sink;
+
+// NOTE - aiOrder is the list order, aiOrderRemove an unrelated permutation used for removal
+template <typename A>
+static void RunAll(A & adapter, const std::vector<uint32_t> & aiOrder, const std::vector<uint32_t> & aiOrderRemove, int cRep, Result * aResult)
+{
+    const uint32_t * aiItem = aiOrder.data();
+    size_t cItem = aiOrder.size();
+    size_t cItemHalf = cItem / 2;
+
+    // Evens are linked up front, each odd one is then inserted before the even one that follows it
+
+    std::vector<uint32_t> aiEven;
+    std::vector<uint32_t> aiOdd;
+    for (size_t i = 0; i < cItem; i++) ((i & 1) ? aiOdd : aiEven).push_back(aiItem[i]);
+
+    for (int op = 0; op < OP_Max; op++)
+    {
+        Timer timer;
+        double cOp = 0;
+
+        for (int iRep = 0; iRep < cRep; iRep++)
+        {
+            switch (op)
+            {
+            case OP_AddTail:
+                timer.Begin();
+                for (size_t i = 0; i < cItem; i++) adapter.AddTail(aiItem[i]);
+                timer.End();
+                cOp += cItem;
+                break;
+
+            case OP_AddHead:
+                timer.Begin();
+                for (size_t i = 0; i < cItem; i++) adapter.AddHead(aiItem[i]);
+                timer.End();
+                cOp += cItem;
+                break;
+
+            case OP_InsertBefore:
+                adapter.Fill(aiEven.data(), aiEven.size());
+                timer.Begin();
+                for (size_t i = 0; i + 1 < aiEven.size(); i++) adapter.InsertBefore(aiOdd[i], aiEven[i + 1]);
+                timer.End();
+                cOp += aiEven.size() ? aiEven.size() - 1 : 0;
+                break;
+
+            case OP_Remove:
+                adapter.Fill(aiItem, cItem);
+                timer.Begin();
+                for (size_t i = 0; i < cItem; i++) adapter.Remove(aiOrderRemove[i]);
+                timer.End();
+                cOp += cItem;
+                break;
+
+            case OP_Traverse:
+                adapter.Fill(aiItem, cItem);
+                timer.Begin();
+                s_sink = s_sink + adapter.Traverse();
+                timer.End();
+                cOp += cItem;
+                break;
+
+            case OP_Combine:
+                adapter.Fill(aiItem, cItemHalf);
+                adapter.FillSecond(aiItem + cItemHalf, cItem - cItemHalf);
+                timer.Begin();
+                adapter.Combine();
+                timer.End();
+                cOp += 1;
+                break;
+
+            case OP_Clear:
+                adapter.Fill(aiItem, cItem);
+                timer.Begin();
+                adapter.Clear();
+                timer.End();
+                cOp += cItem;
+                break;
+
+            case OP_Sort:
+                adapter.Fill(aiItem, cItem);
+                timer.Begin();
+                adapter.Sort();
+                timer.End();
+                cOp += cItem;
+                break;
+            }
+
+            adapter.Empty();
+        }
+
+        aResult[op].ns = cOp ? timer.sec * 1e9 / cOp : 0;
+        aResult[op].cMissPerOp = (timer.HasMisses() && cOp) ? timer.cMiss / cOp : -1;
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    size_t cItemMax = (argc > 1) ? (size_t)atoll(argv[1]) : 100000;
+
+    const char * apChzImpl[] = { "ll", "std::list", "boost" };
+#if LL_BENCH_BOOST
+    const int cImpl = 3;
+#else
+    const int cImpl = 2;
+#endif
+
+    std::mt19937_64 rng(1);
+
+    for (size_t cItem = 10; cItem <= cItemMax; cItem *= 10)
+    {
+        std::vector<Item> aItem(cItem);
+        for (Item & item : aItem)
+        {
+            item.key = rng();
+            item.node.pPrev = nullptr;
+            item.node.pNext = nullptr;
+        }
+
+        std::vector<uint32_t> aiOrderRemove(cItem);
+        for (size_t i = 0; i < cItem; i++) aiOrderRemove[i] = (uint32_t)i;
+        std::shuffle(aiOrderRemove.begin(), aiOrderRemove.end(), rng);
+
+        // Enough repetitions for ~2M item-ops per row, at least one
+
+        int cRep = (int)std::max<size_t>(1, 2000000 / cItem);
+
+        for (int isShuffled = 0; isShuffled < 2; isShuffled++)
+        {
+            std::vector<uint32_t> aiOrder(cItem);
+            for (size_t i = 0; i < cItem; i++) aiOrder[i] = (uint32_t)i;
+            if (isShuffled) std::shuffle(aiOrder.begin(), aiOrder.end(), rng);
+
+            Result aaResult[3][OP_Max];
+
+            LlAdapter ll(aItem.data());
+            RunAll(ll, aiOrder, aiOrderRemove, cRep, aaResult[0]);
+
+            StdAdapter stdList(aItem.data(), cItem);
+            RunAll(stdList, aiOrder, aiOrderRemove, cRep, aaResult[1]);
+
+#if LL_BENCH_BOOST
+            BoostAdapter boostList(aItem.data());
+            RunAll(boostList, aiOrder, aiOrderRemove, cRep, aaResult[2]);
+#endif
+
+            printf("\n%zu items, %s\n", cItem, isShuffled ? "shuffled" : "contiguous");
+            printf("%-14s", "ns/item");
+            for (int iImpl = 0; iImpl < cImpl; iImpl++) printf(" %12s %9s", apChzImpl[iImpl], "miss");
+            printf("\n");
+
+            for (int op = 0; op < OP_Max; op++)
+            {
+                printf("%-14s", s_apChzOp[op]);
+                for (int iImpl = 0; iImpl < cImpl; iImpl++)
+                {
+                    const Result & result = aaResult[iImpl][op];
+                    printf(" %12.2f", result.ns);
+                    if (result.cMissPerOp >= 0) printf(" %9.3f", result.cMissPerOp);
+                    else printf(" %9s", "-");
+                }
+                printf("\n");
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "../ll.h"
+
+//
+// LL2Remove against LL2CircRemove on the same items, each linked into both kinds of list. Items are removed in random
+//  order within blocks of 4096, so the data stays in cache and the position in the list (head, middle, tail, only
+//  item) is what varies. Short lists hit LL2Remove's head/tail branches most often; long lists are nearly all middle
+//  removes, which predict well.
+//
+// Usage: ll_circ_bench [cItem]
+//
+
+struct Item
+{
+    int value;
+
+    DefineLL2CircNode(Item);
+    LL2CircNode circNode;
+
+    DefineLL2Node(Item);
+    LL2Node node;
+};
+
+DefineLL2Circ(Item, circNode, CircItems);
+DefineLL2(Item, node, Items);
+
+static double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char ** argv)
+{
+    int cItem = (argc > 1) ? atoi(argv[1]) : 2000000;
+    const int cRep = 3;
+
+    std::vector<Item> aItem(cItem);
+    std::vector<int> aiItemRemove(cItem);
+    for (int iItem = 0; iItem < cItem; iItem++) aiItemRemove[iItem] = iItem;
+
+    std::mt19937 rng(1);
+    for (int iBlock = 0; iBlock < cItem; iBlock += 4096)
+    {
+        std::shuffle(aiItemRemove.begin() + iBlock, aiItemRemove.begin() + std::min(cItem, iBlock + 4096), rng);
+    }
+
+    printf("%d removes, ns per remove (best of %d)\n", cItem, cRep);
+    printf("%-14s %12s %14s\n", "items/list", "LL2Remove", "LL2CircRemove");
+
+    for (int cItemPerList : { 1, 4, 16, 256, cItem })
+    {
+        int cList = (cItem + cItemPerList - 1) / cItemPerList;
+        double secLL2 = 1e9;
+        double secCirc = 1e9;
+
+        for (int iRep = 0; iRep < cRep; iRep++)
+        {
+            std::vector<LL2Type(Items)> aList(cList);
+            std::vector<LL2CircType(CircItems)> aCircList(cList);
+            for (LL2Type(Items) & list : aList) list = {};
+            for (LL2CircType(CircItems) & circList : aCircList) LL2CircInit(circList);
+
+            for (int iItem = 0; iItem < cItem; iItem++)
+            {
+                Item * pItem = &aItem[iItem];
+                pItem->node = {};
+                pItem->circNode = {};
+                LL2AddTail(Item, aList[iItem / cItemPerList], pItem);
+                LL2CircAddTail(Item, aCircList[iItem / cItemPerList], pItem);
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            for (int iItem : aiItemRemove) LL2Remove(Item, aList[iItem / cItemPerList], &aItem[iItem]);
+            secLL2 = std::min(secLL2, SecondsSince(start));
+
+            start = std::chrono::steady_clock::now();
+            for (int iItem : aiItemRemove) LL2CircRemove(Item, aCircList[iItem / cItemPerList], &aItem[iItem]);
+            secCirc = std::min(secCirc, SecondsSince(start));
+
+            for (LL2Type(Items) & list : aList) if (list.pHead) return 1;
+            for (LL2CircType(CircItems) & circList : aCircList) if (!LL2CircIsEmpty(circList)) return 1;
+        }
+
+        printf("%-14d %12.2f %14.2f\n", cItemPerList, secLL2 * 1e9 / cItem, secCirc * 1e9 / cItem);
+    }
+    return 0;
+}
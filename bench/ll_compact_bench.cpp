@@ -0,0 +1,92 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "../ll.h"
+#include "../ll_compact.h"
+
+//
+// Traversal cost of an LL2 list whose items are scattered across their arena, before and after ll::Compactor puts
+//  them back in list order, and what the compaction itself costs (run in 1 ms Steps, as a frame loop would).
+//
+// Usage: ll_compact_bench [cItemMax]
+//
+
+struct Item
+{
+    int64_t value;
+    char pad[48];
+
+    DefineLL2Node(Item);
+    LL2Node node;
+};
+
+typedef ll::List<Item, &Item::node> ItemList;
+
+static volatile int64_t s_sink;
+
+static double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double NsPerItemWalk(ItemList & list, int cItem)
+{
+    const int cRep = 5;
+    int64_t sum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int iRep = 0; iRep < cRep; iRep++)
+    {
+        for (Item * pItem : list) sum += pItem->value;
+    }
+    double sec = SecondsSince(start);
+
+    s_sink = sum;
+    return sec * 1e9 / ((double)cItem * cRep);
+}
+
+int main(int argc, char ** argv)
+{
+    int cItemMax = (argc > 1) ? atoi(argv[1]) : 1024000;
+
+    printf("%-10s %14s %14s %14s %10s %12s\n", "items", "scattered ns", "compacted ns", "compact ms", "steps", "swaps");
+    for (int cItem = 16000; cItem <= cItemMax; cItem *= 4)
+    {
+        std::vector<Item> aItem(cItem);
+        memset((void *)aItem.data(), 0, sizeof(Item) * cItem);
+
+        std::vector<int> aiItem(cItem);
+        for (int iItem = 0; iItem < cItem; iItem++) aiItem[iItem] = iItem;
+        std::mt19937 rng(1);
+        std::shuffle(aiItem.begin(), aiItem.end(), rng);
+
+        ItemList list;
+        for (int iItem : aiItem)
+        {
+            aItem[iItem].value = iItem;
+            list.AddTail(&aItem[iItem]);
+        }
+
+        double nsScattered = NsPerItemWalk(list, cItem);
+
+        ll::Compactor<Item, &Item::node> compactor;
+        compactor.Init(aItem.data(), cItem, list);
+
+        int cStep = 1;
+        auto start = std::chrono::steady_clock::now();
+        while (!compactor.Step(std::chrono::milliseconds(1))) cStep++;
+        double msCompact = SecondsSince(start) * 1e3;
+
+        double nsCompacted = NsPerItemWalk(list, cItem);
+
+        printf("%-10d %14.2f %14.2f %14.1f %10d %12llu\n", cItem, nsScattered, nsCompacted, msCompact, cStep, (unsigned long long)compactor.cSwap);
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "../ll.h"
+
+//
+// Traversal cost of LL2Compact against LL2: the same small items, once with pointer links (24 bytes per item) and once
+//  with 32-bit arena-relative links (16 bytes per item), linked in shuffled order and walked end to end
+//
+// Usage: ll_compact_list_bench [cItemMax]
+//
+
+struct Wide
+{
+    int64_t value;
+
+    DefineLL2Node(Wide);
+    LL2Node node;
+};
+
+struct Narrow
+{
+    int64_t value;
+
+    DefineLL2CompactNode(Narrow);
+    LL2CompactNode node;
+};
+
+DefineLL2(Wide, node, Wides);
+DefineLL2Compact(Narrow, node, Narrows);
+
+static double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static volatile int64_t s_sink;
+
+static double BenchWide(const std::vector<int> & aiOrder, int cPass)
+{
+    std::vector<Wide> aWide(aiOrder.size());
+    LL2Type(Wides) list = {};
+    for (int i : aiOrder)
+    {
+        aWide[i].value = i;
+        aWide[i].node = {};
+        LL2AddTail(Wide, list, &aWide[i]);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    int64_t sum = 0;
+    for (int iPass = 0; iPass < cPass; iPass++)
+    {
+        ForLL2(Wide, it, list)
+        {
+            sum += it->value;
+        }
+    }
+    double sec = SecondsSince(start);
+
+    s_sink = sum;
+    return sec * 1e9 / ((double)cPass * aiOrder.size());
+}
+
+static double BenchNarrow(const std::vector<int> & aiOrder, int cPass)
+{
+    std::vector<Narrow> aNarrow(aiOrder.size());
+    LL2CompactType(Narrows) list = {};
+    list.pBase = aNarrow.data();
+    for (int i : aiOrder)
+    {
+        aNarrow[i].value = i;
+        aNarrow[i].node = {};
+        LL2CompactAddTail(Narrow, list, &aNarrow[i]);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    int64_t sum = 0;
+    for (int iPass = 0; iPass < cPass; iPass++)
+    {
+        ForLL2Compact(Narrow, it, list)
+        {
+            sum += it->value;
+        }
+    }
+    double sec = SecondsSince(start);
+
+    s_sink = sum;
+    return sec * 1e9 / ((double)cPass * aiOrder.size());
+}
+
+int main(int argc, char ** argv)
+{
+    int cItemMax = (argc > 1) ? atoi(argv[1]) : 4096000;
+
+    static_assert(sizeof(Wide) == 24 && sizeof(Narrow) == 16, "item sizes this benchmark is about");
+
+    printf("%-10s %14s %14s %8s\n", "items", "LL2 ns/item", "compact ns/item", "gain");
+    for (int cItem = 1000; cItem <= cItemMax; cItem *= 4)
+    {
+        std::vector<int> aiOrder(cItem);
+        for (int i = 0; i < cItem; i++) aiOrder[i] = i;
+        std::mt19937 rng(1);
+        std::shuffle(aiOrder.begin(), aiOrder.end(), rng);
+
+        int cPass = std::max(1, 20000000 / cItem);
+        double nsWide = BenchWide(aiOrder, cPass);
+        double nsNarrow = BenchNarrow(aiOrder, cPass);
+        printf("%-10d %14.2f %15.2f %7.2fx\n", cItem, nsWide, nsNarrow, nsWide / nsNarrow);
+    }
+    return 0;
+}
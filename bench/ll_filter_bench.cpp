@@ -0,0 +1,107 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "../ll.h"
+
+//
+// A garbage sweep over an LL2 list of cItem items with 1%, 10% and 50% of them dead, done the old way (ForLL2 +
+//  LL2RemoveWhileIterating) and with LL2RemoveIf and LL2Partition (dead items moved to a free list). The list is
+//  linked in memory order, then in shuffled order, where every hop is a cache miss and the link writes matter less.
+//
+// Usage: ll_filter_bench [cItem]
+//
+
+struct Item
+{
+    int isDead;
+
+    DefineLL2Node(Item);
+    LL2Node node;
+};
+
+DefineLL2(Item, node, Items);
+
+static double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool IsDead(Item * pItem)
+{
+    return pItem->isDead != 0;
+}
+
+static void Build(LL2Type(Items) & list, std::vector<Item> & aItem, const std::vector<int> & aiItemOrder)
+{
+    list = {};
+    for (int iItem : aiItemOrder)
+    {
+        aItem[iItem].node = {};
+        LL2AddTail(Item, list, &aItem[iItem]);
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    int cItem = (argc > 1) ? atoi(argv[1]) : 500000;
+    const int cRep = 10;
+
+    std::vector<Item> aItem(cItem);
+    std::vector<int> aiItemOrder(cItem);
+    for (int iItem = 0; iItem < cItem; iItem++) aiItemOrder[iItem] = iItem;
+    std::mt19937 rng(2);
+
+    printf("%d items, ms per sweep (avg of %d)\n", cItem, cRep);
+    printf("%-10s %6s %22s %12s %13s\n", "order", "dead", "RemoveWhileIterating", "RemoveIf", "Partition");
+
+    for (int isShuffled = 0; isShuffled < 2; isShuffled++)
+    {
+        if (isShuffled) std::shuffle(aiItemOrder.begin(), aiItemOrder.end(), rng);
+
+        for (int pctDead : { 1, 10, 50 })
+        {
+            double secIterating = 0;
+            double secRemoveIf = 0;
+            double secPartition = 0;
+
+            for (int iRep = 0; iRep < cRep; iRep++)
+            {
+                for (Item & item : aItem) item.isDead = (int)(rng() % 100) < pctDead;
+
+                LL2Type(Items) list;
+                Build(list, aItem, aiItemOrder);
+                auto start = std::chrono::steady_clock::now();
+                ForLL2(Item, it, list)
+                {
+                    if (it->isDead) LL2RemoveWhileIterating(Item, list, it);
+                }
+                secIterating += SecondsSince(start);
+
+                Build(list, aItem, aiItemOrder);
+                start = std::chrono::steady_clock::now();
+                LL2RemoveIf(Item, list, IsDead);
+                secRemoveIf += SecondsSince(start);
+
+                Build(list, aItem, aiItemOrder);
+                LL2Type(Items) freeList = {};
+                start = std::chrono::steady_clock::now();
+                LL2Partition(Item, list, freeList, IsDead);
+                secPartition += SecondsSince(start);
+            }
+
+            printf("%-10s %5d%% %22.2f %12.2f %13.2f\n",
+                isShuffled ? "shuffled" : "in memory",
+                pctDead,
+                secIterating * 1e3 / cRep,
+                secRemoveIf * 1e3 / cRep,
+                secPartition * 1e3 / cRep);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "../ll.h"
+
+//
+// LL2GenClear against LL2Clear. A list of cItem items (scattered in memory, like a list of objects that came and went)
+//  is filled and cleared over and over. LL2Clear walks and unlinks every item, LL2GenClear just bumps the list's
+//  counter, so the clear column should be flat for gen and grow with the list for the plain one. The cycle column
+//  includes the refill, where gen pays a little extra to stamp each item.
+//
+// Usage: ll_gen_bench [cItemMax]
+//
+
+struct Item
+{
+    int64_t value;
+
+    DefineLL2Node(Item);
+    LL2Node node;
+
+    DefineLL2GenNode(Item);
+    LL2GenNode genNode;
+};
+
+DefineLL2(Item, node, Items);
+DefineLL2Gen(Item, genNode, GenItems);
+
+static volatile int64_t s_sink;
+
+static double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Result
+{
+    double nsClear;
+    double nsCycle;
+};
+
+static Result BenchPlain(const std::vector<Item *> & apItem, int cRep)
+{
+    LL2Type(Items) list = {};
+    double secClear = 0;
+
+    auto startCycle = std::chrono::steady_clock::now();
+    for (int iRep = 0; iRep < cRep; iRep++)
+    {
+        for (Item * pItem : apItem) LL2AddTail(Item, list, pItem);
+        s_sink = s_sink + list.pTail->value;
+
+        auto start = std::chrono::steady_clock::now();
+        LL2Clear(Item, list);
+        secClear += SecondsSince(start);
+    }
+    double secCycle = SecondsSince(startCycle);
+
+    Result result;
+    result.nsClear = secClear * 1e9 / cRep;
+    result.nsCycle = secCycle * 1e9 / cRep;
+    return result;
+}
+
+static Result BenchGen(const std::vector<Item *> & apItem, int cRep)
+{
+    LL2GenType(GenItems) list = {};
+    double secClear = 0;
+
+    auto startCycle = std::chrono::steady_clock::now();
+    for (int iRep = 0; iRep < cRep; iRep++)
+    {
+        for (Item * pItem : apItem) LL2GenAddTail(Item, list, pItem);
+        s_sink = s_sink + list.pTail->value;
+
+        auto start = std::chrono::steady_clock::now();
+        LL2GenClear(Item, list);
+        secClear += SecondsSince(start);
+    }
+    double secCycle = SecondsSince(startCycle);
+
+    Result result;
+    result.nsClear = secClear * 1e9 / cRep;
+    result.nsCycle = secCycle * 1e9 / cRep;
+    return result;
+}
+
+int main(int argc, char ** argv)
+{
+    int cItemMax = (argc > 1) ? atoi(argv[1]) : 1024000;
+
+    printf("ns/rep         %25s   %25s\n", "LL2Clear", "LL2GenClear");
+    printf("%-10s %14s %14s   %14s %14s\n", "items", "clear", "cycle", "clear", "cycle");
+    for (int cItem = 1000; cItem <= cItemMax; cItem *= 4)
+    {
+        std::vector<Item> aItem(cItem);
+        std::vector<Item *> apItem(cItem);
+        for (int iItem = 0; iItem < cItem; iItem++)
+        {
+            aItem[iItem] = Item();
+            aItem[iItem].value = iItem;
+            apItem[iItem] = &aItem[iItem];
+        }
+
+        std::mt19937 rng(1);
+        std::shuffle(apItem.begin(), apItem.end(), rng);
+
+        // About 8M item insertions per row
+
+        int cRep = std::max(4, 8000000 / cItem);
+
+        Result resultPlain = BenchPlain(apItem, cRep);
+        Result resultGen = BenchGen(apItem, cRep);
+        printf("%-10d %14.0f %14.0f   %14.0f %14.0f\n", cItem, resultPlain.nsClear, resultPlain.nsCycle, resultGen.nsClear, resultGen.nsCycle);
+    }
+    return 0;
+}
@@ -0,0 +1,151 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "../ll_hash.h"
+
+//
+// Per-Insert latency while ll::HashTable grows from 16 buckets to cItem, against the hand-rolled table it replaces: an
+//  array of LL1 heads that rehashes every chain into a table twice the size as soon as the load passes 1 (stop the
+//  world). Every Insert is timed on its own, so the totals include the clock reads.
+//
+// Usage: ll_hash_bench [cItem]     (pass 10000000 for the 10M-entry case, about 7s)
+//
+
+struct Item
+{
+    uint64_t key;
+
+    DefineLL1Node(Item)
+    LL1Node node;
+};
+
+typedef ll::HashTable<Item, &Item::node, uint64_t, &Item::key> ItemTable;
+typedef std::chrono::steady_clock Clock;
+
+static volatile uint64_t s_sink;
+
+static float NsSince(Clock::time_point start)
+{
+    return (float)std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+static float Percentile(std::vector<float> & aNs, double fraction)
+{
+    size_t iNs = (size_t)((double)aNs.size() * fraction);
+    if (iNs >= aNs.size()) iNs = aNs.size() - 1;
+    std::nth_element(aNs.begin(), aNs.begin() + iNs, aNs.end());
+    return aNs[iNs];
+}
+
+static void Report(const char * name, const std::vector<float> & aNs)
+{
+    double nsTotal = 0;
+    for (float ns : aNs) nsTotal += ns;
+
+    std::vector<float> aNsSorted(aNs);
+    float nsP50 = Percentile(aNsSorted, 0.5);
+    float nsP99 = Percentile(aNsSorted, 0.99);
+    float nsP999 = Percentile(aNsSorted, 0.999);
+    float nsMax = *std::max_element(aNs.begin(), aNs.end());
+
+    printf("%-16s %10.0f %10.0f %10.0f %12.3f %12.0f\n", name, nsP50, nsP99, nsP999, nsMax / 1e6, nsTotal / 1e6);
+}
+
+// NOTE - What ll_hash.h replaces: LL1 chains hashed like ll::HashTable, all moved at once on grow
+
+struct StopTheWorldTable
+{
+    Item ** apBucket = nullptr;
+    uint32_t cBit = 4;
+    uintptr_t cItem = 0;
+
+    StopTheWorldTable() { apBucket = (Item **)calloc((size_t)1 << cBit, sizeof(Item *)); }
+    ~StopTheWorldTable() { free(apBucket); }
+
+    static uintptr_t IndexOf(uint64_t key, uint32_t cBit)
+    {
+        return (uintptr_t)((key * 0x9E3779B97F4A7C15ULL) >> (64 - cBit));
+    }
+
+    static void PushHead(Item ** ppBucket, Item * pItem)
+    {
+        pItem->node.pNext = *ppBucket ? *ppBucket : (Item *)LLEndOfList_;
+        *ppBucket = pItem;
+    }
+
+    void Insert(Item * pItem)
+    {
+        if (cItem >= ((uintptr_t)1 << cBit))
+        {
+            Item ** apBucketNew = (Item **)calloc((size_t)2 << cBit, sizeof(Item *));
+            for (uintptr_t iBucket = 0; iBucket < ((uintptr_t)1 << cBit); iBucket++)
+            {
+                Item * pItemMove = apBucket[iBucket];
+                while (pItemMove && pItemMove != (Item *)LLEndOfList_)
+                {
+                    Item * pItemNext = pItemMove->node.pNext;
+                    PushHead(&apBucketNew[IndexOf(pItemMove->key, cBit + 1)], pItemMove);
+                    pItemMove = pItemNext;
+                }
+            }
+
+            free(apBucket);
+            apBucket = apBucketNew;
+            cBit++;
+        }
+
+        PushHead(&apBucket[IndexOf(pItem->key, cBit)], pItem);
+        cItem++;
+    }
+};
+
+int main(int argc, char ** argv)
+{
+    int cItem = (argc > 1) ? atoi(argv[1]) : 2000000;
+
+    std::mt19937_64 rng(11);
+    std::vector<Item> aItem(cItem);
+    for (Item & item : aItem)
+    {
+        item.key = rng();
+        item.node = {};
+    }
+
+    std::vector<float> aNs(cItem);
+
+    printf("%d inserts from 16 buckets\n", cItem);
+    printf("%-16s %10s %10s %10s %12s %12s\n", "ns/insert", "p50", "p99", "p99.9", "max ms", "total ms");
+
+    {
+        ItemTable table;
+        table.Init();
+        for (int iItem = 0; iItem < cItem; iItem++)
+        {
+            Clock::time_point start = Clock::now();
+            table.Insert(&aItem[iItem]);
+            aNs[iItem] = NsSince(start);
+        }
+        s_sink = table.Count();
+        Report("incremental", aNs);
+        table.Clear();
+    }
+
+    {
+        StopTheWorldTable table;
+        for (int iItem = 0; iItem < cItem; iItem++)
+        {
+            Clock::time_point start = Clock::now();
+            table.Insert(&aItem[iItem]);
+            aNs[iItem] = NsSince(start);
+        }
+        s_sink = table.cItem;
+        Report("stop-the-world", aNs);
+    }
+    return 0;
+}
@@ -0,0 +1,264 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../ll_heap.h"
+
+//
+// ll::PairingHeap against std::priority_queue of item pointers:
+//  -bulk: insert cItem random keys, then pop them all
+//  -steady: a 1000-item queue doing pop + push (event loop style)
+//  -decrease-key: 3 key decreases per pop; priority_queue has no decrease-key, so it pushes a new entry and skips
+//   stale ones on pop (the usual Dijkstra workaround)
+//  -remove: random Remove of half the items, straight after inserting them (every item is a child of the root, the
+//   worst case for the sibling walk in Cut) and after one PopMin has paired them up. priority_queue can't do this.
+//
+// Usage: ll_heap_bench [cItemMax]
+//
+
+struct Item
+{
+    uint64_t key;
+    int id;
+
+    DefineLL2Node(Item);
+    LL2Node node;
+};
+
+typedef ll::PairingHeap<Item, &Item::node, uint64_t, &Item::key> ItemHeap;
+
+struct ItemGreater
+{
+    bool operator()(const Item * pA, const Item * pB) const { return pA->key > pB->key; }
+};
+
+typedef std::priority_queue<Item *, std::vector<Item *>, ItemGreater> ItemQueue;
+
+static volatile uint64_t s_sink;
+
+static double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void ResetItems(std::vector<Item> & aItem, const std::vector<uint64_t> & aKey)
+{
+    for (size_t iItem = 0; iItem < aItem.size(); iItem++)
+    {
+        aItem[iItem].key = aKey[iItem];
+        aItem[iItem].id = (int)iItem;
+        aItem[iItem].node = {};
+    }
+}
+
+static void BenchBulk(std::vector<Item> & aItem, const std::vector<uint64_t> & aKey)
+{
+    double cItem = (double)aItem.size();
+    uint64_t sum = 0;
+
+    ResetItems(aItem, aKey);
+    ItemHeap heap;
+    auto start = std::chrono::steady_clock::now();
+    for (Item & item : aItem) heap.Insert(&item);
+    double nsHeapInsert = SecondsSince(start) * 1e9 / cItem;
+
+    start = std::chrono::steady_clock::now();
+    while (Item * pItem = heap.PopMin()) sum += pItem->key;
+    double nsHeapPop = SecondsSince(start) * 1e9 / cItem;
+
+    ResetItems(aItem, aKey);
+    ItemQueue queue;
+    start = std::chrono::steady_clock::now();
+    for (Item & item : aItem) queue.push(&item);
+    double nsQueuePush = SecondsSince(start) * 1e9 / cItem;
+
+    start = std::chrono::steady_clock::now();
+    while (!queue.empty())
+    {
+        sum -= queue.top()->key;
+        queue.pop();
+    }
+    double nsQueuePop = SecondsSince(start) * 1e9 / cItem;
+
+    s_sink = sum;
+    printf("%-10d %12.1f %12.1f %12.1f %12.1f\n", (int)aItem.size(), nsHeapInsert, nsHeapPop, nsQueuePush, nsQueuePop);
+}
+
+static void BenchSteady(std::vector<Item> & aItem, const std::vector<uint64_t> & aKey)
+{
+    const size_t cLive = 1000;
+    double cOp = (double)(aItem.size() - cLive);
+
+    ResetItems(aItem, aKey);
+    ItemHeap heap;
+    for (size_t iItem = 0; iItem < cLive; iItem++) heap.Insert(&aItem[iItem]);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t iItem = cLive; iItem < aItem.size(); iItem++)
+    {
+        Item * pItemMin = heap.PopMin();
+        aItem[iItem].key += pItemMin->key;
+        heap.Insert(&aItem[iItem]);
+    }
+    double nsHeap = SecondsSince(start) * 1e9 / cOp;
+    heap.Clear();
+
+    ResetItems(aItem, aKey);
+    ItemQueue queue;
+    for (size_t iItem = 0; iItem < cLive; iItem++) queue.push(&aItem[iItem]);
+
+    start = std::chrono::steady_clock::now();
+    for (size_t iItem = cLive; iItem < aItem.size(); iItem++)
+    {
+        Item * pItemMin = queue.top();
+        queue.pop();
+        aItem[iItem].key += pItemMin->key;
+        queue.push(&aItem[iItem]);
+    }
+    double nsQueue = SecondsSince(start) * 1e9 / cOp;
+
+    printf("steady (1000 live), ns per pop+push: heap %.1f, priority_queue %.1f\n", nsHeap, nsQueue);
+}
+
+static void BenchDecreaseKey(std::vector<Item> & aItem, const std::vector<uint64_t> & aKey)
+{
+    std::mt19937 rng(5);
+    std::vector<uint32_t> aiItemOp(aItem.size() * 4);
+    for (uint32_t & iItem : aiItemOp) iItem = rng() % (uint32_t)aItem.size();
+
+    // Every 4th op pops, the others decrease a random item's key by 1/8
+
+    ResetItems(aItem, aKey);
+    ItemHeap heap;
+    for (Item & item : aItem) heap.Insert(&item);
+
+    uint64_t sumHeap = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t iOp = 0; iOp < aiItemOp.size(); iOp++)
+    {
+        if (iOp % 4 == 3)
+        {
+            Item * pItemMin = heap.PopMin();
+            if (!pItemMin) break;
+            sumHeap += pItemMin->key;
+            continue;
+        }
+
+        Item * pItem = &aItem[aiItemOp[iOp]];
+        if (ItemHeap::IsItemLinked(pItem)) heap.DecreaseKey(pItem, pItem->key - pItem->key / 8);
+    }
+    double msHeap = SecondsSince(start) * 1e3;
+    heap.Clear();
+
+    ResetItems(aItem, aKey);
+    typedef std::pair<uint64_t, int> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    std::vector<bool> aIsDone(aItem.size(), false);
+    for (Item & item : aItem) queue.push(Entry(item.key, item.id));
+
+    uint64_t sumQueue = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t iOp = 0; iOp < aiItemOp.size(); iOp++)
+    {
+        if (iOp % 4 == 3)
+        {
+            while (!queue.empty() && (aIsDone[queue.top().second] || queue.top().first != aItem[queue.top().second].key))
+            {
+                queue.pop();
+            }
+            if (queue.empty()) break;
+
+            sumQueue += queue.top().first;
+            aIsDone[queue.top().second] = true;
+            queue.pop();
+            continue;
+        }
+
+        Item * pItem = &aItem[aiItemOp[iOp]];
+        if (aIsDone[pItem->id]) continue;
+        pItem->key -= pItem->key / 8;
+        queue.push(Entry(pItem->key, pItem->id));
+    }
+    double msQueue = SecondsSince(start) * 1e3;
+
+    if (sumHeap != sumQueue) printf("decrease-key results differ\n");
+    printf("decrease-key mix (%d items): heap %.1f ms, priority_queue (lazy) %.1f ms\n", (int)aItem.size(), msHeap, msQueue);
+}
+
+static void BenchRemove(std::vector<Item> & aItem, const std::vector<uint64_t> & aKey)
+{
+    std::mt19937 rng(7);
+    std::vector<Item *> apItem;
+    for (Item & item : aItem) apItem.push_back(&item);
+    std::shuffle(apItem.begin(), apItem.end(), rng);
+    size_t cRemove = apItem.size() / 2;
+
+    double aNs[2];
+    for (int isPaired = 0; isPaired < 2; isPaired++)
+    {
+        ResetItems(aItem, aKey);
+        ItemHeap heap;
+        for (Item & item : aItem) heap.Insert(&item);
+
+        if (isPaired)
+        {
+            Item * pItemMin = heap.PopMin();
+            heap.Insert(pItemMin);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t iRemove = 0; iRemove < cRemove; iRemove++) heap.Remove(apItem[iRemove]);
+        aNs[isPaired] = SecondsSince(start) * 1e9 / (double)cRemove;
+        heap.Clear();
+    }
+
+    printf("%-10d %16.1f %16.1f\n", (int)aItem.size(), aNs[0], aNs[1]);
+}
+
+int main(int argc, char ** argv)
+{
+    int cItemMax = (argc > 1) ? atoi(argv[1]) : 1024000;
+
+    std::mt19937_64 rng(3);
+    std::vector<uint64_t> aKeyMax(cItemMax);
+    for (uint64_t & key : aKeyMax) key = rng() >> 20;
+
+    printf("ns/item    %25s   %25s\n", "pairing heap", "priority_queue");
+    printf("%-10s %12s %12s %12s %12s\n", "items", "insert", "pop", "push", "pop");
+    for (int cItem = 1000; cItem <= cItemMax; cItem *= 4)
+    {
+        std::vector<Item> aItem(cItem);
+        std::vector<uint64_t> aKey(aKeyMax.begin(), aKeyMax.begin() + cItem);
+        BenchBulk(aItem, aKey);
+    }
+
+    {
+        std::vector<Item> aItem(cItemMax);
+        BenchSteady(aItem, aKeyMax);
+    }
+
+    {
+        int cItem = std::min(cItemMax, 256000);
+        std::vector<Item> aItem(cItem);
+        std::vector<uint64_t> aKey(aKeyMax.begin(), aKeyMax.begin() + cItem);
+        BenchDecreaseKey(aItem, aKey);
+    }
+
+    // The unpaired column grows with n: Cut walks the root's whole child list
+
+    printf("Remove ns  %16s %16s\n", "after inserts", "after a PopMin");
+    for (int cItem = 1000; cItem <= std::min(cItemMax, 16000); cItem *= 2)
+    {
+        std::vector<Item> aItem(cItem);
+        std::vector<uint64_t> aKey(aKeyMax.begin(), aKeyMax.begin() + cItem);
+        BenchRemove(aItem, aKey);
+    }
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <list>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "../ll_lru.h"
+
+//
+// ll::Lru against the usual std::unordered_map + std::list LRU. Both replay the same Zipf-distributed key stream
+//  (lookup, insert on miss) at a few cache sizes; hit rates should match exactly, so the difference is ns/lookup.
+//
+// Usage: ll_lru_bench [cLookup]
+//
+
+struct Entry
+{
+    uint64_t key;
+
+    DefineLL2Node(Entry);
+    LL2Node lruNode;
+};
+
+typedef ll::Lru<Entry, &Entry::lruNode, uint64_t, &Entry::key> EntryLru;
+
+static double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// NOTE - Evicted entries go back on a free stack so the cache never allocates while it runs
+
+struct FreeStack
+{
+    std::vector<Entry *> apEntry;
+};
+
+static void EvictEntry(Entry * pEntry, void * pUserData)
+{
+    ((FreeStack *)pUserData)->apEntry.push_back(pEntry);
+}
+
+struct Result
+{
+    double nsPerLookup;
+    double hitRate;
+};
+
+static Result BenchLl(const std::vector<uint64_t> & aKey, int cCapacity)
+{
+    std::vector<Entry> aEntry(cCapacity + 1);
+    FreeStack freeStack;
+    for (Entry & entry : aEntry)
+    {
+        entry.lruNode = {};
+        freeStack.apEntry.push_back(&entry);
+    }
+
+    EntryLru lru;
+    lru.Init(cCapacity, 0, EvictEntry, &freeStack);
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t key : aKey)
+    {
+        if (lru.Lookup(key)) continue;
+
+        Entry * pEntry = freeStack.apEntry.back();
+        freeStack.apEntry.pop_back();
+        pEntry->key = key;
+        lru.Insert(pEntry);
+    }
+    double sec = SecondsSince(start);
+
+    Result result;
+    result.nsPerLookup = sec * 1e9 / aKey.size();
+    result.hitRate = (double)lru.cHit / aKey.size();
+    return result;
+}
+
+static Result BenchStd(const std::vector<uint64_t> & aKey, int cCapacity)
+{
+    std::list<uint64_t> recency;
+    std::unordered_map<uint64_t, std::list<uint64_t>::iterator> map;
+    map.reserve(cCapacity * 2);
+    uint64_t cHit = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t key : aKey)
+    {
+        auto itFound = map.find(key);
+        if (itFound != map.end())
+        {
+            recency.splice(recency.begin(), recency, itFound->second);
+            cHit++;
+            continue;
+        }
+
+        recency.push_front(key);
+        map[key] = recency.begin();
+        if ((int)map.size() > cCapacity)
+        {
+            map.erase(recency.back());
+            recency.pop_back();
+        }
+    }
+    double sec = SecondsSince(start);
+
+    Result result;
+    result.nsPerLookup = sec * 1e9 / aKey.size();
+    result.hitRate = (double)cHit / aKey.size();
+    return result;
+}
+
+// NOTE - Inverse-CDF sampling of a Zipf(s = 1) distribution over cKey keys, scattered so hot keys aren't adjacent
+
+static std::vector<uint64_t> MakeZipfKeys(int cLookup, int cKey)
+{
+    std::vector<double> aCdf(cKey);
+    double sum = 0;
+    for (int iKey = 0; iKey < cKey; iKey++)
+    {
+        sum += 1.0 / (iKey + 1);
+        aCdf[iKey] = sum;
+    }
+
+    std::mt19937_64 rng(1);
+    std::uniform_real_distribution<double> uniform(0, sum);
+    std::vector<uint64_t> aKey(cLookup);
+    for (uint64_t & key : aKey)
+    {
+        int iKey = (int)(std::lower_bound(aCdf.begin(), aCdf.end(), uniform(rng)) - aCdf.begin());
+        key = (uint64_t)iKey * 0x9e3779b97f4a7c15ull;
+    }
+    return aKey;
+}
+
+int main(int argc, char ** argv)
+{
+    int cLookup = (argc > 1) ? atoi(argv[1]) : 4000000;
+    const int cKey = 1000000;
+
+    std::vector<uint64_t> aKey = MakeZipfKeys(cLookup, cKey);
+
+    printf("%d lookups over %d Zipf keys\n", cLookup, cKey);
+    printf("%-10s %10s %14s %14s\n", "capacity", "hit rate", "ll ns/lookup", "std ns/lookup");
+    for (int cCapacity = 1000; cCapacity <= 256000; cCapacity *= 4)
+    {
+        Result resultLl = BenchLl(aKey, cCapacity);
+        Result resultStd = BenchStd(aKey, cCapacity);
+        if (fabs(resultLl.hitRate - resultStd.hitRate) > 1e-9)
+        {
+            printf("hit rates differ: %f vs %f\n", resultLl.hitRate, resultStd.hitRate);
+            return 1;
+        }
+
+        printf("%-10d %9.1f%% %14.1f %14.1f\n", cCapacity, resultLl.hitRate * 100, resultLl.nsPerLookup, resultStd.nsPerLookup);
+    }
+    return 0;
+}
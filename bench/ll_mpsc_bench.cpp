@@ -0,0 +1,137 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../ll_mpsc.h"
+
+//
+// Throughput of ll_mpsc.h against a mutex-protected LL1 list: P producers push cJobPerProducer items each while one
+//  consumer drains them in batches
+//
+// Usage: ll_mpsc_bench [cProducerMax]
+//
+
+struct Job
+{
+    DefineLL1Node(Job)
+    LL1Node node;
+};
+
+DefineLL1Mpsc(Job, node, Jobs);
+DefineLL1(Job, node, JobList);
+
+static double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double BenchMpsc(int cProducer, int cJobPerProducer)
+{
+    static LL1MpscType(Jobs) s_queue;
+    s_queue.pTail.store(nullptr);
+    s_queue.pHead = nullptr;
+    s_queue.pStubNext = nullptr;
+
+    std::vector<Job> aJob((size_t)cProducer * cJobPerProducer);
+    for (Job & job : aJob) job.node.pNext = nullptr;
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> aThread;
+    for (int iProducer = 0; iProducer < cProducer; iProducer++)
+    {
+        aThread.emplace_back([&aJob, iProducer, cJobPerProducer]()
+        {
+            Job * aJobMine = &aJob[(size_t)iProducer * cJobPerProducer];
+            for (int iJob = 0; iJob < cJobPerProducer; iJob++)
+            {
+                LL1MpscPush(Job, s_queue, &aJobMine[iJob]);
+            }
+        });
+    }
+
+    long cConsumed = 0;
+    while (cConsumed < (long)aJob.size())
+    {
+        LL1Type(JobList) list = {};
+        int cDrained;
+        LL1MpscDrain(Job, s_queue, list, cDrained);
+        if (!cDrained) std::this_thread::yield();
+        cConsumed += cDrained;
+    }
+
+    for (std::thread & thread : aThread) thread.join();
+    return SecondsSince(start);
+}
+
+static double BenchMutex(int cProducer, int cJobPerProducer)
+{
+    static std::mutex s_mutex;
+    static LL1Type(JobList) s_list;
+    std::vector<Job> aJob((size_t)cProducer * cJobPerProducer);
+    for (Job & job : aJob) job.node.pNext = nullptr;
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> aThread;
+    for (int iProducer = 0; iProducer < cProducer; iProducer++)
+    {
+        aThread.emplace_back([&aJob, iProducer, cJobPerProducer]()
+        {
+            Job * aJobMine = &aJob[(size_t)iProducer * cJobPerProducer];
+            for (int iJob = 0; iJob < cJobPerProducer; iJob++)
+            {
+                std::lock_guard<std::mutex> lock(s_mutex);
+                LL1AddTail(Job, s_list, &aJobMine[iJob]);
+            }
+        });
+    }
+
+    long cConsumed = 0;
+    while (cConsumed < (long)aJob.size())
+    {
+        LL1Type(JobList) list = {};
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            list = s_list;
+            s_list.pHead = nullptr;
+            s_list.pTail = nullptr;
+        }
+
+        int cDrained = 0;
+        Job * pJob;
+        for (;;)
+        {
+            LL1RemoveHead(Job, list, pJob);
+            if (!pJob) break;
+            cDrained++;
+        }
+        if (!cDrained) std::this_thread::yield();
+        cConsumed += cDrained;
+    }
+
+    for (std::thread & thread : aThread) thread.join();
+    return SecondsSince(start);
+}
+
+int main(int argc, char ** argv)
+{
+    int cProducerMax = (argc > 1) ? atoi(argv[1]) : 8;
+    const int cJobPerProducer = 1000000;
+
+    printf("%-10s %14s %14s\n", "producers", "mpsc Mjob/s", "mutex Mjob/s");
+    for (int cProducer = 1; cProducer <= cProducerMax; cProducer *= 2)
+    {
+        double cJobMillion = cProducer * (cJobPerProducer / 1e6);
+        double secMpsc = BenchMpsc(cProducer, cJobPerProducer);
+        double secMutex = BenchMutex(cProducer, cJobPerProducer);
+        printf("%-10d %14.1f %14.1f\n", cProducer, cJobMillion / secMpsc, cJobMillion / secMutex);
+    }
+    return 0;
+}
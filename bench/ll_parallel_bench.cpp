@@ -0,0 +1,117 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../ll_parallel.h"
+
+//
+// ll::ParallelList ForEach and Reduce over a shuffled LL2 list of cItem particles, serially (no scheduler) and on
+//  2, 4, ... workers, plus the cost of the serial walk that rebuilds the checkpoints. Speedups need as many hardware
+//  threads as workers.
+//
+// Usage: ll_parallel_bench [cItem] [cWorkerMax]
+//
+
+struct Particle
+{
+    double x;
+    double v;
+
+    DefineLL2Node(Particle);
+    LL2Node node;
+};
+
+typedef ll::List<Particle, &Particle::node> ParticleList;
+typedef ll::ParallelList<Particle, &Particle::node> ParticleParallelList;
+
+static volatile double s_sink;
+
+static double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Result
+{
+    double msForEach;
+    double msReduce;
+};
+
+static Result Bench(ParticleParallelList & parallel, ll::Scheduler * pScheduler)
+{
+    const int cRep = 3;
+    Result result;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int iRep = 0; iRep < cRep; iRep++)
+    {
+        parallel.ForEach(pScheduler, [](Particle * pParticle) { pParticle->x += pParticle->v * 0.016; });
+    }
+    result.msForEach = SecondsSince(start) * 1e3 / cRep;
+
+    start = std::chrono::steady_clock::now();
+    for (int iRep = 0; iRep < cRep; iRep++)
+    {
+        s_sink = parallel.Reduce(pScheduler, 0.0,
+                                 [](double & acc, Particle * pParticle) { acc += pParticle->x; },
+                                 [](double a, double b) { return a + b; });
+    }
+    result.msReduce = SecondsSince(start) * 1e3 / cRep;
+
+    return result;
+}
+
+int main(int argc, char ** argv)
+{
+    int cItem = (argc > 1) ? atoi(argv[1]) : 1000000;
+    int cWorkerMax = (argc > 2) ? atoi(argv[2]) : 8;
+
+    std::vector<Particle> aParticle(cItem);
+    std::vector<int> aiParticle(cItem);
+    for (int iParticle = 0; iParticle < cItem; iParticle++) aiParticle[iParticle] = iParticle;
+    std::mt19937 rng(1);
+    std::shuffle(aiParticle.begin(), aiParticle.end(), rng);
+
+    ParticleList list;
+    for (int iParticle : aiParticle)
+    {
+        Particle & particle = aParticle[iParticle];
+        particle.x = iParticle;
+        particle.v = 1;
+        particle.node = {};
+        list.AddTail(&particle);
+    }
+
+    ParticleParallelList parallel(list);
+    parallel.Init();
+
+    auto start = std::chrono::steady_clock::now();
+    parallel.Rebuild();
+    double msRebuild = SecondsSince(start) * 1e3;
+
+    printf("%d items, hardware threads: %u, checkpoint rebuild %.2f ms\n", cItem, std::thread::hardware_concurrency(), msRebuild);
+    printf("%-10s %14s %10s %14s %10s\n", "workers", "ForEach ms", "speedup", "Reduce ms", "speedup");
+
+    Result resultSerial = Bench(parallel, nullptr);
+    printf("%-10s %14.2f %9.2fx %14.2f %9.2fx\n", "serial", resultSerial.msForEach, 1.0, resultSerial.msReduce, 1.0);
+
+    for (int cWorker = 2; cWorker <= cWorkerMax; cWorker *= 2)
+    {
+        ll::Scheduler scheduler;
+        scheduler.Init(cWorker);
+        Result result = Bench(parallel, &scheduler);
+        scheduler.Shutdown();
+
+        printf("%-10d %14.2f %9.2fx %14.2f %9.2fx\n",
+            cWorker,
+            result.msForEach, resultSerial.msForEach / result.msForEach,
+            result.msReduce, resultSerial.msReduce / result.msReduce);
+    }
+    return 0;
+}
@@ -0,0 +1,151 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../ll_pool.h"
+
+//
+// ll::Pool against malloc/free and against a single shared LL1 free list under a mutex (the pool without its
+//  per-thread caches). Each of T threads churns cOpPerThread random allocs/frees of 64-byte blocks, keeping a few
+//  thousand live at a time, and touches every block it gets.
+//
+// Usage: ll_pool_bench [cThreadMax]
+//
+
+static const uintptr_t s_cbBlock = 64;
+static const int s_cLiveMax = 4096;
+
+static double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// NOTE - The baseline: one free list for everyone, refilled from malloc one block at a time
+
+struct FreeBlock
+{
+    DefineLL1Node(FreeBlock)
+    LL1Node node;
+};
+
+DefineLL1(FreeBlock, node, FreeBlocks);
+
+struct SingleListPool
+{
+    std::mutex mutex;
+    LL1Type(FreeBlocks) freeList = {};
+    std::vector<void *> apMalloced;
+
+    void * Alloc()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            FreeBlock * pBlock;
+            LL1RemoveHead(FreeBlock, freeList, pBlock);
+            if (pBlock) return pBlock;
+        }
+
+        void * p = malloc(s_cbBlock);
+        std::lock_guard<std::mutex> lock(mutex);
+        apMalloced.push_back(p);
+        return p;
+    }
+
+    void Free(void * p)
+    {
+        FreeBlock * pBlock = (FreeBlock *)p;
+        pBlock->node = {};
+        std::lock_guard<std::mutex> lock(mutex);
+        LL1AddHead(FreeBlock, freeList, pBlock);
+    }
+
+    ~SingleListPool()
+    {
+        for (void * p : apMalloced) free(p);
+    }
+};
+
+template <typename FnAlloc, typename FnFree>
+static void Churn(int iThread, int cOp, FnAlloc fnAlloc, FnFree fnFree)
+{
+    std::mt19937 rng(iThread);
+    std::vector<void *> apLive;
+    apLive.reserve(s_cLiveMax);
+
+    for (int iOp = 0; iOp < cOp; iOp++)
+    {
+        bool isAlloc = apLive.empty() || ((int)apLive.size() < s_cLiveMax && (rng() & 1));
+        if (isAlloc)
+        {
+            void * p = fnAlloc();
+            memset(p, iThread, s_cbBlock);
+            apLive.push_back(p);
+        }
+        else
+        {
+            size_t i = rng() % apLive.size();
+            void * p = apLive[i];
+            apLive[i] = apLive.back();
+            apLive.pop_back();
+            fnFree(p);
+        }
+    }
+
+    for (void * p : apLive) fnFree(p);
+}
+
+template <typename FnThread>
+static double RunThreads(int cThread, FnThread fnThread)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> aThread;
+    for (int iThread = 0; iThread < cThread; iThread++)
+    {
+        aThread.emplace_back(fnThread, iThread);
+    }
+    for (std::thread & thread : aThread) thread.join();
+    return SecondsSince(start);
+}
+
+int main(int argc, char ** argv)
+{
+    int cThreadMax = (argc > 1) ? atoi(argv[1]) : 8;
+    const int cOpPerThread = 2000000;
+
+    printf("%-10s %14s %14s %14s   (Mop/s)\n", "threads", "ll::Pool", "malloc", "single list");
+    for (int cThread = 1; cThread <= cThreadMax; cThread *= 2)
+    {
+        double cOpMillion = cThread * (cOpPerThread / 1e6);
+
+        ll::Pool pool;
+        pool.Init(s_cbBlock);
+        double secPool = RunThreads(cThread, [&pool, cOpPerThread](int iThread)
+        {
+            ll::PoolCache cache;
+            Churn(iThread, cOpPerThread, [&]() { return pool.Alloc(&cache); }, [&](void * p) { pool.Free(&cache, p); });
+            pool.Flush(&cache);
+        });
+        pool.Destroy();
+
+        double secMalloc = RunThreads(cThread, [cOpPerThread](int iThread)
+        {
+            Churn(iThread, cOpPerThread, []() { return malloc(s_cbBlock); }, [](void * p) { free(p); });
+        });
+
+        SingleListPool singleListPool;
+        double secSingleList = RunThreads(cThread, [&singleListPool, cOpPerThread](int iThread)
+        {
+            Churn(iThread, cOpPerThread, [&]() { return singleListPool.Alloc(); }, [&](void * p) { singleListPool.Free(p); });
+        });
+
+        printf("%-10d %14.1f %14.1f %14.1f\n", cThread, cOpMillion / secPool, cOpMillion / secMalloc, cOpMillion / secSingleList);
+    }
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "../ll.h"
+
+//
+// ForLL2 against ForLL2Prefetch and LL2VisitBatched on a list whose items are shuffled in memory. Each item is two
+//  cache lines, with the link at the front and the payload the visit reads in the second line, plus a little
+//  arithmetic per item so there is work to overlap the misses with.
+//
+// Usage: ll_prefetch_bench [cItemMax]
+//
+
+struct Item
+{
+    DefineLL2Node(Item);
+    LL2Node node;
+
+    char pad[64 - sizeof(LL2Node)];
+    uint64_t aPayload[8];
+};
+
+DefineLL2(Item, node, Items);
+
+static double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static volatile uint64_t s_sink;
+static uint64_t s_sum;
+
+static inline void Visit(Item * pItem)
+{
+    uint64_t hash = pItem->aPayload[0];
+    for (int i = 0; i < 8; i++)
+    {
+        hash = (hash ^ pItem->aPayload[i]) * 0x100000001b3ull;
+    }
+    s_sum += hash;
+}
+
+enum MODE
+{
+    MODE_Plain,
+    MODE_Prefetch,
+    MODE_VisitBatched,
+
+    MODE_Max
+};
+
+static const char * s_aModeName[MODE_Max] = { "ForLL2", "ForLL2Prefetch(8)", "LL2VisitBatched" };
+
+static double Bench(LL2Type(Items) & list, MODE mode, int cItem, int cPass)
+{
+    s_sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int iPass = 0; iPass < cPass; iPass++)
+    {
+        switch (mode)
+        {
+        case MODE_Plain:
+            ForLL2(Item, it, list)
+            {
+                Visit(it);
+            }
+            break;
+
+        case MODE_Prefetch:
+            ForLL2Prefetch(Item, it, list, 8)
+            {
+                Visit(it);
+            }
+            break;
+
+        case MODE_VisitBatched:
+            LL2VisitBatched(Item, list, Visit);
+            break;
+
+        default:
+            break;
+        }
+    }
+    double sec = SecondsSince(start);
+
+    s_sink = s_sum;
+    return sec * 1e9 / ((double)cPass * cItem);
+}
+
+int main(int argc, char ** argv)
+{
+    int cItemMax = (argc > 1) ? atoi(argv[1]) : 1024000;
+
+    printf("%-10s", "items");
+    for (int mode = 0; mode < MODE_Max; mode++) printf(" %18s", s_aModeName[mode]);
+    printf("   (ns/item)\n");
+
+    for (int cItem = 1000; cItem <= cItemMax; cItem *= 4)
+    {
+        std::vector<Item> aItem(cItem);
+        std::vector<int> aiOrder(cItem);
+        for (int i = 0; i < cItem; i++) aiOrder[i] = i;
+        std::mt19937 rng(1);
+        std::shuffle(aiOrder.begin(), aiOrder.end(), rng);
+
+        LL2Type(Items) list = {};
+        for (int i : aiOrder)
+        {
+            aItem[i].node = {};
+            for (int iPayload = 0; iPayload < 8; iPayload++) aItem[i].aPayload[iPayload] = (uint64_t)i * 8 + iPayload;
+            LL2AddTail(Item, list, &aItem[i]);
+        }
+
+        int cPass = std::max(1, 10000000 / cItem);
+        printf("%-10d", cItem);
+        for (int mode = 0; mode < MODE_Max; mode++)
+        {
+            printf(" %18.2f", Bench(list, (MODE)mode, cItem, cPass));
+        }
+        printf("\n");
+    }
+    return 0;
+}
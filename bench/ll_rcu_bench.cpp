@@ -0,0 +1,189 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "../ll_rcu.h"
+
+//
+// Reader scaling of ll::RcuList against an LL2 list behind a pthread rwlock: 1, 2, 4, ... reader threads walk the
+//  whole list as often as they can for a fixed time, while one writer replaces the head every 100us (retiring and
+//  reclaiming it on the RCU side). Reported as total walks per second, for a short and a longer list. Readers only
+//  scale with as many hardware threads as readers; the rwlock's shared counter is what stops it scaling.
+//
+// Usage: ll_rcu_bench [cReaderMax]
+//
+
+struct Item
+{
+    long value;
+
+    DefineLL2Node(Item);
+    LL2Node node;
+};
+
+DefineLL2(Item, node, Items);
+
+typedef ll::RcuList<Item, &Item::node> ItemRcuList;
+
+static const double s_secRun = 0.25;
+static volatile long s_sink;
+
+static void FreeItem(Item * pItem, void *)
+{
+    delete pItem;
+}
+
+static Item * NewItem()
+{
+    Item * pItem = new Item();
+    pItem->value = 1;
+    return pItem;
+}
+
+static double BenchRcu(int cReader, int cItem)
+{
+    ll::EpochDomain domain;
+    ItemRcuList list;
+    list.Init(&domain, FreeItem, nullptr);
+    for (int iItem = 0; iItem < cItem; iItem++) list.AddTail(NewItem());
+
+    std::atomic<bool> isDone(false);
+    std::atomic<long> cWalk(0);
+    std::vector<std::thread> aThreadReader;
+    for (int iReader = 0; iReader < cReader; iReader++)
+    {
+        aThreadReader.emplace_back([&]()
+            {
+                ll::EpochReader reader;
+                domain.Register(&reader);
+
+                long cWalkReader = 0;
+                long sum = 0;
+                while (!isDone.load(std::memory_order_relaxed))
+                {
+                    ll::EpochGuard guard(&reader);
+                    for (Item * pItem = list.Head(); pItem; pItem = ItemRcuList::Next(pItem)) sum += pItem->value;
+                    cWalkReader++;
+                }
+
+                domain.Unregister(&reader);
+                cWalk += cWalkReader;
+                s_sink = sum;
+            });
+    }
+
+    std::thread threadWriter([&]()
+        {
+            while (!isDone.load())
+            {
+                Item * pItemHead = list.Head();
+                list.Remove(pItemHead);
+                list.Retire(pItemHead);
+                list.AddTail(NewItem());
+                list.Reclaim();
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        });
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(s_secRun));
+    isDone = true;
+    for (std::thread & thread : aThreadReader) thread.join();
+    threadWriter.join();
+
+    while (Item * pItem = list.Head())
+    {
+        list.Remove(pItem);
+        list.Retire(pItem);
+    }
+    list.ReclaimAll();
+
+    return cWalk.load() / s_secRun;
+}
+
+static double BenchRwlock(int cReader, int cItem)
+{
+    pthread_rwlock_t lock;
+    pthread_rwlock_init(&lock, nullptr);
+    LL2Type(Items) list = {};
+    for (int iItem = 0; iItem < cItem; iItem++)
+    {
+        Item * pItem = NewItem();
+        LL2AddTail(Item, list, pItem);
+    }
+
+    std::atomic<bool> isDone(false);
+    std::atomic<long> cWalk(0);
+    std::vector<std::thread> aThreadReader;
+    for (int iReader = 0; iReader < cReader; iReader++)
+    {
+        aThreadReader.emplace_back([&]()
+            {
+                long cWalkReader = 0;
+                long sum = 0;
+                while (!isDone.load(std::memory_order_relaxed))
+                {
+                    pthread_rwlock_rdlock(&lock);
+                    ForLL2(Item, it, list) sum += it->value;
+                    pthread_rwlock_unlock(&lock);
+                    cWalkReader++;
+                }
+
+                cWalk += cWalkReader;
+                s_sink = sum;
+            });
+    }
+
+    std::thread threadWriter([&]()
+        {
+            while (!isDone.load())
+            {
+                Item * pItemNew = NewItem();
+                pthread_rwlock_wrlock(&lock);
+                Item * pItemHead = list.pHead;
+                LL2Remove(Item, list, pItemHead);
+                LL2AddTail(Item, list, pItemNew);
+                pthread_rwlock_unlock(&lock);
+                delete pItemHead;
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        });
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(s_secRun));
+    isDone = true;
+    for (std::thread & thread : aThreadReader) thread.join();
+    threadWriter.join();
+
+    while (Item * pItem = list.pHead)
+    {
+        LL2Remove(Item, list, pItem);
+        delete pItem;
+    }
+    pthread_rwlock_destroy(&lock);
+
+    return cWalk.load() / s_secRun;
+}
+
+int main(int argc, char ** argv)
+{
+    int cReaderMax = (argc > 1) ? atoi(argv[1]) : 8;
+
+    printf("hardware threads: %u, M walks/s\n", std::thread::hardware_concurrency());
+    printf("%-8s %-10s %12s %12s\n", "items", "readers", "RcuList", "rwlock");
+
+    for (int cItem : { 8, 256 })
+    {
+        for (int cReader = 1; cReader <= cReaderMax; cReader *= 2)
+        {
+            double walkPerSecRcu = BenchRcu(cReader, cItem);
+            double walkPerSecRwlock = BenchRwlock(cReader, cItem);
+            printf("%-8d %-10d %12.2f %12.2f\n", cItem, cReader, walkPerSecRcu / 1e6, walkPerSecRwlock / 1e6);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "../ll_sched.h"
+
+//
+// ll::Scheduler throughput on 1 to cWorkerMax workers. Each run is one binary tree of tasks spawned from a single root,
+//  so every worker past the first only gets work by stealing. Fine tasks do nothing but spawn (scheduler overhead),
+//  coarse tasks also spin for a while (how well stealing spreads real work). Tasks come from a preallocated array so
+//  the allocator stays out of the numbers.
+//
+// Usage: ll_sched_bench [cWorkerMax]
+//
+
+struct Job : ll::Task
+{
+    ll::Scheduler * pScheduler;
+    int depth;
+    int cSpin;
+};
+
+static std::vector<Job> s_aJob;
+static std::atomic<int> s_iJobNext;
+static volatile uint64_t s_sink;
+
+static double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void RunJob(ll::Task * pTask)
+{
+    Job * pJob = static_cast<Job *>(pTask);
+
+    uint64_t x = 0;
+    for (int iSpin = 0; iSpin < pJob->cSpin; iSpin++) x += (uint64_t)iSpin * iSpin;
+    s_sink = x;
+
+    for (int iChild = 0; pJob->depth > 0 && iChild < 2; iChild++)
+    {
+        Job * pJobChild = &s_aJob[s_iJobNext.fetch_add(1, std::memory_order_relaxed)];
+        pJobChild->pfnRun = RunJob;
+        pJobChild->pScheduler = pJob->pScheduler;
+        pJobChild->depth = pJob->depth - 1;
+        pJobChild->cSpin = pJob->cSpin;
+        pJob->pScheduler->Submit(pJobChild);
+    }
+}
+
+struct Result
+{
+    double ns;
+    uint64_t cSteal;
+};
+
+static Result RunTree(int cWorker, int depth, int cSpin)
+{
+    int cJob = (2 << depth) - 1;
+    s_aJob.assign(cJob, Job());
+    s_iJobNext = 1;
+
+    ll::Scheduler scheduler;
+    scheduler.Init(cWorker);
+
+    Job * pJobRoot = &s_aJob[0];
+    pJobRoot->pfnRun = RunJob;
+    pJobRoot->pScheduler = &scheduler;
+    pJobRoot->depth = depth;
+    pJobRoot->cSpin = cSpin;
+
+    auto start = std::chrono::steady_clock::now();
+    scheduler.Submit(pJobRoot);
+    scheduler.WaitIdle();
+    double sec = SecondsSince(start);
+
+    Result result;
+    result.ns = sec * 1e9 / cJob;
+    result.cSteal = 0;
+    for (int iWorker = 0; iWorker < cWorker; iWorker++) result.cSteal += scheduler.aWorker[iWorker].cSteal;
+
+    scheduler.Shutdown();
+    return result;
+}
+
+int main(int argc, char ** argv)
+{
+    int cWorkerMax = (argc > 1) ? atoi(argv[1]) : 8;
+    const int depthFine = 17;
+    const int depthCoarse = 10;
+    const int cSpinCoarse = 20000;
+
+    printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    printf("fine: %d tasks, coarse: %d tasks of %d spins\n", (2 << depthFine) - 1, (2 << depthCoarse) - 1, cSpinCoarse);
+    printf("%-10s %12s %10s %10s   %12s %10s %10s\n", "workers", "fine ns", "speedup", "steals", "coarse ns", "speedup", "steals");
+
+    Result resultFine1 = {};
+    Result resultCoarse1 = {};
+    for (int cWorker = 1; cWorker <= cWorkerMax; cWorker *= 2)
+    {
+        Result resultFine = RunTree(cWorker, depthFine, 0);
+        Result resultCoarse = RunTree(cWorker, depthCoarse, cSpinCoarse);
+        if (cWorker == 1)
+        {
+            resultFine1 = resultFine;
+            resultCoarse1 = resultCoarse;
+        }
+
+        printf("%-10d %12.1f %9.2fx %10llu   %12.1f %9.2fx %10llu\n",
+            cWorker,
+            resultFine.ns, resultFine1.ns / resultFine.ns, (unsigned long long)resultFine.cSteal,
+            resultCoarse.ns, resultCoarse1.ns / resultCoarse.ns, (unsigned long long)resultCoarse.cSteal);
+    }
+    return 0;
+}
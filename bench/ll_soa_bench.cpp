@@ -0,0 +1,132 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "../ll.h"
+
+//
+// Walks that only need the links (count, and find the last item by index) over cItem 256-byte objects, with the
+//  links embedded in the objects (LL2) against the links in an LL2Soa side table. Both lists hold every object, in
+//  memory order and then in shuffled order. The embedded walk touches one object line per hop; the side-table walk
+//  only reads the 4-byte next[] array, so it stays in cache far longer as cItem grows.
+//
+// Usage: ll_soa_bench [cItem]
+//
+
+struct Item
+{
+    uint32_t iItem;
+    char aPad[256 - 4 - 2 * sizeof(void *)];
+
+    DefineLL2Node(Item);
+    LL2Node node;
+};
+
+DefineLL2(Item, node, Items);
+
+static volatile uint64_t s_sink;
+static uint32_t s_iItemTarget;
+
+static double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool IsTarget(uint32_t iItem)
+{
+    return iItem == s_iItemTarget;
+}
+
+int main(int argc, char ** argv)
+{
+    uint32_t cItem = (argc > 1) ? (uint32_t)atoi(argv[1]) : 500000;
+    const int cRep = 10;
+
+    std::vector<Item> aItem(cItem);
+    std::vector<uint32_t> aiPrev(cItem);
+    std::vector<uint32_t> aiNext(cItem);
+    std::vector<uint32_t> aiItemOrder(cItem);
+    for (uint32_t iItem = 0; iItem < cItem; iItem++) aiItemOrder[iItem] = iItem;
+    std::mt19937 rng(1);
+
+    printf("%u items of %d bytes, ms per walk (avg of %d)\n", cItem, (int)sizeof(Item), cRep);
+    printf("%-10s %-6s %10s %10s\n", "order", "walk", "LL2", "LL2Soa");
+
+    for (int isShuffled = 0; isShuffled < 2; isShuffled++)
+    {
+        if (isShuffled) std::shuffle(aiItemOrder.begin(), aiItemOrder.end(), rng);
+
+        LL2Type(Items) list = {};
+        LL2SoaTable table;
+        LL2SoaTableInit(table, aiPrev.data(), aiNext.data(), cItem);
+        LL2Soa soaList;
+        LL2SoaInit(soaList, &table);
+
+        for (uint32_t iItem : aiItemOrder)
+        {
+            Item * pItem = &aItem[iItem];
+            pItem->iItem = iItem;
+            pItem->node = {};
+            LL2AddTail(Item, list, pItem);
+            LL2SoaAddTail(soaList, iItem);
+        }
+        s_iItemTarget = aiItemOrder[cItem - 1];
+
+        // Count
+
+        auto start = std::chrono::steady_clock::now();
+        for (int iRep = 0; iRep < cRep; iRep++)
+        {
+            uint64_t cItemCounted = 0;
+            ForLL2(Item, it, list) cItemCounted++;
+            s_sink = s_sink + cItemCounted;
+        }
+        double secCountLL2 = SecondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        for (int iRep = 0; iRep < cRep; iRep++)
+        {
+            uint32_t cItemCounted;
+            LL2SoaCount(soaList, cItemCounted);
+            s_sink = s_sink + cItemCounted;
+        }
+        double secCountSoa = SecondsSince(start);
+
+        // Find the last item by index
+
+        start = std::chrono::steady_clock::now();
+        for (int iRep = 0; iRep < cRep; iRep++)
+        {
+            Item * pItemFound = nullptr;
+            ForLL2(Item, it, list)
+            {
+                if (it->iItem == s_iItemTarget)
+                {
+                    pItemFound = it;
+                    break;
+                }
+            }
+            s_sink = s_sink + (uintptr_t)pItemFound;
+        }
+        double secFindLL2 = SecondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        for (int iRep = 0; iRep < cRep; iRep++)
+        {
+            uint32_t iItemFound;
+            LL2SoaFind(soaList, IsTarget, iItemFound);
+            s_sink = s_sink + iItemFound;
+        }
+        double secFindSoa = SecondsSince(start);
+
+        const char * szOrder = isShuffled ? "shuffled" : "in memory";
+        printf("%-10s %-6s %10.2f %10.2f\n", szOrder, "count", secCountLL2 * 1e3 / cRep, secCountSoa * 1e3 / cRep);
+        printf("%-10s %-6s %10.2f %10.2f\n", szOrder, "find", secFindLL2 * 1e3 / cRep, secFindSoa * 1e3 / cRep);
+    }
+    return 0;
+}
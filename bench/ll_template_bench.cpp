@@ -0,0 +1,132 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "../ll.h"
+
+//
+// The ll::List template layer against the LL2 macros it wraps: the same add/traverse/remove workload through both
+//  APIs. The two should be indistinguishable; the template layer is only meant to cost compile time.
+//
+// Usage: ll_template_bench [cItem]
+//
+
+struct Item
+{
+    int64_t value;
+
+    DefineLL2Node(Item);
+    LL2Node node;
+};
+
+DefineLL2(Item, node, Items);
+
+typedef ll::List<Item, &Item::node> ItemList;
+
+static double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static volatile int64_t s_sink;
+
+struct Times
+{
+    double nsAdd;
+    double nsTraverse;
+    double nsRemove;
+};
+
+static Times BenchMacro(std::vector<Item> & aItem, const std::vector<int> & aiOrder, int cPass)
+{
+    Times times = {};
+    int64_t sum = 0;
+    for (int iPass = 0; iPass < cPass; iPass++)
+    {
+        LL2Type(Items) list = {};
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i : aiOrder) LL2AddTail(Item, list, &aItem[i]);
+        times.nsAdd += SecondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        ForLL2(Item, it, list)
+        {
+            sum += it->value;
+        }
+        times.nsTraverse += SecondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < aItem.size(); i++) LL2Remove(Item, list, &aItem[i]);
+        times.nsRemove += SecondsSince(start);
+    }
+
+    s_sink = sum;
+    return times;
+}
+
+static Times BenchTemplate(std::vector<Item> & aItem, const std::vector<int> & aiOrder, int cPass)
+{
+    Times times = {};
+    int64_t sum = 0;
+    for (int iPass = 0; iPass < cPass; iPass++)
+    {
+        ItemList list;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i : aiOrder) list.AddTail(&aItem[i]);
+        times.nsAdd += SecondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        for (Item * pItem : list)
+        {
+            sum += pItem->value;
+        }
+        times.nsTraverse += SecondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < aItem.size(); i++) list.Remove(&aItem[i]);
+        times.nsRemove += SecondsSince(start);
+    }
+
+    s_sink = sum;
+    return times;
+}
+
+int main(int argc, char ** argv)
+{
+    int cItem = (argc > 1) ? atoi(argv[1]) : 100000;
+    const int cPass = 50;
+
+    std::vector<Item> aItem(cItem);
+    std::vector<int> aiOrder(cItem);
+    for (int i = 0; i < cItem; i++)
+    {
+        aItem[i].value = i;
+        aItem[i].node = {};
+        aiOrder[i] = i;
+    }
+    std::mt19937 rng(1);
+    std::shuffle(aiOrder.begin(), aiOrder.end(), rng);
+
+    // Run both once untimed so neither pays for first touch
+
+    BenchMacro(aItem, aiOrder, 1);
+    BenchTemplate(aItem, aiOrder, 1);
+
+    Times timesMacro = BenchMacro(aItem, aiOrder, cPass);
+    Times timesTemplate = BenchTemplate(aItem, aiOrder, cPass);
+
+    double nsPerSec = 1e9 / ((double)cPass * cItem);
+    printf("%d shuffled items, ns/item\n", cItem);
+    printf("%-10s %10s %10s\n", "", "macro", "template");
+    printf("%-10s %10.2f %10.2f\n", "add tail", timesMacro.nsAdd * nsPerSec, timesTemplate.nsAdd * nsPerSec);
+    printf("%-10s %10.2f %10.2f\n", "traverse", timesMacro.nsTraverse * nsPerSec, timesTemplate.nsTraverse * nsPerSec);
+    printf("%-10s %10.2f %10.2f\n", "remove", timesMacro.nsRemove * nsPerSec, timesTemplate.nsRemove * nsPerSec);
+    return 0;
+}
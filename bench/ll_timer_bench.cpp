@@ -0,0 +1,163 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "../ll_timer.h"
+
+//
+// ll::TimerWheel against a sorted LL2 list (the simplest intrusive timer queue: insert in expiry order, expire from
+//  the head). cTimer timers are armed with random expiries up to a minute out (ms ticks) and then either all
+//  cancelled in random order, or all run to expiry by advancing 1 tick at a time. The sorted list's insert is O(n),
+//  so it is skipped above s_cTimerSortedMax.
+//
+// Usage: ll_timer_bench [cTimerMax]
+//
+
+struct Timer
+{
+    uint64_t expiry;
+
+    DefineLL2Node(Timer);
+    LL2Node node;
+};
+
+DefineLL2(Timer, node, Timers);
+
+typedef ll::TimerWheel<Timer, &Timer::node, &Timer::expiry> Wheel;
+typedef ll::List<Timer, &Timer::node> TimerList;
+
+static const int s_cTimerSortedMax = 16000;
+static const uint64_t s_tickSpan = 60000;
+
+static double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Result
+{
+    double nsArm;
+    double nsCancel;
+    double nsExpire;
+};
+
+static void ResetTimers(std::vector<Timer> & aTimer)
+{
+    for (Timer & timer : aTimer) timer.node = {};
+}
+
+static Result BenchWheel(std::vector<Timer> & aTimer, const std::vector<uint64_t> & aExpiry, const std::vector<int> & aiCancel)
+{
+    static Wheel s_wheel;
+    Result result = {};
+    double cTimer = (double)aTimer.size();
+    ResetTimers(aTimer);
+
+    s_wheel.Init(0);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < aTimer.size(); i++) s_wheel.Arm(&aTimer[i], aExpiry[i]);
+    result.nsArm = SecondsSince(start) * 1e9 / cTimer;
+
+    start = std::chrono::steady_clock::now();
+    for (int i : aiCancel) s_wheel.Cancel(&aTimer[i]);
+    result.nsCancel = SecondsSince(start) * 1e9 / cTimer;
+
+    for (size_t i = 0; i < aTimer.size(); i++) s_wheel.Arm(&aTimer[i], aExpiry[i]);
+
+    start = std::chrono::steady_clock::now();
+    TimerList expired;
+    for (uint64_t tick = 1; tick <= s_tickSpan; tick++)
+    {
+        s_wheel.Advance(tick, expired);
+        expired.ClearWithoutUnlinking();
+    }
+    result.nsExpire = SecondsSince(start) * 1e9 / cTimer;
+
+    s_wheel.Init(0);
+    return result;
+}
+
+static Result BenchSorted(std::vector<Timer> & aTimer, const std::vector<uint64_t> & aExpiry, const std::vector<int> & aiCancel)
+{
+    Result result = {};
+    double cTimer = (double)aTimer.size();
+    ResetTimers(aTimer);
+
+    // Insert walking back from the tail, which is the cheap direction when most new timers are the latest
+
+    LL2Type(Timers) list = {};
+    auto arm = [&list](Timer * pTimer, uint64_t expiry)
+    {
+        pTimer->expiry = expiry;
+        Timer * pTimerNext = nullptr;
+        for (Timer * pTimerPrev = list.pTail; pTimerPrev && pTimerPrev->expiry > expiry; pTimerPrev = LL2Prev(Timer, list, pTimerPrev))
+        {
+            pTimerNext = pTimerPrev;
+        }
+        LL2InsertBefore(Timer, list, pTimer, pTimerNext);
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < aTimer.size(); i++) arm(&aTimer[i], aExpiry[i]);
+    result.nsArm = SecondsSince(start) * 1e9 / cTimer;
+
+    start = std::chrono::steady_clock::now();
+    for (int i : aiCancel) LL2Remove(Timer, list, &aTimer[i]);
+    result.nsCancel = SecondsSince(start) * 1e9 / cTimer;
+
+    for (size_t i = 0; i < aTimer.size(); i++) arm(&aTimer[i], aExpiry[i]);
+
+    start = std::chrono::steady_clock::now();
+    for (uint64_t tick = 1; tick <= s_tickSpan; tick++)
+    {
+        while (list.pHead && list.pHead->expiry <= tick)
+        {
+            Timer * pTimer;
+            LL2RemoveHead(Timer, list, pTimer);
+            (void)pTimer;
+        }
+    }
+    result.nsExpire = SecondsSince(start) * 1e9 / cTimer;
+
+    return result;
+}
+
+int main(int argc, char ** argv)
+{
+    int cTimerMax = (argc > 1) ? atoi(argv[1]) : 1024000;
+
+    printf("ns/timer       %30s   %30s\n", "wheel", "sorted LL2");
+    printf("%-10s %10s %10s %10s   %10s %10s %10s\n", "timers", "arm", "cancel", "expire", "arm", "cancel", "expire");
+    for (int cTimer = 1000; cTimer <= cTimerMax; cTimer *= 4)
+    {
+        std::mt19937_64 rng(1);
+        std::vector<Timer> aTimer(cTimer);
+        std::vector<uint64_t> aExpiry(cTimer);
+        std::vector<int> aiCancel(cTimer);
+        for (int i = 0; i < cTimer; i++)
+        {
+            aExpiry[i] = 1 + rng() % s_tickSpan;
+            aiCancel[i] = i;
+        }
+        std::shuffle(aiCancel.begin(), aiCancel.end(), rng);
+
+        Result resultWheel = BenchWheel(aTimer, aExpiry, aiCancel);
+        printf("%-10d %10.1f %10.1f %10.1f", cTimer, resultWheel.nsArm, resultWheel.nsCancel, resultWheel.nsExpire);
+
+        if (cTimer <= s_cTimerSortedMax)
+        {
+            Result resultSorted = BenchSorted(aTimer, aExpiry, aiCancel);
+            printf("   %10.1f %10.1f %10.1f\n", resultSorted.nsArm, resultSorted.nsCancel, resultSorted.nsExpire);
+        }
+        else
+        {
+            printf("   %10s %10s %10s\n", "-", "-", "-");
+        }
+    }
+    return 0;
+}
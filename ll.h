@@ -1,699 +1,5028 @@
-#ifndef ALS_LL_H
-#define ALS_LL_H
-
-#ifdef ALS_ASSERT
-#define LL_ASSERT ALS_ASSERT
-#else
-#define LL_ASSERT()
-#endif
-
-//
-// Macros for creating and working with intrusive singly (LL1) and doubly (LL2) linked lists
-//
-// Requires:
-//  -offsetof macro
-//  -uintptr_t
-//
-// Options:
-//  -define ALS_ASSERT before including to get runtime asserts
-//
-
-
-// NOTE - Null indicates an empty list. For non-empty lists, the end is indicated by a
-//  sentinel value. This lets items trivially check if they are members of a list by
-//  checking for null. (The sentinel value is required to make this work if they are
-//  the only member of the list!)
-#define LLEndOfList_ 0x1
-
-
-//
-// Singly linked list
-//
-
-#define DefineLL1Node(type)                     \
-    struct LL1Node                              \
-    {                                           \
-        struct type * pNext;                    \
-    };                                          \
-    struct LL1Ref                               \
-    {                                           \
-        struct type ** ppHead;                  \
-        struct type ** ppTail;                  \
-        uintptr_t offset;                       \
-    };                                          \
-    
-#define LL1Type(userId) LL1_##userId
-        
-#define DefineLL1(type, linkMember, userId)                         \
-    struct LL1_##userId                                             \
-    {                                                               \
-        struct type * pHead;                                        \
-        struct type * pTail;                                        \
-        enum Offset { offset = offsetof(type, linkMember) };        \
-    };
-
-
-
-#define LL1MakeRef(listRefPtr, list)            \
-    do {                                        \
-        (listRefPtr)->ppHead = &list.pHead;     \
-        (listRefPtr)->ppTail = &list.pTail;     \
-        (listRefPtr)->offset = list.offset;     \
-    } while(0)
-
-
-
-#define LL1NodePtr_(type, pItem, listOffset)                    \
-    ((type::LL1Node *)((unsigned char * )pItem + listOffset))
-
-#define LL1NodePtr(type, list, pItem)           \
-    LL1NodePtr_(type, pItem, list.offset)
-
-#define LL1RefNodePtr(type, listRef, pItem)     \
-    LL1NodePtr_(type, pItem, listRef.offset)
-
-
-#define LL1IsItemLinked_(type, pItem, listOffset)               \
-    (LL1NodePtr_(type, pItem, listOffset)->pNext != nullptr)
-
-// NOTE - It's possible for an item to be linked, but not necessarily be a part of this list (i.e., there are multiple heads that all
-//  use the same nodes as links and items can only be on one list). Querying this would require O(n) search.
-#define LL1IsItemLinked(type, list, pItem)      \
-    LL1IsItemLinked_(type, pItem, list.offset)
-
-#define LL1RefIsItemLinked(type, listRef, pItem)    \
-    LL1IsItemLinked_(type, pItem, listRef.offset)
-
-
-    
-#define LL1IsNodeLinked(node)                   \
-    (node.pNext != nullptr)
-
-
-    
-#define LL1AddHead_(type, ppListHead, ppListTail, listOffset, pItem)    \
-    do {                                                                \
-        if (LL1IsItemLinked_(type, pItem, listOffset))                  \
-        {                                                               \
-            LL_ASSERT(false);                                           \
-            break;                                                      \
-        }                                                               \
-        auto * itemNode_ = LL1NodePtr_(type, pItem, listOffset);        \
-        if (*ppListHead)                                                \
-        {                                                               \
-            itemNode_->pNext = *ppListHead;                             \
-        }                                                               \
-        else                                                            \
-        {                                                               \
-            itemNode_->pNext = (type *)LLEndOfList_;                    \
-            *ppListTail = pItem;                                        \
-        }                                                               \
-        *ppListHead = pItem;                                            \
-    } while(0)
-
-#define LL1AddHead(type, list, pItem)                               \
-    LL1AddHead_(type, &list.pHead, &list.pTail, list.offset, pItem)
-
-#define LL1RefAddHead(type, listRef, pItem)                             \
-    LL1AddHead_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pItem)
-
-#define LL1Add(type, list, pItem)               \
-    LL1AddHead(type, list, pItem)
-
-#define LL1RefAdd(type, listRef, pItem)         \
-    LL1RefAddHead(type, listRef, pItem)
-
-
-
-#define LL1AddTail_(type, ppListHead, ppListTail, listOffset, pItem)    \
-    do {                                                                \
-        if (LL1IsItemLinked_(type, pItem, listOffset))                  \
-        {                                                               \
-            LL_ASSERT(false);                                           \
-            break;                                                      \
-        }                                                               \
-        auto * itemNode_ = LL1NodePtr_(type, pItem, listOffset);        \
-        if (*ppListTail)                                                \
-        {                                                               \
-            LL1NodePtr_(type, *ppListTail, listOffset)->pNext = pItem;  \
-        }                                                               \
-        else                                                            \
-        {                                                               \
-            *ppListHead = pItem;                                        \
-        }                                                               \
-        itemNode_->pNext = (type *)LLEndOfList_;                        \
-        *ppListTail = pItem;                                            \
-    } while(0)
-
-#define LL1AddTail(type, list, pItem)                               \
-    LL1AddTail_(type, &list.pHead, &list.pTail, list.offset, pItem)
-
-#define LL1RefAddTail(type, listRef, pItem)                             \
-    LL1AddTail_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pItem)
-
-
-
-#define LL1RemoveHead_(type, ppListHead, ppListTail, listOffset, pAssignTo) \
-    do {                                                                \
-        type * headToRemove_ = *ppListHead;                             \
-        pAssignTo = headToRemove_;                                      \
-        if (headToRemove_)                                              \
-        {                                                               \
-            auto * headToRemoveNode_ = LL1NodePtr_(type, headToRemove_, listOffset); \
-            if (headToRemoveNode_->pNext != (type *)LLEndOfList_)       \
-            {                                                           \
-                *ppListHead = headToRemoveNode_->pNext;                 \
-            }                                                           \
-            else                                                        \
-            {                                                           \
-                *ppListHead = nullptr;                                  \
-                *ppListTail = nullptr;                                  \
-            }                                                           \
-            headToRemoveNode_->pNext = nullptr;                         \
-        }                                                               \
-    } while (0)
-
-#define LL1RemoveHead(type, list, pAssignTo)                            \
-    LL1RemoveHead_(type, &list.pHead, &list.pTail, list.offset, pAssignTo)
-
-#define LL1RefRemoveHead(type, listRef, pAssignTo)                      \
-    LL1RemoveHead_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pAssignTo)
-
-
-
-
-#define LL1Next_(type, pItem, listOffset)                               \
-    ((LL1NodePtr_(type, pItem, listOffset)->pNext == (type *)LLEndOfList_) ? nullptr : LL1NodePtr_(type, pItem, listOffset)->pNext)
-
-#define LL1Next(type, list, pItem)              \
-    LL1Next_(type, pItem, list.offset)
-
-#define LL1RefNext(type, listRef, pItem)        \
-    LL1Next_(type, pItem, listRef.offset)
-
-
-
-#define LL1Prev_(type, pItem, listOffset)                               \
-    ((LL1NodePtr_(type, pItem, listOffset)->pPrev == (type *)LLEndOfList_) ? nullptr : LL1NodePtr_(type, pItem, listOffset)->pPrev)
-
-#define LL1Prev(type, list, pItem)              \
-    LL1Prev_(type, pItem, list.offset)
-
-#define LL1RefPrev(type, listRef, pItem)        \
-    LL1Prev_(type, pItem, listRef.offset)
-
-    
-
-#define LL1Clear_(type, ppListHead, ppListTail, listOffset)             \
-    do {                                                                \
-        while (*ppListHead)                                             \
-        {                                                               \
-            auto * pHeadNode_ = LL1NodePtr_(type, *ppListHead, listOffset); \
-            auto * pHeadNext_ = LL1Next_(type, *ppListHead, listOffset); \
-            pHeadNode_->pNext = nullptr;                                \
-            *ppListHead = pHeadNext_;                                   \
-        }                                                               \
-        *ppListTail = nullptr;                                          \
-    } while(0)
-
-#define LL1Clear(type, list)                                \
-    LL1Clear_(type, &list.pHead, &list.pTail, list.offset)
-
-#define LL1RefClear(type, listRef)                                  \
-    LL1Clear_(type, listRef.ppHead, listRef.ppTail, listRef.offset)
-
-
-
-#define LL1ClearWithoutUnlinking_(type, ppListHead, ppListTail) \
-    do { *ppListHead = nullptr; *ppListTail = nullptr; } while (0)
-
-#define LL1ClearWithoutUnlinking(type, list)                    \
-    LL1ClearWithoutUnlinking_(type, &list.pHead, &list.pTail)
-
-#define LL1RefClearWithoutUnlinking(type, listRef)                  \
-    LL1ClearWithoutUnlinking_(type, listRef.ppHead, listRef.ppTail)
-
-    
-
-#define LL1IsEmpty_(ppListHead)                 \
-    (!(*ppListHead))
-
-#define LL1IsEmpty(list)                        \
-    LL1IsEmpty_(&list.pHead)
-
-#define LL1RefIsEmpty(listRef)                  \
-    LL1IsEmpty_(listRef.ppHead)
-
-        
-
-#define ForLL1_(type, it, ppListHead, listOffset)                       \
-    for (type * it = *ppListHead; it; it = LL1Next_(type, it, listOffset))
-    
-#define ForLL1(type, it, list)                  \
-    ForLL1_(type, it, &list.pHead, list.offset)
-
-#define ForLL1Ref(type, it, listRef)                    \
-    ForLL1_(type, it, listRef.ppHead, listRef.offset)
-
-
-
-    
-//
-// Doubly linked list
-//
-
-#define DefineLL2Node(type)                     \
-    struct LL2Node                              \
-    {                                           \
-        struct type * pPrev;                    \
-        struct type * pNext;                    \
-    };                                          \
-    struct LL2Ref                               \
-    {                                           \
-        struct type ** ppHead;                  \
-        struct type ** ppTail;                  \
-        uintptr_t offset;                       \
-    };                                          \
-    struct LL2CombineParam                      \
-    {                                           \
-        struct type ** ppHead0;                 \
-        struct type ** ppTail0;                 \
-        struct type ** ppHead1;                 \
-        struct type ** ppTail1;                 \
-        uintptr_t offset;                       \
-    }
-    
-#define LL2Type(userId) LL2_##userId
-        
-#define DefineLL2(type, linkMember, userId)                             \
-        struct LL2_##userId                                             \
-        {                                                               \
-            struct type * pHead;                                        \
-            struct type * pTail;                                        \
-            static const uintptr_t offset = offsetof(type, linkMember); \
-        };                                                              \
-
-#define LL2MakeRef(listRefPtr, list)            \
-    do {                                        \
-        (listRefPtr)->ppHead = &list.pHead;     \
-        (listRefPtr)->ppTail = &list.pTail;     \
-        (listRefPtr)->offset = list.offset;     \
-    } while(0)
-
-
-
-#define LL2NodePtr_(type, pItem, listOffset)                    \
-    ((type::LL2Node *)((unsigned char * )pItem + listOffset))
-
-#define LL2NodePtr(type, list, pItem)           \
-    LL2NodePtr_(type, pItem, list.offset)
-
-#define LL2RefNodePtr(type, listRef, pItem)     \
-    LL2NodePtr_(type, pItem, listRef.offset)
-
-
-#define LL2IsItemLinked_(type, pItem, listOffset)               \
-    (LL2NodePtr_(type, pItem, listOffset)->pPrev != nullptr)
-
-// NOTE - It's possible for an item to be linked, but not necessarily be a part of this list (i.e., there are multiple heads that all
-//  use the same nodes as links and items can only be on one list). Querying this would require O(n) search.
-#define LL2IsItemLinked(type, list, pItem)      \
-    LL2IsItemLinked_(type, pItem, list.offset)
-
-#define LL2RefIsItemLinked(type, listRef, pItem)    \
-    LL2IsItemLinked_(type, pItem, listRef.offset)
-
-
-    
-#define LL2IsNodeLinked(node)                   \
-    (node.pPrev != nullptr)
-
-
-#define LL2AddHead_(type, ppListHead, ppListTail, listOffset, pItem)    \
-    do {                                                                \
-        if (LL2IsItemLinked_(type, pItem, listOffset))                  \
-        {                                                               \
-            LL_ASSERT(false);                                           \
-            break;                                                      \
-        }                                                               \
-        auto * itemNode_ = LL2NodePtr_(type, pItem, listOffset);        \
-        if (*ppListHead)                                                \
-        {                                                               \
-            LL2NodePtr_(type, *ppListHead, listOffset)->pPrev = pItem;  \
-            itemNode_->pNext = *ppListHead;                             \
-        }                                                               \
-        else                                                            \
-        {                                                               \
-            itemNode_->pNext = (type *)LLEndOfList_;                    \
-            *ppListTail = pItem;                                        \
-        }                                                               \
-        itemNode_->pPrev = (type *)LLEndOfList_;                        \
-        *ppListHead = pItem;                                            \
-    } while(0)
-
-#define LL2AddHead(type, list, pItem)                               \
-    LL2AddHead_(type, &list.pHead, &list.pTail, list.offset, pItem)
-
-#define LL2RefAddHead(type, listRef, pItem)                             \
-    LL2AddHead_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pItem)
-
-#define LL2Add(type, list, pItem)               \
-    LL2AddHead(type, list, pItem)
-
-#define LL2RefAdd(type, listRef, pItem)         \
-    LL2RefAddHead(type, listRef, pItem)
-
-
-
-// TODO - LL2IsItemLinked check will break if linked to a separate list that uses the same node?
-//  What is the desired behavior in this case?
-#define LL2AddTail_(type, ppListHead, ppListTail, listOffset, pItem)    \
-    do {                                                                \
-        if (LL2IsItemLinked_(type, pItem, listOffset))                  \
-        {                                                               \
-            LL_ASSERT(false);                                           \
-            break;                                                      \
-        }                                                               \
-        auto * itemNode_ = LL2NodePtr_(type, pItem, listOffset);        \
-        if (*ppListTail)                                                \
-        {                                                               \
-            LL2NodePtr_(type, *ppListTail, listOffset)->pNext = pItem;  \
-            itemNode_->pPrev = *ppListTail;                             \
-        }                                                               \
-        else                                                            \
-        {                                                               \
-            itemNode_->pPrev = (type *)LLEndOfList_;                    \
-            *ppListHead = pItem;                                        \
-        }                                                               \
-        itemNode_->pNext = (type *)LLEndOfList_;                        \
-        *ppListTail = pItem;                                            \
-    } while(0)
-
-#define LL2AddTail(type, list, pItem)                               \
-    LL2AddTail_(type, &list.pHead, &list.pTail, list.offset, pItem)
-
-#define LL2RefAddTail(type, listRef, pItem)                             \
-    LL2AddTail_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pItem)
-
-    
-
-#define LL2Remove_(type, ppListHead, ppListTail, listOffset, pItem)     \
-    do {                                                                \
-        auto * node_ = LL2NodePtr_(type, pItem, listOffset);            \
-        if (!LL2IsItemLinked_(type, pItem, listOffset)) break;          \
-        type * pPrev_ = node_->pPrev;                                   \
-        type * pNext_ = node_->pNext;                                   \
-        bool hasNext_ = pNext_ != (type *)LLEndOfList_;                 \
-        bool hasPrev_ = pPrev_ != (type *)LLEndOfList_;                 \
-        if (hasNext_ && hasPrev_)                                       \
-        {                                                               \
-            LL2NodePtr_(type, pNext_, listOffset)->pPrev = pPrev_;      \
-            LL2NodePtr_(type, pPrev_, listOffset)->pNext = pNext_;      \
-        }                                                               \
-        else if (hasNext_ && !hasPrev_)                                 \
-        {                                                               \
-            LL2NodePtr_(type, pNext_, listOffset)->pPrev = (type *)LLEndOfList_; \
-            *ppListHead = pNext_;                                       \
-        }                                                               \
-        else if (!hasNext_ && hasPrev_)                                 \
-        {                                                               \
-            LL2NodePtr_(type, pPrev_, listOffset)->pNext = (type *)LLEndOfList_; \
-            *ppListTail = pPrev_;                                       \
-        }                                                               \
-        else                                                            \
-        {                                                               \
-            *ppListHead = nullptr;                                      \
-            *ppListTail = nullptr;                                      \
-        }                                                               \
-        node_->pPrev = nullptr;                                         \
-        node_->pNext = nullptr;                                         \
-    } while(0)
-
-#define LL2Remove(type, list, pItem)                                \
-    LL2Remove_(type, &list.pHead, &list.pTail, list.offset, pItem)
-
-#define LL2RefRemove(type, listRef, pItem)                              \
-    LL2Remove_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pItem)
-
-
-
-#define LL2InsertBefore_(type, ppListHead, ppListTail, listOffset, pItem, pItemNext) \
-    do {                                                                \
-        if (!pItemNext) LL2AddTail_(type, ppListHead, ppListTail, listOffset, pItem); \
-        else if (pItemNext == *ppListHead) LL2AddHead_(type, ppListHead, ppListTail, listOffset, pItem); \
-        else {                                                          \
-            if (LL2IsItemLinked_(type, pItem, listOffset))              \
-            {                                                           \
-                LL_ASSERT(false);                                       \
-                break;                                                  \
-            }                                                           \
-            auto * node = LL2NodePtr_(type, pItem, listOffset);         \
-            auto * nextNode = LL2NodePtr_(type, pItemNext, listOffset); \
-            auto * pItemPrev = LL2Prev_(type, pItemNext, listOffset);   \
-            auto * prevNode = LL2NodePtr_(type, pItemPrev, listOffset); \
-            prevNode->pNext = pItem;                                    \
-            nextNode->pPrev = pItem;                                    \
-            node->pNext = pItemNext;                                    \
-            node->pPrev = pItemPrev;                                    \
-        }                                                               \
-    } while(0)
-
-#define LL2InsertBefore(type, list, pItem, pItemNext)                   \
-    LL2InsertBefore_(type, &list.pHead, &list.pTail, list.offset, pItem, pItemNext)
-
-#define LL2RefInsertBefore(type, listRef, pItem, pItemNext)             \
-    LL2InsertBefore_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pItem, pItemNext)
-
-      
-
-#define LL2RemoveHead_(type, ppListHead, ppListTail, listOffset, pAssignTo) \
-    do {                                                                \
-        type * headToRemove_ = *ppListHead;                             \
-        pAssignTo = headToRemove_;                                      \
-        if (headToRemove_)                                              \
-        {                                                               \
-            auto * headToRemoveNode_ = LL2NodePtr_(type, headToRemove_, listOffset); \
-            if (headToRemoveNode_->pNext != (type *)LLEndOfList_)       \
-            {                                                           \
-                *ppListHead = headToRemoveNode_->pNext;                 \
-                auto * newHeadNode_ = LL2NodePtr_(type, *ppListHead, listOffset); \
-                newHeadNode_->pPrev = (type *)LLEndOfList_;              \
-            }                                                           \
-            else                                                        \
-            {                                                           \
-                *ppListHead = nullptr;                                  \
-                *ppListTail = nullptr;                                  \
-            }                                                           \
-            headToRemoveNode_->pNext = nullptr;                         \
-            headToRemoveNode_->pPrev = nullptr;                         \
-        }                                                               \
-    } while (0)
-
-#define LL2RemoveHead(type, list, pAssignTo)                            \
-    LL2RemoveHead_(type, &list.pHead, &list.pTail, list.offset, pAssignTo)
-
-#define LL2RefRemoveHead(type, listRef, pAssignTo)                      \
-    LL2RemoveHead_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pAssignTo)
-
-
-
-#define LL2RemoveTail_(type, ppListHead, ppListTail, listOffset, pAssignTo) \
-    do {                                                                \
-        type * tailToRemove_ = *ppListTail;                             \
-        pAssignTo = tailToRemove_;                                      \
-        if (tailToRemove_)                                              \
-        {                                                               \
-            auto * tailToRemoveNode_ = LL2NodePtr_(type, tailToRemove_, listOffset); \
-            if (tailToRemoveNode_->pPrev != (type *)LLEndOfList_)       \
-            {                                                           \
-                *ppListTail = tailToRemoveNode_->pPrev;                 \
-                auto * newTailNode_ = LL2NodePtr_(type, *ppListTail, listOffset); \
-                newTailNode_->pNext = (type *)LLEndOfList_;              \
-            }                                                           \
-            else                                                        \
-            {                                                           \
-                *ppListHead = nullptr;                                  \
-                *ppListTail = nullptr;                                  \
-            }                                                           \
-            tailToRemoveNode_->pNext = nullptr;                         \
-            tailToRemoveNode_->pPrev = nullptr;                         \
-        }                                                               \
-    } while (0)
-
-#define LL2RemoveTail(type, list, pAssignTo)                            \
-    LL2RemoveTail_(type, &list.pHead, &list.pTail, list.offset, pAssignTo)
-
-#define LL2RefRemoveTail(type, listRef, pAssignTo)                      \
-    LL2RemoveTail_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pAssignTo)
-
-
-
-#define LL2Next_(type, pItem, listOffset)                               \
-    ((LL2NodePtr_(type, pItem, listOffset)->pNext == (type *)LLEndOfList_) ? nullptr : LL2NodePtr_(type, pItem, listOffset)->pNext)
-
-#define LL2Next(type, list, pItem)              \
-    LL2Next_(type, pItem, list.offset)
-
-#define LL2RefNext(type, listRef, pItem)        \
-    LL2Next_(type, pItem, listRef.offset)
-
-
-
-#define LL2Prev_(type, pItem, listOffset)                               \
-    ((LL2NodePtr_(type, pItem, listOffset)->pPrev == (type *)LLEndOfList_) ? nullptr : LL2NodePtr_(type, pItem, listOffset)->pPrev)
-
-#define LL2Prev(type, list, pItem)              \
-    LL2Prev_(type, pItem, list.offset)
-
-#define LL2RefPrev(type, listRef, pItem)        \
-    LL2Prev_(type, pItem, listRef.offset)
-
-
-    
-
-#define LL2Clear_(type, ppListHead, ppListTail, listOffset)             \
-    do {                                                                \
-        while (*ppListHead)                                             \
-        {                                                               \
-            auto * pHeadNode_ = LL2NodePtr_(type, *ppListHead, listOffset); \
-            auto * pHeadNext_ = LL2Next_(type, *ppListHead, listOffset); \
-            pHeadNode_->pNext = nullptr;                                \
-            pHeadNode_->pPrev = nullptr;                                \
-            *ppListHead = pHeadNext_;                                   \
-        }                                                               \
-        *ppListTail = nullptr;                                          \
-    } while(0)
-
-#define LL2Clear(type, list)                                \
-    LL2Clear_(type, &list.pHead, &list.pTail, list.offset)
-
-#define LL2RefClear(type, listRef)                                  \
-    LL2Clear_(type, listRef.ppHead, listRef.ppTail, listRef.offset)
-
-
-
-#define LL2ClearWithoutUnlinking_(type, ppListHead, ppListTail)     \
-    do { *ppListHead = nullptr; *ppListTail = nullptr; } while (0)
-
-#define LL2ClearWithoutUnlinking(type, list)                    \
-    LL2ClearWithoutUnlinking_(type, &list.pHead, &list.pTail)
-
-#define LL2RefClearWithoutUnlinking(type, listRef)                  \
-    LL2ClearWithoutUnlinking_(type, listRef.ppHead, listRef.ppTail)
-
-
-
-#define LL2IsEmpty_(ppListHead)                 \
-    (!(*ppListHead))
-
-#define LL2IsEmpty(list)                        \
-    LL2IsEmpty_(&list.pHead)
-
-#define LL2RefIsEmpty(listRef)                  \
-    LL2IsEmpty_(listRef.ppHead)
-
-    
-
-// NOTE - List 1 is cleared
-#define LL2Combine_(type, ppList0Head, ppList0Tail, ppList1Head, ppList1Tail, listOffset) \
-    do {                                                                \
-        if (LL2IsEmpty_(ppList0Head))                                   \
-        {                                                               \
-            *ppList0Head = *ppList1Head;                                \
-            *ppList0Tail = *ppList1Tail;                                \
-        }                                                               \
-        else if (!LL2IsEmpty_(ppList1Head))                             \
-        {                                                               \
-            auto * pNodeTail0_ = LL2NodePtr_(type, *ppList0Tail, listOffset); \
-            auto * pNodeHead1_ = LL2NodePtr_(type, *ppList1Head, listOffset); \
-            pNodeTail0_->pNext = *ppList1Head;                          \
-            pNodeHead1_->pPrev = *ppList0Tail;                          \
-            *ppList0Tail = *ppList1Tail;                                \
-        }                                                               \
-        *ppList1Head = nullptr;                                         \
-        *ppList1Tail = nullptr;                                         \
-    } while(0)
-
-#define LL2Combine(type, combineParam)                                  \
-    LL2Combine_(type, combineParam.ppHead0, combineParam.ppTail0, combineParam.ppHead1, combineParam.ppTail1, combineParam.offset)
-
-        
-
-#define ForLL2_(type, it, ppListHead, listOffset)                       \
-    for (type * it = *ppListHead; it; it = LL2Next_(type, it, listOffset))
-    
-#define ForLL2(type, it, list)                  \
-    ForLL2_(type, it, &list.pHead, list.offset)
-
-#define ForLL2Ref(type, it, listRef)                    \
-    ForLL2_(type, it, listRef.ppHead, listRef.offset)
-
-
-
-// NOTE - Do not try to use 'it' after calling this! Just let the loop run to the next iteration, at which
-//  point 'it' will work as you'd expect.
-#define LL2RemoveWhileIterating_(type, ppListHead, ppListTail, listOffset, it) \
-    do {                                                                \
-        if (it == *ppListHead)                                          \
-        {                                                               \
-            type * removedHead;                                         \
-            LL2RemoveHead_(type, ppListHead, ppListTail, listOffset, removedHead); \
-            /* @Hack - Make 'it' point to a fake location where we know the LL2Next_ call in ForLL2_ will get the right pointer value to the head! */ \
-            it = (type *)((unsigned char *)ppListHead - (listOffset + offsetof(type::LL2Node, pNext))); \
-        }                                                               \
-        else                                                            \
-        {                                                               \
-            type * itPrev = LL2Prev_(type, it, listOffset);             \
-            LL2Remove_(type, ppListHead, ppListTail, listOffset, it);   \
-            it = itPrev;                                                \
-        }                                                               \
-    } while (0)
-
-#define LL2RemoveWhileIterating(type, list, it)  \
-          LL2RemoveWhileIterating_(type, &list.pHead, &list.pTail, list.offset, it)
-
-#define LL2RefRemoveWhileIterating(type, listRef, it)                      \
-          LL2RemoveWhileIterating_(type, listRef.ppHead, listRef.ppTail, listRef.offset, it)
-
-
-// NOTE - This assumes that the newAddress has its intrusive pointers already set properly
-#define LL2Relocate_(type, ppListHead, ppListTail, listOffset, prevAddress, newAddress) \
-    do {                                                                \
-        if (*ppListHead == prevAddress)                                 \
-        {                                                               \
-            *ppListHead = newAddress;                                   \
-        }                                                               \
-        if (*ppListTail == prevAddress)                                 \
-        {                                                               \
-            *ppListTail = newAddress;                                   \
-        }                                                               \
-        type * prev_ = LL2Prev_(type, newAddress, listOffset);          \
-        if (prev_)                                                      \
-        {                                                               \
-            LL_ASSERT(LL2Next_(type, prev_, listOffset) == prevAddress); \
-            auto * prevNode_ = LL2NodePtr_(type, prev_, listOffset);    \
-            prevNode_->pNext = newAddress;                              \
-        }                                                               \
-        type * next_ = LL2Next_(type, newAddress, listOffset);          \
-        if (next_)                                                      \
-        {                                                               \
-            LL_ASSERT(LL2Prev_(type, next_, listOffset) == prevAddress); \
-            auto * nextNode_ = LL2NodePtr_(type, next_, listOffset);    \
-            nextNode_->pPrev = newAddress;                              \
-        }                                                               \
-    } while (0)
-
-#define LL2Relocate(type, list, prevAddress, newAddress) \
-    LL2Relocate_(type, &list.pHead, &list.pTail, list.offset, prevAddress, newAddress)
-
-#define LL2RefRelocate(type, listRef, prevAddress, newAddress)          \
-    LL2Relocate_(type, listRef.ppHead, listRef.ppTail, listRef.offset, prevAddress, newAddress)
-
-
-
-
-//
-// Author: Andrew Smith - alsmith.net
-// License: MIT
-//
-#endif
+#ifndef ALS_LL_H
+#define ALS_LL_H
+
+#include <stdint.h>
+
+#ifdef ALS_ASSERT
+#define LL_ASSERT ALS_ASSERT
+#else
+#define LL_ASSERT(expr)
+#endif
+
+#ifndef LL_PREFETCH
+#if defined(__GNUC__) || defined(__clang__)
+#define LL_PREFETCH(addr) __builtin_prefetch((const void *)(addr))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define LL_PREFETCH(addr) _mm_prefetch((const char *)(addr), _MM_HINT_T0)
+#else
+#define LL_PREFETCH(addr) ((void)(addr))
+#endif
+#endif
+
+#ifndef LL_VISIT_BATCH
+#define LL_VISIT_BATCH 16
+#endif
+
+// NOTE - Hides where a pointer came from, so the optimizer has to take it at face value. LL2RemoveWhileIterating_'s
+//  @Hack points 'it' at a fake item whose node starts just before the list's head pointer, and with a local list GCC
+//  proves that out of bounds and turns the loop into a trap.
+#if defined(__GNUC__) || defined(__clang__)
+#define LLOpaquePtr_(p) __asm__("" : "+r"(p) : : "memory")
+#else
+#define LLOpaquePtr_(p) ((void)(p))
+#endif
+
+//
+// Macros for creating and working with intrusive singly (LL1) and doubly (LL2) linked lists
+//
+// Requires:
+//  -offsetof macro
+//  -stdint.h (included here, since the side-table list structs use uint32_t outside of any macro)
+//
+// Options:
+//  -define ALS_ASSERT before including to get runtime asserts
+//  -define LL_PREFETCH(addr) before including to supply your own software prefetch (used by the Prefetch/VisitBatched macros)
+//  -define LL_VISIT_BATCH before including to change how many items the VisitBatched macros chase ahead (default 16)
+//  -define LL_INSTRUMENT before including to collect per-list op counts, ForLL1/ForLL2 walk length histograms and
+//   LL2Remove_ branch counts, see LLInstrumentSnapshot (requires std::atomic and std::mutex)
+//  -define LL_VALIDATE before including to run the structural validator (LL1Validate_/LL2Validate_) after every
+//   LL1/LL2 mutation. O(n) per op, for debug builds only. Failures go through LL_ASSERT, so ALS_ASSERT must be
+//   defined too.
+//
+
+
+// NOTE - Null indicates an empty list. For non-empty lists, the end is indicated by a
+//  sentinel value. This lets items trivially check if they are members of a list by
+//  checking for null. (The sentinel value is required to make this work if they are
+//  the only member of the list!)
+#define LLEndOfList_ 0x1
+
+
+// NOTE - Helpers that only touch the pNext chain, shared by LL1 and LL2. nextOffset is the byte offset of
+//  pNext within the item (list offset + offset of pNext within the node). Chains here are nullptr terminated.
+#define LLNextField_(type, pItem, nextOffset)                   \
+    (*(type **)((unsigned char *)(pItem) + (nextOffset)))
+
+// NOTE - Stable: on ties, items from chain A come first
+#define LLMergeChains_(type, nextOffset, pChainA, pChainB, lessFn, pAssignTo) \
+    do {                                                                \
+        type * pMergeA_ = pChainA;                                      \
+        type * pMergeB_ = pChainB;                                      \
+        type * pMerged_ = nullptr;                                      \
+        type ** ppMergedEnd_ = &pMerged_;                               \
+        while (pMergeA_ && pMergeB_)                                    \
+        {                                                               \
+            if (lessFn(pMergeB_, pMergeA_))                             \
+            {                                                           \
+                *ppMergedEnd_ = pMergeB_;                               \
+                ppMergedEnd_ = &LLNextField_(type, pMergeB_, nextOffset); \
+                pMergeB_ = *ppMergedEnd_;                               \
+            }                                                           \
+            else                                                        \
+            {                                                           \
+                *ppMergedEnd_ = pMergeA_;                               \
+                ppMergedEnd_ = &LLNextField_(type, pMergeA_, nextOffset); \
+                pMergeA_ = *ppMergedEnd_;                               \
+            }                                                           \
+        }                                                               \
+        *ppMergedEnd_ = pMergeA_ ? pMergeA_ : pMergeB_;                 \
+        pAssignTo = pMerged_;                                           \
+    } while(0)
+
+// NOTE - Bottom-up merge sort. aBin_[i] holds a sorted run of 2^i items, so there is no recursion and no
+//  allocation. Stable.
+#define LLSortChain_(type, nextOffset, pChain, lessFn, pAssignTo)       \
+    do {                                                                \
+        type * aBin_[64] = {};                                          \
+        type * pSortCur_ = pChain;                                      \
+        while (pSortCur_)                                               \
+        {                                                               \
+            type * pRun_ = pSortCur_;                                   \
+            pSortCur_ = LLNextField_(type, pSortCur_, nextOffset);      \
+            LLNextField_(type, pRun_, nextOffset) = nullptr;            \
+            int iBin_ = 0;                                              \
+            for (; aBin_[iBin_]; iBin_++)                               \
+            {                                                           \
+                LLMergeChains_(type, nextOffset, aBin_[iBin_], pRun_, lessFn, pRun_); \
+                aBin_[iBin_] = nullptr;                                 \
+            }                                                           \
+            aBin_[iBin_] = pRun_;                                       \
+        }                                                               \
+        type * pSorted_ = nullptr;                                      \
+        for (int iBin_ = 0; iBin_ < 64; iBin_++)                        \
+        {                                                               \
+            if (aBin_[iBin_]) LLMergeChains_(type, nextOffset, aBin_[iBin_], pSorted_, lessFn, pSorted_); \
+        }                                                               \
+        pAssignTo = pSorted_;                                           \
+    } while(0)
+
+
+
+//
+// Instrumentation
+//
+
+// NOTE - Everything here compiles away unless LL_INSTRUMENT / LL_VALIDATE is defined. Stats are kept per list type,
+//  keyed by the item type's name and the link member's offset (i.e. one entry per DefineLL1/DefineLL2 userId, shared
+//  by every list made from it). Counters are relaxed atomics, so lists can be used from any thread. Only the macros
+//  are instrumented, the ll:: template layer is not.
+#ifdef LL_INSTRUMENT
+
+#include <atomic>
+#include <mutex>
+#include <string.h>
+
+#ifndef LL_INSTRUMENT_LIST_MAX
+#define LL_INSTRUMENT_LIST_MAX 256
+#endif
+
+enum LLInstrumentOp
+{
+    LLInstrumentOp_AddHead,
+    LLInstrumentOp_AddTail,
+    LLInstrumentOp_Insert,          // LL1InsertAfter_/LL2InsertBefore_ in the middle (head/tail count as AddHead/AddTail)
+    LLInstrumentOp_Remove,
+    LLInstrumentOp_RemoveHead,
+    LLInstrumentOp_RemoveTail,
+    LLInstrumentOp_MoveToHead,
+    LLInstrumentOp_Splice,          // LL2SpliceRange_, LL2SplitAt_, LL2Rotate_
+    LLInstrumentOp_Clear,           // Including ClearWithoutUnlinking
+    LLInstrumentOp_Combine,
+    LLInstrumentOp_Sort,
+    LLInstrumentOp_Merge,           // LL1MergeSorted_/LL2MergeSorted_
+    LLInstrumentOp_Filter,          // LL1RemoveIf_, LL2RemoveIf_/Partition_/Unique_/UniqueInto_
+    LLInstrumentOp_Relocate,
+    LLInstrumentOp_Walk,            // ForLL1_/ForLL2_ loops
+
+    LLInstrumentOp_Max
+};
+
+enum LLInstrumentRemove
+{
+    LLInstrumentRemove_NotLinked,
+    LLInstrumentRemove_Middle,
+    LLInstrumentRemove_Head,
+    LLInstrumentRemove_Tail,
+    LLInstrumentRemove_Only,
+
+    LLInstrumentRemove_Max
+};
+
+// NOTE - aWalk[0] counts walks that visited nothing, aWalk[i] walks that visited [2^(i-1), 2^i) items
+#define LLInstrumentWalkBucketMax 65
+
+struct LLInstrumentStats
+{
+    const char * typeName;
+    uintptr_t offset;
+    uint64_t aOp[LLInstrumentOp_Max];
+    uint64_t aRemove[LLInstrumentRemove_Max];
+    uint64_t aWalk[LLInstrumentWalkBucketMax];
+    uint64_t cWalkItem;
+    uint64_t cWalkItemMax;
+};
+
+struct LLInstrumentList_
+{
+    const char * typeName;
+    uintptr_t offset;
+    std::atomic<uint64_t> aOp[LLInstrumentOp_Max];
+    std::atomic<uint64_t> aRemove[LLInstrumentRemove_Max];
+    std::atomic<uint64_t> aWalk[LLInstrumentWalkBucketMax];
+    std::atomic<uint64_t> cWalkItem;
+    std::atomic<uint64_t> cWalkItemMax;
+};
+
+struct LLInstrumentRegistry_
+{
+    std::mutex mutex;
+    std::atomic<int> cList;
+    LLInstrumentList_ aList[LL_INSTRUMENT_LIST_MAX];
+};
+
+inline LLInstrumentRegistry_ & LLInstrumentGetRegistry_()
+{
+    static LLInstrumentRegistry_ s_registry;
+    return s_registry;
+}
+
+// NOTE - Only called the first time a call site sees a given list type (the result is cached per site and thread).
+//  Once the table is full, every new list type shares the last entry.
+inline LLInstrumentList_ * LLInstrumentFind_(const char * typeName, uintptr_t offset)
+{
+    LLInstrumentRegistry_ & registry = LLInstrumentGetRegistry_();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    int cList = registry.cList.load(std::memory_order_relaxed);
+    for (int iList = 0; iList < cList; iList++)
+    {
+        LLInstrumentList_ * pList = &registry.aList[iList];
+        if (pList->offset == offset && strcmp(pList->typeName, typeName) == 0) return pList;
+    }
+
+    if (cList == LL_INSTRUMENT_LIST_MAX)
+    {
+        return &registry.aList[LL_INSTRUMENT_LIST_MAX - 1];
+    }
+
+    LLInstrumentList_ * pList = &registry.aList[cList];
+    pList->typeName = (cList == LL_INSTRUMENT_LIST_MAX - 1) ? "(overflow)" : typeName;
+    pList->offset = offset;
+    registry.cList.store(cList + 1, std::memory_order_release);
+    return pList;
+}
+
+// NOTE - Copies up to cStatsMax entries into aStats. Returns the number of list types with stats, which can be more
+//  than cStatsMax. Safe to call while other threads keep using their lists (each counter is read atomically, but
+//  the snapshot as a whole isn't).
+inline int LLInstrumentSnapshot(LLInstrumentStats * aStats, int cStatsMax)
+{
+    LLInstrumentRegistry_ & registry = LLInstrumentGetRegistry_();
+    int cList = registry.cList.load(std::memory_order_acquire);
+    for (int iList = 0; iList < cList && iList < cStatsMax; iList++)
+    {
+        LLInstrumentList_ & list = registry.aList[iList];
+        LLInstrumentStats & stats = aStats[iList];
+        stats.typeName = list.typeName;
+        stats.offset = list.offset;
+        for (int i = 0; i < LLInstrumentOp_Max; i++) stats.aOp[i] = list.aOp[i].load(std::memory_order_relaxed);
+        for (int i = 0; i < LLInstrumentRemove_Max; i++) stats.aRemove[i] = list.aRemove[i].load(std::memory_order_relaxed);
+        for (int i = 0; i < LLInstrumentWalkBucketMax; i++) stats.aWalk[i] = list.aWalk[i].load(std::memory_order_relaxed);
+        stats.cWalkItem = list.cWalkItem.load(std::memory_order_relaxed);
+        stats.cWalkItemMax = list.cWalkItemMax.load(std::memory_order_relaxed);
+    }
+    return cList;
+}
+
+// NOTE - Zeroes every counter, but keeps the registered list types
+inline void LLInstrumentReset()
+{
+    LLInstrumentRegistry_ & registry = LLInstrumentGetRegistry_();
+    int cList = registry.cList.load(std::memory_order_acquire);
+    for (int iList = 0; iList < cList; iList++)
+    {
+        LLInstrumentList_ & list = registry.aList[iList];
+        for (int i = 0; i < LLInstrumentOp_Max; i++) list.aOp[i].store(0, std::memory_order_relaxed);
+        for (int i = 0; i < LLInstrumentRemove_Max; i++) list.aRemove[i].store(0, std::memory_order_relaxed);
+        for (int i = 0; i < LLInstrumentWalkBucketMax; i++) list.aWalk[i].store(0, std::memory_order_relaxed);
+        list.cWalkItem.store(0, std::memory_order_relaxed);
+        list.cWalkItemMax.store(0, std::memory_order_relaxed);
+    }
+}
+
+// NOTE - Lives for the duration of one ForLL1_/ForLL2_ loop and records its length when the loop exits (including
+//  through break or return)
+struct LLInstrumentWalk_
+{
+    LLInstrumentList_ * pList;
+    uint64_t cItem;
+    bool isFirst;
+
+    explicit LLInstrumentWalk_(LLInstrumentList_ * pList) : pList(pList), cItem(0), isFirst(true) {}
+
+    bool Visit() { cItem++; return true; }
+
+    ~LLInstrumentWalk_()
+    {
+        int iBucket = 0;
+        for (uint64_t c = cItem; c; c >>= 1) iBucket++;
+
+        pList->aOp[LLInstrumentOp_Walk].fetch_add(1, std::memory_order_relaxed);
+        pList->aWalk[iBucket].fetch_add(1, std::memory_order_relaxed);
+        pList->cWalkItem.fetch_add(cItem, std::memory_order_relaxed);
+
+        uint64_t cMax = pList->cWalkItemMax.load(std::memory_order_relaxed);
+        while (cItem > cMax && !pList->cWalkItemMax.compare_exchange_weak(cMax, cItem, std::memory_order_relaxed)) {}
+    }
+};
+
+// NOTE - Each expansion is its own lambda, so each call site gets its own cached entry
+#define LLInstrumentListOf_(type, listOffset)                           \
+    ([&]() -> LLInstrumentList_ * {                                     \
+        static thread_local LLInstrumentList_ * s_pList = nullptr;      \
+        uintptr_t offset_ = (uintptr_t)(listOffset);                    \
+        if (!s_pList || s_pList->offset != offset_) s_pList = LLInstrumentFind_(#type, offset_); \
+        return s_pList;                                                 \
+    }())
+
+#define LLInstrumentCount_(type, listOffset, op)                        \
+    ((void)LLInstrumentListOf_(type, listOffset)->aOp[LLInstrumentOp_##op].fetch_add(1, std::memory_order_relaxed))
+
+#define LLInstrumentRemoveBranch_(type, listOffset, branch)             \
+    ((void)LLInstrumentListOf_(type, listOffset)->aRemove[LLInstrumentRemove_##branch].fetch_add(1, std::memory_order_relaxed))
+
+#define LLInstrumentWalkBegin_(type, it, listOffset)                    \
+    for (LLInstrumentWalk_ it##Walk_(LLInstrumentListOf_(type, listOffset)); it##Walk_.isFirst; it##Walk_.isFirst = false)
+
+#define LLInstrumentWalkVisit_(it)                                      \
+    && it##Walk_.Visit()
+
+#else
+
+#define LLInstrumentCount_(type, listOffset, op) ((void)0)
+#define LLInstrumentRemoveBranch_(type, listOffset, branch) ((void)0)
+#define LLInstrumentWalkBegin_(type, it, listOffset)
+#define LLInstrumentWalkVisit_(it)
+
+#endif
+
+#ifdef LL_VALIDATE
+
+// NOTE - Validation failures are only reported through LL_ASSERT, which is a no-op without ALS_ASSERT
+#ifndef ALS_ASSERT
+#error "LL_VALIDATE needs ALS_ASSERT defined before including ll.h"
+#endif
+
+#define LL1InstrumentCheck_(type, ppListHead, ppListTail, listOffset)   \
+    do {                                                                \
+        bool isValidCheck_;                                             \
+        LL1Validate_(type, ppListHead, ppListTail, listOffset, isValidCheck_); \
+        (void)isValidCheck_;                                            \
+    } while(0)
+
+#define LL2InstrumentCheck_(type, ppListHead, ppListTail, listOffset)   \
+    do {                                                                \
+        bool isValidCheck_;                                             \
+        LL2Validate_(type, ppListHead, ppListTail, listOffset, isValidCheck_); \
+        (void)isValidCheck_;                                            \
+    } while(0)
+
+#else
+
+#define LL1InstrumentCheck_(type, ppListHead, ppListTail, listOffset) ((void)0)
+#define LL2InstrumentCheck_(type, ppListHead, ppListTail, listOffset) ((void)0)
+
+#endif
+
+// NOTE - Placed at the end of every mutating LL1/LL2 macro
+#define LL1InstrumentOp_(type, ppListHead, ppListTail, listOffset, op)  \
+    do {                                                                \
+        LLInstrumentCount_(type, listOffset, op);                       \
+        LL1InstrumentCheck_(type, ppListHead, ppListTail, listOffset);  \
+    } while(0)
+
+#define LL2InstrumentOp_(type, ppListHead, ppListTail, listOffset, op)  \
+    do {                                                                \
+        LLInstrumentCount_(type, listOffset, op);                       \
+        LL2InstrumentCheck_(type, ppListHead, ppListTail, listOffset);  \
+    } while(0)
+
+
+//
+// Singly linked list
+//
+
+#define DefineLL1Node(type)                     \
+    struct LL1Node                              \
+    {                                           \
+        struct type * pNext;                    \
+    };                                          \
+    struct LL1Ref                               \
+    {                                           \
+        struct type ** ppHead;                  \
+        struct type ** ppTail;                  \
+        uintptr_t offset;                       \
+    };                                          \
+    
+#define LL1Type(userId) LL1_##userId
+        
+#define DefineLL1(type, linkMember, userId)                         \
+    struct LL1_##userId                                             \
+    {                                                               \
+        struct type * pHead;                                        \
+        struct type * pTail;                                        \
+        enum Offset { offset = offsetof(type, linkMember) };        \
+    };
+
+
+
+#define LL1MakeRef(listRefPtr, list)            \
+    do {                                        \
+        (listRefPtr)->ppHead = &list.pHead;     \
+        (listRefPtr)->ppTail = &list.pTail;     \
+        (listRefPtr)->offset = list.offset;     \
+    } while(0)
+
+
+
+#define LL1NodePtr_(type, pItem, listOffset)                    \
+    ((type::LL1Node *)((unsigned char * )pItem + listOffset))
+
+#define LL1NodePtr(type, list, pItem)           \
+    LL1NodePtr_(type, pItem, list.offset)
+
+#define LL1RefNodePtr(type, listRef, pItem)     \
+    LL1NodePtr_(type, pItem, listRef.offset)
+
+
+#define LL1IsItemLinked_(type, pItem, listOffset)               \
+    (LL1NodePtr_(type, pItem, listOffset)->pNext != nullptr)
+
+// NOTE - It's possible for an item to be linked, but not necessarily be a part of this list (i.e., there are multiple heads that all
+//  use the same nodes as links and items can only be on one list). Querying this would require O(n) search.
+//  Counted lists (DefineLL1Counted) tag nodes with their owner and can answer it in O(1), see LL1CountedIsItemOnList.
+#define LL1IsItemLinked(type, list, pItem)      \
+    LL1IsItemLinked_(type, pItem, list.offset)
+
+#define LL1RefIsItemLinked(type, listRef, pItem)    \
+    LL1IsItemLinked_(type, pItem, listRef.offset)
+
+
+    
+#define LL1IsNodeLinked(node)                   \
+    (node.pNext != nullptr)
+
+
+    
+#define LL1AddHead_(type, ppListHead, ppListTail, listOffset, pItem)    \
+    do {                                                                \
+        if (LL1IsItemLinked_(type, pItem, listOffset))                  \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        auto * itemNode_ = LL1NodePtr_(type, pItem, listOffset);        \
+        if (*ppListHead)                                                \
+        {                                                               \
+            itemNode_->pNext = *ppListHead;                             \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            itemNode_->pNext = (type *)LLEndOfList_;                    \
+            *ppListTail = pItem;                                        \
+        }                                                               \
+        *ppListHead = pItem;                                            \
+        LL1InstrumentOp_(type, ppListHead, ppListTail, listOffset, AddHead); \
+    } while(0)
+
+#define LL1AddHead(type, list, pItem)                               \
+    LL1AddHead_(type, &list.pHead, &list.pTail, list.offset, pItem)
+
+#define LL1RefAddHead(type, listRef, pItem)                             \
+    LL1AddHead_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pItem)
+
+#define LL1Add(type, list, pItem)               \
+    LL1AddHead(type, list, pItem)
+
+#define LL1RefAdd(type, listRef, pItem)         \
+    LL1RefAddHead(type, listRef, pItem)
+
+
+
+#define LL1AddTail_(type, ppListHead, ppListTail, listOffset, pItem)    \
+    do {                                                                \
+        if (LL1IsItemLinked_(type, pItem, listOffset))                  \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        auto * itemNode_ = LL1NodePtr_(type, pItem, listOffset);        \
+        if (*ppListTail)                                                \
+        {                                                               \
+            LL1NodePtr_(type, *ppListTail, listOffset)->pNext = pItem;  \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            *ppListHead = pItem;                                        \
+        }                                                               \
+        itemNode_->pNext = (type *)LLEndOfList_;                        \
+        *ppListTail = pItem;                                            \
+        LL1InstrumentOp_(type, ppListHead, ppListTail, listOffset, AddTail); \
+    } while(0)
+
+#define LL1AddTail(type, list, pItem)                               \
+    LL1AddTail_(type, &list.pHead, &list.pTail, list.offset, pItem)
+
+#define LL1RefAddTail(type, listRef, pItem)                             \
+    LL1AddTail_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pItem)
+
+
+
+#define LL1RemoveHead_(type, ppListHead, ppListTail, listOffset, pAssignTo) \
+    do {                                                                \
+        type * headToRemove_ = *ppListHead;                             \
+        pAssignTo = headToRemove_;                                      \
+        if (headToRemove_)                                              \
+        {                                                               \
+            auto * headToRemoveNode_ = LL1NodePtr_(type, headToRemove_, listOffset); \
+            if (headToRemoveNode_->pNext != (type *)LLEndOfList_)       \
+            {                                                           \
+                *ppListHead = headToRemoveNode_->pNext;                 \
+            }                                                           \
+            else                                                        \
+            {                                                           \
+                *ppListHead = nullptr;                                  \
+                *ppListTail = nullptr;                                  \
+            }                                                           \
+            headToRemoveNode_->pNext = nullptr;                         \
+            LL1InstrumentOp_(type, ppListHead, ppListTail, listOffset, RemoveHead); \
+        }                                                               \
+    } while (0)
+
+#define LL1RemoveHead(type, list, pAssignTo)                            \
+    LL1RemoveHead_(type, &list.pHead, &list.pTail, list.offset, pAssignTo)
+
+#define LL1RefRemoveHead(type, listRef, pAssignTo)                      \
+    LL1RemoveHead_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pAssignTo)
+
+
+
+
+#define LL1Next_(type, pItem, listOffset)                               \
+    ((LL1NodePtr_(type, pItem, listOffset)->pNext == (type *)LLEndOfList_) ? nullptr : LL1NodePtr_(type, pItem, listOffset)->pNext)
+
+#define LL1Next(type, list, pItem)              \
+    LL1Next_(type, pItem, list.offset)
+
+#define LL1RefNext(type, listRef, pItem)        \
+    LL1Next_(type, pItem, listRef.offset)
+
+
+
+// NOTE - There are no back links, so this is an O(n) search from the head. pAssignTo gets nullptr if pItem is the head
+//  (or isn't on the list).
+#define LL1Prev_(type, ppListHead, listOffset, pItem, pAssignTo)        \
+    do {                                                                \
+        pAssignTo = nullptr;                                            \
+        for (type * pPrevSearch_ = *ppListHead; pPrevSearch_ && pPrevSearch_ != (pItem); pPrevSearch_ = LL1Next_(type, pPrevSearch_, listOffset)) \
+        {                                                               \
+            if (LL1NodePtr_(type, pPrevSearch_, listOffset)->pNext == (pItem)) \
+            {                                                           \
+                pAssignTo = pPrevSearch_;                               \
+                break;                                                  \
+            }                                                           \
+        }                                                               \
+    } while(0)
+
+#define LL1Prev(type, list, pItem, pAssignTo)                           \
+    LL1Prev_(type, &list.pHead, list.offset, pItem, pAssignTo)
+
+#define LL1RefPrev(type, listRef, pItem, pAssignTo)                     \
+    LL1Prev_(type, listRef.ppHead, listRef.offset, pItem, pAssignTo)
+
+    
+
+#define LL1Clear_(type, ppListHead, ppListTail, listOffset)             \
+    do {                                                                \
+        while (*ppListHead)                                             \
+        {                                                               \
+            auto * pHeadNode_ = LL1NodePtr_(type, *ppListHead, listOffset); \
+            auto * pHeadNext_ = LL1Next_(type, *ppListHead, listOffset); \
+            pHeadNode_->pNext = nullptr;                                \
+            *ppListHead = pHeadNext_;                                   \
+        }                                                               \
+        *ppListTail = nullptr;                                          \
+        LL1InstrumentOp_(type, ppListHead, ppListTail, listOffset, Clear); \
+    } while(0)
+
+#define LL1Clear(type, list)                                \
+    LL1Clear_(type, &list.pHead, &list.pTail, list.offset)
+
+#define LL1RefClear(type, listRef)                                  \
+    LL1Clear_(type, listRef.ppHead, listRef.ppTail, listRef.offset)
+
+
+
+#define LL1ClearWithoutUnlinking_(type, ppListHead, ppListTail, listOffset) \
+    do {                                                                \
+        *ppListHead = nullptr;                                          \
+        *ppListTail = nullptr;                                          \
+        LL1InstrumentOp_(type, ppListHead, ppListTail, listOffset, Clear); \
+    } while (0)
+
+#define LL1ClearWithoutUnlinking(type, list)                    \
+    LL1ClearWithoutUnlinking_(type, &list.pHead, &list.pTail, list.offset)
+
+#define LL1RefClearWithoutUnlinking(type, listRef)                  \
+    LL1ClearWithoutUnlinking_(type, listRef.ppHead, listRef.ppTail, listRef.offset)
+
+    
+
+#define LL1IsEmpty_(ppListHead)                 \
+    (!(*ppListHead))
+
+#define LL1IsEmpty(list)                        \
+    LL1IsEmpty_(&list.pHead)
+
+#define LL1RefIsEmpty(listRef)                  \
+    LL1IsEmpty_(listRef.ppHead)
+
+        
+
+#define ForLL1_(type, it, ppListHead, listOffset)                       \
+    LLInstrumentWalkBegin_(type, it, listOffset)                        \
+        for (type * it = *ppListHead; it LLInstrumentWalkVisit_(it); it = LL1Next_(type, it, listOffset))
+    
+#define ForLL1(type, it, list)                  \
+    ForLL1_(type, it, &list.pHead, list.offset)
+
+#define ForLL1Ref(type, it, listRef)                    \
+    ForLL1_(type, it, listRef.ppHead, listRef.offset)
+
+
+
+// NOTE - Full structural check, O(n): head and tail agree on emptiness, the walk from the head never hits a nullptr
+//  link, doesn't cycle, and ends (at the sentinel) exactly at the tail. isValid gets the result, and LL_ASSERT fires
+//  on failure.
+#define LL1Validate_(type, ppListHead, ppListTail, listOffset, isValid) \
+    do {                                                                \
+        isValid = true;                                                 \
+        type * pValidateHead_ = *ppListHead;                            \
+        type * pValidateTail_ = *ppListTail;                            \
+        if (!pValidateHead_ || !pValidateTail_)                         \
+        {                                                               \
+            isValid = !pValidateHead_ && !pValidateTail_;               \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            type * pValidateCur_ = pValidateHead_;                      \
+            type * pValidateSlow_ = pValidateHead_;                     \
+            uintptr_t cValidateStep_ = 0;                               \
+            for (;;)                                                    \
+            {                                                           \
+                type * pValidateNext_ = LL1NodePtr_(type, pValidateCur_, listOffset)->pNext; \
+                if (!pValidateNext_) { isValid = false; break; }        \
+                if (pValidateNext_ == (type *)LLEndOfList_) { isValid = (pValidateCur_ == pValidateTail_); break; } \
+                pValidateCur_ = pValidateNext_;                         \
+                if (!(++cValidateStep_ & 1)) pValidateSlow_ = LL1NodePtr_(type, pValidateSlow_, listOffset)->pNext; \
+                if (pValidateCur_ == pValidateSlow_) { isValid = false; break; } \
+            }                                                           \
+        }                                                               \
+        LL_ASSERT(isValid);                                             \
+    } while(0)
+
+#define LL1Validate(type, list, isValid)                                \
+    LL1Validate_(type, &list.pHead, &list.pTail, list.offset, isValid)
+
+#define LL1RefValidate(type, listRef, isValid)                          \
+    LL1Validate_(type, listRef.ppHead, listRef.ppTail, listRef.offset, isValid)
+
+
+
+// NOTE - Inserts pItem after pItemPrev, or at the head if pItemPrev is null. The singly linked counterpart of
+//  LL2InsertBefore_.
+#define LL1InsertAfter_(type, ppListHead, ppListTail, listOffset, pItem, pItemPrev) \
+    do {                                                                \
+        if (!pItemPrev) LL1AddHead_(type, ppListHead, ppListTail, listOffset, pItem); \
+        else if (pItemPrev == *ppListTail) LL1AddTail_(type, ppListHead, ppListTail, listOffset, pItem); \
+        else {                                                          \
+            if (LL1IsItemLinked_(type, pItem, listOffset))              \
+            {                                                           \
+                LL_ASSERT(false);                                       \
+                break;                                                  \
+            }                                                           \
+            auto * node = LL1NodePtr_(type, pItem, listOffset);         \
+            auto * prevNode = LL1NodePtr_(type, pItemPrev, listOffset); \
+            node->pNext = prevNode->pNext;                              \
+            prevNode->pNext = pItem;                                    \
+            LL1InstrumentOp_(type, ppListHead, ppListTail, listOffset, Insert); \
+        }                                                               \
+    } while(0)
+
+#define LL1InsertAfter(type, list, pItem, pItemPrev)                    \
+    LL1InsertAfter_(type, &list.pHead, &list.pTail, list.offset, pItem, pItemPrev)
+
+#define LL1RefInsertAfter(type, listRef, pItem, pItemPrev)              \
+    LL1InsertAfter_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pItem, pItemPrev)
+
+
+
+// NOTE - Removes the item after pItemPrev (or the head if pItemPrev is null) and assigns it to pAssignTo, which gets
+//  nullptr if there was nothing to remove.
+#define LL1RemoveAfter_(type, ppListHead, ppListTail, listOffset, pItemPrev, pAssignTo) \
+    do {                                                                \
+        type * pRemoveAfter_ = pItemPrev;                               \
+        if (!pRemoveAfter_)                                             \
+        {                                                               \
+            LL1RemoveHead_(type, ppListHead, ppListTail, listOffset, pAssignTo); \
+            break;                                                      \
+        }                                                               \
+        auto * prevNode_ = LL1NodePtr_(type, pRemoveAfter_, listOffset); \
+        type * pToRemove_ = LL1Next_(type, pRemoveAfter_, listOffset);  \
+        pAssignTo = pToRemove_;                                         \
+        if (!pToRemove_) break;                                         \
+        auto * removeNode_ = LL1NodePtr_(type, pToRemove_, listOffset); \
+        prevNode_->pNext = removeNode_->pNext;                          \
+        if (pToRemove_ == *ppListTail)                                  \
+        {                                                               \
+            *ppListTail = pRemoveAfter_;                                \
+        }                                                               \
+        removeNode_->pNext = nullptr;                                   \
+        LL1InstrumentOp_(type, ppListHead, ppListTail, listOffset, Remove); \
+    } while(0)
+
+#define LL1RemoveAfter(type, list, pItemPrev, pAssignTo)                \
+    LL1RemoveAfter_(type, &list.pHead, &list.pTail, list.offset, pItemPrev, pAssignTo)
+
+#define LL1RefRemoveAfter(type, listRef, pItemPrev, pAssignTo)          \
+    LL1RemoveAfter_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pItemPrev, pAssignTo)
+
+
+
+// NOTE - O(n) since the predecessor has to be found first. Prefer LL1RemoveAfter_ or LL1RemoveWhileIterating_ when
+//  you already know it.
+#define LL1Remove_(type, ppListHead, ppListTail, listOffset, pItem)     \
+    do {                                                                \
+        if (!LL1IsItemLinked_(type, pItem, listOffset)) break;          \
+        type * pRemovePrev_;                                            \
+        type * pRemoved_;                                               \
+        LL1Prev_(type, ppListHead, listOffset, pItem, pRemovePrev_);    \
+        LL_ASSERT(pRemovePrev_ || *ppListHead == (pItem));              \
+        LL1RemoveAfter_(type, ppListHead, ppListTail, listOffset, pRemovePrev_, pRemoved_); \
+        (void)pRemoved_;                                                \
+    } while(0)
+
+#define LL1Remove(type, list, pItem)                                    \
+    LL1Remove_(type, &list.pHead, &list.pTail, list.offset, pItem)
+
+#define LL1RefRemove(type, listRef, pItem)                              \
+    LL1Remove_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pItem)
+
+
+
+// NOTE - List 1 is cleared. O(1) thanks to the tail pointer.
+#define LL1Combine_(type, ppList0Head, ppList0Tail, ppList1Head, ppList1Tail, listOffset) \
+    do {                                                                \
+        if (LL1IsEmpty_(ppList0Head))                                   \
+        {                                                               \
+            *ppList0Head = *ppList1Head;                                \
+            *ppList0Tail = *ppList1Tail;                                \
+        }                                                               \
+        else if (!LL1IsEmpty_(ppList1Head))                             \
+        {                                                               \
+            LL1NodePtr_(type, *ppList0Tail, listOffset)->pNext = *ppList1Head; \
+            *ppList0Tail = *ppList1Tail;                                \
+        }                                                               \
+        *ppList1Head = nullptr;                                         \
+        *ppList1Tail = nullptr;                                         \
+        LL1InstrumentOp_(type, ppList0Head, ppList0Tail, listOffset, Combine); \
+    } while(0)
+
+#define LL1Combine(type, list0, list1)                                  \
+    LL1Combine_(type, &list0.pHead, &list0.pTail, &list1.pHead, &list1.pTail, list0.offset)
+
+#define LL1RefCombine(type, listRef0, listRef1)                         \
+    LL1Combine_(type, listRef0.ppHead, listRef0.ppTail, listRef1.ppHead, listRef1.ppTail, listRef0.offset)
+
+
+
+// NOTE - Like ForLL1_, but also keeps 'itPrev' pointing at the item before 'it' (nullptr at the head), which is what
+//  LL1RemoveWhileIterating_ needs. If 'it' is null after the body (the head was removed), the loop picks the walk
+//  back up from the list's new head.
+#define ForLL1WithPrev_(type, it, itPrev, ppListHead, listOffset)       \
+    for (type * itPrev = nullptr, * it = *ppListHead;                   \
+         it;                                                            \
+         itPrev = it, it = it ? LL1Next_(type, it, listOffset) : *ppListHead)
+
+#define ForLL1WithPrev(type, it, itPrev, list)                          \
+    ForLL1WithPrev_(type, it, itPrev, &list.pHead, list.offset)
+
+#define ForLL1RefWithPrev(type, it, itPrev, listRef)                    \
+    ForLL1WithPrev_(type, it, itPrev, listRef.ppHead, listRef.offset)
+
+
+
+// NOTE - Only valid inside ForLL1WithPrev_. Do not try to use 'it' after calling this! Just let the loop run to the
+//  next iteration, at which point 'it' will work as you'd expect.
+#define LL1RemoveWhileIterating_(type, ppListHead, ppListTail, listOffset, it, itPrev) \
+    do {                                                                \
+        type * removed_;                                                \
+        LL1RemoveAfter_(type, ppListHead, ppListTail, listOffset, itPrev, removed_); \
+        LL_ASSERT(removed_ == it);                                      \
+        (void)removed_;                                                 \
+        it = itPrev;                                                    \
+    } while (0)
+
+#define LL1RemoveWhileIterating(type, list, it, itPrev)                 \
+    LL1RemoveWhileIterating_(type, &list.pHead, &list.pTail, list.offset, it, itPrev)
+
+#define LL1RefRemoveWhileIterating(type, listRef, it, itPrev)           \
+    LL1RemoveWhileIterating_(type, listRef.ppHead, listRef.ppTail, listRef.offset, it, itPrev)
+
+
+
+// NOTE - Unlinks every item for which pred(pItem) is true, in a single pass. Survivors are only relinked where a
+//  removed run has to be skipped over.
+#define LL1RemoveIf_(type, ppListHead, ppListTail, listOffset, pred)    \
+    do {                                                                \
+        type * pKeptTail_ = nullptr;                                    \
+        type * pCur_ = *ppListHead;                                     \
+        while (pCur_)                                                   \
+        {                                                               \
+            auto * curNode_ = LL1NodePtr_(type, pCur_, listOffset);     \
+            type * pNext_ = LL1Next_(type, pCur_, listOffset);          \
+            if (pred(pCur_))                                            \
+            {                                                           \
+                curNode_->pNext = nullptr;                              \
+            }                                                           \
+            else                                                        \
+            {                                                           \
+                if (!pKeptTail_) *ppListHead = pCur_;                   \
+                else if (LL1NodePtr_(type, pKeptTail_, listOffset)->pNext != pCur_) LL1NodePtr_(type, pKeptTail_, listOffset)->pNext = pCur_; \
+                pKeptTail_ = pCur_;                                     \
+            }                                                           \
+            pCur_ = pNext_;                                             \
+        }                                                               \
+        if (pKeptTail_) LL1NodePtr_(type, pKeptTail_, listOffset)->pNext = (type *)LLEndOfList_; \
+        else *ppListHead = nullptr;                                     \
+        *ppListTail = pKeptTail_;                                       \
+        LL1InstrumentOp_(type, ppListHead, ppListTail, listOffset, Filter); \
+    } while(0)
+
+#define LL1RemoveIf(type, list, pred)                                   \
+    LL1RemoveIf_(type, &list.pHead, &list.pTail, list.offset, pred)
+
+#define LL1RefRemoveIf(type, listRef, pred)                             \
+    LL1RemoveIf_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pred)
+
+
+
+// NOTE - Like ForLL1_, but a second cursor runs 'distance' hops ahead of 'it' and prefetches each item it lands on.
+//  The runner still has to chase pNext itself, but its misses overlap with the loop body instead of stalling the
+//  next iteration. Same rules as ForLL1_ for removing 'it' inside the body. If the runner is left on an item that
+//  got unlinked (i.e. it was still on 'it'), it restarts from the new 'it'. distance is clamped to at least 1.
+#define LL1PrefetchAdvance_(type, pAhead, listOffset)                   \
+    (pAhead ? (pAhead = LL1Next_(type, pAhead, listOffset),             \
+               pAhead ? (LL_PREFETCH(pAhead), LL_PREFETCH(LL1NodePtr_(type, pAhead, listOffset)), 0) : 0) : 0)
+
+// NOTE - The advance that follows puts the runner 1 hop ahead of the new 'it', hence gap = 1
+#define LL1PrefetchCatchUp_(type, it, pAhead, gap, listOffset)          \
+    ((pAhead && !LL1NodePtr_(type, pAhead, listOffset)->pNext) ? (pAhead = (it), gap = 1) : 0)
+
+#define ForLL1Prefetch_(type, it, ppListHead, listOffset, distance)     \
+    for (int it##Gap_ = 0, it##Distance_ = ((distance) > 1) ? (distance) : 1; it##Gap_ >= 0; it##Gap_ = -1) \
+        for (type * it = *ppListHead, * it##Ahead_ = it;                \
+             it;                                                        \
+             it = LL1Next_(type, it, listOffset),                       \
+                 LL1PrefetchCatchUp_(type, it, it##Ahead_, it##Gap_, listOffset), \
+                 LL1PrefetchAdvance_(type, it##Ahead_, listOffset),     \
+                 (it##Gap_ < it##Distance_) ? (it##Gap_++, LL1PrefetchAdvance_(type, it##Ahead_, listOffset)) : 0)
+
+#define ForLL1Prefetch(type, it, list, distance)                        \
+    ForLL1Prefetch_(type, it, &list.pHead, list.offset, distance)
+
+#define ForLL1RefPrefetch(type, it, listRef, distance)                  \
+    ForLL1Prefetch_(type, it, listRef.ppHead, listRef.offset, distance)
+
+
+
+// NOTE - Keeps a ring of the next LL_VISIT_BATCH items. Each step takes the oldest item off the ring, chases one
+//  more pNext to refill it, and only then calls visitFn(pItem) on the item it took. The pNext load for the item K
+//  hops ahead is therefore already issued while visitFn runs, and each chased item is prefetched so its payload is
+//  warm by the time it comes around. visitFn may unlink the item it's given, but no others.
+#define LL1VisitBatched_(type, ppListHead, listOffset, visitFn)         \
+    do {                                                                \
+        type * apRing_[LL_VISIT_BATCH];                                 \
+        int iRingOldest_ = 0;                                           \
+        int cRing_ = 0;                                                 \
+        type * pChase_ = *ppListHead;                                   \
+        while (pChase_ && cRing_ < LL_VISIT_BATCH)                      \
+        {                                                               \
+            LL_PREFETCH(pChase_);                                       \
+            apRing_[cRing_++] = pChase_;                                \
+            pChase_ = LL1Next_(type, pChase_, listOffset);              \
+        }                                                               \
+        while (cRing_)                                                  \
+        {                                                               \
+            type * pVisit_ = apRing_[iRingOldest_];                     \
+            if (pChase_)                                                \
+            {                                                           \
+                LL_PREFETCH(pChase_);                                   \
+                apRing_[iRingOldest_] = pChase_;                        \
+                pChase_ = LL1Next_(type, pChase_, listOffset);          \
+            }                                                           \
+            else                                                        \
+            {                                                           \
+                cRing_--;                                               \
+            }                                                           \
+            if (++iRingOldest_ == LL_VISIT_BATCH) iRingOldest_ = 0;     \
+            visitFn(pVisit_);                                           \
+        }                                                               \
+    } while(0)
+
+#define LL1VisitBatched(type, list, visitFn)                            \
+    LL1VisitBatched_(type, &list.pHead, list.offset, visitFn)
+
+#define LL1RefVisitBatched(type, listRef, visitFn)                      \
+    LL1VisitBatched_(type, listRef.ppHead, listRef.offset, visitFn)
+
+
+
+// NOTE - lessFn(pA, pB) should return true if pA belongs before pB. Stable, O(n log n), no allocation.
+#define LL1Sort_(type, ppListHead, ppListTail, listOffset, lessFn)      \
+    do {                                                                \
+        if (*ppListHead)                                                \
+        {                                                               \
+            LL1NodePtr_(type, *ppListTail, listOffset)->pNext = nullptr; \
+            LLSortChain_(type, (listOffset) + offsetof(type::LL1Node, pNext), *ppListHead, lessFn, *ppListHead); \
+            type * pNewTail_ = *ppListHead;                             \
+            while (LL1NodePtr_(type, pNewTail_, listOffset)->pNext)     \
+            {                                                           \
+                pNewTail_ = LL1NodePtr_(type, pNewTail_, listOffset)->pNext; \
+            }                                                           \
+            LL1NodePtr_(type, pNewTail_, listOffset)->pNext = (type *)LLEndOfList_; \
+            *ppListTail = pNewTail_;                                    \
+        }                                                               \
+        LL1InstrumentOp_(type, ppListHead, ppListTail, listOffset, Sort); \
+    } while(0)
+
+#define LL1Sort(type, list, lessFn)                                     \
+    LL1Sort_(type, &list.pHead, &list.pTail, list.offset, lessFn)
+
+#define LL1RefSort(type, listRef, lessFn)                               \
+    LL1Sort_(type, listRef.ppHead, listRef.ppTail, listRef.offset, lessFn)
+
+
+
+// NOTE - Both lists must already be sorted by lessFn. List 1 is cleared. Stable: on ties, list 0's items come first.
+#define LL1MergeSorted_(type, ppList0Head, ppList0Tail, ppList1Head, ppList1Tail, listOffset, lessFn) \
+    do {                                                                \
+        if (LL1IsEmpty_(ppList0Head))                                   \
+        {                                                               \
+            *ppList0Head = *ppList1Head;                                \
+            *ppList0Tail = *ppList1Tail;                                \
+        }                                                               \
+        else if (!LL1IsEmpty_(ppList1Head))                             \
+        {                                                               \
+            type * pA_ = *ppList0Head;                                  \
+            type * pB_ = *ppList1Head;                                  \
+            type ** ppLink_ = ppList0Head;                              \
+            while (pA_ && pB_)                                          \
+            {                                                           \
+                type * pPick_;                                          \
+                if (lessFn(pB_, pA_))                                   \
+                {                                                       \
+                    pPick_ = pB_;                                       \
+                    pB_ = LL1Next_(type, pB_, listOffset);              \
+                }                                                       \
+                else                                                    \
+                {                                                       \
+                    pPick_ = pA_;                                       \
+                    pA_ = LL1Next_(type, pA_, listOffset);              \
+                }                                                       \
+                *ppLink_ = pPick_;                                      \
+                ppLink_ = &LL1NodePtr_(type, pPick_, listOffset)->pNext; \
+            }                                                           \
+            *ppLink_ = pA_ ? pA_ : pB_;                                 \
+            if (!pA_) *ppList0Tail = *ppList1Tail;                      \
+        }                                                               \
+        *ppList1Head = nullptr;                                         \
+        *ppList1Tail = nullptr;                                         \
+        LL1InstrumentOp_(type, ppList0Head, ppList0Tail, listOffset, Merge); \
+    } while(0)
+
+#define LL1MergeSorted(type, list0, list1, lessFn)                      \
+    LL1MergeSorted_(type, &list0.pHead, &list0.pTail, &list1.pHead, &list1.pTail, list0.offset, lessFn)
+
+#define LL1RefMergeSorted(type, listRef0, listRef1, lessFn)             \
+    LL1MergeSorted_(type, listRef0.ppHead, listRef0.ppTail, listRef1.ppHead, listRef1.ppTail, listRef0.offset, lessFn)
+
+
+
+    
+//
+// Doubly linked list
+//
+
+#define DefineLL2Node(type)                     \
+    struct LL2Node                              \
+    {                                           \
+        struct type * pPrev;                    \
+        struct type * pNext;                    \
+    };                                          \
+    struct LL2Ref                               \
+    {                                           \
+        struct type ** ppHead;                  \
+        struct type ** ppTail;                  \
+        uintptr_t offset;                       \
+    };                                          \
+    struct LL2CombineParam                      \
+    {                                           \
+        struct type ** ppHead0;                 \
+        struct type ** ppTail0;                 \
+        struct type ** ppHead1;                 \
+        struct type ** ppTail1;                 \
+        uintptr_t offset;                       \
+    }
+    
+#define LL2Type(userId) LL2_##userId
+        
+#define DefineLL2(type, linkMember, userId)                             \
+        struct LL2_##userId                                             \
+        {                                                               \
+            struct type * pHead;                                        \
+            struct type * pTail;                                        \
+            static const uintptr_t offset = offsetof(type, linkMember); \
+        };                                                              \
+
+#define LL2MakeRef(listRefPtr, list)            \
+    do {                                        \
+        (listRefPtr)->ppHead = &list.pHead;     \
+        (listRefPtr)->ppTail = &list.pTail;     \
+        (listRefPtr)->offset = list.offset;     \
+    } while(0)
+
+
+
+#define LL2NodePtr_(type, pItem, listOffset)                    \
+    ((type::LL2Node *)((unsigned char * )pItem + listOffset))
+
+#define LL2NodePtr(type, list, pItem)           \
+    LL2NodePtr_(type, pItem, list.offset)
+
+#define LL2RefNodePtr(type, listRef, pItem)     \
+    LL2NodePtr_(type, pItem, listRef.offset)
+
+
+#define LL2IsItemLinked_(type, pItem, listOffset)               \
+    (LL2NodePtr_(type, pItem, listOffset)->pPrev != nullptr)
+
+// NOTE - It's possible for an item to be linked, but not necessarily be a part of this list (i.e., there are multiple heads that all
+//  use the same nodes as links and items can only be on one list). Querying this would require O(n) search.
+//  Counted lists (DefineLL2Counted) tag nodes with their owner and can answer it in O(1), see LL2CountedIsItemOnList.
+#define LL2IsItemLinked(type, list, pItem)      \
+    LL2IsItemLinked_(type, pItem, list.offset)
+
+#define LL2RefIsItemLinked(type, listRef, pItem)    \
+    LL2IsItemLinked_(type, pItem, listRef.offset)
+
+
+    
+#define LL2IsNodeLinked(node)                   \
+    (node.pPrev != nullptr)
+
+
+#define LL2AddHead_(type, ppListHead, ppListTail, listOffset, pItem)    \
+    do {                                                                \
+        if (LL2IsItemLinked_(type, pItem, listOffset))                  \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        auto * itemNode_ = LL2NodePtr_(type, pItem, listOffset);        \
+        if (*ppListHead)                                                \
+        {                                                               \
+            LL2NodePtr_(type, *ppListHead, listOffset)->pPrev = pItem;  \
+            itemNode_->pNext = *ppListHead;                             \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            itemNode_->pNext = (type *)LLEndOfList_;                    \
+            *ppListTail = pItem;                                        \
+        }                                                               \
+        itemNode_->pPrev = (type *)LLEndOfList_;                        \
+        *ppListHead = pItem;                                            \
+        LL2InstrumentOp_(type, ppListHead, ppListTail, listOffset, AddHead); \
+    } while(0)
+
+#define LL2AddHead(type, list, pItem)                               \
+    LL2AddHead_(type, &list.pHead, &list.pTail, list.offset, pItem)
+
+#define LL2RefAddHead(type, listRef, pItem)                             \
+    LL2AddHead_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pItem)
+
+#define LL2Add(type, list, pItem)               \
+    LL2AddHead(type, list, pItem)
+
+#define LL2RefAdd(type, listRef, pItem)         \
+    LL2RefAddHead(type, listRef, pItem)
+
+
+
+// TODO - LL2IsItemLinked check will break if linked to a separate list that uses the same node?
+//  What is the desired behavior in this case? (Counted lists can at least tell you which list it's on, see LL2CountedOwner)
+#define LL2AddTail_(type, ppListHead, ppListTail, listOffset, pItem)    \
+    do {                                                                \
+        if (LL2IsItemLinked_(type, pItem, listOffset))                  \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        auto * itemNode_ = LL2NodePtr_(type, pItem, listOffset);        \
+        if (*ppListTail)                                                \
+        {                                                               \
+            LL2NodePtr_(type, *ppListTail, listOffset)->pNext = pItem;  \
+            itemNode_->pPrev = *ppListTail;                             \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            itemNode_->pPrev = (type *)LLEndOfList_;                    \
+            *ppListHead = pItem;                                        \
+        }                                                               \
+        itemNode_->pNext = (type *)LLEndOfList_;                        \
+        *ppListTail = pItem;                                            \
+        LL2InstrumentOp_(type, ppListHead, ppListTail, listOffset, AddTail); \
+    } while(0)
+
+#define LL2AddTail(type, list, pItem)                               \
+    LL2AddTail_(type, &list.pHead, &list.pTail, list.offset, pItem)
+
+#define LL2RefAddTail(type, listRef, pItem)                             \
+    LL2AddTail_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pItem)
+
+    
+
+#define LL2Remove_(type, ppListHead, ppListTail, listOffset, pItem)     \
+    do {                                                                \
+        auto * node_ = LL2NodePtr_(type, pItem, listOffset);            \
+        if (!LL2IsItemLinked_(type, pItem, listOffset))                 \
+        {                                                               \
+            LLInstrumentRemoveBranch_(type, listOffset, NotLinked);     \
+            break;                                                      \
+        }                                                               \
+        type * pPrev_ = node_->pPrev;                                   \
+        type * pNext_ = node_->pNext;                                   \
+        bool hasNext_ = pNext_ != (type *)LLEndOfList_;                 \
+        bool hasPrev_ = pPrev_ != (type *)LLEndOfList_;                 \
+        if (hasNext_ && hasPrev_)                                       \
+        {                                                               \
+            LLInstrumentRemoveBranch_(type, listOffset, Middle);        \
+            LL2NodePtr_(type, pNext_, listOffset)->pPrev = pPrev_;      \
+            LL2NodePtr_(type, pPrev_, listOffset)->pNext = pNext_;      \
+        }                                                               \
+        else if (hasNext_ && !hasPrev_)                                 \
+        {                                                               \
+            LLInstrumentRemoveBranch_(type, listOffset, Head);          \
+            LL2NodePtr_(type, pNext_, listOffset)->pPrev = (type *)LLEndOfList_; \
+            *ppListHead = pNext_;                                       \
+        }                                                               \
+        else if (!hasNext_ && hasPrev_)                                 \
+        {                                                               \
+            LLInstrumentRemoveBranch_(type, listOffset, Tail);          \
+            LL2NodePtr_(type, pPrev_, listOffset)->pNext = (type *)LLEndOfList_; \
+            *ppListTail = pPrev_;                                       \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            LLInstrumentRemoveBranch_(type, listOffset, Only);          \
+            *ppListHead = nullptr;                                      \
+            *ppListTail = nullptr;                                      \
+        }                                                               \
+        node_->pPrev = nullptr;                                         \
+        node_->pNext = nullptr;                                         \
+        LL2InstrumentOp_(type, ppListHead, ppListTail, listOffset, Remove); \
+    } while(0)
+
+#define LL2Remove(type, list, pItem)                                \
+    LL2Remove_(type, &list.pHead, &list.pTail, list.offset, pItem)
+
+#define LL2RefRemove(type, listRef, pItem)                              \
+    LL2Remove_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pItem)
+
+
+
+#define LL2InsertBefore_(type, ppListHead, ppListTail, listOffset, pItem, pItemNext) \
+    do {                                                                \
+        if (!pItemNext) LL2AddTail_(type, ppListHead, ppListTail, listOffset, pItem); \
+        else if (pItemNext == *ppListHead) LL2AddHead_(type, ppListHead, ppListTail, listOffset, pItem); \
+        else {                                                          \
+            if (LL2IsItemLinked_(type, pItem, listOffset))              \
+            {                                                           \
+                LL_ASSERT(false);                                       \
+                break;                                                  \
+            }                                                           \
+            auto * node = LL2NodePtr_(type, pItem, listOffset);         \
+            auto * nextNode = LL2NodePtr_(type, pItemNext, listOffset); \
+            auto * pItemPrev = LL2Prev_(type, pItemNext, listOffset);   \
+            auto * prevNode = LL2NodePtr_(type, pItemPrev, listOffset); \
+            prevNode->pNext = pItem;                                    \
+            nextNode->pPrev = pItem;                                    \
+            node->pNext = pItemNext;                                    \
+            node->pPrev = pItemPrev;                                    \
+            LL2InstrumentOp_(type, ppListHead, ppListTail, listOffset, Insert); \
+        }                                                               \
+    } while(0)
+
+#define LL2InsertBefore(type, list, pItem, pItemNext)                   \
+    LL2InsertBefore_(type, &list.pHead, &list.pTail, list.offset, pItem, pItemNext)
+
+#define LL2RefInsertBefore(type, listRef, pItem, pItemNext)             \
+    LL2InsertBefore_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pItem, pItemNext)
+
+      
+
+#define LL2RemoveHead_(type, ppListHead, ppListTail, listOffset, pAssignTo) \
+    do {                                                                \
+        type * headToRemove_ = *ppListHead;                             \
+        pAssignTo = headToRemove_;                                      \
+        if (headToRemove_)                                              \
+        {                                                               \
+            auto * headToRemoveNode_ = LL2NodePtr_(type, headToRemove_, listOffset); \
+            if (headToRemoveNode_->pNext != (type *)LLEndOfList_)       \
+            {                                                           \
+                *ppListHead = headToRemoveNode_->pNext;                 \
+                auto * newHeadNode_ = LL2NodePtr_(type, *ppListHead, listOffset); \
+                newHeadNode_->pPrev = (type *)LLEndOfList_;              \
+            }                                                           \
+            else                                                        \
+            {                                                           \
+                *ppListHead = nullptr;                                  \
+                *ppListTail = nullptr;                                  \
+            }                                                           \
+            headToRemoveNode_->pNext = nullptr;                         \
+            headToRemoveNode_->pPrev = nullptr;                         \
+            LL2InstrumentOp_(type, ppListHead, ppListTail, listOffset, RemoveHead); \
+        }                                                               \
+    } while (0)
+
+#define LL2RemoveHead(type, list, pAssignTo)                            \
+    LL2RemoveHead_(type, &list.pHead, &list.pTail, list.offset, pAssignTo)
+
+#define LL2RefRemoveHead(type, listRef, pAssignTo)                      \
+    LL2RemoveHead_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pAssignTo)
+
+
+
+#define LL2RemoveTail_(type, ppListHead, ppListTail, listOffset, pAssignTo) \
+    do {                                                                \
+        type * tailToRemove_ = *ppListTail;                             \
+        pAssignTo = tailToRemove_;                                      \
+        if (tailToRemove_)                                              \
+        {                                                               \
+            auto * tailToRemoveNode_ = LL2NodePtr_(type, tailToRemove_, listOffset); \
+            if (tailToRemoveNode_->pPrev != (type *)LLEndOfList_)       \
+            {                                                           \
+                *ppListTail = tailToRemoveNode_->pPrev;                 \
+                auto * newTailNode_ = LL2NodePtr_(type, *ppListTail, listOffset); \
+                newTailNode_->pNext = (type *)LLEndOfList_;              \
+            }                                                           \
+            else                                                        \
+            {                                                           \
+                *ppListHead = nullptr;                                  \
+                *ppListTail = nullptr;                                  \
+            }                                                           \
+            tailToRemoveNode_->pNext = nullptr;                         \
+            tailToRemoveNode_->pPrev = nullptr;                         \
+            LL2InstrumentOp_(type, ppListHead, ppListTail, listOffset, RemoveTail); \
+        }                                                               \
+    } while (0)
+
+#define LL2RemoveTail(type, list, pAssignTo)                            \
+    LL2RemoveTail_(type, &list.pHead, &list.pTail, list.offset, pAssignTo)
+
+#define LL2RefRemoveTail(type, listRef, pAssignTo)                      \
+    LL2RemoveTail_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pAssignTo)
+
+
+
+// NOTE - Equivalent to LL2Remove_ followed by LL2AddHead_, but done in one step. pItem must already be on this list.
+//  Since pItem isn't the head (checked first) it's known to have a prev, so the only remaining sentinel branch is
+//  whether it was the tail.
+#define LL2MoveToHead_(type, ppListHead, ppListTail, listOffset, pItem) \
+    do {                                                                \
+        type * pMoveHead_ = *ppListHead;                                \
+        if (pItem == pMoveHead_) break;                                 \
+        auto * moveNode_ = LL2NodePtr_(type, pItem, listOffset);        \
+        type * pMovePrev_ = moveNode_->pPrev;                           \
+        type * pMoveNext_ = moveNode_->pNext;                           \
+        LL2NodePtr_(type, pMovePrev_, listOffset)->pNext = pMoveNext_;  \
+        if (pMoveNext_ != (type *)LLEndOfList_) LL2NodePtr_(type, pMoveNext_, listOffset)->pPrev = pMovePrev_; \
+        else *ppListTail = pMovePrev_;                                  \
+        moveNode_->pPrev = (type *)LLEndOfList_;                        \
+        moveNode_->pNext = pMoveHead_;                                  \
+        LL2NodePtr_(type, pMoveHead_, listOffset)->pPrev = pItem;       \
+        *ppListHead = pItem;                                            \
+        LL2InstrumentOp_(type, ppListHead, ppListTail, listOffset, MoveToHead); \
+    } while(0)
+
+#define LL2MoveToHead(type, list, pItem)                                \
+    LL2MoveToHead_(type, &list.pHead, &list.pTail, list.offset, pItem)
+
+#define LL2RefMoveToHead(type, listRef, pItem)                          \
+    LL2MoveToHead_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pItem)
+
+
+
+#define LL2Next_(type, pItem, listOffset)                               \
+    ((LL2NodePtr_(type, pItem, listOffset)->pNext == (type *)LLEndOfList_) ? nullptr : LL2NodePtr_(type, pItem, listOffset)->pNext)
+
+#define LL2Next(type, list, pItem)              \
+    LL2Next_(type, pItem, list.offset)
+
+#define LL2RefNext(type, listRef, pItem)        \
+    LL2Next_(type, pItem, listRef.offset)
+
+
+
+#define LL2Prev_(type, pItem, listOffset)                               \
+    ((LL2NodePtr_(type, pItem, listOffset)->pPrev == (type *)LLEndOfList_) ? nullptr : LL2NodePtr_(type, pItem, listOffset)->pPrev)
+
+#define LL2Prev(type, list, pItem)              \
+    LL2Prev_(type, pItem, list.offset)
+
+#define LL2RefPrev(type, listRef, pItem)        \
+    LL2Prev_(type, pItem, listRef.offset)
+
+
+    
+
+#define LL2Clear_(type, ppListHead, ppListTail, listOffset)             \
+    do {                                                                \
+        while (*ppListHead)                                             \
+        {                                                               \
+            auto * pHeadNode_ = LL2NodePtr_(type, *ppListHead, listOffset); \
+            auto * pHeadNext_ = LL2Next_(type, *ppListHead, listOffset); \
+            pHeadNode_->pNext = nullptr;                                \
+            pHeadNode_->pPrev = nullptr;                                \
+            *ppListHead = pHeadNext_;                                   \
+        }                                                               \
+        *ppListTail = nullptr;                                          \
+        LL2InstrumentOp_(type, ppListHead, ppListTail, listOffset, Clear); \
+    } while(0)
+
+#define LL2Clear(type, list)                                \
+    LL2Clear_(type, &list.pHead, &list.pTail, list.offset)
+
+#define LL2RefClear(type, listRef)                                  \
+    LL2Clear_(type, listRef.ppHead, listRef.ppTail, listRef.offset)
+
+
+
+#define LL2ClearWithoutUnlinking_(type, ppListHead, ppListTail, listOffset) \
+    do {                                                                \
+        *ppListHead = nullptr;                                          \
+        *ppListTail = nullptr;                                          \
+        LL2InstrumentOp_(type, ppListHead, ppListTail, listOffset, Clear); \
+    } while (0)
+
+#define LL2ClearWithoutUnlinking(type, list)                    \
+    LL2ClearWithoutUnlinking_(type, &list.pHead, &list.pTail, list.offset)
+
+#define LL2RefClearWithoutUnlinking(type, listRef)                  \
+    LL2ClearWithoutUnlinking_(type, listRef.ppHead, listRef.ppTail, listRef.offset)
+
+
+
+#define LL2IsEmpty_(ppListHead)                 \
+    (!(*ppListHead))
+
+#define LL2IsEmpty(list)                        \
+    LL2IsEmpty_(&list.pHead)
+
+#define LL2RefIsEmpty(listRef)                  \
+    LL2IsEmpty_(listRef.ppHead)
+
+    
+
+// NOTE - List 1 is cleared
+#define LL2Combine_(type, ppList0Head, ppList0Tail, ppList1Head, ppList1Tail, listOffset) \
+    do {                                                                \
+        if (LL2IsEmpty_(ppList0Head))                                   \
+        {                                                               \
+            *ppList0Head = *ppList1Head;                                \
+            *ppList0Tail = *ppList1Tail;                                \
+        }                                                               \
+        else if (!LL2IsEmpty_(ppList1Head))                             \
+        {                                                               \
+            auto * pNodeTail0_ = LL2NodePtr_(type, *ppList0Tail, listOffset); \
+            auto * pNodeHead1_ = LL2NodePtr_(type, *ppList1Head, listOffset); \
+            pNodeTail0_->pNext = *ppList1Head;                          \
+            pNodeHead1_->pPrev = *ppList0Tail;                          \
+            *ppList0Tail = *ppList1Tail;                                \
+        }                                                               \
+        *ppList1Head = nullptr;                                         \
+        *ppList1Tail = nullptr;                                         \
+        LL2InstrumentOp_(type, ppList0Head, ppList0Tail, listOffset, Combine); \
+    } while(0)
+
+#define LL2Combine(type, combineParam)                                  \
+    LL2Combine_(type, combineParam.ppHead0, combineParam.ppTail0, combineParam.ppHead1, combineParam.ppTail1, combineParam.offset)
+
+
+
+// NOTE - Moves the run [pFirst, pLast] (pFirst at or before pLast) out of the source list and inserts it before
+//  pDstNext in the destination list, or at the destination's tail if pDstNext is null. O(1) no matter how long the
+//  run is, only the links at the two seams are written. Source and destination may be the same list, as long as
+//  pDstNext isn't inside the run.
+#define LL2SpliceRange_(type, ppSrcHead, ppSrcTail, ppDstHead, ppDstTail, listOffset, pFirst, pLast, pDstNext) \
+    do {                                                                \
+        type * pSpliceFirst_ = pFirst;                                  \
+        type * pSpliceLast_ = pLast;                                    \
+        type * pSpliceDstNext_ = pDstNext;                              \
+        auto * firstNode_ = LL2NodePtr_(type, pSpliceFirst_, listOffset); \
+        auto * lastNode_ = LL2NodePtr_(type, pSpliceLast_, listOffset); \
+        type * pBefore_ = firstNode_->pPrev;                            \
+        type * pAfter_ = lastNode_->pNext;                              \
+        bool hasBefore_ = pBefore_ != (type *)LLEndOfList_;             \
+        bool hasAfter_ = pAfter_ != (type *)LLEndOfList_;               \
+        if (hasBefore_) LL2NodePtr_(type, pBefore_, listOffset)->pNext = pAfter_; \
+        else *ppSrcHead = hasAfter_ ? pAfter_ : nullptr;                \
+        if (hasAfter_) LL2NodePtr_(type, pAfter_, listOffset)->pPrev = pBefore_; \
+        else *ppSrcTail = hasBefore_ ? pBefore_ : nullptr;              \
+        type * pDstPrev_;                                               \
+        if (pSpliceDstNext_)                                            \
+        {                                                               \
+            auto * dstNextNode_ = LL2NodePtr_(type, pSpliceDstNext_, listOffset); \
+            pDstPrev_ = dstNextNode_->pPrev;                            \
+            dstNextNode_->pPrev = pSpliceLast_;                         \
+            lastNode_->pNext = pSpliceDstNext_;                         \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            pDstPrev_ = *ppDstTail ? *ppDstTail : (type *)LLEndOfList_; \
+            *ppDstTail = pSpliceLast_;                                  \
+            lastNode_->pNext = (type *)LLEndOfList_;                    \
+        }                                                               \
+        firstNode_->pPrev = pDstPrev_;                                  \
+        if (pDstPrev_ != (type *)LLEndOfList_) LL2NodePtr_(type, pDstPrev_, listOffset)->pNext = pSpliceFirst_; \
+        else *ppDstHead = pSpliceFirst_;                                \
+        LL2InstrumentCheck_(type, ppSrcHead, ppSrcTail, listOffset);    \
+        LL2InstrumentOp_(type, ppDstHead, ppDstTail, listOffset, Splice); \
+    } while(0)
+
+#define LL2SpliceRange(type, srcList, dstList, pFirst, pLast, pDstNext) \
+    LL2SpliceRange_(type, &srcList.pHead, &srcList.pTail, &dstList.pHead, &dstList.pTail, srcList.offset, pFirst, pLast, pDstNext)
+
+#define LL2RefSpliceRange(type, srcListRef, dstListRef, pFirst, pLast, pDstNext) \
+    LL2SpliceRange_(type, srcListRef.ppHead, srcListRef.ppTail, dstListRef.ppHead, dstListRef.ppTail, srcListRef.offset, pFirst, pLast, pDstNext)
+
+
+
+// NOTE - pItem and everything after it move to the new list, which must be empty. O(1).
+#define LL2SplitAt_(type, ppListHead, ppListTail, ppNewListHead, ppNewListTail, listOffset, pItem) \
+    do {                                                                \
+        if (!LL2IsEmpty_(ppNewListHead))                                \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        auto * splitNode_ = LL2NodePtr_(type, pItem, listOffset);       \
+        type * pSplitPrev_ = splitNode_->pPrev;                         \
+        *ppNewListHead = pItem;                                         \
+        *ppNewListTail = *ppListTail;                                   \
+        splitNode_->pPrev = (type *)LLEndOfList_;                       \
+        if (pSplitPrev_ != (type *)LLEndOfList_)                        \
+        {                                                               \
+            LL2NodePtr_(type, pSplitPrev_, listOffset)->pNext = (type *)LLEndOfList_; \
+            *ppListTail = pSplitPrev_;                                  \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            *ppListHead = nullptr;                                      \
+            *ppListTail = nullptr;                                      \
+        }                                                               \
+        LL2InstrumentCheck_(type, ppNewListHead, ppNewListTail, listOffset); \
+        LL2InstrumentOp_(type, ppListHead, ppListTail, listOffset, Splice); \
+    } while(0)
+
+#define LL2SplitAt(type, list, newList, pItem)                          \
+    LL2SplitAt_(type, &list.pHead, &list.pTail, &newList.pHead, &newList.pTail, list.offset, pItem)
+
+#define LL2RefSplitAt(type, listRef, newListRef, pItem)                 \
+    LL2SplitAt_(type, listRef.ppHead, listRef.ppTail, newListRef.ppHead, newListRef.ppTail, listRef.offset, pItem)
+
+
+
+// NOTE - Rotates the list so that pNewHead becomes the head, keeping the cyclic order. O(1).
+#define LL2Rotate_(type, ppListHead, ppListTail, listOffset, pNewHead)  \
+    do {                                                                \
+        type * pRotateHead_ = pNewHead;                                 \
+        if (pRotateHead_ == *ppListHead) break;                         \
+        auto * newHeadNode_ = LL2NodePtr_(type, pRotateHead_, listOffset); \
+        type * pNewTail_ = newHeadNode_->pPrev;                         \
+        LL2NodePtr_(type, *ppListTail, listOffset)->pNext = *ppListHead; \
+        LL2NodePtr_(type, *ppListHead, listOffset)->pPrev = *ppListTail; \
+        LL2NodePtr_(type, pNewTail_, listOffset)->pNext = (type *)LLEndOfList_; \
+        newHeadNode_->pPrev = (type *)LLEndOfList_;                     \
+        *ppListHead = pRotateHead_;                                     \
+        *ppListTail = pNewTail_;                                        \
+        LL2InstrumentOp_(type, ppListHead, ppListTail, listOffset, Splice); \
+    } while(0)
+
+#define LL2Rotate(type, list, pNewHead)                                 \
+    LL2Rotate_(type, &list.pHead, &list.pTail, list.offset, pNewHead)
+
+#define LL2RefRotate(type, listRef, pNewHead)                           \
+    LL2Rotate_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pNewHead)
+
+        
+
+#define ForLL2_(type, it, ppListHead, listOffset)                       \
+    LLInstrumentWalkBegin_(type, it, listOffset)                        \
+        for (type * it = *ppListHead; it LLInstrumentWalkVisit_(it); it = LL2Next_(type, it, listOffset))
+    
+#define ForLL2(type, it, list)                  \
+    ForLL2_(type, it, &list.pHead, list.offset)
+
+#define ForLL2Ref(type, it, listRef)                    \
+    ForLL2_(type, it, listRef.ppHead, listRef.offset)
+
+
+
+// NOTE - Full structural check, O(n): head and tail agree on emptiness, every node's pPrev is the node the walk came
+//  from (LLEndOfList_ for the head), no link is nullptr, and the walk ends (at the sentinel) exactly at the tail. The
+//  pPrev check also rules out cycles, since re-entering a node from a second predecessor can't match. isValid gets the
+//  result, and LL_ASSERT fires on failure.
+#define LL2Validate_(type, ppListHead, ppListTail, listOffset, isValid) \
+    do {                                                                \
+        isValid = true;                                                 \
+        type * pValidateHead_ = *ppListHead;                            \
+        type * pValidateTail_ = *ppListTail;                            \
+        if (!pValidateHead_ || !pValidateTail_)                         \
+        {                                                               \
+            isValid = !pValidateHead_ && !pValidateTail_;               \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            type * pValidatePrev_ = (type *)LLEndOfList_;               \
+            type * pValidateCur_ = pValidateHead_;                      \
+            for (;;)                                                    \
+            {                                                           \
+                auto * validateNode_ = LL2NodePtr_(type, pValidateCur_, listOffset); \
+                if (validateNode_->pPrev != pValidatePrev_ || !validateNode_->pNext) { isValid = false; break; } \
+                if (validateNode_->pNext == (type *)LLEndOfList_) { isValid = (pValidateCur_ == pValidateTail_); break; } \
+                pValidatePrev_ = pValidateCur_;                         \
+                pValidateCur_ = validateNode_->pNext;                   \
+            }                                                           \
+        }                                                               \
+        LL_ASSERT(isValid);                                             \
+    } while(0)
+
+#define LL2Validate(type, list, isValid)                                \
+    LL2Validate_(type, &list.pHead, &list.pTail, list.offset, isValid)
+
+#define LL2RefValidate(type, listRef, isValid)                          \
+    LL2Validate_(type, listRef.ppHead, listRef.ppTail, listRef.offset, isValid)
+
+
+
+// NOTE - Like ForLL2_, but a second cursor runs 'distance' hops ahead of 'it' and prefetches each item it lands on.
+//  The runner still has to chase pNext itself, but its misses overlap with the loop body instead of stalling the
+//  next iteration. Same rules as ForLL2_ for removing 'it' inside the body. If the runner is left on an item that
+//  got unlinked (i.e. it was still on 'it'), it restarts from the new 'it'. distance is clamped to at least 1.
+#define LL2PrefetchAdvance_(type, pAhead, listOffset)                   \
+    (pAhead ? (pAhead = LL2Next_(type, pAhead, listOffset),             \
+               pAhead ? (LL_PREFETCH(pAhead), LL_PREFETCH(LL2NodePtr_(type, pAhead, listOffset)), 0) : 0) : 0)
+
+// NOTE - The advance that follows puts the runner 1 hop ahead of the new 'it', hence gap = 1
+#define LL2PrefetchCatchUp_(type, it, pAhead, gap, listOffset)          \
+    ((pAhead && !LL2NodePtr_(type, pAhead, listOffset)->pNext) ? (pAhead = (it), gap = 1) : 0)
+
+#define ForLL2Prefetch_(type, it, ppListHead, listOffset, distance)     \
+    for (int it##Gap_ = 0, it##Distance_ = ((distance) > 1) ? (distance) : 1; it##Gap_ >= 0; it##Gap_ = -1) \
+        for (type * it = *ppListHead, * it##Ahead_ = it;                \
+             it;                                                        \
+             it = LL2Next_(type, it, listOffset),                       \
+                 LL2PrefetchCatchUp_(type, it, it##Ahead_, it##Gap_, listOffset), \
+                 LL2PrefetchAdvance_(type, it##Ahead_, listOffset),     \
+                 (it##Gap_ < it##Distance_) ? (it##Gap_++, LL2PrefetchAdvance_(type, it##Ahead_, listOffset)) : 0)
+
+#define ForLL2Prefetch(type, it, list, distance)                        \
+    ForLL2Prefetch_(type, it, &list.pHead, list.offset, distance)
+
+#define ForLL2RefPrefetch(type, it, listRef, distance)                  \
+    ForLL2Prefetch_(type, it, listRef.ppHead, listRef.offset, distance)
+
+
+
+// NOTE - Keeps a ring of the next LL_VISIT_BATCH items. Each step takes the oldest item off the ring, chases one
+//  more pNext to refill it, and only then calls visitFn(pItem) on the item it took. The pNext load for the item K
+//  hops ahead is therefore already issued while visitFn runs, and each chased item is prefetched so its payload is
+//  warm by the time it comes around. visitFn may unlink the item it's given, but no others.
+#define LL2VisitBatched_(type, ppListHead, listOffset, visitFn)         \
+    do {                                                                \
+        type * apRing_[LL_VISIT_BATCH];                                 \
+        int iRingOldest_ = 0;                                           \
+        int cRing_ = 0;                                                 \
+        type * pChase_ = *ppListHead;                                   \
+        while (pChase_ && cRing_ < LL_VISIT_BATCH)                      \
+        {                                                               \
+            LL_PREFETCH(pChase_);                                       \
+            apRing_[cRing_++] = pChase_;                                \
+            pChase_ = LL2Next_(type, pChase_, listOffset);              \
+        }                                                               \
+        while (cRing_)                                                  \
+        {                                                               \
+            type * pVisit_ = apRing_[iRingOldest_];                     \
+            if (pChase_)                                                \
+            {                                                           \
+                LL_PREFETCH(pChase_);                                   \
+                apRing_[iRingOldest_] = pChase_;                        \
+                pChase_ = LL2Next_(type, pChase_, listOffset);          \
+            }                                                           \
+            else                                                        \
+            {                                                           \
+                cRing_--;                                               \
+            }                                                           \
+            if (++iRingOldest_ == LL_VISIT_BATCH) iRingOldest_ = 0;     \
+            visitFn(pVisit_);                                           \
+        }                                                               \
+    } while(0)
+
+#define LL2VisitBatched(type, list, visitFn)                            \
+    LL2VisitBatched_(type, &list.pHead, list.offset, visitFn)
+
+#define LL2RefVisitBatched(type, listRef, visitFn)                      \
+    LL2VisitBatched_(type, listRef.ppHead, listRef.offset, visitFn)
+
+
+
+// NOTE - Do not try to use 'it' after calling this! Just let the loop run to the next iteration, at which
+//  point 'it' will work as you'd expect.
+#define LL2RemoveWhileIterating_(type, ppListHead, ppListTail, listOffset, it) \
+    do {                                                                \
+        if (it == *ppListHead)                                          \
+        {                                                               \
+            type * removedHead;                                         \
+            LL2RemoveHead_(type, ppListHead, ppListTail, listOffset, removedHead); \
+            (void)removedHead;                                          \
+            /* @Hack - Make 'it' point to a fake location where we know the LL2Next_ call in ForLL2_ will get the right pointer value to the head! */ \
+            unsigned char * pHeadAddress_ = (unsigned char *)ppListHead; \
+            LLOpaquePtr_(pHeadAddress_);                                \
+            it = (type *)(pHeadAddress_ - (listOffset + offsetof(type::LL2Node, pNext))); \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            type * itPrev = LL2Prev_(type, it, listOffset);             \
+            LL2Remove_(type, ppListHead, ppListTail, listOffset, it);   \
+            it = itPrev;                                                \
+        }                                                               \
+    } while (0)
+
+#define LL2RemoveWhileIterating(type, list, it)  \
+          LL2RemoveWhileIterating_(type, &list.pHead, &list.pTail, list.offset, it)
+
+#define LL2RefRemoveWhileIterating(type, listRef, it)                      \
+          LL2RemoveWhileIterating_(type, listRef.ppHead, listRef.ppTail, listRef.offset, it)
+
+
+// NOTE - This assumes that the newAddress has its intrusive pointers already set properly
+#define LL2Relocate_(type, ppListHead, ppListTail, listOffset, prevAddress, newAddress) \
+    do {                                                                \
+        if (*ppListHead == prevAddress)                                 \
+        {                                                               \
+            *ppListHead = newAddress;                                   \
+        }                                                               \
+        if (*ppListTail == prevAddress)                                 \
+        {                                                               \
+            *ppListTail = newAddress;                                   \
+        }                                                               \
+        type * prev_ = LL2Prev_(type, newAddress, listOffset);          \
+        if (prev_)                                                      \
+        {                                                               \
+            LL_ASSERT(LL2Next_(type, prev_, listOffset) == prevAddress); \
+            auto * prevNode_ = LL2NodePtr_(type, prev_, listOffset);    \
+            prevNode_->pNext = newAddress;                              \
+        }                                                               \
+        type * next_ = LL2Next_(type, newAddress, listOffset);          \
+        if (next_)                                                      \
+        {                                                               \
+            LL_ASSERT(LL2Prev_(type, next_, listOffset) == prevAddress); \
+            auto * nextNode_ = LL2NodePtr_(type, next_, listOffset);    \
+            nextNode_->pPrev = newAddress;                              \
+        }                                                               \
+        LL2InstrumentOp_(type, ppListHead, ppListTail, listOffset, Relocate); \
+    } while (0)
+
+#define LL2Relocate(type, list, prevAddress, newAddress) \
+    LL2Relocate_(type, &list.pHead, &list.pTail, list.offset, prevAddress, newAddress)
+
+#define LL2RefRelocate(type, listRef, prevAddress, newAddress)          \
+    LL2Relocate_(type, listRef.ppHead, listRef.ppTail, listRef.offset, prevAddress, newAddress)
+
+
+
+// NOTE - lessFn(pA, pB) should return true if pA belongs before pB. Stable, O(n log n), no allocation.
+//  Sorts on the pNext chain alone and then fixes up every pPrev in one final pass.
+#define LL2Sort_(type, ppListHead, ppListTail, listOffset, lessFn)      \
+    do {                                                                \
+        if (*ppListHead)                                                \
+        {                                                               \
+            LL2NodePtr_(type, *ppListTail, listOffset)->pNext = nullptr; \
+            LLSortChain_(type, (listOffset) + offsetof(type::LL2Node, pNext), *ppListHead, lessFn, *ppListHead); \
+            type * pFixPrev_ = (type *)LLEndOfList_;                    \
+            type * pFix_ = *ppListHead;                                 \
+            for (;;)                                                    \
+            {                                                           \
+                auto * pFixNode_ = LL2NodePtr_(type, pFix_, listOffset); \
+                pFixNode_->pPrev = pFixPrev_;                           \
+                if (!pFixNode_->pNext) break;                           \
+                pFixPrev_ = pFix_;                                      \
+                pFix_ = pFixNode_->pNext;                               \
+            }                                                           \
+            LL2NodePtr_(type, pFix_, listOffset)->pNext = (type *)LLEndOfList_; \
+            *ppListTail = pFix_;                                        \
+        }                                                               \
+        LL2InstrumentOp_(type, ppListHead, ppListTail, listOffset, Sort); \
+    } while(0)
+
+#define LL2Sort(type, list, lessFn)                                     \
+    LL2Sort_(type, &list.pHead, &list.pTail, list.offset, lessFn)
+
+#define LL2RefSort(type, listRef, lessFn)                               \
+    LL2Sort_(type, listRef.ppHead, listRef.ppTail, listRef.offset, lessFn)
+
+
+
+// NOTE - Both lists must already be sorted by lessFn. List 1 is cleared (like LL2Combine_). Stable: on ties, list 0's
+//  items come first.
+#define LL2MergeSorted_(type, ppList0Head, ppList0Tail, ppList1Head, ppList1Tail, listOffset, lessFn) \
+    do {                                                                \
+        if (LL2IsEmpty_(ppList0Head))                                   \
+        {                                                               \
+            *ppList0Head = *ppList1Head;                                \
+            *ppList0Tail = *ppList1Tail;                                \
+        }                                                               \
+        else if (!LL2IsEmpty_(ppList1Head))                             \
+        {                                                               \
+            type * pA_ = *ppList0Head;                                  \
+            type * pB_ = *ppList1Head;                                  \
+            type * pPrev_ = (type *)LLEndOfList_;                       \
+            type ** ppLink_ = ppList0Head;                              \
+            while (pA_ && pB_)                                          \
+            {                                                           \
+                type * pPick_;                                          \
+                if (lessFn(pB_, pA_))                                   \
+                {                                                       \
+                    pPick_ = pB_;                                       \
+                    pB_ = LL2Next_(type, pB_, listOffset);              \
+                }                                                       \
+                else                                                    \
+                {                                                       \
+                    pPick_ = pA_;                                       \
+                    pA_ = LL2Next_(type, pA_, listOffset);              \
+                }                                                       \
+                auto * pPickNode_ = LL2NodePtr_(type, pPick_, listOffset); \
+                *ppLink_ = pPick_;                                      \
+                pPickNode_->pPrev = pPrev_;                             \
+                ppLink_ = &pPickNode_->pNext;                           \
+                pPrev_ = pPick_;                                        \
+            }                                                           \
+            type * pRest_ = pA_ ? pA_ : pB_;                            \
+            *ppLink_ = pRest_;                                          \
+            LL2NodePtr_(type, pRest_, listOffset)->pPrev = pPrev_;      \
+            if (!pA_) *ppList0Tail = *ppList1Tail;                      \
+        }                                                               \
+        *ppList1Head = nullptr;                                         \
+        *ppList1Tail = nullptr;                                         \
+        LL2InstrumentOp_(type, ppList0Head, ppList0Tail, listOffset, Merge); \
+    } while(0)
+
+#define LL2MergeSorted(type, list0, list1, lessFn)                      \
+    LL2MergeSorted_(type, &list0.pHead, &list0.pTail, &list1.pHead, &list1.pTail, list0.offset, lessFn)
+
+#define LL2RefMergeSorted(type, listRef0, listRef1, lessFn)             \
+    LL2MergeSorted_(type, listRef0.ppHead, listRef0.ppTail, listRef1.ppHead, listRef1.ppTail, listRef0.offset, lessFn)
+
+
+// NOTE - Shared single pass behind LL2RemoveIf_, LL2Partition_ and LL2Unique_. isMove is evaluated for every item as
+//  pCur_, with pKeptTail_ the last item kept so far (nullptr before the first). Matching items are appended to the
+//  out list in order, or unlinked if ppOutHead is null. Survivors are only written where a removed run has to be
+//  skipped over, and every moved item's links are written once.
+#define LL2FilterCore_(type, ppListHead, ppListTail, listOffset, ppOutHead, ppOutTail, isMove) \
+    do {                                                                \
+        type ** ppFilterOutHead_ = (ppOutHead);                         \
+        type ** ppFilterOutTail_ = (ppOutTail);                         \
+        type * pOutTail_ = ppFilterOutHead_ ? *ppFilterOutTail_ : nullptr; \
+        type * pKeptTail_ = nullptr;                                    \
+        type * pCur_ = *ppListHead;                                     \
+        while (pCur_)                                                   \
+        {                                                               \
+            auto * curNode_ = LL2NodePtr_(type, pCur_, listOffset);     \
+            type * pNext_ = LL2Next_(type, pCur_, listOffset);          \
+            if (isMove)                                                 \
+            {                                                           \
+                if (!ppFilterOutHead_)                                  \
+                {                                                       \
+                    curNode_->pPrev = nullptr;                          \
+                    curNode_->pNext = nullptr;                          \
+                }                                                       \
+                else                                                    \
+                {                                                       \
+                    if (pOutTail_) LL2NodePtr_(type, pOutTail_, listOffset)->pNext = pCur_; \
+                    else *ppFilterOutHead_ = pCur_;                     \
+                    curNode_->pPrev = pOutTail_ ? pOutTail_ : (type *)LLEndOfList_; \
+                    pOutTail_ = pCur_;                                  \
+                }                                                       \
+            }                                                           \
+            else                                                        \
+            {                                                           \
+                type * pKeptPrev_ = pKeptTail_ ? pKeptTail_ : (type *)LLEndOfList_; \
+                if (curNode_->pPrev != pKeptPrev_)                      \
+                {                                                       \
+                    curNode_->pPrev = pKeptPrev_;                       \
+                    if (pKeptTail_) LL2NodePtr_(type, pKeptTail_, listOffset)->pNext = pCur_; \
+                    else *ppListHead = pCur_;                           \
+                }                                                       \
+                pKeptTail_ = pCur_;                                     \
+            }                                                           \
+            pCur_ = pNext_;                                             \
+        }                                                               \
+        if (pKeptTail_) LL2NodePtr_(type, pKeptTail_, listOffset)->pNext = (type *)LLEndOfList_; \
+        else *ppListHead = nullptr;                                     \
+        *ppListTail = pKeptTail_;                                       \
+        if (pOutTail_)                                                  \
+        {                                                               \
+            LL2NodePtr_(type, pOutTail_, listOffset)->pNext = (type *)LLEndOfList_; \
+            *ppFilterOutTail_ = pOutTail_;                              \
+        }                                                               \
+        LL2InstrumentOp_(type, ppListHead, ppListTail, listOffset, Filter); \
+    } while(0)
+
+
+
+// NOTE - Unlinks every item for which pred(pItem) is true, in a single pass. Replaces ForLL2 +
+//  LL2RemoveWhileIterating for filtering: no per-item LL2Remove_, and no rewriting of neighbours that get removed
+//  too.
+#define LL2RemoveIf_(type, ppListHead, ppListTail, listOffset, pred)    \
+    LL2FilterCore_(type, ppListHead, ppListTail, listOffset, nullptr, nullptr, pred(pCur_))
+
+#define LL2RemoveIf(type, list, pred)                                   \
+    LL2RemoveIf_(type, &list.pHead, &list.pTail, list.offset, pred)
+
+#define LL2RefRemoveIf(type, listRef, pred)                             \
+    LL2RemoveIf_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pred)
+
+
+
+// NOTE - Moves every item for which pred(pItem) is true to the tail of the out list (which may already hold items),
+//  in a single pass. Both lists keep their relative order.
+#define LL2Partition_(type, ppListHead, ppListTail, ppOutHead, ppOutTail, listOffset, pred) \
+    LL2FilterCore_(type, ppListHead, ppListTail, listOffset, ppOutHead, ppOutTail, pred(pCur_))
+
+#define LL2Partition(type, list, outList, pred)                         \
+    LL2Partition_(type, &list.pHead, &list.pTail, &outList.pHead, &outList.pTail, list.offset, pred)
+
+#define LL2RefPartition(type, listRef, outListRef, pred)                \
+    LL2Partition_(type, listRef.ppHead, listRef.ppTail, outListRef.ppHead, outListRef.ppTail, listRef.offset, pred)
+
+
+
+// NOTE - For sorted lists: drops every item that equalFn(pKept, pItem) says is equal to the item kept before it, so
+//  the first of each run of equal items survives. LL2UniqueInto_ moves the dropped items to the tail of the out list
+//  instead of unlinking them (e.g. to free them afterwards).
+#define LL2Unique_(type, ppListHead, ppListTail, listOffset, equalFn)   \
+    LL2FilterCore_(type, ppListHead, ppListTail, listOffset, nullptr, nullptr, pKeptTail_ && equalFn(pKeptTail_, pCur_))
+
+#define LL2Unique(type, list, equalFn)                                  \
+    LL2Unique_(type, &list.pHead, &list.pTail, list.offset, equalFn)
+
+#define LL2RefUnique(type, listRef, equalFn)                            \
+    LL2Unique_(type, listRef.ppHead, listRef.ppTail, listRef.offset, equalFn)
+
+#define LL2UniqueInto_(type, ppListHead, ppListTail, ppOutHead, ppOutTail, listOffset, equalFn) \
+    LL2FilterCore_(type, ppListHead, ppListTail, listOffset, ppOutHead, ppOutTail, pKeptTail_ && equalFn(pKeptTail_, pCur_))
+
+#define LL2UniqueInto(type, list, outList, equalFn)                     \
+    LL2UniqueInto_(type, &list.pHead, &list.pTail, &outList.pHead, &outList.pTail, list.offset, equalFn)
+
+#define LL2RefUniqueInto(type, listRef, outListRef, equalFn)            \
+    LL2UniqueInto_(type, listRef.ppHead, listRef.ppTail, outListRef.ppHead, outListRef.ppTail, listRef.offset, equalFn)
+
+
+
+
+//
+// Counted singly linked list
+//
+
+// NOTE - Opt-in variant of LL1 that keeps an element count and tags each linked node with the list it is on, so size,
+//  "which list is this item on" and "is it on this list" are all O(1). The counted node wraps an LL1Node (which must be
+//  its first member), so a counted list is also a valid LL1 list for every read-only LL1 macro (ForLL1_, LL1Next_, ...)
+//  using the counted list's offset. The owner tag is the address of the list's head pointer, which is the same
+//  whether you go through the list or a ref to it. Requires DefineLL1Node(type) in the same struct.
+//
+//  Since the tag is the list's own address, a non-empty counted list can't be copied or moved (e.g. by a
+//  std::vector growing): every item would still be tagged with the old address. Keep counted lists at a fixed
+//  address, or move only empty ones.
+//
+//  The same tag is why Combine is O(size of list 1) rather than O(1): every moved item has to be retagged with its
+//  new list, and there is no way to do that without visiting it.
+#define DefineLL1CountedNode(type)                                      \
+    struct LL1CountedNode                                               \
+    {                                                                   \
+        LL1Node link;                                                   \
+        const void * pOwner;                                            \
+    };                                                                  \
+    struct LL1CountedRef                                                \
+    {                                                                   \
+        struct type ** ppHead;                                          \
+        struct type ** ppTail;                                          \
+        uintptr_t * pCount;                                             \
+        uintptr_t offset;                                               \
+    }
+
+#define LL1CountedType(userId) LL1Counted_##userId
+
+#define DefineLL1Counted(type, linkMember, userId)                      \
+        struct LL1Counted_##userId                                      \
+        {                                                               \
+            struct type * pHead;                                        \
+            struct type * pTail;                                        \
+            uintptr_t count;                                            \
+            static const uintptr_t offset = offsetof(type, linkMember); \
+        };                                                              \
+
+#define LL1CountedMakeRef(listRefPtr, list)                             \
+    do {                                                                \
+        (listRefPtr)->ppHead = &list.pHead;                             \
+        (listRefPtr)->ppTail = &list.pTail;                             \
+        (listRefPtr)->pCount = &list.count;                             \
+        (listRefPtr)->offset = list.offset;                             \
+    } while(0)
+
+
+
+#define LL1CountedNodePtr_(type, pItem, listOffset)                     \
+    ((type::LL1CountedNode *)((unsigned char * )pItem + listOffset))
+
+#define LL1CountedNodePtr(type, list, pItem)                            \
+    LL1CountedNodePtr_(type, pItem, list.offset)
+
+#define LL1CountedRefNodePtr(type, listRef, pItem)                      \
+    LL1CountedNodePtr_(type, pItem, listRef.offset)
+
+
+
+#define LL1CountedCount_(pCount)                                        \
+    (*(pCount))
+
+#define LL1CountedCount(list)                                           \
+    LL1CountedCount_(&list.count)
+
+#define LL1CountedRefCount(listRef)                                     \
+    LL1CountedCount_(listRef.pCount)
+
+
+
+// NOTE - Returns an opaque tag for the list the item is on, or nullptr. Compare against LL1CountedOwnerTag(list).
+#define LL1CountedOwner_(type, pItem, listOffset)                       \
+    (LL1CountedNodePtr_(type, pItem, listOffset)->pOwner)
+
+#define LL1CountedOwner(type, list, pItem)                              \
+    LL1CountedOwner_(type, pItem, list.offset)
+
+#define LL1CountedRefOwner(type, listRef, pItem)                        \
+    LL1CountedOwner_(type, pItem, listRef.offset)
+
+#define LL1CountedOwnerTag(list)                                        \
+    ((const void *)&list.pHead)
+
+#define LL1CountedRefOwnerTag(listRef)                                  \
+    ((const void *)listRef.ppHead)
+
+
+
+#define LL1CountedIsItemOnList_(type, ppListHead, listOffset, pItem)    \
+    (LL1CountedOwner_(type, pItem, listOffset) == (const void *)(ppListHead))
+
+#define LL1CountedIsItemOnList(type, list, pItem)                       \
+    LL1CountedIsItemOnList_(type, &list.pHead, list.offset, pItem)
+
+#define LL1CountedRefIsItemOnList(type, listRef, pItem)                 \
+    LL1CountedIsItemOnList_(type, listRef.ppHead, listRef.offset, pItem)
+
+
+
+#define LL1CountedAddHead_(type, ppListHead, ppListTail, pCount, listOffset, pItem) \
+    do {                                                                \
+        if (LL1IsItemLinked_(type, pItem, listOffset))                  \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        LL1AddHead_(type, ppListHead, ppListTail, listOffset, pItem);   \
+        LL1CountedNodePtr_(type, pItem, listOffset)->pOwner = (const void *)(ppListHead); \
+        (*(pCount))++;                                                  \
+    } while(0)
+
+#define LL1CountedAddHead(type, list, pItem)                            \
+    LL1CountedAddHead_(type, &list.pHead, &list.pTail, &list.count, list.offset, pItem)
+
+#define LL1CountedRefAddHead(type, listRef, pItem)                      \
+    LL1CountedAddHead_(type, listRef.ppHead, listRef.ppTail, listRef.pCount, listRef.offset, pItem)
+
+#define LL1CountedAdd(type, list, pItem)                                \
+    LL1CountedAddHead(type, list, pItem)
+
+#define LL1CountedRefAdd(type, listRef, pItem)                          \
+    LL1CountedRefAddHead(type, listRef, pItem)
+
+
+
+#define LL1CountedAddTail_(type, ppListHead, ppListTail, pCount, listOffset, pItem) \
+    do {                                                                \
+        if (LL1IsItemLinked_(type, pItem, listOffset))                  \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        LL1AddTail_(type, ppListHead, ppListTail, listOffset, pItem);   \
+        LL1CountedNodePtr_(type, pItem, listOffset)->pOwner = (const void *)(ppListHead); \
+        (*(pCount))++;                                                  \
+    } while(0)
+
+#define LL1CountedAddTail(type, list, pItem)                            \
+    LL1CountedAddTail_(type, &list.pHead, &list.pTail, &list.count, list.offset, pItem)
+
+#define LL1CountedRefAddTail(type, listRef, pItem)                      \
+    LL1CountedAddTail_(type, listRef.ppHead, listRef.ppTail, listRef.pCount, listRef.offset, pItem)
+
+
+
+#define LL1CountedRemoveHead_(type, ppListHead, ppListTail, pCount, listOffset, pAssignTo) \
+    do {                                                                \
+        LL1RemoveHead_(type, ppListHead, ppListTail, listOffset, pAssignTo); \
+        if (pAssignTo)                                                  \
+        {                                                               \
+            LL1CountedNodePtr_(type, pAssignTo, listOffset)->pOwner = nullptr; \
+            (*(pCount))--;                                              \
+        }                                                               \
+    } while (0)
+
+#define LL1CountedRemoveHead(type, list, pAssignTo)                     \
+    LL1CountedRemoveHead_(type, &list.pHead, &list.pTail, &list.count, list.offset, pAssignTo)
+
+#define LL1CountedRefRemoveHead(type, listRef, pAssignTo)               \
+    LL1CountedRemoveHead_(type, listRef.ppHead, listRef.ppTail, listRef.pCount, listRef.offset, pAssignTo)
+
+
+
+#define LL1CountedInsertAfter_(type, ppListHead, ppListTail, pCount, listOffset, pItem, pItemPrev) \
+    do {                                                                \
+        if (LL1IsItemLinked_(type, pItem, listOffset))                  \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        LL_ASSERT(!(pItemPrev) || LL1CountedIsItemOnList_(type, ppListHead, listOffset, pItemPrev)); \
+        LL1InsertAfter_(type, ppListHead, ppListTail, listOffset, pItem, pItemPrev); \
+        LL1CountedNodePtr_(type, pItem, listOffset)->pOwner = (const void *)(ppListHead); \
+        (*(pCount))++;                                                  \
+    } while(0)
+
+#define LL1CountedInsertAfter(type, list, pItem, pItemPrev)             \
+    LL1CountedInsertAfter_(type, &list.pHead, &list.pTail, &list.count, list.offset, pItem, pItemPrev)
+
+#define LL1CountedRefInsertAfter(type, listRef, pItem, pItemPrev)       \
+    LL1CountedInsertAfter_(type, listRef.ppHead, listRef.ppTail, listRef.pCount, listRef.offset, pItem, pItemPrev)
+
+
+
+#define LL1CountedRemoveAfter_(type, ppListHead, ppListTail, pCount, listOffset, pItemPrev, pAssignTo) \
+    do {                                                                \
+        LL_ASSERT(!(pItemPrev) || LL1CountedIsItemOnList_(type, ppListHead, listOffset, pItemPrev)); \
+        LL1RemoveAfter_(type, ppListHead, ppListTail, listOffset, pItemPrev, pAssignTo); \
+        if (pAssignTo)                                                  \
+        {                                                               \
+            LL1CountedNodePtr_(type, pAssignTo, listOffset)->pOwner = nullptr; \
+            (*(pCount))--;                                              \
+        }                                                               \
+    } while (0)
+
+#define LL1CountedRemoveAfter(type, list, pItemPrev, pAssignTo)         \
+    LL1CountedRemoveAfter_(type, &list.pHead, &list.pTail, &list.count, list.offset, pItemPrev, pAssignTo)
+
+#define LL1CountedRefRemoveAfter(type, listRef, pItemPrev, pAssignTo)   \
+    LL1CountedRemoveAfter_(type, listRef.ppHead, listRef.ppTail, listRef.pCount, listRef.offset, pItemPrev, pAssignTo)
+
+
+
+// NOTE - O(n) like LL1Remove_, since the predecessor has to be found first. The owner check is still O(1), so
+//  removing an item that is linked on a *different* list is caught (and ignored) before the walk.
+#define LL1CountedRemove_(type, ppListHead, ppListTail, pCount, listOffset, pItem) \
+    do {                                                                \
+        if (!LL1CountedIsItemOnList_(type, ppListHead, listOffset, pItem)) \
+        {                                                               \
+            LL_ASSERT(!LL1IsItemLinked_(type, pItem, listOffset));      \
+            break;                                                      \
+        }                                                               \
+        LL1Remove_(type, ppListHead, ppListTail, listOffset, pItem);    \
+        LL1CountedNodePtr_(type, pItem, listOffset)->pOwner = nullptr;  \
+        (*(pCount))--;                                                  \
+    } while(0)
+
+#define LL1CountedRemove(type, list, pItem)                             \
+    LL1CountedRemove_(type, &list.pHead, &list.pTail, &list.count, list.offset, pItem)
+
+#define LL1CountedRefRemove(type, listRef, pItem)                       \
+    LL1CountedRemove_(type, listRef.ppHead, listRef.ppTail, listRef.pCount, listRef.offset, pItem)
+
+
+
+#define LL1CountedClear_(type, ppListHead, ppListTail, pCount, listOffset) \
+    do {                                                                \
+        while (*ppListHead)                                             \
+        {                                                               \
+            auto * pHeadNode_ = LL1CountedNodePtr_(type, *ppListHead, listOffset); \
+            auto * pHeadNext_ = LL1Next_(type, *ppListHead, listOffset); \
+            pHeadNode_->link = {};                                      \
+            pHeadNode_->pOwner = nullptr;                               \
+            *ppListHead = pHeadNext_;                                   \
+        }                                                               \
+        *ppListTail = nullptr;                                          \
+        *(pCount) = 0;                                                  \
+    } while(0)
+
+#define LL1CountedClear(type, list)                                     \
+    LL1CountedClear_(type, &list.pHead, &list.pTail, &list.count, list.offset)
+
+#define LL1CountedRefClear(type, listRef)                               \
+    LL1CountedClear_(type, listRef.ppHead, listRef.ppTail, listRef.pCount, listRef.offset)
+
+
+
+// NOTE - List 1 is cleared. Unlike the plain list, this is O(size of list 1) since every moved item gets its owner
+//  tag rewritten.
+#define LL1CountedCombine_(type, ppList0Head, ppList0Tail, pCount0, ppList1Head, ppList1Tail, pCount1, listOffset) \
+    do {                                                                \
+        ForLL1_(type, itMoved_, ppList1Head, listOffset)                \
+        {                                                               \
+            LL1CountedNodePtr_(type, itMoved_, listOffset)->pOwner = (const void *)(ppList0Head); \
+        }                                                               \
+        if (LL1IsEmpty_(ppList0Head))                                   \
+        {                                                               \
+            *ppList0Head = *ppList1Head;                                \
+            *ppList0Tail = *ppList1Tail;                                \
+        }                                                               \
+        else if (!LL1IsEmpty_(ppList1Head))                             \
+        {                                                               \
+            LL1NodePtr_(type, *ppList0Tail, listOffset)->pNext = *ppList1Head; \
+            *ppList0Tail = *ppList1Tail;                                \
+        }                                                               \
+        *ppList1Head = nullptr;                                         \
+        *ppList1Tail = nullptr;                                         \
+        *(pCount0) += *(pCount1);                                       \
+        *(pCount1) = 0;                                                 \
+    } while(0)
+
+#define LL1CountedCombine(type, list0, list1)                           \
+    LL1CountedCombine_(type, &list0.pHead, &list0.pTail, &list0.count, &list1.pHead, &list1.pTail, &list1.count, list0.offset)
+
+#define LL1CountedRefCombine(type, listRef0, listRef1)                  \
+    LL1CountedCombine_(type, listRef0.ppHead, listRef0.ppTail, listRef0.pCount, listRef1.ppHead, listRef1.ppTail, listRef1.pCount, listRef0.offset)
+
+
+
+#define ForLL1Counted(type, it, list)                                   \
+    ForLL1_(type, it, &list.pHead, list.offset)
+
+#define ForLL1CountedRef(type, it, listRef)                             \
+    ForLL1_(type, it, listRef.ppHead, listRef.offset)
+
+
+
+//
+// Counted doubly linked list
+//
+
+// NOTE - Opt-in variant of LL2 that keeps an element count and tags each linked node with the list it is on, so size,
+//  "which list is this item on" and "is it on this list" are all O(1). The counted node wraps an LL2Node (which must be
+//  its first member), so a counted list is also a valid LL2 list for every read-only LL2 macro (ForLL2_, LL2Next_, ...)
+//  using the counted list's offset. The owner tag is the address of the list's head pointer, which is the same
+//  whether you go through the list or a ref to it. Requires DefineLL2Node(type) in the same struct.
+//
+//  Since the tag is the list's own address, a non-empty counted list can't be copied or moved (e.g. by a
+//  std::vector growing): every item would still be tagged with the old address. Keep counted lists at a fixed
+//  address, or move only empty ones.
+//
+//  The same tag is why Combine is O(size of list 1) rather than O(1): every moved item has to be retagged with its
+//  new list, and there is no way to do that without visiting it.
+#define DefineLL2CountedNode(type)                                      \
+    struct LL2CountedNode                                               \
+    {                                                                   \
+        LL2Node link;                                                   \
+        const void * pOwner;                                            \
+    };                                                                  \
+    struct LL2CountedRef                                                \
+    {                                                                   \
+        struct type ** ppHead;                                          \
+        struct type ** ppTail;                                          \
+        uintptr_t * pCount;                                             \
+        uintptr_t offset;                                               \
+    }
+
+#define LL2CountedType(userId) LL2Counted_##userId
+
+#define DefineLL2Counted(type, linkMember, userId)                      \
+        struct LL2Counted_##userId                                      \
+        {                                                               \
+            struct type * pHead;                                        \
+            struct type * pTail;                                        \
+            uintptr_t count;                                            \
+            static const uintptr_t offset = offsetof(type, linkMember); \
+        };                                                              \
+
+#define LL2CountedMakeRef(listRefPtr, list)                             \
+    do {                                                                \
+        (listRefPtr)->ppHead = &list.pHead;                             \
+        (listRefPtr)->ppTail = &list.pTail;                             \
+        (listRefPtr)->pCount = &list.count;                             \
+        (listRefPtr)->offset = list.offset;                             \
+    } while(0)
+
+
+
+#define LL2CountedNodePtr_(type, pItem, listOffset)                     \
+    ((type::LL2CountedNode *)((unsigned char * )pItem + listOffset))
+
+#define LL2CountedNodePtr(type, list, pItem)                            \
+    LL2CountedNodePtr_(type, pItem, list.offset)
+
+#define LL2CountedRefNodePtr(type, listRef, pItem)                      \
+    LL2CountedNodePtr_(type, pItem, listRef.offset)
+
+
+
+#define LL2CountedCount_(pCount)                                        \
+    (*(pCount))
+
+#define LL2CountedCount(list)                                           \
+    LL2CountedCount_(&list.count)
+
+#define LL2CountedRefCount(listRef)                                     \
+    LL2CountedCount_(listRef.pCount)
+
+
+
+// NOTE - Returns an opaque tag for the list the item is on, or nullptr. Compare against LL2CountedOwnerTag(list).
+#define LL2CountedOwner_(type, pItem, listOffset)                       \
+    (LL2CountedNodePtr_(type, pItem, listOffset)->pOwner)
+
+#define LL2CountedOwner(type, list, pItem)                              \
+    LL2CountedOwner_(type, pItem, list.offset)
+
+#define LL2CountedRefOwner(type, listRef, pItem)                        \
+    LL2CountedOwner_(type, pItem, listRef.offset)
+
+#define LL2CountedOwnerTag(list)                                        \
+    ((const void *)&list.pHead)
+
+#define LL2CountedRefOwnerTag(listRef)                                  \
+    ((const void *)listRef.ppHead)
+
+
+
+#define LL2CountedIsItemOnList_(type, ppListHead, listOffset, pItem)    \
+    (LL2CountedOwner_(type, pItem, listOffset) == (const void *)(ppListHead))
+
+#define LL2CountedIsItemOnList(type, list, pItem)                       \
+    LL2CountedIsItemOnList_(type, &list.pHead, list.offset, pItem)
+
+#define LL2CountedRefIsItemOnList(type, listRef, pItem)                 \
+    LL2CountedIsItemOnList_(type, listRef.ppHead, listRef.offset, pItem)
+
+
+
+#define LL2CountedAddHead_(type, ppListHead, ppListTail, pCount, listOffset, pItem) \
+    do {                                                                \
+        if (LL2IsItemLinked_(type, pItem, listOffset))                  \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        LL2AddHead_(type, ppListHead, ppListTail, listOffset, pItem);   \
+        LL2CountedNodePtr_(type, pItem, listOffset)->pOwner = (const void *)(ppListHead); \
+        (*(pCount))++;                                                  \
+    } while(0)
+
+#define LL2CountedAddHead(type, list, pItem)                            \
+    LL2CountedAddHead_(type, &list.pHead, &list.pTail, &list.count, list.offset, pItem)
+
+#define LL2CountedRefAddHead(type, listRef, pItem)                      \
+    LL2CountedAddHead_(type, listRef.ppHead, listRef.ppTail, listRef.pCount, listRef.offset, pItem)
+
+#define LL2CountedAdd(type, list, pItem)                                \
+    LL2CountedAddHead(type, list, pItem)
+
+#define LL2CountedRefAdd(type, listRef, pItem)                          \
+    LL2CountedRefAddHead(type, listRef, pItem)
+
+
+
+#define LL2CountedAddTail_(type, ppListHead, ppListTail, pCount, listOffset, pItem) \
+    do {                                                                \
+        if (LL2IsItemLinked_(type, pItem, listOffset))                  \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        LL2AddTail_(type, ppListHead, ppListTail, listOffset, pItem);   \
+        LL2CountedNodePtr_(type, pItem, listOffset)->pOwner = (const void *)(ppListHead); \
+        (*(pCount))++;                                                  \
+    } while(0)
+
+#define LL2CountedAddTail(type, list, pItem)                            \
+    LL2CountedAddTail_(type, &list.pHead, &list.pTail, &list.count, list.offset, pItem)
+
+#define LL2CountedRefAddTail(type, listRef, pItem)                      \
+    LL2CountedAddTail_(type, listRef.ppHead, listRef.ppTail, listRef.pCount, listRef.offset, pItem)
+
+
+
+#define LL2CountedRemoveHead_(type, ppListHead, ppListTail, pCount, listOffset, pAssignTo) \
+    do {                                                                \
+        LL2RemoveHead_(type, ppListHead, ppListTail, listOffset, pAssignTo); \
+        if (pAssignTo)                                                  \
+        {                                                               \
+            LL2CountedNodePtr_(type, pAssignTo, listOffset)->pOwner = nullptr; \
+            (*(pCount))--;                                              \
+        }                                                               \
+    } while (0)
+
+#define LL2CountedRemoveHead(type, list, pAssignTo)                     \
+    LL2CountedRemoveHead_(type, &list.pHead, &list.pTail, &list.count, list.offset, pAssignTo)
+
+#define LL2CountedRefRemoveHead(type, listRef, pAssignTo)               \
+    LL2CountedRemoveHead_(type, listRef.ppHead, listRef.ppTail, listRef.pCount, listRef.offset, pAssignTo)
+
+
+
+// NOTE - Unlike LL2Remove_, removing an item that is linked on a *different* list is caught (and ignored) instead of
+//  corrupting both lists.
+#define LL2CountedRemove_(type, ppListHead, ppListTail, pCount, listOffset, pItem) \
+    do {                                                                \
+        if (!LL2CountedIsItemOnList_(type, ppListHead, listOffset, pItem)) \
+        {                                                               \
+            LL_ASSERT(!LL2IsItemLinked_(type, pItem, listOffset));      \
+            break;                                                      \
+        }                                                               \
+        LL2Remove_(type, ppListHead, ppListTail, listOffset, pItem);    \
+        LL2CountedNodePtr_(type, pItem, listOffset)->pOwner = nullptr;  \
+        (*(pCount))--;                                                  \
+    } while(0)
+
+#define LL2CountedRemove(type, list, pItem)                             \
+    LL2CountedRemove_(type, &list.pHead, &list.pTail, &list.count, list.offset, pItem)
+
+#define LL2CountedRefRemove(type, listRef, pItem)                       \
+    LL2CountedRemove_(type, listRef.ppHead, listRef.ppTail, listRef.pCount, listRef.offset, pItem)
+
+
+
+#define LL2CountedInsertBefore_(type, ppListHead, ppListTail, pCount, listOffset, pItem, pItemNext) \
+    do {                                                                \
+        if (LL2IsItemLinked_(type, pItem, listOffset))                  \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        LL_ASSERT(!(pItemNext) || LL2CountedIsItemOnList_(type, ppListHead, listOffset, pItemNext)); \
+        LL2InsertBefore_(type, ppListHead, ppListTail, listOffset, pItem, pItemNext); \
+        LL2CountedNodePtr_(type, pItem, listOffset)->pOwner = (const void *)(ppListHead); \
+        (*(pCount))++;                                                  \
+    } while(0)
+
+#define LL2CountedInsertBefore(type, list, pItem, pItemNext)            \
+    LL2CountedInsertBefore_(type, &list.pHead, &list.pTail, &list.count, list.offset, pItem, pItemNext)
+
+#define LL2CountedRefInsertBefore(type, listRef, pItem, pItemNext)      \
+    LL2CountedInsertBefore_(type, listRef.ppHead, listRef.ppTail, listRef.pCount, listRef.offset, pItem, pItemNext)
+
+
+
+#define LL2CountedRemoveTail_(type, ppListHead, ppListTail, pCount, listOffset, pAssignTo) \
+    do {                                                                \
+        LL2RemoveTail_(type, ppListHead, ppListTail, listOffset, pAssignTo); \
+        if (pAssignTo)                                                  \
+        {                                                               \
+            LL2CountedNodePtr_(type, pAssignTo, listOffset)->pOwner = nullptr; \
+            (*(pCount))--;                                              \
+        }                                                               \
+    } while (0)
+
+#define LL2CountedRemoveTail(type, list, pAssignTo)                     \
+    LL2CountedRemoveTail_(type, &list.pHead, &list.pTail, &list.count, list.offset, pAssignTo)
+
+#define LL2CountedRefRemoveTail(type, listRef, pAssignTo)               \
+    LL2CountedRemoveTail_(type, listRef.ppHead, listRef.ppTail, listRef.pCount, listRef.offset, pAssignTo)
+
+
+
+// NOTE - Do not try to use 'it' after calling this! Same rules as LL2RemoveWhileIterating_.
+#define LL2CountedRemoveWhileIterating_(type, ppListHead, ppListTail, pCount, listOffset, it) \
+    do {                                                                \
+        auto * countedNode_ = LL2CountedNodePtr_(type, it, listOffset); \
+        LL2RemoveWhileIterating_(type, ppListHead, ppListTail, listOffset, it); \
+        countedNode_->pOwner = nullptr;                                 \
+        (*(pCount))--;                                                  \
+    } while (0)
+
+#define LL2CountedRemoveWhileIterating(type, list, it)                  \
+    LL2CountedRemoveWhileIterating_(type, &list.pHead, &list.pTail, &list.count, list.offset, it)
+
+#define LL2CountedRefRemoveWhileIterating(type, listRef, it)            \
+    LL2CountedRemoveWhileIterating_(type, listRef.ppHead, listRef.ppTail, listRef.pCount, listRef.offset, it)
+
+
+
+#define LL2CountedRelocate(type, list, prevAddress, newAddress)         \
+    LL2Relocate_(type, &list.pHead, &list.pTail, list.offset, prevAddress, newAddress)
+
+#define LL2CountedRefRelocate(type, listRef, prevAddress, newAddress)   \
+    LL2Relocate_(type, listRef.ppHead, listRef.ppTail, listRef.offset, prevAddress, newAddress)
+
+
+
+#define LL2CountedClear_(type, ppListHead, ppListTail, pCount, listOffset) \
+    do {                                                                \
+        while (*ppListHead)                                             \
+        {                                                               \
+            auto * pHeadNode_ = LL2CountedNodePtr_(type, *ppListHead, listOffset); \
+            auto * pHeadNext_ = LL2Next_(type, *ppListHead, listOffset); \
+            pHeadNode_->link = {};                                      \
+            pHeadNode_->pOwner = nullptr;                               \
+            *ppListHead = pHeadNext_;                                   \
+        }                                                               \
+        *ppListTail = nullptr;                                          \
+        *(pCount) = 0;                                                  \
+    } while(0)
+
+#define LL2CountedClear(type, list)                                     \
+    LL2CountedClear_(type, &list.pHead, &list.pTail, &list.count, list.offset)
+
+#define LL2CountedRefClear(type, listRef)                               \
+    LL2CountedClear_(type, listRef.ppHead, listRef.ppTail, listRef.pCount, listRef.offset)
+
+
+
+// NOTE - List 1 is cleared. Unlike LL2Combine_, this is O(size of list 1) since every moved item gets its owner
+//  tag rewritten.
+#define LL2CountedCombine_(type, ppList0Head, ppList0Tail, pCount0, ppList1Head, ppList1Tail, pCount1, listOffset) \
+    do {                                                                \
+        ForLL2_(type, itMoved_, ppList1Head, listOffset)                \
+        {                                                               \
+            LL2CountedNodePtr_(type, itMoved_, listOffset)->pOwner = (const void *)(ppList0Head); \
+        }                                                               \
+        if (LL2IsEmpty_(ppList0Head))                                   \
+        {                                                               \
+            *ppList0Head = *ppList1Head;                                \
+            *ppList0Tail = *ppList1Tail;                                \
+        }                                                               \
+        else if (!LL2IsEmpty_(ppList1Head))                             \
+        {                                                               \
+            LL2NodePtr_(type, *ppList0Tail, listOffset)->pNext = *ppList1Head; \
+            LL2NodePtr_(type, *ppList1Head, listOffset)->pPrev = *ppList0Tail; \
+            *ppList0Tail = *ppList1Tail;                                \
+        }                                                               \
+        *ppList1Head = nullptr;                                         \
+        *ppList1Tail = nullptr;                                         \
+        *(pCount0) += *(pCount1);                                       \
+        *(pCount1) = 0;                                                 \
+    } while(0)
+
+#define LL2CountedCombine(type, list0, list1)                           \
+    LL2CountedCombine_(type, &list0.pHead, &list0.pTail, &list0.count, &list1.pHead, &list1.pTail, &list1.count, list0.offset)
+
+#define LL2CountedRefCombine(type, listRef0, listRef1)                  \
+    LL2CountedCombine_(type, listRef0.ppHead, listRef0.ppTail, listRef0.pCount, listRef1.ppHead, listRef1.ppTail, listRef1.pCount, listRef0.offset)
+
+
+
+#define ForLL2Counted(type, it, list)                                   \
+    ForLL2_(type, it, &list.pHead, list.offset)
+
+#define ForLL2CountedRef(type, it, listRef)                             \
+    ForLL2_(type, it, listRef.ppHead, listRef.offset)
+
+
+
+//
+// Generation-cleared singly linked list
+//
+
+// NOTE - Opt-in variant of LL1 where Clear is O(1). The list keeps a generation counter and every node records the
+//  counter's address and value at the time it was linked. Clearing just drops the head/tail and bumps the counter,
+//  which turns every node that was on the list stale at once without touching them. Stale nodes still hold old
+//  pNext values, so use LL1GenIsItemLinked (not LL1IsItemLinked) on these items. The add macros forget a stale
+//  node's old links before relinking it, so the double-add asserts keep working.
+//
+//  The gen node wraps an LL1Node (which must be its first member), so a gen list is also a valid LL1 list for every
+//  read-only LL1 macro (ForLL1_, LL1Next_, ...) using the gen list's offset. Nodes point at the list's counter, so the
+//  list has to outlive any LL1GenIsItemLinked query on items that were linked to it. Requires DefineLL1Node(type) in
+//  the same struct.
+//
+//  For the same reason a gen list can't be copied or moved (e.g. by a std::vector growing) while it has items: they
+//  would still point at the old counter, and look stale or, worse, linked to whatever reuses that memory. Keep gen
+//  lists at a fixed address, or move only empty ones.
+//
+//  Combine is the one operation that is slower than on a plain list: the moved items have to be restamped with list 0's
+//  counter, so it is O(size of list 1) instead of O(1).
+#define DefineLL1GenNode(type)                                          \
+    struct LL1GenNode                                                   \
+    {                                                                   \
+        LL1Node link;                                                   \
+        const uintptr_t * pGen;                                         \
+        uintptr_t gen;                                                  \
+    };                                                                  \
+    struct LL1GenRef                                                    \
+    {                                                                   \
+        struct type ** ppHead;                                          \
+        struct type ** ppTail;                                          \
+        uintptr_t * pGen;                                               \
+        uintptr_t offset;                                               \
+    }
+
+#define LL1GenType(userId) LL1Gen_##userId
+
+#define DefineLL1Gen(type, linkMember, userId)                          \
+        struct LL1Gen_##userId                                          \
+        {                                                               \
+            struct type * pHead;                                        \
+            struct type * pTail;                                        \
+            uintptr_t gen;                                              \
+            static const uintptr_t offset = offsetof(type, linkMember); \
+        };
+
+#define LL1GenMakeRef(listRefPtr, list)                                 \
+    do {                                                                \
+        (listRefPtr)->ppHead = &list.pHead;                             \
+        (listRefPtr)->ppTail = &list.pTail;                             \
+        (listRefPtr)->pGen = &list.gen;                                 \
+        (listRefPtr)->offset = list.offset;                             \
+    } while(0)
+
+
+
+#define LL1GenNodePtr_(type, pItem, listOffset)                         \
+    ((type::LL1GenNode *)((unsigned char * )pItem + listOffset))
+
+#define LL1GenNodePtr(type, list, pItem)                                \
+    LL1GenNodePtr_(type, pItem, list.offset)
+
+#define LL1GenRefNodePtr(type, listRef, pItem)                          \
+    LL1GenNodePtr_(type, pItem, listRef.offset)
+
+
+
+#define LL1GenIsItemLinked_(type, pItem, listOffset)                    \
+    (LL1GenNodePtr_(type, pItem, listOffset)->pGen && *LL1GenNodePtr_(type, pItem, listOffset)->pGen == LL1GenNodePtr_(type, pItem, listOffset)->gen)
+
+#define LL1GenIsItemLinked(type, list, pItem)                           \
+    LL1GenIsItemLinked_(type, pItem, list.offset)
+
+#define LL1GenRefIsItemLinked(type, listRef, pItem)                     \
+    LL1GenIsItemLinked_(type, pItem, listRef.offset)
+
+
+
+#define LL1GenIsItemOnList_(type, pListGen, listOffset, pItem)          \
+    (LL1GenNodePtr_(type, pItem, listOffset)->pGen == (pListGen) && *(pListGen) == LL1GenNodePtr_(type, pItem, listOffset)->gen)
+
+#define LL1GenIsItemOnList(type, list, pItem)                           \
+    LL1GenIsItemOnList_(type, &list.gen, list.offset, pItem)
+
+#define LL1GenRefIsItemOnList(type, listRef, pItem)                     \
+    LL1GenIsItemOnList_(type, listRef.pGen, listRef.offset, pItem)
+
+
+
+#define LL1GenAddHead_(type, ppListHead, ppListTail, pListGen, listOffset, pItem) \
+    do {                                                                \
+        auto * genNode_ = LL1GenNodePtr_(type, pItem, listOffset);      \
+        if (LL1GenIsItemLinked_(type, pItem, listOffset))               \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        genNode_->link = {};                                            \
+        LL1AddHead_(type, ppListHead, ppListTail, listOffset, pItem);   \
+        genNode_->pGen = (pListGen);                                    \
+        genNode_->gen = *(pListGen);                                    \
+    } while(0)
+
+#define LL1GenAddHead(type, list, pItem)                                \
+    LL1GenAddHead_(type, &list.pHead, &list.pTail, &list.gen, list.offset, pItem)
+
+#define LL1GenRefAddHead(type, listRef, pItem)                          \
+    LL1GenAddHead_(type, listRef.ppHead, listRef.ppTail, listRef.pGen, listRef.offset, pItem)
+
+#define LL1GenAdd(type, list, pItem)                                    \
+    LL1GenAddHead(type, list, pItem)
+
+#define LL1GenRefAdd(type, listRef, pItem)                              \
+    LL1GenRefAddHead(type, listRef, pItem)
+
+
+
+#define LL1GenAddTail_(type, ppListHead, ppListTail, pListGen, listOffset, pItem) \
+    do {                                                                \
+        auto * genNode_ = LL1GenNodePtr_(type, pItem, listOffset);      \
+        if (LL1GenIsItemLinked_(type, pItem, listOffset))               \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        genNode_->link = {};                                            \
+        LL1AddTail_(type, ppListHead, ppListTail, listOffset, pItem);   \
+        genNode_->pGen = (pListGen);                                    \
+        genNode_->gen = *(pListGen);                                    \
+    } while(0)
+
+#define LL1GenAddTail(type, list, pItem)                                \
+    LL1GenAddTail_(type, &list.pHead, &list.pTail, &list.gen, list.offset, pItem)
+
+#define LL1GenRefAddTail(type, listRef, pItem)                          \
+    LL1GenAddTail_(type, listRef.ppHead, listRef.ppTail, listRef.pGen, listRef.offset, pItem)
+
+
+
+#define LL1GenRemoveHead_(type, ppListHead, ppListTail, listOffset, pAssignTo) \
+    do {                                                                \
+        LL1RemoveHead_(type, ppListHead, ppListTail, listOffset, pAssignTo); \
+        if (pAssignTo) LL1GenNodePtr_(type, pAssignTo, listOffset)->pGen = nullptr; \
+    } while (0)
+
+#define LL1GenRemoveHead(type, list, pAssignTo)                         \
+    LL1GenRemoveHead_(type, &list.pHead, &list.pTail, list.offset, pAssignTo)
+
+#define LL1GenRefRemoveHead(type, listRef, pAssignTo)                   \
+    LL1GenRemoveHead_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pAssignTo)
+
+
+
+#define LL1GenInsertAfter_(type, ppListHead, ppListTail, pListGen, listOffset, pItem, pItemPrev) \
+    do {                                                                \
+        auto * genNode_ = LL1GenNodePtr_(type, pItem, listOffset);      \
+        if (LL1GenIsItemLinked_(type, pItem, listOffset))               \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        LL_ASSERT(!(pItemPrev) || LL1GenIsItemOnList_(type, pListGen, listOffset, pItemPrev)); \
+        genNode_->link = {};                                            \
+        LL1InsertAfter_(type, ppListHead, ppListTail, listOffset, pItem, pItemPrev); \
+        genNode_->pGen = (pListGen);                                    \
+        genNode_->gen = *(pListGen);                                    \
+    } while(0)
+
+#define LL1GenInsertAfter(type, list, pItem, pItemPrev)                 \
+    LL1GenInsertAfter_(type, &list.pHead, &list.pTail, &list.gen, list.offset, pItem, pItemPrev)
+
+#define LL1GenRefInsertAfter(type, listRef, pItem, pItemPrev)           \
+    LL1GenInsertAfter_(type, listRef.ppHead, listRef.ppTail, listRef.pGen, listRef.offset, pItem, pItemPrev)
+
+
+
+#define LL1GenRemoveAfter_(type, ppListHead, ppListTail, pListGen, listOffset, pItemPrev, pAssignTo) \
+    do {                                                                \
+        LL_ASSERT(!(pItemPrev) || LL1GenIsItemOnList_(type, pListGen, listOffset, pItemPrev)); \
+        LL1RemoveAfter_(type, ppListHead, ppListTail, listOffset, pItemPrev, pAssignTo); \
+        if (pAssignTo) LL1GenNodePtr_(type, pAssignTo, listOffset)->pGen = nullptr; \
+    } while (0)
+
+#define LL1GenRemoveAfter(type, list, pItemPrev, pAssignTo)             \
+    LL1GenRemoveAfter_(type, &list.pHead, &list.pTail, &list.gen, list.offset, pItemPrev, pAssignTo)
+
+#define LL1GenRefRemoveAfter(type, listRef, pItemPrev, pAssignTo)       \
+    LL1GenRemoveAfter_(type, listRef.ppHead, listRef.ppTail, listRef.pGen, listRef.offset, pItemPrev, pAssignTo)
+
+
+
+// NOTE - O(n) like LL1Remove_, since the predecessor has to be found first. Removing a stale item, or one that is
+//  linked on a different list, is caught (and ignored) before the walk.
+#define LL1GenRemove_(type, ppListHead, ppListTail, pListGen, listOffset, pItem) \
+    do {                                                                \
+        if (!LL1GenIsItemOnList_(type, pListGen, listOffset, pItem))    \
+        {                                                               \
+            LL_ASSERT(!LL1GenIsItemLinked_(type, pItem, listOffset));   \
+            break;                                                      \
+        }                                                               \
+        LL1Remove_(type, ppListHead, ppListTail, listOffset, pItem);    \
+        LL1GenNodePtr_(type, pItem, listOffset)->pGen = nullptr;        \
+    } while(0)
+
+#define LL1GenRemove(type, list, pItem)                                 \
+    LL1GenRemove_(type, &list.pHead, &list.pTail, &list.gen, list.offset, pItem)
+
+#define LL1GenRefRemove(type, listRef, pItem)                           \
+    LL1GenRemove_(type, listRef.ppHead, listRef.ppTail, listRef.pGen, listRef.offset, pItem)
+
+
+
+// NOTE - O(1), no node is touched
+#define LL1GenClear_(ppListHead, ppListTail, pListGen)                  \
+    do {                                                                \
+        *(ppListHead) = nullptr;                                        \
+        *(ppListTail) = nullptr;                                        \
+        (*(pListGen))++;                                                \
+    } while(0)
+
+#define LL1GenClear(type, list)                                         \
+    LL1GenClear_(&list.pHead, &list.pTail, &list.gen)
+
+#define LL1GenRefClear(type, listRef)                                   \
+    LL1GenClear_(listRef.ppHead, listRef.ppTail, listRef.pGen)
+
+
+
+#define LL1GenIsEmpty(list)                                             \
+    LL1IsEmpty_(&list.pHead)
+
+#define LL1GenRefIsEmpty(listRef)                                       \
+    LL1IsEmpty_(listRef.ppHead)
+
+
+
+// NOTE - List 1 is cleared. Every moved item has to be restamped with list 0's generation, so this is O(size of
+//  list 1).
+#define LL1GenCombine_(type, ppList0Head, ppList0Tail, pList0Gen, ppList1Head, ppList1Tail, listOffset) \
+    do {                                                                \
+        ForLL1_(type, itMoved_, ppList1Head, listOffset)                \
+        {                                                               \
+            LL1GenNodePtr_(type, itMoved_, listOffset)->pGen = (pList0Gen); \
+            LL1GenNodePtr_(type, itMoved_, listOffset)->gen = *(pList0Gen); \
+        }                                                               \
+        LL1Combine_(type, ppList0Head, ppList0Tail, ppList1Head, ppList1Tail, listOffset); \
+    } while(0)
+
+#define LL1GenCombine(type, list0, list1)                               \
+    LL1GenCombine_(type, &list0.pHead, &list0.pTail, &list0.gen, &list1.pHead, &list1.pTail, list0.offset)
+
+#define LL1GenRefCombine(type, listRef0, listRef1)                      \
+    LL1GenCombine_(type, listRef0.ppHead, listRef0.ppTail, listRef0.pGen, listRef1.ppHead, listRef1.ppTail, listRef0.offset)
+
+
+
+#define ForLL1Gen(type, it, list)                                       \
+    ForLL1_(type, it, &list.pHead, list.offset)
+
+#define ForLL1GenRef(type, it, listRef)                                 \
+    ForLL1_(type, it, listRef.ppHead, listRef.offset)
+
+
+
+//
+// Generation-cleared doubly linked list
+//
+
+// NOTE - Opt-in variant of LL2 where Clear is O(1). The list keeps a generation counter and every node records the
+//  counter's address and value at the time it was linked. Clearing just drops the head/tail and bumps the counter,
+//  which turns every node that was on the list stale at once without touching them. Stale nodes still hold old
+//  pPrev/pNext values, so use LL2GenIsItemLinked (not LL2IsItemLinked) on these items. The add macros forget a stale
+//  node's old links before relinking it, so the double-add asserts keep working.
+//
+//  The gen node wraps an LL2Node (which must be its first member), so a gen list is also a valid LL2 list for every
+//  read-only LL2 macro (ForLL2_, LL2Next_, ...) using the gen list's offset. Nodes point at the list's counter, so the
+//  list has to outlive any LL2GenIsItemLinked query on items that were linked to it. Requires DefineLL2Node(type) in
+//  the same struct.
+//
+//  For the same reason a gen list can't be copied or moved (e.g. by a std::vector growing) while it has items: they
+//  would still point at the old counter, and look stale or, worse, linked to whatever reuses that memory. Keep gen
+//  lists at a fixed address, or move only empty ones.
+//
+//  Combine is the one operation that is slower than on a plain list: the moved items have to be restamped with list 0's
+//  counter, so it is O(size of list 1) instead of O(1).
+#define DefineLL2GenNode(type)                                          \
+    struct LL2GenNode                                                   \
+    {                                                                   \
+        LL2Node link;                                                   \
+        const uintptr_t * pGen;                                         \
+        uintptr_t gen;                                                  \
+    };                                                                  \
+    struct LL2GenRef                                                    \
+    {                                                                   \
+        struct type ** ppHead;                                          \
+        struct type ** ppTail;                                          \
+        uintptr_t * pGen;                                               \
+        uintptr_t offset;                                               \
+    }
+
+#define LL2GenType(userId) LL2Gen_##userId
+
+#define DefineLL2Gen(type, linkMember, userId)                          \
+        struct LL2Gen_##userId                                          \
+        {                                                               \
+            struct type * pHead;                                        \
+            struct type * pTail;                                        \
+            uintptr_t gen;                                              \
+            static const uintptr_t offset = offsetof(type, linkMember); \
+        };
+
+#define LL2GenMakeRef(listRefPtr, list)                                 \
+    do {                                                                \
+        (listRefPtr)->ppHead = &list.pHead;                             \
+        (listRefPtr)->ppTail = &list.pTail;                             \
+        (listRefPtr)->pGen = &list.gen;                                 \
+        (listRefPtr)->offset = list.offset;                             \
+    } while(0)
+
+
+
+#define LL2GenNodePtr_(type, pItem, listOffset)                         \
+    ((type::LL2GenNode *)((unsigned char * )pItem + listOffset))
+
+#define LL2GenNodePtr(type, list, pItem)                                \
+    LL2GenNodePtr_(type, pItem, list.offset)
+
+#define LL2GenRefNodePtr(type, listRef, pItem)                          \
+    LL2GenNodePtr_(type, pItem, listRef.offset)
+
+
+
+#define LL2GenIsItemLinked_(type, pItem, listOffset)                    \
+    (LL2GenNodePtr_(type, pItem, listOffset)->pGen && *LL2GenNodePtr_(type, pItem, listOffset)->pGen == LL2GenNodePtr_(type, pItem, listOffset)->gen)
+
+#define LL2GenIsItemLinked(type, list, pItem)                           \
+    LL2GenIsItemLinked_(type, pItem, list.offset)
+
+#define LL2GenRefIsItemLinked(type, listRef, pItem)                     \
+    LL2GenIsItemLinked_(type, pItem, listRef.offset)
+
+
+
+#define LL2GenIsItemOnList_(type, pListGen, listOffset, pItem)          \
+    (LL2GenNodePtr_(type, pItem, listOffset)->pGen == (pListGen) && *(pListGen) == LL2GenNodePtr_(type, pItem, listOffset)->gen)
+
+#define LL2GenIsItemOnList(type, list, pItem)                           \
+    LL2GenIsItemOnList_(type, &list.gen, list.offset, pItem)
+
+#define LL2GenRefIsItemOnList(type, listRef, pItem)                     \
+    LL2GenIsItemOnList_(type, listRef.pGen, listRef.offset, pItem)
+
+
+
+#define LL2GenAddHead_(type, ppListHead, ppListTail, pListGen, listOffset, pItem) \
+    do {                                                                \
+        auto * genNode_ = LL2GenNodePtr_(type, pItem, listOffset);      \
+        if (LL2GenIsItemLinked_(type, pItem, listOffset))               \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        genNode_->link = {};                                            \
+        LL2AddHead_(type, ppListHead, ppListTail, listOffset, pItem);   \
+        genNode_->pGen = (pListGen);                                    \
+        genNode_->gen = *(pListGen);                                    \
+    } while(0)
+
+#define LL2GenAddHead(type, list, pItem)                                \
+    LL2GenAddHead_(type, &list.pHead, &list.pTail, &list.gen, list.offset, pItem)
+
+#define LL2GenRefAddHead(type, listRef, pItem)                          \
+    LL2GenAddHead_(type, listRef.ppHead, listRef.ppTail, listRef.pGen, listRef.offset, pItem)
+
+#define LL2GenAdd(type, list, pItem)                                    \
+    LL2GenAddHead(type, list, pItem)
+
+#define LL2GenRefAdd(type, listRef, pItem)                              \
+    LL2GenRefAddHead(type, listRef, pItem)
+
+
+
+#define LL2GenAddTail_(type, ppListHead, ppListTail, pListGen, listOffset, pItem) \
+    do {                                                                \
+        auto * genNode_ = LL2GenNodePtr_(type, pItem, listOffset);      \
+        if (LL2GenIsItemLinked_(type, pItem, listOffset))               \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        genNode_->link = {};                                            \
+        LL2AddTail_(type, ppListHead, ppListTail, listOffset, pItem);   \
+        genNode_->pGen = (pListGen);                                    \
+        genNode_->gen = *(pListGen);                                    \
+    } while(0)
+
+#define LL2GenAddTail(type, list, pItem)                                \
+    LL2GenAddTail_(type, &list.pHead, &list.pTail, &list.gen, list.offset, pItem)
+
+#define LL2GenRefAddTail(type, listRef, pItem)                          \
+    LL2GenAddTail_(type, listRef.ppHead, listRef.ppTail, listRef.pGen, listRef.offset, pItem)
+
+
+
+#define LL2GenInsertBefore_(type, ppListHead, ppListTail, pListGen, listOffset, pItem, pItemNext) \
+    do {                                                                \
+        auto * genNode_ = LL2GenNodePtr_(type, pItem, listOffset);      \
+        if (LL2GenIsItemLinked_(type, pItem, listOffset))               \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        LL_ASSERT(!(pItemNext) || LL2GenIsItemOnList_(type, pListGen, listOffset, pItemNext)); \
+        genNode_->link = {};                                            \
+        LL2InsertBefore_(type, ppListHead, ppListTail, listOffset, pItem, pItemNext); \
+        genNode_->pGen = (pListGen);                                    \
+        genNode_->gen = *(pListGen);                                    \
+    } while(0)
+
+#define LL2GenInsertBefore(type, list, pItem, pItemNext)                \
+    LL2GenInsertBefore_(type, &list.pHead, &list.pTail, &list.gen, list.offset, pItem, pItemNext)
+
+#define LL2GenRefInsertBefore(type, listRef, pItem, pItemNext)          \
+    LL2GenInsertBefore_(type, listRef.ppHead, listRef.ppTail, listRef.pGen, listRef.offset, pItem, pItemNext)
+
+
+
+// NOTE - Removing a stale item, or one that is linked on a different list, is caught (and ignored)
+#define LL2GenRemove_(type, ppListHead, ppListTail, pListGen, listOffset, pItem) \
+    do {                                                                \
+        if (!LL2GenIsItemOnList_(type, pListGen, listOffset, pItem))    \
+        {                                                               \
+            LL_ASSERT(!LL2GenIsItemLinked_(type, pItem, listOffset));   \
+            break;                                                      \
+        }                                                               \
+        LL2Remove_(type, ppListHead, ppListTail, listOffset, pItem);    \
+        LL2GenNodePtr_(type, pItem, listOffset)->pGen = nullptr;        \
+    } while(0)
+
+#define LL2GenRemove(type, list, pItem)                                 \
+    LL2GenRemove_(type, &list.pHead, &list.pTail, &list.gen, list.offset, pItem)
+
+#define LL2GenRefRemove(type, listRef, pItem)                           \
+    LL2GenRemove_(type, listRef.ppHead, listRef.ppTail, listRef.pGen, listRef.offset, pItem)
+
+
+
+#define LL2GenRemoveHead_(type, ppListHead, ppListTail, listOffset, pAssignTo) \
+    do {                                                                \
+        LL2RemoveHead_(type, ppListHead, ppListTail, listOffset, pAssignTo); \
+        if (pAssignTo) LL2GenNodePtr_(type, pAssignTo, listOffset)->pGen = nullptr; \
+    } while (0)
+
+#define LL2GenRemoveHead(type, list, pAssignTo)                         \
+    LL2GenRemoveHead_(type, &list.pHead, &list.pTail, list.offset, pAssignTo)
+
+#define LL2GenRefRemoveHead(type, listRef, pAssignTo)                   \
+    LL2GenRemoveHead_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pAssignTo)
+
+
+
+#define LL2GenRemoveTail_(type, ppListHead, ppListTail, listOffset, pAssignTo) \
+    do {                                                                \
+        LL2RemoveTail_(type, ppListHead, ppListTail, listOffset, pAssignTo); \
+        if (pAssignTo) LL2GenNodePtr_(type, pAssignTo, listOffset)->pGen = nullptr; \
+    } while (0)
+
+#define LL2GenRemoveTail(type, list, pAssignTo)                         \
+    LL2GenRemoveTail_(type, &list.pHead, &list.pTail, list.offset, pAssignTo)
+
+#define LL2GenRefRemoveTail(type, listRef, pAssignTo)                   \
+    LL2GenRemoveTail_(type, listRef.ppHead, listRef.ppTail, listRef.offset, pAssignTo)
+
+
+
+// NOTE - Do not try to use 'it' after calling this! Same rules as LL2RemoveWhileIterating_.
+#define LL2GenRemoveWhileIterating_(type, ppListHead, ppListTail, listOffset, it) \
+    do {                                                                \
+        auto * genNode_ = LL2GenNodePtr_(type, it, listOffset);         \
+        LL2RemoveWhileIterating_(type, ppListHead, ppListTail, listOffset, it); \
+        genNode_->pGen = nullptr;                                       \
+    } while (0)
+
+#define LL2GenRemoveWhileIterating(type, list, it)                      \
+    LL2GenRemoveWhileIterating_(type, &list.pHead, &list.pTail, list.offset, it)
+
+#define LL2GenRefRemoveWhileIterating(type, listRef, it)                \
+    LL2GenRemoveWhileIterating_(type, listRef.ppHead, listRef.ppTail, listRef.offset, it)
+
+
+
+// NOTE - O(1), no node is touched
+#define LL2GenClear_(ppListHead, ppListTail, pListGen)                  \
+    do {                                                                \
+        *(ppListHead) = nullptr;                                        \
+        *(ppListTail) = nullptr;                                        \
+        (*(pListGen))++;                                                \
+    } while(0)
+
+#define LL2GenClear(type, list)                                         \
+    LL2GenClear_(&list.pHead, &list.pTail, &list.gen)
+
+#define LL2GenRefClear(type, listRef)                                   \
+    LL2GenClear_(listRef.ppHead, listRef.ppTail, listRef.pGen)
+
+
+
+#define LL2GenIsEmpty(list)                                             \
+    LL2IsEmpty_(&list.pHead)
+
+#define LL2GenRefIsEmpty(listRef)                                       \
+    LL2IsEmpty_(listRef.ppHead)
+
+
+
+// NOTE - List 1 is cleared. Every moved item has to be restamped with list 0's generation, so this is O(size of
+//  list 1).
+#define LL2GenCombine_(type, ppList0Head, ppList0Tail, pList0Gen, ppList1Head, ppList1Tail, listOffset) \
+    do {                                                                \
+        ForLL2_(type, itMoved_, ppList1Head, listOffset)                \
+        {                                                               \
+            LL2GenNodePtr_(type, itMoved_, listOffset)->pGen = (pList0Gen); \
+            LL2GenNodePtr_(type, itMoved_, listOffset)->gen = *(pList0Gen); \
+        }                                                               \
+        LL2Combine_(type, ppList0Head, ppList0Tail, ppList1Head, ppList1Tail, listOffset); \
+    } while(0)
+
+#define LL2GenCombine(type, list0, list1)                               \
+    LL2GenCombine_(type, &list0.pHead, &list0.pTail, &list0.gen, &list1.pHead, &list1.pTail, list0.offset)
+
+#define LL2GenRefCombine(type, listRef0, listRef1)                      \
+    LL2GenCombine_(type, listRef0.ppHead, listRef0.ppTail, listRef0.pGen, listRef1.ppHead, listRef1.ppTail, listRef0.offset)
+
+
+
+#define ForLL2Gen(type, it, list)                                       \
+    ForLL2_(type, it, &list.pHead, list.offset)
+
+#define ForLL2GenRef(type, it, listRef)                                 \
+    ForLL2_(type, it, listRef.ppHead, listRef.offset)
+
+
+
+//
+// Compact doubly linked list
+//
+
+// NOTE - Same operations as LL2, but links are 32-bit indices into an arena (an array of type) instead of pointers,
+//  which halves the size of the node. Every list stores its arena base, and all items on a list must live in that
+//  arena. Indices are stored +1 so that 0 still indicates "not linked"/empty, and LL2CompactEndOfList_ plays the
+//  role of LLEndOfList_.
+#define LL2CompactEndOfList_ 0xFFFFFFFF
+
+#define DefineLL2CompactNode(type)              \
+    struct LL2CompactNode                       \
+    {                                           \
+        uint32_t iPrev;                         \
+        uint32_t iNext;                         \
+    };                                          \
+    struct LL2CompactRef                        \
+    {                                           \
+        struct type * pBase;                    \
+        uint32_t * piHead;                      \
+        uint32_t * piTail;                      \
+        uintptr_t offset;                       \
+    }
+
+#define LL2CompactType(userId) LL2Compact_##userId
+
+#define DefineLL2Compact(type, linkMember, userId)                      \
+        struct LL2Compact_##userId                                      \
+        {                                                               \
+            struct type * pBase;                                        \
+            uint32_t iHead;                                             \
+            uint32_t iTail;                                             \
+            static const uintptr_t offset = offsetof(type, linkMember); \
+        };                                                              \
+
+#define LL2CompactMakeRef(listRefPtr, list)     \
+    do {                                        \
+        (listRefPtr)->pBase = list.pBase;       \
+        (listRefPtr)->piHead = &list.iHead;     \
+        (listRefPtr)->piTail = &list.iTail;     \
+        (listRefPtr)->offset = list.offset;     \
+    } while(0)
+
+
+
+#define LL2CompactIndexOf_(pBase, pItem)        \
+    ((uint32_t)((pItem) - (pBase)) + 1)
+
+#define LL2CompactItemAt_(pBase, iLink)         \
+    ((pBase) + ((iLink) - 1))
+
+#define LL2CompactNodePtr_(type, pItem, listOffset)                     \
+    ((type::LL2CompactNode *)((unsigned char * )pItem + listOffset))
+
+#define LL2CompactNodePtr(type, list, pItem)                    \
+    LL2CompactNodePtr_(type, pItem, list.offset)
+
+#define LL2CompactRefNodePtr(type, listRef, pItem)              \
+    LL2CompactNodePtr_(type, pItem, listRef.offset)
+
+
+
+#define LL2CompactIsItemLinked_(type, pItem, listOffset)        \
+    (LL2CompactNodePtr_(type, pItem, listOffset)->iPrev != 0)
+
+// NOTE - Same caveat as LL2IsItemLinked
+#define LL2CompactIsItemLinked(type, list, pItem)               \
+    LL2CompactIsItemLinked_(type, pItem, list.offset)
+
+#define LL2CompactRefIsItemLinked(type, listRef, pItem)         \
+    LL2CompactIsItemLinked_(type, pItem, listRef.offset)
+
+
+
+#define LL2CompactHead_(pBase, piListHead)                                      \
+    (*piListHead ? LL2CompactItemAt_(pBase, *piListHead) : nullptr)
+
+#define LL2CompactHead(list)                    \
+    LL2CompactHead_(list.pBase, &list.iHead)
+
+#define LL2CompactRefHead(listRef)              \
+    LL2CompactHead_(listRef.pBase, listRef.piHead)
+
+#define LL2CompactTail(list)                    \
+    LL2CompactHead_(list.pBase, &list.iTail)
+
+#define LL2CompactRefTail(listRef)              \
+    LL2CompactHead_(listRef.pBase, listRef.piTail)
+
+
+
+#define LL2CompactAddHead_(type, pBase, piListHead, piListTail, listOffset, pItem) \
+    do {                                                                \
+        if (LL2CompactIsItemLinked_(type, pItem, listOffset))           \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        auto * itemNode_ = LL2CompactNodePtr_(type, pItem, listOffset); \
+        uint32_t iItem_ = LL2CompactIndexOf_(pBase, pItem);             \
+        if (*piListHead)                                                \
+        {                                                               \
+            LL2CompactNodePtr_(type, LL2CompactItemAt_(pBase, *piListHead), listOffset)->iPrev = iItem_; \
+            itemNode_->iNext = *piListHead;                             \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            itemNode_->iNext = LL2CompactEndOfList_;                    \
+            *piListTail = iItem_;                                       \
+        }                                                               \
+        itemNode_->iPrev = LL2CompactEndOfList_;                        \
+        *piListHead = iItem_;                                           \
+    } while(0)
+
+#define LL2CompactAddHead(type, list, pItem)                            \
+    LL2CompactAddHead_(type, list.pBase, &list.iHead, &list.iTail, list.offset, pItem)
+
+#define LL2CompactRefAddHead(type, listRef, pItem)                      \
+    LL2CompactAddHead_(type, listRef.pBase, listRef.piHead, listRef.piTail, listRef.offset, pItem)
+
+#define LL2CompactAdd(type, list, pItem)        \
+    LL2CompactAddHead(type, list, pItem)
+
+#define LL2CompactRefAdd(type, listRef, pItem)  \
+    LL2CompactRefAddHead(type, listRef, pItem)
+
+
+
+#define LL2CompactAddTail_(type, pBase, piListHead, piListTail, listOffset, pItem) \
+    do {                                                                \
+        if (LL2CompactIsItemLinked_(type, pItem, listOffset))           \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        auto * itemNode_ = LL2CompactNodePtr_(type, pItem, listOffset); \
+        uint32_t iItem_ = LL2CompactIndexOf_(pBase, pItem);             \
+        if (*piListTail)                                                \
+        {                                                               \
+            LL2CompactNodePtr_(type, LL2CompactItemAt_(pBase, *piListTail), listOffset)->iNext = iItem_; \
+            itemNode_->iPrev = *piListTail;                             \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            itemNode_->iPrev = LL2CompactEndOfList_;                    \
+            *piListHead = iItem_;                                       \
+        }                                                               \
+        itemNode_->iNext = LL2CompactEndOfList_;                        \
+        *piListTail = iItem_;                                           \
+    } while(0)
+
+#define LL2CompactAddTail(type, list, pItem)                            \
+    LL2CompactAddTail_(type, list.pBase, &list.iHead, &list.iTail, list.offset, pItem)
+
+#define LL2CompactRefAddTail(type, listRef, pItem)                      \
+    LL2CompactAddTail_(type, listRef.pBase, listRef.piHead, listRef.piTail, listRef.offset, pItem)
+
+
+
+#define LL2CompactRemove_(type, pBase, piListHead, piListTail, listOffset, pItem) \
+    do {                                                                \
+        auto * node_ = LL2CompactNodePtr_(type, pItem, listOffset);     \
+        if (!LL2CompactIsItemLinked_(type, pItem, listOffset)) break;   \
+        uint32_t iPrev_ = node_->iPrev;                                 \
+        uint32_t iNext_ = node_->iNext;                                 \
+        bool hasNext_ = iNext_ != LL2CompactEndOfList_;                 \
+        bool hasPrev_ = iPrev_ != LL2CompactEndOfList_;                 \
+        if (hasNext_ && hasPrev_)                                       \
+        {                                                               \
+            LL2CompactNodePtr_(type, LL2CompactItemAt_(pBase, iNext_), listOffset)->iPrev = iPrev_; \
+            LL2CompactNodePtr_(type, LL2CompactItemAt_(pBase, iPrev_), listOffset)->iNext = iNext_; \
+        }                                                               \
+        else if (hasNext_ && !hasPrev_)                                 \
+        {                                                               \
+            LL2CompactNodePtr_(type, LL2CompactItemAt_(pBase, iNext_), listOffset)->iPrev = LL2CompactEndOfList_; \
+            *piListHead = iNext_;                                       \
+        }                                                               \
+        else if (!hasNext_ && hasPrev_)                                 \
+        {                                                               \
+            LL2CompactNodePtr_(type, LL2CompactItemAt_(pBase, iPrev_), listOffset)->iNext = LL2CompactEndOfList_; \
+            *piListTail = iPrev_;                                       \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            *piListHead = 0;                                            \
+            *piListTail = 0;                                            \
+        }                                                               \
+        node_->iPrev = 0;                                               \
+        node_->iNext = 0;                                               \
+    } while(0)
+
+#define LL2CompactRemove(type, list, pItem)                             \
+    LL2CompactRemove_(type, list.pBase, &list.iHead, &list.iTail, list.offset, pItem)
+
+#define LL2CompactRefRemove(type, listRef, pItem)                       \
+    LL2CompactRemove_(type, listRef.pBase, listRef.piHead, listRef.piTail, listRef.offset, pItem)
+
+
+
+#define LL2CompactInsertBefore_(type, pBase, piListHead, piListTail, listOffset, pItem, pItemNext) \
+    do {                                                                \
+        if (!pItemNext) LL2CompactAddTail_(type, pBase, piListHead, piListTail, listOffset, pItem); \
+        else if (LL2CompactIndexOf_(pBase, pItemNext) == *piListHead) LL2CompactAddHead_(type, pBase, piListHead, piListTail, listOffset, pItem); \
+        else {                                                          \
+            if (LL2CompactIsItemLinked_(type, pItem, listOffset))       \
+            {                                                           \
+                LL_ASSERT(false);                                       \
+                break;                                                  \
+            }                                                           \
+            auto * node = LL2CompactNodePtr_(type, pItem, listOffset);  \
+            auto * nextNode = LL2CompactNodePtr_(type, pItemNext, listOffset); \
+            uint32_t iItem = LL2CompactIndexOf_(pBase, pItem);          \
+            uint32_t iItemPrev = nextNode->iPrev;                       \
+            LL2CompactNodePtr_(type, LL2CompactItemAt_(pBase, iItemPrev), listOffset)->iNext = iItem; \
+            node->iNext = LL2CompactIndexOf_(pBase, pItemNext);         \
+            node->iPrev = iItemPrev;                                    \
+            nextNode->iPrev = iItem;                                    \
+        }                                                               \
+    } while(0)
+
+#define LL2CompactInsertBefore(type, list, pItem, pItemNext)            \
+    LL2CompactInsertBefore_(type, list.pBase, &list.iHead, &list.iTail, list.offset, pItem, pItemNext)
+
+#define LL2CompactRefInsertBefore(type, listRef, pItem, pItemNext)      \
+    LL2CompactInsertBefore_(type, listRef.pBase, listRef.piHead, listRef.piTail, listRef.offset, pItem, pItemNext)
+
+
+
+#define LL2CompactRemoveHead_(type, pBase, piListHead, piListTail, listOffset, pAssignTo) \
+    do {                                                                \
+        pAssignTo = LL2CompactHead_(pBase, piListHead);                 \
+        if (pAssignTo)                                                  \
+        {                                                               \
+            auto * headToRemoveNode_ = LL2CompactNodePtr_(type, pAssignTo, listOffset); \
+            if (headToRemoveNode_->iNext != LL2CompactEndOfList_)       \
+            {                                                           \
+                *piListHead = headToRemoveNode_->iNext;                 \
+                LL2CompactNodePtr_(type, LL2CompactItemAt_(pBase, *piListHead), listOffset)->iPrev = LL2CompactEndOfList_; \
+            }                                                           \
+            else                                                        \
+            {                                                           \
+                *piListHead = 0;                                        \
+                *piListTail = 0;                                        \
+            }                                                           \
+            headToRemoveNode_->iNext = 0;                               \
+            headToRemoveNode_->iPrev = 0;                               \
+        }                                                               \
+    } while (0)
+
+#define LL2CompactRemoveHead(type, list, pAssignTo)                     \
+    LL2CompactRemoveHead_(type, list.pBase, &list.iHead, &list.iTail, list.offset, pAssignTo)
+
+#define LL2CompactRefRemoveHead(type, listRef, pAssignTo)               \
+    LL2CompactRemoveHead_(type, listRef.pBase, listRef.piHead, listRef.piTail, listRef.offset, pAssignTo)
+
+
+
+#define LL2CompactRemoveTail_(type, pBase, piListHead, piListTail, listOffset, pAssignTo) \
+    do {                                                                \
+        pAssignTo = LL2CompactHead_(pBase, piListTail);                 \
+        if (pAssignTo)                                                  \
+        {                                                               \
+            auto * tailToRemoveNode_ = LL2CompactNodePtr_(type, pAssignTo, listOffset); \
+            if (tailToRemoveNode_->iPrev != LL2CompactEndOfList_)       \
+            {                                                           \
+                *piListTail = tailToRemoveNode_->iPrev;                 \
+                LL2CompactNodePtr_(type, LL2CompactItemAt_(pBase, *piListTail), listOffset)->iNext = LL2CompactEndOfList_; \
+            }                                                           \
+            else                                                        \
+            {                                                           \
+                *piListHead = 0;                                        \
+                *piListTail = 0;                                        \
+            }                                                           \
+            tailToRemoveNode_->iNext = 0;                               \
+            tailToRemoveNode_->iPrev = 0;                               \
+        }                                                               \
+    } while (0)
+
+#define LL2CompactRemoveTail(type, list, pAssignTo)                     \
+    LL2CompactRemoveTail_(type, list.pBase, &list.iHead, &list.iTail, list.offset, pAssignTo)
+
+#define LL2CompactRefRemoveTail(type, listRef, pAssignTo)               \
+    LL2CompactRemoveTail_(type, listRef.pBase, listRef.piHead, listRef.piTail, listRef.offset, pAssignTo)
+
+
+
+#define LL2CompactNext_(type, pBase, pItem, listOffset)                 \
+    ((LL2CompactNodePtr_(type, pItem, listOffset)->iNext == LL2CompactEndOfList_) ? nullptr : LL2CompactItemAt_(pBase, LL2CompactNodePtr_(type, pItem, listOffset)->iNext))
+
+#define LL2CompactNext(type, list, pItem)       \
+    LL2CompactNext_(type, list.pBase, pItem, list.offset)
+
+#define LL2CompactRefNext(type, listRef, pItem) \
+    LL2CompactNext_(type, listRef.pBase, pItem, listRef.offset)
+
+
+
+#define LL2CompactPrev_(type, pBase, pItem, listOffset)                 \
+    ((LL2CompactNodePtr_(type, pItem, listOffset)->iPrev == LL2CompactEndOfList_) ? nullptr : LL2CompactItemAt_(pBase, LL2CompactNodePtr_(type, pItem, listOffset)->iPrev))
+
+#define LL2CompactPrev(type, list, pItem)       \
+    LL2CompactPrev_(type, list.pBase, pItem, list.offset)
+
+#define LL2CompactRefPrev(type, listRef, pItem) \
+    LL2CompactPrev_(type, listRef.pBase, pItem, listRef.offset)
+
+
+
+#define LL2CompactClear_(type, pBase, piListHead, piListTail, listOffset) \
+    do {                                                                \
+        while (*piListHead)                                             \
+        {                                                               \
+            auto * pHeadNode_ = LL2CompactNodePtr_(type, LL2CompactItemAt_(pBase, *piListHead), listOffset); \
+            uint32_t iHeadNext_ = pHeadNode_->iNext;                    \
+            pHeadNode_->iNext = 0;                                      \
+            pHeadNode_->iPrev = 0;                                      \
+            *piListHead = (iHeadNext_ == LL2CompactEndOfList_) ? 0 : iHeadNext_; \
+        }                                                               \
+        *piListTail = 0;                                                \
+    } while(0)
+
+#define LL2CompactClear(type, list)                                     \
+    LL2CompactClear_(type, list.pBase, &list.iHead, &list.iTail, list.offset)
+
+#define LL2CompactRefClear(type, listRef)                               \
+    LL2CompactClear_(type, listRef.pBase, listRef.piHead, listRef.piTail, listRef.offset)
+
+
+
+#define LL2CompactClearWithoutUnlinking_(type, piListHead, piListTail)  \
+    do { *piListHead = 0; *piListTail = 0; } while (0)
+
+#define LL2CompactClearWithoutUnlinking(type, list)                     \
+    LL2CompactClearWithoutUnlinking_(type, &list.iHead, &list.iTail)
+
+#define LL2CompactRefClearWithoutUnlinking(type, listRef)               \
+    LL2CompactClearWithoutUnlinking_(type, listRef.piHead, listRef.piTail)
+
+
+
+#define LL2CompactIsEmpty_(piListHead)          \
+    (!(*piListHead))
+
+#define LL2CompactIsEmpty(list)                 \
+    LL2CompactIsEmpty_(&list.iHead)
+
+#define LL2CompactRefIsEmpty(listRef)           \
+    LL2CompactIsEmpty_(listRef.piHead)
+
+
+
+// NOTE - List 1 is cleared. Both lists must use the same arena.
+#define LL2CompactCombine_(type, pBase, piList0Head, piList0Tail, piList1Head, piList1Tail, listOffset) \
+    do {                                                                \
+        if (LL2CompactIsEmpty_(piList0Head))                            \
+        {                                                               \
+            *piList0Head = *piList1Head;                                \
+            *piList0Tail = *piList1Tail;                                \
+        }                                                               \
+        else if (!LL2CompactIsEmpty_(piList1Head))                      \
+        {                                                               \
+            LL2CompactNodePtr_(type, LL2CompactItemAt_(pBase, *piList0Tail), listOffset)->iNext = *piList1Head; \
+            LL2CompactNodePtr_(type, LL2CompactItemAt_(pBase, *piList1Head), listOffset)->iPrev = *piList0Tail; \
+            *piList0Tail = *piList1Tail;                                \
+        }                                                               \
+        *piList1Head = 0;                                               \
+        *piList1Tail = 0;                                               \
+    } while(0)
+
+#define LL2CompactCombine(type, list0, list1)                           \
+    LL2CompactCombine_(type, list0.pBase, &list0.iHead, &list0.iTail, &list1.iHead, &list1.iTail, list0.offset)
+
+#define LL2CompactRefCombine(type, listRef0, listRef1)                  \
+    LL2CompactCombine_(type, listRef0.pBase, listRef0.piHead, listRef0.piTail, listRef1.piHead, listRef1.piTail, listRef0.offset)
+
+
+
+// NOTE - The next link is read before the loop body runs, so removing 'it' inside the body is safe (there is no
+//  fake head address to aim 'it' at like LL2RemoveWhileIterating_ does). Removing any other item is not.
+#define ForLL2Compact_(type, it, pBase, piListHead, listOffset)         \
+    for (type * it = LL2CompactHead_(pBase, piListHead), * it##Next_ = it ? LL2CompactNext_(type, pBase, it, listOffset) : nullptr; \
+         it;                                                            \
+         it = it##Next_, it##Next_ = it ? LL2CompactNext_(type, pBase, it, listOffset) : nullptr)
+
+#define ForLL2Compact(type, it, list)           \
+    ForLL2Compact_(type, it, list.pBase, &list.iHead, list.offset)
+
+#define ForLL2CompactRef(type, it, listRef)     \
+    ForLL2Compact_(type, it, listRef.pBase, listRef.piHead, listRef.offset)
+
+#define LL2CompactRemoveWhileIterating(type, list, it)  \
+    LL2CompactRemove(type, list, it)
+
+#define LL2CompactRefRemoveWhileIterating(type, listRef, it)    \
+    LL2CompactRefRemove(type, listRef, it)
+
+
+
+// NOTE - This assumes that the newAddress has its intrusive links already set properly, and is in the same arena
+#define LL2CompactRelocate_(type, pBase, piListHead, piListTail, listOffset, prevAddress, newAddress) \
+    do {                                                                \
+        uint32_t iPrevAddress_ = LL2CompactIndexOf_(pBase, prevAddress); \
+        uint32_t iNewAddress_ = LL2CompactIndexOf_(pBase, newAddress);  \
+        if (*piListHead == iPrevAddress_)                               \
+        {                                                               \
+            *piListHead = iNewAddress_;                                 \
+        }                                                               \
+        if (*piListTail == iPrevAddress_)                               \
+        {                                                               \
+            *piListTail = iNewAddress_;                                 \
+        }                                                               \
+        type * prev_ = LL2CompactPrev_(type, pBase, newAddress, listOffset); \
+        if (prev_)                                                      \
+        {                                                               \
+            LL_ASSERT(LL2CompactNodePtr_(type, prev_, listOffset)->iNext == iPrevAddress_); \
+            LL2CompactNodePtr_(type, prev_, listOffset)->iNext = iNewAddress_; \
+        }                                                               \
+        type * next_ = LL2CompactNext_(type, pBase, newAddress, listOffset); \
+        if (next_)                                                      \
+        {                                                               \
+            LL_ASSERT(LL2CompactNodePtr_(type, next_, listOffset)->iPrev == iPrevAddress_); \
+            LL2CompactNodePtr_(type, next_, listOffset)->iPrev = iNewAddress_; \
+        }                                                               \
+    } while (0)
+
+#define LL2CompactRelocate(type, list, prevAddress, newAddress)         \
+    LL2CompactRelocate_(type, list.pBase, &list.iHead, &list.iTail, list.offset, prevAddress, newAddress)
+
+#define LL2CompactRefRelocate(type, listRef, prevAddress, newAddress)   \
+    LL2CompactRelocate_(type, listRef.pBase, listRef.piHead, listRef.piTail, listRef.offset, prevAddress, newAddress)
+
+
+//
+// Self-relative doubly linked list
+//
+
+// NOTE - Same operations as LL2, but every link is a byte offset from the address holding it to the address it points
+//  at: item links are relative to their own item, and the list's head/tail are relative to the head/tail fields
+//  themselves. Nothing depends on where the memory is mapped, so items and lists (and the lists' headers) can be
+//  written to a file or shared memory segment as-is and used directly from a mapping at any address, by several
+//  processes at once (see ll_mmap.h). 0 indicates "not linked"/empty, and LL2RelEndOfList_ plays the role of
+//  LLEndOfList_ (no real offset can be 1, since items are at least pointer aligned).
+//
+//  Reading a list (Head/Tail/Next/Prev/ForLL2Rel) never writes, so it works on read-only mappings. A list header
+//  must not share its address with an item it links to (i.e. don't put a list as the first member of its own item).
+#define LL2RelEndOfList_ 1
+
+#define DefineLL2RelNode(type)                                          \
+    struct LL2RelNode                                                   \
+    {                                                                   \
+        intptr_t dPrev;                                                 \
+        intptr_t dNext;                                                 \
+    };                                                                  \
+    struct LL2RelRef                                                    \
+    {                                                                   \
+        intptr_t * pdHead;                                              \
+        intptr_t * pdTail;                                              \
+        uintptr_t offset;                                               \
+    }
+
+#define LL2RelType(userId) LL2Rel_##userId
+
+#define DefineLL2Rel(type, linkMember, userId)                          \
+        struct LL2Rel_##userId                                          \
+        {                                                               \
+            intptr_t dHead;                                             \
+            intptr_t dTail;                                             \
+            static const uintptr_t offset = offsetof(type, linkMember); \
+        };                                                              \
+
+#define LL2RelMakeRef(listRefPtr, list)                                 \
+    do {                                                                \
+        (listRefPtr)->pdHead = &list.dHead;                             \
+        (listRefPtr)->pdTail = &list.dTail;                             \
+        (listRefPtr)->offset = list.offset;                             \
+    } while(0)
+
+
+
+#define LL2RelDelta_(pFrom, pTo)                                        \
+    ((intptr_t)((const unsigned char *)(pTo) - (const unsigned char *)(pFrom)))
+
+#define LL2RelAt_(type, pFrom, delta)                                   \
+    ((type *)((unsigned char *)(pFrom) + (delta)))
+
+#define LL2RelNodePtr_(type, pItem, listOffset)                         \
+    ((type::LL2RelNode *)((unsigned char * )pItem + listOffset))
+
+#define LL2RelNodePtr(type, list, pItem)                                \
+    LL2RelNodePtr_(type, pItem, list.offset)
+
+#define LL2RelRefNodePtr(type, listRef, pItem)                          \
+    LL2RelNodePtr_(type, pItem, listRef.offset)
+
+
+
+#define LL2RelIsItemLinked_(type, pItem, listOffset)                    \
+    (LL2RelNodePtr_(type, pItem, listOffset)->dPrev != 0)
+
+// NOTE - Same caveat as LL2IsItemLinked
+#define LL2RelIsItemLinked(type, list, pItem)                           \
+    LL2RelIsItemLinked_(type, pItem, list.offset)
+
+#define LL2RelRefIsItemLinked(type, listRef, pItem)                     \
+    LL2RelIsItemLinked_(type, pItem, listRef.offset)
+
+
+
+// NOTE - pdListEnd is the address of the head or tail field
+#define LL2RelHead_(type, pdListEnd)                                    \
+    (*(pdListEnd) ? LL2RelAt_(type, pdListEnd, *(pdListEnd)) : nullptr)
+
+#define LL2RelHead(type, list)                                          \
+    LL2RelHead_(type, &list.dHead)
+
+#define LL2RelRefHead(type, listRef)                                    \
+    LL2RelHead_(type, listRef.pdHead)
+
+#define LL2RelTail(type, list)                                          \
+    LL2RelHead_(type, &list.dTail)
+
+#define LL2RelRefTail(type, listRef)                                    \
+    LL2RelHead_(type, listRef.pdTail)
+
+#define LL2RelSetEnd_(pdListEnd, pItem)                                 \
+    (*(pdListEnd) = LL2RelDelta_(pdListEnd, pItem))
+
+
+
+#define LL2RelNext_(type, pItem, listOffset)                            \
+    ((LL2RelNodePtr_(type, pItem, listOffset)->dNext == LL2RelEndOfList_) ? nullptr : LL2RelAt_(type, pItem, LL2RelNodePtr_(type, pItem, listOffset)->dNext))
+
+#define LL2RelNext(type, list, pItem)                                   \
+    LL2RelNext_(type, pItem, list.offset)
+
+#define LL2RelRefNext(type, listRef, pItem)                             \
+    LL2RelNext_(type, pItem, listRef.offset)
+
+
+
+#define LL2RelPrev_(type, pItem, listOffset)                            \
+    ((LL2RelNodePtr_(type, pItem, listOffset)->dPrev == LL2RelEndOfList_) ? nullptr : LL2RelAt_(type, pItem, LL2RelNodePtr_(type, pItem, listOffset)->dPrev))
+
+#define LL2RelPrev(type, list, pItem)                                   \
+    LL2RelPrev_(type, pItem, list.offset)
+
+#define LL2RelRefPrev(type, listRef, pItem)                             \
+    LL2RelPrev_(type, pItem, listRef.offset)
+
+
+
+#define LL2RelAddHead_(type, pdListHead, pdListTail, listOffset, pItem) \
+    do {                                                                \
+        if (LL2RelIsItemLinked_(type, pItem, listOffset))               \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        auto * itemNode_ = LL2RelNodePtr_(type, pItem, listOffset);     \
+        type * pOldHead_ = LL2RelHead_(type, pdListHead);               \
+        if (pOldHead_)                                                  \
+        {                                                               \
+            LL2RelNodePtr_(type, pOldHead_, listOffset)->dPrev = LL2RelDelta_(pOldHead_, pItem); \
+            itemNode_->dNext = LL2RelDelta_(pItem, pOldHead_);          \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            itemNode_->dNext = LL2RelEndOfList_;                        \
+            LL2RelSetEnd_(pdListTail, pItem);                           \
+        }                                                               \
+        itemNode_->dPrev = LL2RelEndOfList_;                            \
+        LL2RelSetEnd_(pdListHead, pItem);                               \
+    } while(0)
+
+#define LL2RelAddHead(type, list, pItem)                                \
+    LL2RelAddHead_(type, &list.dHead, &list.dTail, list.offset, pItem)
+
+#define LL2RelRefAddHead(type, listRef, pItem)                          \
+    LL2RelAddHead_(type, listRef.pdHead, listRef.pdTail, listRef.offset, pItem)
+
+#define LL2RelAdd(type, list, pItem)                                    \
+    LL2RelAddHead(type, list, pItem)
+
+#define LL2RelRefAdd(type, listRef, pItem)                              \
+    LL2RelRefAddHead(type, listRef, pItem)
+
+
+
+#define LL2RelAddTail_(type, pdListHead, pdListTail, listOffset, pItem) \
+    do {                                                                \
+        if (LL2RelIsItemLinked_(type, pItem, listOffset))               \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        auto * itemNode_ = LL2RelNodePtr_(type, pItem, listOffset);     \
+        type * pOldTail_ = LL2RelHead_(type, pdListTail);               \
+        if (pOldTail_)                                                  \
+        {                                                               \
+            LL2RelNodePtr_(type, pOldTail_, listOffset)->dNext = LL2RelDelta_(pOldTail_, pItem); \
+            itemNode_->dPrev = LL2RelDelta_(pItem, pOldTail_);          \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            itemNode_->dPrev = LL2RelEndOfList_;                        \
+            LL2RelSetEnd_(pdListHead, pItem);                           \
+        }                                                               \
+        itemNode_->dNext = LL2RelEndOfList_;                            \
+        LL2RelSetEnd_(pdListTail, pItem);                               \
+    } while(0)
+
+#define LL2RelAddTail(type, list, pItem)                                \
+    LL2RelAddTail_(type, &list.dHead, &list.dTail, list.offset, pItem)
+
+#define LL2RelRefAddTail(type, listRef, pItem)                          \
+    LL2RelAddTail_(type, listRef.pdHead, listRef.pdTail, listRef.offset, pItem)
+
+
+
+#define LL2RelRemove_(type, pdListHead, pdListTail, listOffset, pItem)  \
+    do {                                                                \
+        auto * node_ = LL2RelNodePtr_(type, pItem, listOffset);         \
+        if (!LL2RelIsItemLinked_(type, pItem, listOffset)) break;       \
+        type * pPrev_ = LL2RelPrev_(type, pItem, listOffset);           \
+        type * pNext_ = LL2RelNext_(type, pItem, listOffset);           \
+        if (pNext_ && pPrev_)                                           \
+        {                                                               \
+            LL2RelNodePtr_(type, pNext_, listOffset)->dPrev = LL2RelDelta_(pNext_, pPrev_); \
+            LL2RelNodePtr_(type, pPrev_, listOffset)->dNext = LL2RelDelta_(pPrev_, pNext_); \
+        }                                                               \
+        else if (pNext_ && !pPrev_)                                     \
+        {                                                               \
+            LL2RelNodePtr_(type, pNext_, listOffset)->dPrev = LL2RelEndOfList_; \
+            LL2RelSetEnd_(pdListHead, pNext_);                          \
+        }                                                               \
+        else if (!pNext_ && pPrev_)                                     \
+        {                                                               \
+            LL2RelNodePtr_(type, pPrev_, listOffset)->dNext = LL2RelEndOfList_; \
+            LL2RelSetEnd_(pdListTail, pPrev_);                          \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            *(pdListHead) = 0;                                          \
+            *(pdListTail) = 0;                                          \
+        }                                                               \
+        node_->dPrev = 0;                                               \
+        node_->dNext = 0;                                               \
+    } while(0)
+
+#define LL2RelRemove(type, list, pItem)                                 \
+    LL2RelRemove_(type, &list.dHead, &list.dTail, list.offset, pItem)
+
+#define LL2RelRefRemove(type, listRef, pItem)                           \
+    LL2RelRemove_(type, listRef.pdHead, listRef.pdTail, listRef.offset, pItem)
+
+
+
+#define LL2RelInsertBefore_(type, pdListHead, pdListTail, listOffset, pItem, pItemNext) \
+    do {                                                                \
+        if (!pItemNext) LL2RelAddTail_(type, pdListHead, pdListTail, listOffset, pItem); \
+        else if (pItemNext == LL2RelHead_(type, pdListHead)) LL2RelAddHead_(type, pdListHead, pdListTail, listOffset, pItem); \
+        else {                                                          \
+            if (LL2RelIsItemLinked_(type, pItem, listOffset))           \
+            {                                                           \
+                LL_ASSERT(false);                                       \
+                break;                                                  \
+            }                                                           \
+            auto * node = LL2RelNodePtr_(type, pItem, listOffset);      \
+            auto * nextNode = LL2RelNodePtr_(type, pItemNext, listOffset); \
+            type * pItemPrev = LL2RelPrev_(type, pItemNext, listOffset); \
+            LL2RelNodePtr_(type, pItemPrev, listOffset)->dNext = LL2RelDelta_(pItemPrev, pItem); \
+            node->dNext = LL2RelDelta_(pItem, pItemNext);               \
+            node->dPrev = LL2RelDelta_(pItem, pItemPrev);               \
+            nextNode->dPrev = LL2RelDelta_(pItemNext, pItem);           \
+        }                                                               \
+    } while(0)
+
+#define LL2RelInsertBefore(type, list, pItem, pItemNext)                \
+    LL2RelInsertBefore_(type, &list.dHead, &list.dTail, list.offset, pItem, pItemNext)
+
+#define LL2RelRefInsertBefore(type, listRef, pItem, pItemNext)          \
+    LL2RelInsertBefore_(type, listRef.pdHead, listRef.pdTail, listRef.offset, pItem, pItemNext)
+
+
+
+#define LL2RelRemoveHead_(type, pdListHead, pdListTail, listOffset, pAssignTo) \
+    do {                                                                \
+        pAssignTo = LL2RelHead_(type, pdListHead);                      \
+        if (pAssignTo) LL2RelRemove_(type, pdListHead, pdListTail, listOffset, pAssignTo); \
+    } while (0)
+
+#define LL2RelRemoveHead(type, list, pAssignTo)                         \
+    LL2RelRemoveHead_(type, &list.dHead, &list.dTail, list.offset, pAssignTo)
+
+#define LL2RelRefRemoveHead(type, listRef, pAssignTo)                   \
+    LL2RelRemoveHead_(type, listRef.pdHead, listRef.pdTail, listRef.offset, pAssignTo)
+
+
+
+#define LL2RelClear_(type, pdListHead, pdListTail, listOffset)          \
+    do {                                                                \
+        type * pClear_ = LL2RelHead_(type, pdListHead);                 \
+        while (pClear_)                                                 \
+        {                                                               \
+            auto * pClearNode_ = LL2RelNodePtr_(type, pClear_, listOffset); \
+            type * pClearNext_ = LL2RelNext_(type, pClear_, listOffset); \
+            pClearNode_->dNext = 0;                                     \
+            pClearNode_->dPrev = 0;                                     \
+            pClear_ = pClearNext_;                                      \
+        }                                                               \
+        *(pdListHead) = 0;                                              \
+        *(pdListTail) = 0;                                              \
+    } while(0)
+
+#define LL2RelClear(type, list)                                         \
+    LL2RelClear_(type, &list.dHead, &list.dTail, list.offset)
+
+#define LL2RelRefClear(type, listRef)                                   \
+    LL2RelClear_(type, listRef.pdHead, listRef.pdTail, listRef.offset)
+
+
+
+#define LL2RelIsEmpty_(pdListHead)                                      \
+    (!(*(pdListHead)))
+
+#define LL2RelIsEmpty(list)                                             \
+    LL2RelIsEmpty_(&list.dHead)
+
+#define LL2RelRefIsEmpty(listRef)                                       \
+    LL2RelIsEmpty_(listRef.pdHead)
+
+
+
+// NOTE - Unlike ForLL2_, there is no RemoveWhileIterating for this loop. Removing 'it' inside the body zeroes its
+//  links, and the next step would then land on 'it' again forever. To filter, walk by hand and take LL2RelNext_
+//  before removing. type may be const-qualified when walking a read-only mapping.
+#define ForLL2Rel_(type, it, pdListHead, listOffset)                    \
+    for (type * it = LL2RelHead_(type, pdListHead); it; it = LL2RelNext_(type, it, listOffset))
+
+#define ForLL2Rel(type, it, list)                                       \
+    ForLL2Rel_(type, it, &list.dHead, list.offset)
+
+#define ForLL2RelRef(type, it, listRef)                                 \
+    ForLL2Rel_(type, it, listRef.pdHead, listRef.offset)
+
+
+
+// NOTE - Appends every item of a pointer-based LL2 list (same item type, any link) to a self-relative list, e.g. to
+//  build an image for ll_mmap.h from lists that were assembled in place. O(n). The source list is left untouched.
+#define LL2RelAppendFromLL2_(type, pdListHead, pdListTail, relOffset, ppSrcHead, srcOffset) \
+    do {                                                                \
+        for (type * pAppend_ = *(ppSrcHead); pAppend_; pAppend_ = LL2Next_(type, pAppend_, srcOffset)) \
+        {                                                               \
+            LL2RelAddTail_(type, pdListHead, pdListTail, relOffset, pAppend_); \
+        }                                                               \
+    } while(0)
+
+#define LL2RelAppendFromLL2(type, relList, srcList)                     \
+    LL2RelAppendFromLL2_(type, &relList.dHead, &relList.dTail, relList.offset, &srcList.pHead, srcList.offset)
+
+
+
+//
+// Circular doubly linked list
+//
+
+// NOTE - Alternative to LL2 for remove-heavy code. The list's header is itself a node, linked into the ring with the
+//  items, so every item always has a real node on both sides and nothing needs a special case: AddHead, AddTail,
+//  InsertBefore and Remove are each four pointer stores with no branches (other than the adds refusing an item that
+//  is already linked, as everywhere else), and SpliceRange six. An empty list is its header pointing at itself, so a
+//  list must be initialized with LL2CircInit before use (a zeroed header is not an empty list). Unlinked items have
+//  null links, as with LL2, so "is linked" stays O(1).
+//
+//  The ring points back at the header, so a list can't be copied or moved (e.g. by a std::vector growing), not even
+//  an empty one: the copy's header would still point at the original. Keep lists at a fixed address, or LL2CircInit
+//  the new location and move the items over with LL2CircCombine.
+//
+//  Links point at nodes rather than items, so these macros don't mix with LL2 ones on the same list, and
+//  Next/Prev need the list to recognize the header. Remove needs only the item, but (unlike LL2Remove) it must be
+//  linked: removing an unlinked item asserts and does nothing.
+#define DefineLL2CircNode(type)                                         \
+    struct LL2CircNode                                                  \
+    {                                                                   \
+        LL2CircNode * pPrev;                                            \
+        LL2CircNode * pNext;                                            \
+    };                                                                  \
+    struct LL2CircRef                                                   \
+    {                                                                   \
+        LL2CircNode * pHeader;                                          \
+        uintptr_t offset;                                               \
+    }
+
+#define LL2CircType(userId) LL2Circ_##userId
+
+#define DefineLL2Circ(type, linkMember, userId)                         \
+        struct LL2Circ_##userId                                         \
+        {                                                               \
+            type::LL2CircNode header;                                   \
+            static const uintptr_t offset = offsetof(type, linkMember); \
+        };                                                              \
+
+#define LL2CircMakeRef(listRefPtr, list)                                \
+    do {                                                                \
+        (listRefPtr)->pHeader = &list.header;                           \
+        (listRefPtr)->offset = list.offset;                             \
+    } while(0)
+
+
+
+#define LL2CircInit_(pHeader)                                           \
+    do {                                                                \
+        (pHeader)->pPrev = (pHeader);                                   \
+        (pHeader)->pNext = (pHeader);                                   \
+    } while(0)
+
+#define LL2CircInit(list)                                               \
+    LL2CircInit_(&list.header)
+
+#define LL2CircRefInit(listRef)                                         \
+    LL2CircInit_(listRef.pHeader)
+
+
+
+#define LL2CircNodePtr_(type, pItem, listOffset)                        \
+    ((type::LL2CircNode *)((unsigned char * )pItem + listOffset))
+
+#define LL2CircNodePtr(type, list, pItem)                               \
+    LL2CircNodePtr_(type, pItem, list.offset)
+
+#define LL2CircRefNodePtr(type, listRef, pItem)                         \
+    LL2CircNodePtr_(type, pItem, listRef.offset)
+
+#define LL2CircItem_(type, pNode, listOffset)                           \
+    ((type *)((unsigned char *)(pNode) - listOffset))
+
+
+
+#define LL2CircIsItemLinked_(type, pItem, listOffset)                   \
+    (LL2CircNodePtr_(type, pItem, listOffset)->pNext != nullptr)
+
+// NOTE - Same caveat as LL2IsItemLinked
+#define LL2CircIsItemLinked(type, list, pItem)                          \
+    LL2CircIsItemLinked_(type, pItem, list.offset)
+
+#define LL2CircRefIsItemLinked(type, listRef, pItem)                    \
+    LL2CircIsItemLinked_(type, pItem, listRef.offset)
+
+
+
+#define LL2CircIsEmpty_(pHeader)                                        \
+    ((pHeader)->pNext == (pHeader))
+
+#define LL2CircIsEmpty(list)                                            \
+    LL2CircIsEmpty_(&list.header)
+
+#define LL2CircRefIsEmpty(listRef)                                      \
+    LL2CircIsEmpty_(listRef.pHeader)
+
+
+
+// NOTE - Item behind a node, or nullptr if the node is the header
+#define LL2CircItemOrNull_(type, pHeader, listOffset, pNode)            \
+    (((pNode) == (pHeader)) ? nullptr : LL2CircItem_(type, pNode, listOffset))
+
+#define LL2CircHead_(type, pHeader, listOffset)                         \
+    LL2CircItemOrNull_(type, pHeader, listOffset, (pHeader)->pNext)
+
+#define LL2CircHead(type, list)                                         \
+    LL2CircHead_(type, &list.header, list.offset)
+
+#define LL2CircRefHead(type, listRef)                                   \
+    LL2CircHead_(type, listRef.pHeader, listRef.offset)
+
+#define LL2CircTail_(type, pHeader, listOffset)                         \
+    LL2CircItemOrNull_(type, pHeader, listOffset, (pHeader)->pPrev)
+
+#define LL2CircTail(type, list)                                         \
+    LL2CircTail_(type, &list.header, list.offset)
+
+#define LL2CircRefTail(type, listRef)                                   \
+    LL2CircTail_(type, listRef.pHeader, listRef.offset)
+
+
+
+#define LL2CircNext_(type, pHeader, listOffset, pItem)                  \
+    LL2CircItemOrNull_(type, pHeader, listOffset, LL2CircNodePtr_(type, pItem, listOffset)->pNext)
+
+#define LL2CircNext(type, list, pItem)                                  \
+    LL2CircNext_(type, &list.header, list.offset, pItem)
+
+#define LL2CircRefNext(type, listRef, pItem)                            \
+    LL2CircNext_(type, listRef.pHeader, listRef.offset, pItem)
+
+#define LL2CircPrev_(type, pHeader, listOffset, pItem)                  \
+    LL2CircItemOrNull_(type, pHeader, listOffset, LL2CircNodePtr_(type, pItem, listOffset)->pPrev)
+
+#define LL2CircPrev(type, list, pItem)                                  \
+    LL2CircPrev_(type, &list.header, list.offset, pItem)
+
+#define LL2CircRefPrev(type, listRef, pItem)                            \
+    LL2CircPrev_(type, listRef.pHeader, listRef.offset, pItem)
+
+
+
+// NOTE - Links pNode between two adjacent nodes
+#define LL2CircLinkBetween_(pNode, pNodePrev, pNodeNext)                \
+    do {                                                                \
+        auto * pLinkNode_ = (pNode);                                    \
+        auto * pLinkPrev_ = (pNodePrev);                                \
+        auto * pLinkNext_ = (pNodeNext);                                \
+        pLinkNode_->pPrev = pLinkPrev_;                                 \
+        pLinkNode_->pNext = pLinkNext_;                                 \
+        pLinkPrev_->pNext = pLinkNode_;                                 \
+        pLinkNext_->pPrev = pLinkNode_;                                 \
+    } while(0)
+
+#define LL2CircAddHead_(type, pHeader, listOffset, pItem)               \
+    do {                                                                \
+        if (LL2CircIsItemLinked_(type, pItem, listOffset))              \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        LL2CircLinkBetween_(LL2CircNodePtr_(type, pItem, listOffset), (pHeader), (pHeader)->pNext); \
+    } while(0)
+
+#define LL2CircAddHead(type, list, pItem)                               \
+    LL2CircAddHead_(type, &list.header, list.offset, pItem)
+
+#define LL2CircRefAddHead(type, listRef, pItem)                         \
+    LL2CircAddHead_(type, listRef.pHeader, listRef.offset, pItem)
+
+#define LL2CircAdd(type, list, pItem)                                   \
+    LL2CircAddHead(type, list, pItem)
+
+#define LL2CircRefAdd(type, listRef, pItem)                             \
+    LL2CircRefAddHead(type, listRef, pItem)
+
+
+
+#define LL2CircAddTail_(type, pHeader, listOffset, pItem)               \
+    do {                                                                \
+        if (LL2CircIsItemLinked_(type, pItem, listOffset))              \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        LL2CircLinkBetween_(LL2CircNodePtr_(type, pItem, listOffset), (pHeader)->pPrev, (pHeader)); \
+    } while(0)
+
+#define LL2CircAddTail(type, list, pItem)                               \
+    LL2CircAddTail_(type, &list.header, list.offset, pItem)
+
+#define LL2CircRefAddTail(type, listRef, pItem)                         \
+    LL2CircAddTail_(type, listRef.pHeader, listRef.offset, pItem)
+
+
+
+// NOTE - A null pItemNext inserts at the tail. That choice compiles to a select rather than a branch.
+#define LL2CircInsertBefore_(type, pHeader, listOffset, pItem, pItemNext) \
+    do {                                                                \
+        if (LL2CircIsItemLinked_(type, pItem, listOffset))              \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        type::LL2CircNode * pInsertNext_ = (pItemNext) ? LL2CircNodePtr_(type, pItemNext, listOffset) : (pHeader); \
+        LL2CircLinkBetween_(LL2CircNodePtr_(type, pItem, listOffset), pInsertNext_->pPrev, pInsertNext_); \
+    } while(0)
+
+#define LL2CircInsertBefore(type, list, pItem, pItemNext)               \
+    LL2CircInsertBefore_(type, &list.header, list.offset, pItem, pItemNext)
+
+#define LL2CircRefInsertBefore(type, listRef, pItem, pItemNext)         \
+    LL2CircInsertBefore_(type, listRef.pHeader, listRef.offset, pItem, pItemNext)
+
+
+
+// NOTE - pItem must be linked. The list isn't needed, the wrappers only take it for symmetry.
+#define LL2CircRemove_(type, listOffset, pItem)                         \
+    do {                                                                \
+        auto * node_ = LL2CircNodePtr_(type, pItem, listOffset);        \
+        if (!node_->pNext)                                              \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        node_->pPrev->pNext = node_->pNext;                             \
+        node_->pNext->pPrev = node_->pPrev;                             \
+        node_->pPrev = nullptr;                                         \
+        node_->pNext = nullptr;                                         \
+    } while(0)
+
+#define LL2CircRemove(type, list, pItem)                                \
+    LL2CircRemove_(type, list.offset, pItem)
+
+#define LL2CircRefRemove(type, listRef, pItem)                          \
+    LL2CircRemove_(type, listRef.offset, pItem)
+
+
+
+#define LL2CircRemoveHead_(type, pHeader, listOffset, pAssignTo)        \
+    do {                                                                \
+        pAssignTo = LL2CircHead_(type, pHeader, listOffset);            \
+        if (pAssignTo) LL2CircRemove_(type, listOffset, pAssignTo);     \
+    } while (0)
+
+#define LL2CircRemoveHead(type, list, pAssignTo)                        \
+    LL2CircRemoveHead_(type, &list.header, list.offset, pAssignTo)
+
+#define LL2CircRefRemoveHead(type, listRef, pAssignTo)                  \
+    LL2CircRemoveHead_(type, listRef.pHeader, listRef.offset, pAssignTo)
+
+#define LL2CircRemoveTail_(type, pHeader, listOffset, pAssignTo)        \
+    do {                                                                \
+        pAssignTo = LL2CircTail_(type, pHeader, listOffset);            \
+        if (pAssignTo) LL2CircRemove_(type, listOffset, pAssignTo);     \
+    } while (0)
+
+#define LL2CircRemoveTail(type, list, pAssignTo)                        \
+    LL2CircRemoveTail_(type, &list.header, list.offset, pAssignTo)
+
+#define LL2CircRefRemoveTail(type, listRef, pAssignTo)                  \
+    LL2CircRemoveTail_(type, listRef.pHeader, listRef.offset, pAssignTo)
+
+
+
+// NOTE - Moves the run [pFirst, pLast] (pFirst at or before pLast, on any circular list using this link) before
+//  pDstNext, or to the tail of the destination if pDstNext is null. Same rules as LL2SpliceRange_: O(1), and source
+//  and destination may be the same list as long as pDstNext isn't inside the run.
+#define LL2CircSpliceRange_(type, pDstHeader, listOffset, pFirst, pLast, pDstNext) \
+    do {                                                                \
+        auto * pSpliceFirst_ = LL2CircNodePtr_(type, pFirst, listOffset); \
+        auto * pSpliceLast_ = LL2CircNodePtr_(type, pLast, listOffset); \
+        type::LL2CircNode * pSpliceNext_ = (pDstNext) ? LL2CircNodePtr_(type, pDstNext, listOffset) : (pDstHeader); \
+        pSpliceFirst_->pPrev->pNext = pSpliceLast_->pNext;              \
+        pSpliceLast_->pNext->pPrev = pSpliceFirst_->pPrev;              \
+        pSpliceFirst_->pPrev = pSpliceNext_->pPrev;                     \
+        pSpliceLast_->pNext = pSpliceNext_;                             \
+        pSpliceNext_->pPrev->pNext = pSpliceFirst_;                     \
+        pSpliceNext_->pPrev = pSpliceLast_;                             \
+    } while(0)
+
+#define LL2CircSpliceRange(type, dstList, pFirst, pLast, pDstNext)      \
+    LL2CircSpliceRange_(type, &dstList.header, dstList.offset, pFirst, pLast, pDstNext)
+
+#define LL2CircRefSpliceRange(type, dstListRef, pFirst, pLast, pDstNext) \
+    LL2CircSpliceRange_(type, dstListRef.pHeader, dstListRef.offset, pFirst, pLast, pDstNext)
+
+
+
+// NOTE - Appends all of list 1 to list 0, leaving list 1 empty. The only branch is on list 1 being empty.
+#define LL2CircCombine_(type, pHeader0, pHeader1, listOffset)           \
+    do {                                                                \
+        if (LL2CircIsEmpty_(pHeader1)) break;                           \
+        (pHeader1)->pNext->pPrev = (pHeader0)->pPrev;                   \
+        (pHeader1)->pPrev->pNext = (pHeader0);                          \
+        (pHeader0)->pPrev->pNext = (pHeader1)->pNext;                   \
+        (pHeader0)->pPrev = (pHeader1)->pPrev;                          \
+        LL2CircInit_(pHeader1);                                         \
+    } while(0)
+
+#define LL2CircCombine(type, list0, list1)                              \
+    LL2CircCombine_(type, &list0.header, &list1.header, list0.offset)
+
+#define LL2CircRefCombine(type, listRef0, listRef1)                     \
+    LL2CircCombine_(type, listRef0.pHeader, listRef1.pHeader, listRef0.offset)
+
+
+
+#define LL2CircClear_(type, pHeader, listOffset)                        \
+    do {                                                                \
+        type::LL2CircNode * pClearNode_ = (pHeader)->pNext;             \
+        while (pClearNode_ != (pHeader))                                \
+        {                                                               \
+            type::LL2CircNode * pClearNext_ = pClearNode_->pNext;       \
+            pClearNode_->pPrev = nullptr;                               \
+            pClearNode_->pNext = nullptr;                               \
+            pClearNode_ = pClearNext_;                                  \
+        }                                                               \
+        LL2CircInit_(pHeader);                                          \
+    } while(0)
+
+#define LL2CircClear(type, list)                                        \
+    LL2CircClear_(type, &list.header, list.offset)
+
+#define LL2CircRefClear(type, listRef)                                  \
+    LL2CircClear_(type, listRef.pHeader, listRef.offset)
+
+
+
+// NOTE - Remove 'it' inside the body with LL2CircRemoveWhileIterating, like LL2RemoveWhileIterating for ForLL2_.
+//  A plain LL2CircRemove of 'it' nulls its links, and the loop's Next would then dereference null.
+#define ForLL2Circ_(type, it, pHeader, listOffset)                      \
+    for (type * it = LL2CircHead_(type, pHeader, listOffset); it; it = LL2CircNext_(type, pHeader, listOffset, it))
+
+#define ForLL2Circ(type, it, list)                                      \
+    ForLL2Circ_(type, it, &list.header, list.offset)
+
+#define ForLL2CircRef(type, it, listRef)                                \
+    ForLL2Circ_(type, it, listRef.pHeader, listRef.offset)
+
+
+
+// NOTE - Do not try to use 'it' after calling this! Just let the loop run to the next iteration. 'it' is left on the
+//  previous node, which for the head is the header itself (a fake item, like LL2RemoveWhileIterating's @Hack, but
+//  here the header really is a node), so no branch is needed.
+#define LL2CircRemoveWhileIterating_(type, listOffset, it)              \
+    do {                                                                \
+        type::LL2CircNode * pRemovePrev_ = LL2CircNodePtr_(type, it, listOffset)->pPrev; \
+        LL2CircRemove_(type, listOffset, it);                           \
+        it = LL2CircItem_(type, pRemovePrev_, listOffset);              \
+    } while(0)
+
+#define LL2CircRemoveWhileIterating(type, list, it)                     \
+    LL2CircRemoveWhileIterating_(type, list.offset, it)
+
+#define LL2CircRefRemoveWhileIterating(type, listRef, it)               \
+    LL2CircRemoveWhileIterating_(type, listRef.offset, it)
+
+
+
+//
+// Side-table doubly linked list
+//
+
+// NOTE - Same operations as LL2, but the links don't live in the objects at all: they are two dense arrays of 32-bit
+//  indices (a link table) owned by whoever owns the objects, and objects are named by their index. A walk then only
+//  touches the next[] array, which for counting, finding by index, splicing etc. means a few cache lines instead of
+//  one object line per hop. Any number of lists can share one link table, with each object on at most one of them
+//  (one table per "link member"). There is no type parameter, and no Ref variant since every list is an LL2Soa.
+//
+//  Links are stored +1, the way LL2Compact does it, so zeroed tables and lists are unlinked/empty: aiPrev is 0 for
+//  an unlinked object and LL2SoaEndOfList_ for a head, aiNext is 0 for a tail. The accessors return plain indices,
+//  with LL2SoaNil where LL2 would return nullptr, and the encoding makes Next a single subtract.
+#define LL2SoaEndOfList_ 0xFFFFFFFF
+#define LL2SoaNil 0xFFFFFFFF
+
+struct LL2SoaTable
+{
+    uint32_t * aiPrev;
+    uint32_t * aiNext;
+    uint32_t cItem;
+};
+
+struct LL2Soa
+{
+    LL2SoaTable * pTable;
+    uint32_t iHead;
+    uint32_t iTail;
+};
+
+// NOTE - The arrays must hold cItem entries each. They are zeroed here, i.e. every object starts out unlinked.
+#define LL2SoaTableInit(table, aiPrev_, aiNext_, cItem_)                \
+    do {                                                                \
+        (table).aiPrev = (aiPrev_);                                     \
+        (table).aiNext = (aiNext_);                                     \
+        (table).cItem = (cItem_);                                       \
+        for (uint32_t iInit_ = 0; iInit_ < (table).cItem; iInit_++)     \
+        {                                                               \
+            (table).aiPrev[iInit_] = 0;                                 \
+            (table).aiNext[iInit_] = 0;                                 \
+        }                                                               \
+    } while(0)
+
+#define LL2SoaInit(list, pTable_)                                       \
+    do {                                                                \
+        (list).pTable = (pTable_);                                      \
+        (list).iHead = 0;                                               \
+        (list).iTail = 0;                                               \
+    } while(0)
+
+
+
+#define LL2SoaLink_(iItem)                                              \
+    ((uint32_t)(iItem) + 1)
+
+#define LL2SoaIsItemLinked_(pTable, iItem)                              \
+    ((pTable)->aiPrev[iItem] != 0)
+
+// NOTE - Same caveat as LL2IsItemLinked, for the lists sharing this table
+#define LL2SoaIsItemLinked(list, iItem)                                 \
+    LL2SoaIsItemLinked_((list).pTable, iItem)
+
+
+
+// NOTE - An empty list's 0 wraps around to LL2SoaNil
+#define LL2SoaHead_(piListHead)                                         \
+    (*(piListHead) - 1)
+
+#define LL2SoaHead(list)                                                \
+    LL2SoaHead_(&(list).iHead)
+
+#define LL2SoaTail(list)                                                \
+    LL2SoaHead_(&(list).iTail)
+
+#define LL2SoaNext_(pTable, iItem)                                      \
+    ((pTable)->aiNext[iItem] - 1)
+
+#define LL2SoaNext(list, iItem)                                         \
+    LL2SoaNext_((list).pTable, iItem)
+
+// NOTE - LL2SoaEndOfList_ is LL2SoaNil, so it passes through unchanged
+#define LL2SoaPrev_(pTable, iItem)                                      \
+    ((pTable)->aiPrev[iItem] - ((pTable)->aiPrev[iItem] != LL2SoaEndOfList_))
+
+#define LL2SoaPrev(list, iItem)                                         \
+    LL2SoaPrev_((list).pTable, iItem)
+
+
+
+#define LL2SoaIsEmpty_(piListHead)                                      \
+    (!*(piListHead))
+
+#define LL2SoaIsEmpty(list)                                             \
+    LL2SoaIsEmpty_(&(list).iHead)
+
+
+
+#define LL2SoaAddHead_(pTable, piListHead, piListTail, iItem)           \
+    do {                                                                \
+        uint32_t iAdd_ = (iItem);                                       \
+        if (LL2SoaIsItemLinked_(pTable, iAdd_))                         \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        uint32_t linkAdd_ = LL2SoaLink_(iAdd_);                         \
+        uint32_t linkOldHead_ = *(piListHead);                          \
+        if (linkOldHead_) (pTable)->aiPrev[linkOldHead_ - 1] = linkAdd_; \
+        else *(piListTail) = linkAdd_;                                  \
+        (pTable)->aiNext[iAdd_] = linkOldHead_;                         \
+        (pTable)->aiPrev[iAdd_] = LL2SoaEndOfList_;                     \
+        *(piListHead) = linkAdd_;                                       \
+    } while(0)
+
+#define LL2SoaAddHead(list, iItem)                                      \
+    LL2SoaAddHead_((list).pTable, &(list).iHead, &(list).iTail, iItem)
+
+#define LL2SoaAdd(list, iItem)                                          \
+    LL2SoaAddHead(list, iItem)
+
+
+
+#define LL2SoaAddTail_(pTable, piListHead, piListTail, iItem)           \
+    do {                                                                \
+        uint32_t iAdd_ = (iItem);                                       \
+        if (LL2SoaIsItemLinked_(pTable, iAdd_))                         \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        uint32_t linkAdd_ = LL2SoaLink_(iAdd_);                         \
+        uint32_t linkOldTail_ = *(piListTail);                          \
+        if (linkOldTail_) (pTable)->aiNext[linkOldTail_ - 1] = linkAdd_; \
+        else *(piListHead) = linkAdd_;                                  \
+        (pTable)->aiPrev[iAdd_] = linkOldTail_ ? linkOldTail_ : LL2SoaEndOfList_; \
+        (pTable)->aiNext[iAdd_] = 0;                                    \
+        *(piListTail) = linkAdd_;                                       \
+    } while(0)
+
+#define LL2SoaAddTail(list, iItem)                                      \
+    LL2SoaAddTail_((list).pTable, &(list).iHead, &(list).iTail, iItem)
+
+
+
+#define LL2SoaRemove_(pTable, piListHead, piListTail, iItem)            \
+    do {                                                                \
+        uint32_t iRemove_ = (iItem);                                    \
+        if (!LL2SoaIsItemLinked_(pTable, iRemove_)) break;              \
+        uint32_t linkPrev_ = (pTable)->aiPrev[iRemove_];                \
+        uint32_t linkNext_ = (pTable)->aiNext[iRemove_];                \
+        if (linkPrev_ != LL2SoaEndOfList_) (pTable)->aiNext[linkPrev_ - 1] = linkNext_; \
+        else *(piListHead) = linkNext_;                                 \
+        if (linkNext_) (pTable)->aiPrev[linkNext_ - 1] = linkPrev_;     \
+        else *(piListTail) = (linkPrev_ != LL2SoaEndOfList_) ? linkPrev_ : 0; \
+        (pTable)->aiPrev[iRemove_] = 0;                                 \
+        (pTable)->aiNext[iRemove_] = 0;                                 \
+    } while(0)
+
+#define LL2SoaRemove(list, iItem)                                       \
+    LL2SoaRemove_((list).pTable, &(list).iHead, &(list).iTail, iItem)
+
+
+
+// NOTE - iItemNext of LL2SoaNil inserts at the tail
+#define LL2SoaInsertBefore_(pTable, piListHead, piListTail, iItem, iItemNext) \
+    do {                                                                \
+        uint32_t iInsert_ = (iItem);                                    \
+        uint32_t iInsertNext_ = (iItemNext);                            \
+        if (iInsertNext_ == LL2SoaNil) LL2SoaAddTail_(pTable, piListHead, piListTail, iInsert_); \
+        else if (LL2SoaLink_(iInsertNext_) == *(piListHead)) LL2SoaAddHead_(pTable, piListHead, piListTail, iInsert_); \
+        else {                                                          \
+            if (LL2SoaIsItemLinked_(pTable, iInsert_))                  \
+            {                                                           \
+                LL_ASSERT(false);                                       \
+                break;                                                  \
+            }                                                           \
+            uint32_t linkInsertPrev_ = (pTable)->aiPrev[iInsertNext_];  \
+            (pTable)->aiNext[linkInsertPrev_ - 1] = LL2SoaLink_(iInsert_); \
+            (pTable)->aiPrev[iInsert_] = linkInsertPrev_;               \
+            (pTable)->aiNext[iInsert_] = LL2SoaLink_(iInsertNext_);     \
+            (pTable)->aiPrev[iInsertNext_] = LL2SoaLink_(iInsert_);     \
+        }                                                               \
+    } while(0)
+
+#define LL2SoaInsertBefore(list, iItem, iItemNext)                      \
+    LL2SoaInsertBefore_((list).pTable, &(list).iHead, &(list).iTail, iItem, iItemNext)
+
+
+
+// NOTE - iAssignTo gets LL2SoaNil if the list is empty
+#define LL2SoaRemoveHead_(pTable, piListHead, piListTail, iAssignTo)    \
+    do {                                                                \
+        iAssignTo = LL2SoaHead_(piListHead);                            \
+        if (iAssignTo != LL2SoaNil) LL2SoaRemove_(pTable, piListHead, piListTail, iAssignTo); \
+    } while (0)
+
+#define LL2SoaRemoveHead(list, iAssignTo)                               \
+    LL2SoaRemoveHead_((list).pTable, &(list).iHead, &(list).iTail, iAssignTo)
+
+#define LL2SoaRemoveTail_(pTable, piListHead, piListTail, iAssignTo)    \
+    do {                                                                \
+        iAssignTo = LL2SoaHead_(piListTail);                            \
+        if (iAssignTo != LL2SoaNil) LL2SoaRemove_(pTable, piListHead, piListTail, iAssignTo); \
+    } while (0)
+
+#define LL2SoaRemoveTail(list, iAssignTo)                               \
+    LL2SoaRemoveTail_((list).pTable, &(list).iHead, &(list).iTail, iAssignTo)
+
+
+
+// NOTE - Same as LL2MoveToHead_: iItem must already be on this list
+#define LL2SoaMoveToHead_(pTable, piListHead, piListTail, iItem)        \
+    do {                                                                \
+        uint32_t iMove_ = (iItem);                                      \
+        if (LL2SoaLink_(iMove_) == *(piListHead)) break;                \
+        uint32_t linkMovePrev_ = (pTable)->aiPrev[iMove_];              \
+        uint32_t linkMoveNext_ = (pTable)->aiNext[iMove_];              \
+        (pTable)->aiNext[linkMovePrev_ - 1] = linkMoveNext_;            \
+        if (linkMoveNext_) (pTable)->aiPrev[linkMoveNext_ - 1] = linkMovePrev_; \
+        else *(piListTail) = linkMovePrev_;                             \
+        (pTable)->aiPrev[iMove_] = LL2SoaEndOfList_;                    \
+        (pTable)->aiNext[iMove_] = *(piListHead);                       \
+        (pTable)->aiPrev[*(piListHead) - 1] = LL2SoaLink_(iMove_);      \
+        *(piListHead) = LL2SoaLink_(iMove_);                            \
+    } while(0)
+
+#define LL2SoaMoveToHead(list, iItem)                                   \
+    LL2SoaMoveToHead_((list).pTable, &(list).iHead, &(list).iTail, iItem)
+
+
+
+#define LL2SoaClear_(pTable, piListHead, piListTail)                    \
+    do {                                                                \
+        uint32_t linkClear_ = *(piListHead);                            \
+        while (linkClear_)                                              \
+        {                                                               \
+            uint32_t linkClearNext_ = (pTable)->aiNext[linkClear_ - 1]; \
+            (pTable)->aiPrev[linkClear_ - 1] = 0;                       \
+            (pTable)->aiNext[linkClear_ - 1] = 0;                       \
+            linkClear_ = linkClearNext_;                                \
+        }                                                               \
+        *(piListHead) = 0;                                              \
+        *(piListTail) = 0;                                              \
+    } while(0)
+
+#define LL2SoaClear(list)                                               \
+    LL2SoaClear_((list).pTable, &(list).iHead, &(list).iTail)
+
+#define LL2SoaClearWithoutUnlinking(list)                               \
+    do {                                                                \
+        (list).iHead = 0;                                               \
+        (list).iTail = 0;                                               \
+    } while(0)
+
+
+
+// NOTE - Appends all of list 1 to list 0, leaving list 1 empty. Both must share a table.
+#define LL2SoaCombine_(pTable, piList0Head, piList0Tail, piList1Head, piList1Tail) \
+    do {                                                                \
+        if (!*(piList1Head)) break;                                     \
+        if (!*(piList0Head))                                            \
+        {                                                               \
+            *(piList0Head) = *(piList1Head);                            \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            (pTable)->aiNext[*(piList0Tail) - 1] = *(piList1Head);      \
+            (pTable)->aiPrev[*(piList1Head) - 1] = *(piList0Tail);      \
+        }                                                               \
+        *(piList0Tail) = *(piList1Tail);                                \
+        *(piList1Head) = 0;                                             \
+        *(piList1Tail) = 0;                                             \
+    } while(0)
+
+#define LL2SoaCombine(list0, list1)                                     \
+    LL2SoaCombine_((list0).pTable, &(list0).iHead, &(list0).iTail, &(list1).iHead, &(list1).iTail)
+
+
+
+// NOTE - Same rules as LL2SpliceRange_: moves the run [iFirst, iLast] before iDstNext (LL2SoaNil for the tail). O(1).
+#define LL2SoaSpliceRange_(pTable, piSrcHead, piSrcTail, piDstHead, piDstTail, iFirst, iLast, iDstNext) \
+    do {                                                                \
+        uint32_t iSpliceFirst_ = (iFirst);                              \
+        uint32_t iSpliceLast_ = (iLast);                                \
+        uint32_t iSpliceDstNext_ = (iDstNext);                          \
+        uint32_t linkBefore_ = (pTable)->aiPrev[iSpliceFirst_];         \
+        uint32_t linkAfter_ = (pTable)->aiNext[iSpliceLast_];           \
+        if (linkBefore_ != LL2SoaEndOfList_) (pTable)->aiNext[linkBefore_ - 1] = linkAfter_; \
+        else *(piSrcHead) = linkAfter_;                                 \
+        if (linkAfter_) (pTable)->aiPrev[linkAfter_ - 1] = linkBefore_; \
+        else *(piSrcTail) = (linkBefore_ != LL2SoaEndOfList_) ? linkBefore_ : 0; \
+        uint32_t linkDstPrev_;                                          \
+        if (iSpliceDstNext_ != LL2SoaNil)                               \
+        {                                                               \
+            linkDstPrev_ = (pTable)->aiPrev[iSpliceDstNext_];           \
+            (pTable)->aiPrev[iSpliceDstNext_] = LL2SoaLink_(iSpliceLast_); \
+            (pTable)->aiNext[iSpliceLast_] = LL2SoaLink_(iSpliceDstNext_); \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            linkDstPrev_ = *(piDstTail) ? *(piDstTail) : LL2SoaEndOfList_; \
+            *(piDstTail) = LL2SoaLink_(iSpliceLast_);                   \
+            (pTable)->aiNext[iSpliceLast_] = 0;                         \
+        }                                                               \
+        (pTable)->aiPrev[iSpliceFirst_] = linkDstPrev_;                 \
+        if (linkDstPrev_ != LL2SoaEndOfList_) (pTable)->aiNext[linkDstPrev_ - 1] = LL2SoaLink_(iSpliceFirst_); \
+        else *(piDstHead) = LL2SoaLink_(iSpliceFirst_);                 \
+    } while(0)
+
+#define LL2SoaSpliceRange(srcList, dstList, iFirst, iLast, iDstNext)    \
+    LL2SoaSpliceRange_((srcList).pTable, &(srcList).iHead, &(srcList).iTail, &(dstList).iHead, &(dstList).iTail, iFirst, iLast, iDstNext)
+
+
+
+#define ForLL2Soa_(it, pTable, piListHead)                              \
+    for (uint32_t it = LL2SoaHead_(piListHead); it != LL2SoaNil; it = LL2SoaNext_(pTable, it))
+
+#define ForLL2Soa(it, list)                                             \
+    ForLL2Soa_(it, (list).pTable, &(list).iHead)
+
+
+
+// NOTE - O(n), but only reads the next[] array
+#define LL2SoaCount_(pTable, piListHead, cAssignTo)                     \
+    do {                                                                \
+        cAssignTo = 0;                                                  \
+        ForLL2Soa_(iCount_, pTable, piListHead) cAssignTo++;            \
+    } while(0)
+
+#define LL2SoaCount(list, cAssignTo)                                    \
+    LL2SoaCount_((list).pTable, &(list).iHead, cAssignTo)
+
+// NOTE - First index for which pred(iItem) is true, or LL2SoaNil. Only reads the next[] array, plus whatever pred
+//  reads.
+#define LL2SoaFind_(pTable, piListHead, pred, iAssignTo)                \
+    do {                                                                \
+        iAssignTo = LL2SoaNil;                                          \
+        ForLL2Soa_(iFind_, pTable, piListHead)                          \
+        {                                                               \
+            if (pred(iFind_))                                           \
+            {                                                           \
+                iAssignTo = iFind_;                                     \
+                break;                                                  \
+            }                                                           \
+        }                                                               \
+    } while(0)
+
+#define LL2SoaFind(list, pred, iAssignTo)                               \
+    LL2SoaFind_((list).pTable, &(list).iHead, pred, iAssignTo)
+
+
+
+//
+// C++ template layer
+//
+
+// NOTE - Counterpart of the DefineLL1/DefineLL2 macros where the link member is a template argument
+//  (ll::List<T, &T::node>) instead of a runtime offset. Node access folds to a constant offset, refs are just the two
+//  head/tail pointers, and iteration works with range-based for. The node types, the nullptr/LLEndOfList_
+//  conventions and the memory layout of a list (pHead, pTail) are the same as the macro versions, so the two can be
+//  mixed freely on the same objects.
+//
+//  Usage:
+//      struct Foo { DefineLL2Node(Foo); LL2Node node; };
+//      ll::List<Foo, &Foo::node> list;
+//      list.AddTail(&foo);
+//      for (Foo * it : list) { ... }
+namespace ll
+{
+    template <typename T, typename T::LL2Node T::* Link>
+    struct List2Ops_
+    {
+        typedef typename T::LL2Node Node;
+
+        static Node * NodePtr(T * pItem) { return &(pItem->*Link); }
+        static T * EndOfList() { return (T *)LLEndOfList_; }
+
+        static bool IsItemLinked(T * pItem) { return NodePtr(pItem)->pPrev != nullptr; }
+
+        static T * Next(T * pItem)
+        {
+            T * pNext = NodePtr(pItem)->pNext;
+            return (pNext == EndOfList()) ? nullptr : pNext;
+        }
+
+        static T * Prev(T * pItem)
+        {
+            T * pPrev = NodePtr(pItem)->pPrev;
+            return (pPrev == EndOfList()) ? nullptr : pPrev;
+        }
+
+        static void AddHead(T ** ppHead, T ** ppTail, T * pItem)
+        {
+            if (IsItemLinked(pItem))
+            {
+                LL_ASSERT(false);
+                return;
+            }
+
+            Node * itemNode = NodePtr(pItem);
+            if (*ppHead)
+            {
+                NodePtr(*ppHead)->pPrev = pItem;
+                itemNode->pNext = *ppHead;
+            }
+            else
+            {
+                itemNode->pNext = EndOfList();
+                *ppTail = pItem;
+            }
+            itemNode->pPrev = EndOfList();
+            *ppHead = pItem;
+        }
+
+        static void AddTail(T ** ppHead, T ** ppTail, T * pItem)
+        {
+            if (IsItemLinked(pItem))
+            {
+                LL_ASSERT(false);
+                return;
+            }
+
+            Node * itemNode = NodePtr(pItem);
+            if (*ppTail)
+            {
+                NodePtr(*ppTail)->pNext = pItem;
+                itemNode->pPrev = *ppTail;
+            }
+            else
+            {
+                itemNode->pPrev = EndOfList();
+                *ppHead = pItem;
+            }
+            itemNode->pNext = EndOfList();
+            *ppTail = pItem;
+        }
+
+        static void Remove(T ** ppHead, T ** ppTail, T * pItem)
+        {
+            Node * node = NodePtr(pItem);
+            if (!IsItemLinked(pItem)) return;
+
+            T * pPrev = node->pPrev;
+            T * pNext = node->pNext;
+            bool hasNext = pNext != EndOfList();
+            bool hasPrev = pPrev != EndOfList();
+            if (hasNext && hasPrev)
+            {
+                NodePtr(pNext)->pPrev = pPrev;
+                NodePtr(pPrev)->pNext = pNext;
+            }
+            else if (hasNext && !hasPrev)
+            {
+                NodePtr(pNext)->pPrev = EndOfList();
+                *ppHead = pNext;
+            }
+            else if (!hasNext && hasPrev)
+            {
+                NodePtr(pPrev)->pNext = EndOfList();
+                *ppTail = pPrev;
+            }
+            else
+            {
+                *ppHead = nullptr;
+                *ppTail = nullptr;
+            }
+            node->pPrev = nullptr;
+            node->pNext = nullptr;
+        }
+
+        static void InsertBefore(T ** ppHead, T ** ppTail, T * pItem, T * pItemNext)
+        {
+            if (!pItemNext) { AddTail(ppHead, ppTail, pItem); return; }
+            if (pItemNext == *ppHead) { AddHead(ppHead, ppTail, pItem); return; }
+
+            if (IsItemLinked(pItem))
+            {
+                LL_ASSERT(false);
+                return;
+            }
+
+            Node * node = NodePtr(pItem);
+            Node * nextNode = NodePtr(pItemNext);
+            T * pItemPrev = nextNode->pPrev;
+            NodePtr(pItemPrev)->pNext = pItem;
+            nextNode->pPrev = pItem;
+            node->pNext = pItemNext;
+            node->pPrev = pItemPrev;
+        }
+
+        static T * RemoveHead(T ** ppHead, T ** ppTail)
+        {
+            T * pHeadToRemove = *ppHead;
+            if (pHeadToRemove) Remove(ppHead, ppTail, pHeadToRemove);
+            return pHeadToRemove;
+        }
+
+        static T * RemoveTail(T ** ppHead, T ** ppTail)
+        {
+            T * pTailToRemove = *ppTail;
+            if (pTailToRemove) Remove(ppHead, ppTail, pTailToRemove);
+            return pTailToRemove;
+        }
+
+        // NOTE - See LL2MoveToHead_
+        static void MoveToHead(T ** ppHead, T ** ppTail, T * pItem)
+        {
+            T * pHead = *ppHead;
+            if (pItem == pHead) return;
+
+            Node * node = NodePtr(pItem);
+            T * pPrev = node->pPrev;
+            T * pNext = node->pNext;
+            NodePtr(pPrev)->pNext = pNext;
+            if (pNext != EndOfList()) NodePtr(pNext)->pPrev = pPrev;
+            else *ppTail = pPrev;
+
+            node->pPrev = EndOfList();
+            node->pNext = pHead;
+            NodePtr(pHead)->pPrev = pItem;
+            *ppHead = pItem;
+        }
+
+        static void Clear(T ** ppHead, T ** ppTail)
+        {
+            while (*ppHead)
+            {
+                Node * headNode = NodePtr(*ppHead);
+                T * pHeadNext = Next(*ppHead);
+                headNode->pNext = nullptr;
+                headNode->pPrev = nullptr;
+                *ppHead = pHeadNext;
+            }
+            *ppTail = nullptr;
+        }
+
+        // NOTE - List 1 is cleared
+        static void Combine(T ** ppHead0, T ** ppTail0, T ** ppHead1, T ** ppTail1)
+        {
+            if (!*ppHead0)
+            {
+                *ppHead0 = *ppHead1;
+                *ppTail0 = *ppTail1;
+            }
+            else if (*ppHead1)
+            {
+                NodePtr(*ppTail0)->pNext = *ppHead1;
+                NodePtr(*ppHead1)->pPrev = *ppTail0;
+                *ppTail0 = *ppTail1;
+            }
+            *ppHead1 = nullptr;
+            *ppTail1 = nullptr;
+        }
+
+        // NOTE - See LL2SplitAt_
+        static void SplitAt(T ** ppHead, T ** ppTail, T ** ppNewHead, T ** ppNewTail, T * pItem)
+        {
+            if (*ppNewHead)
+            {
+                LL_ASSERT(false);
+                return;
+            }
+
+            Node * splitNode = NodePtr(pItem);
+            T * pPrev = splitNode->pPrev;
+            *ppNewHead = pItem;
+            *ppNewTail = *ppTail;
+            splitNode->pPrev = EndOfList();
+            if (pPrev != EndOfList())
+            {
+                NodePtr(pPrev)->pNext = EndOfList();
+                *ppTail = pPrev;
+            }
+            else
+            {
+                *ppHead = nullptr;
+                *ppTail = nullptr;
+            }
+        }
+
+        // NOTE - This assumes that the newAddress has its intrusive pointers already set properly
+        static void Relocate(T ** ppHead, T ** ppTail, T * prevAddress, T * newAddress)
+        {
+            if (*ppHead == prevAddress) *ppHead = newAddress;
+            if (*ppTail == prevAddress) *ppTail = newAddress;
+
+            if (T * pPrev = Prev(newAddress))
+            {
+                LL_ASSERT(Next(pPrev) == prevAddress);
+                NodePtr(pPrev)->pNext = newAddress;
+            }
+
+            if (T * pNext = Next(newAddress))
+            {
+                LL_ASSERT(Prev(pNext) == prevAddress);
+                NodePtr(pNext)->pPrev = newAddress;
+            }
+        }
+    };
+
+    template <typename T, typename T::LL1Node T::* Link>
+    struct List1Ops_
+    {
+        typedef typename T::LL1Node Node;
+
+        static Node * NodePtr(T * pItem) { return &(pItem->*Link); }
+        static T * EndOfList() { return (T *)LLEndOfList_; }
+
+        static bool IsItemLinked(T * pItem) { return NodePtr(pItem)->pNext != nullptr; }
+
+        static T * Next(T * pItem)
+        {
+            T * pNext = NodePtr(pItem)->pNext;
+            return (pNext == EndOfList()) ? nullptr : pNext;
+        }
+
+        static void AddHead(T ** ppHead, T ** ppTail, T * pItem)
+        {
+            if (IsItemLinked(pItem))
+            {
+                LL_ASSERT(false);
+                return;
+            }
+
+            if (*ppHead)
+            {
+                NodePtr(pItem)->pNext = *ppHead;
+            }
+            else
+            {
+                NodePtr(pItem)->pNext = EndOfList();
+                *ppTail = pItem;
+            }
+            *ppHead = pItem;
+        }
+
+        static void AddTail(T ** ppHead, T ** ppTail, T * pItem)
+        {
+            if (IsItemLinked(pItem))
+            {
+                LL_ASSERT(false);
+                return;
+            }
+
+            if (*ppTail)
+            {
+                NodePtr(*ppTail)->pNext = pItem;
+            }
+            else
+            {
+                *ppHead = pItem;
+            }
+            NodePtr(pItem)->pNext = EndOfList();
+            *ppTail = pItem;
+        }
+
+        // NOTE - Inserts after pItemPrev, or at the head if pItemPrev is null
+        static void InsertAfter(T ** ppHead, T ** ppTail, T * pItem, T * pItemPrev)
+        {
+            if (!pItemPrev) { AddHead(ppHead, ppTail, pItem); return; }
+            if (pItemPrev == *ppTail) { AddTail(ppHead, ppTail, pItem); return; }
+
+            if (IsItemLinked(pItem))
+            {
+                LL_ASSERT(false);
+                return;
+            }
+
+            NodePtr(pItem)->pNext = NodePtr(pItemPrev)->pNext;
+            NodePtr(pItemPrev)->pNext = pItem;
+        }
+
+        // NOTE - Removes the item after pItemPrev, or the head if pItemPrev is null
+        static T * RemoveAfter(T ** ppHead, T ** ppTail, T * pItemPrev)
+        {
+            T * pToRemove = pItemPrev ? Next(pItemPrev) : *ppHead;
+            if (!pToRemove) return nullptr;
+
+            T * pNext = NodePtr(pToRemove)->pNext;
+            if (pItemPrev)
+            {
+                NodePtr(pItemPrev)->pNext = pNext;
+            }
+            else
+            {
+                *ppHead = (pNext == EndOfList()) ? nullptr : pNext;
+            }
+
+            if (pToRemove == *ppTail) *ppTail = pItemPrev;
+            NodePtr(pToRemove)->pNext = nullptr;
+            return pToRemove;
+        }
+
+        static T * RemoveHead(T ** ppHead, T ** ppTail)
+        {
+            return RemoveAfter(ppHead, ppTail, nullptr);
+        }
+
+        static void Clear(T ** ppHead, T ** ppTail)
+        {
+            while (*ppHead)
+            {
+                T * pHeadNext = Next(*ppHead);
+                NodePtr(*ppHead)->pNext = nullptr;
+                *ppHead = pHeadNext;
+            }
+            *ppTail = nullptr;
+        }
+
+        // NOTE - List 1 is cleared
+        static void Combine(T ** ppHead0, T ** ppTail0, T ** ppHead1, T ** ppTail1)
+        {
+            if (!*ppHead0)
+            {
+                *ppHead0 = *ppHead1;
+                *ppTail0 = *ppTail1;
+            }
+            else if (*ppHead1)
+            {
+                NodePtr(*ppTail0)->pNext = *ppHead1;
+                *ppTail0 = *ppTail1;
+            }
+            *ppHead1 = nullptr;
+            *ppTail1 = nullptr;
+        }
+    };
+
+    template <typename Ops, typename T>
+    struct ListIterator_
+    {
+        T * pItem;
+
+        T * operator*() const { return pItem; }
+        ListIterator_ & operator++() { pItem = Ops::Next(pItem); return *this; }
+        bool operator==(const ListIterator_ & other) const { return pItem == other.pItem; }
+        bool operator!=(const ListIterator_ & other) const { return pItem != other.pItem; }
+    };
+
+    // NOTE - Shared API for List/ListRef. Derived provides HeadPtr()/TailPtr().
+    template <typename Derived, typename T, typename T::LL2Node T::* Link>
+    struct List2Api_
+    {
+        typedef List2Ops_<T, Link> Ops;
+        typedef ListIterator_<Ops, T> Iterator;
+
+        T ** ppHead_() { return static_cast<Derived *>(this)->HeadPtr(); }
+        T ** ppTail_() { return static_cast<Derived *>(this)->TailPtr(); }
+
+        static typename T::LL2Node * NodePtr(T * pItem) { return Ops::NodePtr(pItem); }
+
+        // NOTE - Same caveat as LL2IsItemLinked
+        static bool IsItemLinked(T * pItem) { return Ops::IsItemLinked(pItem); }
+        static T * Next(T * pItem) { return Ops::Next(pItem); }
+        static T * Prev(T * pItem) { return Ops::Prev(pItem); }
+
+        T * Head() { return *ppHead_(); }
+        T * Tail() { return *ppTail_(); }
+        bool IsEmpty() { return !*ppHead_(); }
+
+        void AddHead(T * pItem) { Ops::AddHead(ppHead_(), ppTail_(), pItem); }
+        void Add(T * pItem) { Ops::AddHead(ppHead_(), ppTail_(), pItem); }
+        void AddTail(T * pItem) { Ops::AddTail(ppHead_(), ppTail_(), pItem); }
+        void Remove(T * pItem) { Ops::Remove(ppHead_(), ppTail_(), pItem); }
+        void InsertBefore(T * pItem, T * pItemNext) { Ops::InsertBefore(ppHead_(), ppTail_(), pItem, pItemNext); }
+        T * RemoveHead() { return Ops::RemoveHead(ppHead_(), ppTail_()); }
+        T * RemoveTail() { return Ops::RemoveTail(ppHead_(), ppTail_()); }
+        void MoveToHead(T * pItem) { Ops::MoveToHead(ppHead_(), ppTail_(), pItem); }
+        void Clear() { Ops::Clear(ppHead_(), ppTail_()); }
+        void ClearWithoutUnlinking() { *ppHead_() = nullptr; *ppTail_() = nullptr; }
+        void Relocate(T * prevAddress, T * newAddress) { Ops::Relocate(ppHead_(), ppTail_(), prevAddress, newAddress); }
+
+        // NOTE - other is cleared
+        template <typename Other>
+        void Combine(Other & other) { Ops::Combine(ppHead_(), ppTail_(), other.HeadPtr(), other.TailPtr()); }
+
+        // NOTE - pItem and everything after it move to other, which must be empty. O(1).
+        template <typename Other>
+        void SplitAt(Other & other, T * pItem) { Ops::SplitAt(ppHead_(), ppTail_(), other.HeadPtr(), other.TailPtr(), pItem); }
+
+        // NOTE - Removing the current item while iterating is not supported, grab Next() first (or use the macros)
+        Iterator begin() { Iterator result = { *ppHead_() }; return result; }
+        Iterator end() { Iterator result = { nullptr }; return result; }
+    };
+
+    template <typename Derived, typename T, typename T::LL1Node T::* Link>
+    struct List1Api_
+    {
+        typedef List1Ops_<T, Link> Ops;
+        typedef ListIterator_<Ops, T> Iterator;
+
+        T ** ppHead_() { return static_cast<Derived *>(this)->HeadPtr(); }
+        T ** ppTail_() { return static_cast<Derived *>(this)->TailPtr(); }
+
+        static typename T::LL1Node * NodePtr(T * pItem) { return Ops::NodePtr(pItem); }
+
+        // NOTE - Same caveat as LL1IsItemLinked
+        static bool IsItemLinked(T * pItem) { return Ops::IsItemLinked(pItem); }
+        static T * Next(T * pItem) { return Ops::Next(pItem); }
+
+        T * Head() { return *ppHead_(); }
+        T * Tail() { return *ppTail_(); }
+        bool IsEmpty() { return !*ppHead_(); }
+
+        void AddHead(T * pItem) { Ops::AddHead(ppHead_(), ppTail_(), pItem); }
+        void Add(T * pItem) { Ops::AddHead(ppHead_(), ppTail_(), pItem); }
+        void AddTail(T * pItem) { Ops::AddTail(ppHead_(), ppTail_(), pItem); }
+        void InsertAfter(T * pItem, T * pItemPrev) { Ops::InsertAfter(ppHead_(), ppTail_(), pItem, pItemPrev); }
+        T * RemoveAfter(T * pItemPrev) { return Ops::RemoveAfter(ppHead_(), ppTail_(), pItemPrev); }
+        T * RemoveHead() { return Ops::RemoveHead(ppHead_(), ppTail_()); }
+        void Clear() { Ops::Clear(ppHead_(), ppTail_()); }
+        void ClearWithoutUnlinking() { *ppHead_() = nullptr; *ppTail_() = nullptr; }
+
+        // NOTE - other is cleared
+        template <typename Other>
+        void Combine(Other & other) { Ops::Combine(ppHead_(), ppTail_(), other.HeadPtr(), other.TailPtr()); }
+
+        Iterator begin() { Iterator result = { *ppHead_() }; return result; }
+        Iterator end() { Iterator result = { nullptr }; return result; }
+    };
+
+    template <typename T, typename T::LL2Node T::* Link>
+    struct List : List2Api_<List<T, Link>, T, Link>
+    {
+        T * pHead = nullptr;
+        T * pTail = nullptr;
+
+        T ** HeadPtr() { return &pHead; }
+        T ** TailPtr() { return &pTail; }
+    };
+
+    // NOTE - Can point at an ll::List or at a list made with DefineLL2 (anything with pHead/pTail members) that uses
+    //  the same link member.
+    template <typename T, typename T::LL2Node T::* Link>
+    struct ListRef : List2Api_<ListRef<T, Link>, T, Link>
+    {
+        T ** ppHead;
+        T ** ppTail;
+
+        template <typename L>
+        ListRef(L & list) : ppHead(&list.pHead), ppTail(&list.pTail) {}
+        ListRef(ListRef & other) : ppHead(other.ppHead), ppTail(other.ppTail) {}
+        ListRef(const ListRef & other) : ppHead(other.ppHead), ppTail(other.ppTail) {}
+        ListRef(T ** ppHead_, T ** ppTail_) : ppHead(ppHead_), ppTail(ppTail_) {}
+
+        T ** HeadPtr() { return ppHead; }
+        T ** TailPtr() { return ppTail; }
+    };
+
+    template <typename T, typename T::LL1Node T::* Link>
+    struct List1 : List1Api_<List1<T, Link>, T, Link>
+    {
+        T * pHead = nullptr;
+        T * pTail = nullptr;
+
+        T ** HeadPtr() { return &pHead; }
+        T ** TailPtr() { return &pTail; }
+    };
+
+    template <typename T, typename T::LL1Node T::* Link>
+    struct List1Ref : List1Api_<List1Ref<T, Link>, T, Link>
+    {
+        T ** ppHead;
+        T ** ppTail;
+
+        template <typename L>
+        List1Ref(L & list) : ppHead(&list.pHead), ppTail(&list.pTail) {}
+        List1Ref(List1Ref & other) : ppHead(other.ppHead), ppTail(other.ppTail) {}
+        List1Ref(const List1Ref & other) : ppHead(other.ppHead), ppTail(other.ppTail) {}
+        List1Ref(T ** ppHead_, T ** ppTail_) : ppHead(ppHead_), ppTail(ppTail_) {}
+
+        T ** HeadPtr() { return ppHead; }
+        T ** TailPtr() { return ppTail; }
+    };
+}
+
+
+
+//
+// Author: Andrew Smith - alsmith.net
+// License: MIT
+//
+#endif
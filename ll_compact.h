@@ -0,0 +1,234 @@
+#ifndef ALS_LL_COMPACT_H
+#define ALS_LL_COMPACT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+
+#include "ll.h"
+
+//
+// Incremental compactor that moves the items of an LL2 list into list order in their arena, so walking the list
+//  touches memory sequentially again
+//
+// Requires:
+//  -ll.h
+//  -memcpy (items are moved bytewise, so they must be trivially relocatable)
+//  -std::chrono::steady_clock (time budget)
+//
+// The arena is a plain array of T. The k-th item of the order list is swapped into arena slot iSlotFirst + k, and
+//  whatever was in that slot (another item or a free slot) takes its old place. Each swap goes through a scratch
+//  copy and uses the same fix-ups as LL2Relocate_ (ll::List::Relocate), so neighbours are patched even when the two
+//  items are linked to each other. Every list registered with AddList is patched, so items can sit on any number of
+//  lists through different link members while being compacted.
+//
+// Step does as much as it can within a time budget and can be called again later (e.g. once per frame), with other
+//  list operations in between. Items added or moved behind the placed prefix are simply picked up. If the prefix
+//  itself was disturbed (its head or last item removed), the next Step starts over from the head, which is cheap
+//  for whatever is already in place.
+//
+// Rules while a compaction is running:
+//  -Every list that links items in the arena, through any link member, must be registered with AddList
+//  -Free slots must have their registered link nodes zeroed (as left by Remove, or by zeroing the arena up front), or
+//   be on a registered list themselves, e.g. an LL2 free list. Several registered lists may share a link member (like
+//   a free list through the order list's node), their items' neighbours are then only patched once.
+//  -Pointers to items outside of the registered lists go stale on every Step. Use pfnMoved to patch them.
+//
+// Usage:
+//      struct Obj { DefineLL2Node(Obj); LL2Node node; LL2Node lruNode; ... };
+//      Obj aObj[4096];
+//      ll::Compactor<Obj, &Obj::node> compactor;
+//      compactor.Init(aObj, 4096, objList);
+//      compactor.AddList<&Obj::lruNode>(lruList);
+//      while (!compactor.Step(std::chrono::microseconds(200))) { ... do other work ... }
+//
+
+namespace ll
+{
+    template <typename T, typename T::LL2Node T::* Link>
+    struct Compactor
+    {
+        typedef void (* PfnMoved)(T * pItemOld, T * pItemNew, void * pUserData);
+        typedef void (* PfnRelocate)(T ** ppHead, T ** ppTail, T * prevAddress, T * newAddress);
+        typedef List2Ops_<T, Link> OrderOps;
+
+        enum
+        {
+            s_cListMax = 8,
+            s_cSwapPerClockCheck = 32,      // Reading the clock costs about as much as a few swaps
+        };
+
+        struct CompactList_
+        {
+            T ** ppHead;
+            T ** ppTail;
+            PfnRelocate pfnRelocate;
+            bool isLinkShared;              // An earlier list uses the same link member, only patch head/tail
+        };
+
+        T * aItem = nullptr;
+        uintptr_t cItem = 0;
+        uintptr_t iSlotFirst = 0;
+
+        // NOTE - Next slot to fill. Slots [iSlotFirst, iSlot) hold the start of the order list, in order.
+        uintptr_t iSlot = 0;
+
+        CompactList_ aList[s_cListMax];
+        int cList = 0;                      // aList[0] is the order list
+
+        PfnMoved pfnMoved = nullptr;
+        void * pUserData = nullptr;
+
+        uint64_t cSwap = 0;
+
+        alignas(T) unsigned char aScratch[sizeof(T)];
+
+        // NOTE - The order list is registered automatically. Items are packed from aItem[iSlotFirst_] onwards.
+        //  pfnMoved (optional) is called for both sides of every swap, after both have moved. One side may be a free
+        //  slot.
+        void Init(T * aItem_, uintptr_t cItem_, ListRef<T, Link> order, uintptr_t iSlotFirst_ = 0, PfnMoved pfnMoved_ = nullptr, void * pUserData_ = nullptr)
+        {
+            LL_ASSERT(iSlotFirst_ <= cItem_);
+
+            aItem = aItem_;
+            cItem = cItem_;
+            iSlotFirst = iSlotFirst_;
+            iSlot = iSlotFirst_;
+            pfnMoved = pfnMoved_;
+            pUserData = pUserData_;
+            cSwap = 0;
+
+            cList = 0;
+            AddList<Link>(order);
+        }
+
+        template <typename T::LL2Node T::* LinkOther>
+        bool AddList(ListRef<T, LinkOther> list)
+        {
+            if (cList == s_cListMax)
+            {
+                LL_ASSERT(false);
+                return false;
+            }
+
+            CompactList_ & compactList = aList[cList++];
+            compactList.ppHead = list.ppHead;
+            compactList.ppTail = list.ppTail;
+            compactList.pfnRelocate = &List2Ops_<T, LinkOther>::Relocate;
+            compactList.isLinkShared = false;
+            for (int iList = 0; iList < cList - 1; iList++)
+            {
+                if (aList[iList].pfnRelocate == compactList.pfnRelocate) compactList.isLinkShared = true;
+            }
+            return true;
+        }
+
+        // NOTE - Starts the next Step over from the head, e.g. after the order list was reordered
+        void Restart()
+        {
+            iSlot = iSlotFirst;
+        }
+
+        // NOTE - Returns true once every item of the order list is in place. The clock is only read every
+        //  s_cSwapPerClockCheck swaps, so a call can overrun the budget by that many swaps.
+        bool Step(std::chrono::nanoseconds budget)
+        {
+            typedef std::chrono::steady_clock Clock;
+            Clock::time_point timeEnd = Clock::now() + budget;
+
+            T * pItem = Resume();
+            for (uintptr_t cSwapStep = 0; pItem; )
+            {
+                LL_ASSERT(IsInArena(pItem));
+                LL_ASSERT(iSlot < cItem);
+
+                T * pSlot = &aItem[iSlot];
+                if (pItem != pSlot)
+                {
+                    Swap(pItem, pSlot);
+                    if (!(++cSwapStep % s_cSwapPerClockCheck) && Clock::now() >= timeEnd)
+                    {
+                        iSlot++;
+                        return !OrderOps::Next(pSlot);
+                    }
+                }
+
+                iSlot++;
+                pItem = OrderOps::Next(pSlot);
+            }
+
+            return true;
+        }
+
+        // Internal
+
+        bool IsInArena(T * pItem) const
+        {
+            return (uintptr_t)pItem >= (uintptr_t)aItem && (uintptr_t)pItem < (uintptr_t)(aItem + cItem);
+        }
+
+        // NOTE - The item after the last one placed, if the placed prefix still looks intact: the head is still in the
+        //  first slot and the last placed item is still linked after the one before it. Edits deeper inside the prefix
+        //  aren't detected, call Restart after those.
+        T * Resume()
+        {
+            T * pHead = *aList[0].ppHead;
+            if (iSlot > iSlotFirst)
+            {
+                T * pItemPrev = &aItem[iSlot - 1];
+                bool isIntact = pHead == &aItem[iSlotFirst] && OrderOps::IsItemLinked(pItemPrev);
+                if (isIntact && iSlot - 1 > iSlotFirst) isIntact = OrderOps::Prev(pItemPrev) == &aItem[iSlot - 2];
+                if (isIntact) return OrderOps::Next(pItemPrev);
+
+                iSlot = iSlotFirst;
+            }
+            return pHead;
+        }
+
+        void Move(T * pItemOld, T * pItemNew)
+        {
+            memcpy((void *)pItemNew, (const void *)pItemOld, sizeof(T));
+            for (int iList = 0; iList < cList; iList++)
+            {
+                CompactList_ & compactList = aList[iList];
+                if (compactList.isLinkShared)
+                {
+                    // The neighbours were already patched through the first list with this link member
+
+                    if (*compactList.ppHead == pItemOld) *compactList.ppHead = pItemNew;
+                    if (*compactList.ppTail == pItemOld) *compactList.ppTail = pItemNew;
+                }
+                else
+                {
+                    compactList.pfnRelocate(compactList.ppHead, compactList.ppTail, pItemOld, pItemNew);
+                }
+            }
+        }
+
+        // NOTE - Every step leaves all lists consistent, which is what lets a and b be neighbours
+        void Swap(T * pA, T * pB)
+        {
+            T * pScratch = (T *)aScratch;
+            Move(pA, pScratch);
+            Move(pB, pA);
+            Move(pScratch, pB);
+            cSwap++;
+
+            if (pfnMoved)
+            {
+                pfnMoved(pA, pB, pUserData);
+                pfnMoved(pB, pA, pUserData);
+            }
+        }
+    };
+}
+
+
+
+
+//
+// Author: Andrew Smith - alsmith.net
+// License: MIT
+//
+#endif
@@ -0,0 +1,341 @@
+#ifndef ALS_LL_HASH_H
+#define ALS_LL_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <functional>
+
+#include "ll.h"
+
+//
+// Intrusive chained hash table whose buckets are LL1 chains through an embedded LL1Node, with incremental resizing
+//
+// Requires:
+//  -ll.h
+//  -calloc/free (bucket arrays only)
+//
+// Items are never allocated or copied, the table only links them. A bucket is a single head pointer (no tail), and
+//  chains end with LLEndOfList_ like LL1 lists, so LL1IsItemLinked still tells whether an item is in a table.
+//
+// Growing never rehashes everything at once. When the load passes 1 item per bucket, a table of twice the size is
+//  allocated next to the current one, and every Insert/Remove after that moves at most s_cBucketMovePerOp old buckets
+//  over (a few short chains). That is enough to finish long before the next grow is due. Find checks whichever table
+//  the key's bucket currently lives in, so lookups stay O(1) throughout. ResizeStep can also be called from idle
+//  time to finish sooner. The table never shrinks on its own.
+//
+// Bucket indices use the high bits of a Fibonacci (multiplicative) remix of Hash, so identity hashes like
+//  std::hash<int> still spread over power-of-two tables.
+//
+// Insert doesn't check for an existing item with the same key (Find first if keys must be unique).
+//
+// Usage:
+//      struct Session { uint64_t id; DefineLL1Node(Session) LL1Node hashNode; ... };
+//      ll::HashTable<Session, &Session::hashNode, uint64_t, &Session::id> sessions;
+//      sessions.Init();
+//      sessions.Insert(pSession);
+//      Session * pFound = sessions.Find(id);
+//      sessions.Remove(pFound);
+//
+
+namespace ll
+{
+    template <typename T, typename T::LL1Node T::* Link, typename K, K T::* Key, typename Hash = std::hash<K>, typename Equal = std::equal_to<K>>
+    struct HashTable
+    {
+        enum
+        {
+            s_cBucketMovePerOp = 2,
+            s_cBitBucketMin = 4,
+        };
+
+        // NOTE - apBucket[i] is the head of bucket i's chain (see IsEnd for empty buckets)
+        struct BucketArray_
+        {
+            T ** apBucket;
+            uint32_t cBit;
+        };
+
+        BucketArray_ cur = {};
+
+        // NOTE - While resizing, buckets [iBucketMove, 2^prev.cBit) of prev haven't been moved into cur yet
+        BucketArray_ prev = {};
+        uintptr_t iBucketMove = 0;
+
+        uintptr_t cItem = 0;
+
+        HashTable() = default;
+        ~HashTable() { Destroy(); }
+
+        HashTable(const HashTable &) = delete;
+        HashTable & operator=(const HashTable &) = delete;
+
+        // NOTE - cItemExpected presizes the table so that many items fit without growing
+        bool Init(uintptr_t cItemExpected = 0)
+        {
+            LL_ASSERT(!cur.apBucket);
+
+            uint32_t cBit = s_cBitBucketMin;
+            while (((uintptr_t)1 << cBit) < cItemExpected) cBit++;
+
+            return AllocBuckets(&cur, cBit);
+        }
+
+        // NOTE - Frees the bucket arrays. Items are forgotten without being unlinked, call Clear first if they will be
+        //  checked for linkage again.
+        void Destroy()
+        {
+            free(cur.apBucket);
+            free(prev.apBucket);
+            cur = BucketArray_();
+            prev = BucketArray_();
+            iBucketMove = 0;
+            cItem = 0;
+        }
+
+        uintptr_t Count() const { return cItem; }
+        uintptr_t BucketCount() const { return (uintptr_t)1 << cur.cBit; }
+        bool IsResizing() const { return prev.apBucket != nullptr; }
+
+        // NOTE - Same caveat as LL1IsItemLinked
+        static bool IsItemLinked(T * pItem)
+        {
+            return (pItem->*Link).pNext != nullptr;
+        }
+
+        bool Insert(T * pItem)
+        {
+            LL_ASSERT(cur.apBucket);
+            if (IsItemLinked(pItem))
+            {
+                LL_ASSERT(false);
+                return false;
+            }
+
+            ResizeStep(s_cBucketMovePerOp);
+            if (cItem >= BucketCount() && !Grow()) return false;
+
+            PushHead(BucketOf(HashOf(pItem->*Key)), pItem);
+            cItem++;
+            return true;
+        }
+
+        T * Find(const K & key) const
+        {
+            if (!cur.apBucket) return nullptr;
+
+            for (T * pItem = *BucketOf(HashOf(key)); !IsEnd(pItem); pItem = (pItem->*Link).pNext)
+            {
+                if (Equal()(pItem->*Key, key)) return pItem;
+            }
+            return nullptr;
+        }
+
+        // NOTE - Returns false if pItem wasn't in the table. O(chain length), there are no back links.
+        bool Remove(T * pItem)
+        {
+            if (!IsItemLinked(pItem)) return false;
+
+            ResizeStep(s_cBucketMovePerOp);
+
+            T ** ppLink = BucketOf(HashOf(pItem->*Key));
+            while (!IsEnd(*ppLink))
+            {
+                if (*ppLink == pItem)
+                {
+                    Unlink(ppLink, pItem);
+                    cItem--;
+                    return true;
+                }
+                ppLink = &((*ppLink)->*Link).pNext;
+            }
+
+            LL_ASSERT(false);   // Linked, but not in this table
+            return false;
+        }
+
+        // NOTE - Removes and returns the first item found with this key, or nullptr
+        T * RemoveKey(const K & key)
+        {
+            if (!cur.apBucket) return nullptr;
+
+            ResizeStep(s_cBucketMovePerOp);
+
+            T ** ppLink = BucketOf(HashOf(key));
+            while (!IsEnd(*ppLink))
+            {
+                T * pItem = *ppLink;
+                if (Equal()(pItem->*Key, key))
+                {
+                    Unlink(ppLink, pItem);
+                    cItem--;
+                    return pItem;
+                }
+                ppLink = &(pItem->*Link).pNext;
+            }
+            return nullptr;
+        }
+
+        // NOTE - Visits every item, in no particular order. fn must not insert or remove.
+        template <typename Fn>
+        void ForEach(Fn fn) const
+        {
+            ForEachInArray(prev, iBucketMove, fn);
+            ForEachInArray(cur, 0, fn);
+        }
+
+        // NOTE - Unlinks every item. O(items + buckets).
+        void Clear()
+        {
+            ClearArray(&prev, iBucketMove);
+            ClearArray(&cur, 0);
+
+            free(prev.apBucket);
+            prev = BucketArray_();
+            iBucketMove = 0;
+            cItem = 0;
+        }
+
+        // NOTE - Moves up to cBucket buckets of an ongoing resize. Returns true once no resize is in progress.
+        bool ResizeStep(uintptr_t cBucket)
+        {
+            if (!prev.apBucket) return true;
+
+            uintptr_t cBucketPrev = (uintptr_t)1 << prev.cBit;
+            uintptr_t iBucketEnd = (cBucket < cBucketPrev - iBucketMove) ? iBucketMove + cBucket : cBucketPrev;
+
+            for (; iBucketMove < iBucketEnd; iBucketMove++)
+            {
+                T * pItem = prev.apBucket[iBucketMove];
+                prev.apBucket[iBucketMove] = nullptr;
+
+                while (!IsEnd(pItem))
+                {
+                    T * pNext = (pItem->*Link).pNext;
+                    (pItem->*Link).pNext = nullptr;
+                    PushHead(&cur.apBucket[IndexOf(HashOf(pItem->*Key), cur.cBit)], pItem);
+                    pItem = pNext;
+                }
+            }
+
+            if (iBucketMove < cBucketPrev) return false;
+
+            free(prev.apBucket);
+            prev = BucketArray_();
+            iBucketMove = 0;
+            return true;
+        }
+
+        // Internal
+
+        static T * EndOfList() { return (T *)LLEndOfList_; }
+
+        // NOTE - Empty buckets are nullptr, chains end with LLEndOfList_. Removing the last item of a chain may leave
+        //  either in the bucket.
+        static bool IsEnd(const T * pItem) { return (uintptr_t)pItem <= (uintptr_t)LLEndOfList_; }
+
+        static uint64_t HashOf(const K & key)
+        {
+            return (uint64_t)Hash()(key);
+        }
+
+        static uintptr_t IndexOf(uint64_t hash, uint32_t cBit)
+        {
+            return (uintptr_t)((hash * 0x9E3779B97F4A7C15ULL) >> (64 - cBit));
+        }
+
+        // NOTE - The bucket a hash lives in right now, in prev if that bucket hasn't been moved yet
+        T ** BucketOf(uint64_t hash) const
+        {
+            if (prev.apBucket)
+            {
+                uintptr_t iBucketPrev = IndexOf(hash, prev.cBit);
+                if (iBucketPrev >= iBucketMove) return &prev.apBucket[iBucketPrev];
+            }
+            return &cur.apBucket[IndexOf(hash, cur.cBit)];
+        }
+
+        static bool AllocBuckets(BucketArray_ * pArray, uint32_t cBit)
+        {
+            T ** apBucket = (T **)calloc((size_t)1 << cBit, sizeof(T *));
+            if (!apBucket) return false;
+
+            pArray->apBucket = apBucket;
+            pArray->cBit = cBit;
+            return true;
+        }
+
+        // NOTE - Starts moving everything into a table twice the size. A resize still in progress is finished first,
+        //  which only happens if ResizeStep was starved (it can't be with Insert alone).
+        bool Grow()
+        {
+            ResizeStep((uintptr_t)-1);
+
+            BucketArray_ next;
+            if (!AllocBuckets(&next, cur.cBit + 1)) return false;
+
+            prev = cur;
+            cur = next;
+            iBucketMove = 0;
+            return true;
+        }
+
+        static void PushHead(T ** ppBucket, T * pItem)
+        {
+            (pItem->*Link).pNext = IsEnd(*ppBucket) ? EndOfList() : *ppBucket;
+            *ppBucket = pItem;
+        }
+
+        // NOTE - ppLink is the bucket head or the pNext pointing at pItem
+        static void Unlink(T ** ppLink, T * pItem)
+        {
+            *ppLink = (pItem->*Link).pNext;
+            (pItem->*Link).pNext = nullptr;
+        }
+
+        template <typename Fn>
+        static void ForEachInArray(const BucketArray_ & array, uintptr_t iBucketFirst, Fn & fn)
+        {
+            if (!array.apBucket) return;
+
+            uintptr_t cBucket = (uintptr_t)1 << array.cBit;
+            for (uintptr_t iBucket = iBucketFirst; iBucket < cBucket; iBucket++)
+            {
+                for (T * pItem = array.apBucket[iBucket]; !IsEnd(pItem); )
+                {
+                    T * pNext = (pItem->*Link).pNext;
+                    fn(pItem);
+                    pItem = pNext;
+                }
+            }
+        }
+
+        static void ClearArray(BucketArray_ * pArray, uintptr_t iBucketFirst)
+        {
+            if (!pArray->apBucket) return;
+
+            uintptr_t cBucket = (uintptr_t)1 << pArray->cBit;
+            for (uintptr_t iBucket = iBucketFirst; iBucket < cBucket; iBucket++)
+            {
+                T * pItem = pArray->apBucket[iBucket];
+                pArray->apBucket[iBucket] = nullptr;
+
+                while (!IsEnd(pItem))
+                {
+                    T * pNext = (pItem->*Link).pNext;
+                    (pItem->*Link).pNext = nullptr;
+                    pItem = pNext;
+                }
+            }
+        }
+    };
+}
+
+
+
+
+//
+// Author: Andrew Smith - alsmith.net
+// License: MIT
+//
+#endif
@@ -0,0 +1,299 @@
+#ifndef ALS_LL_HEAP_H
+#define ALS_LL_HEAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+
+#include "ll.h"
+
+//
+// Intrusive pairing heap (min-heap) that links its items through the same LL2Node they use for LL2 lists
+//
+// Requires:
+//  -ll.h
+//
+// The two pointers of the LL2Node are reused as a child/sibling tree:
+//  -pPrev is the item's first child, or LLEndOfList_ when it has none
+//  -pNext is the next sibling. The last child's pNext is its parent with the low bit set, and the root's pNext is
+//   LLEndOfList_ (which is nullptr with the low bit set, i.e. "no parent").
+//
+// So pPrev is non-null exactly while the item is in the heap, as with LL2 lists, and an item moves between a list and
+//  a heap (Remove from one, Insert into the other) without changing its layout. The same LL2Node can't be on a list
+//  and in a heap at once.
+//
+// Costs: Insert and Meld are O(1). PopMin is amortized O(log n). DecreaseKey and Remove do NOT meet O(log n): on top
+//  of the amortized O(log n) restructuring, they walk the item's siblings to find its parent and predecessor, which
+//  is O(n) in the worst case (e.g. right after n Inserts, every item is a child of the root). An O(1) cut needs a
+//  back link, i.e. a third pointer, and sharing the LL2Node's layout leaves room for only two. The walk is short for
+//  the items that tend to be moved (recently inserted ones sit at the front of the root's children), and each PopMin
+//  shortens the child lists, but if arbitrary removal has to be O(log n), use a heap with its own node instead.
+//
+// Usage:
+//      struct Event { uint64_t time; DefineLL2Node(Event); LL2Node node; ... };
+//      ll::PairingHeap<Event, &Event::node, uint64_t, &Event::time> events;
+//      events.Insert(pEvent);
+//      events.DecreaseKey(pEvent, timeEarlier);
+//      while (Event * pEvent = events.PopMin()) { ... }
+//
+
+namespace ll
+{
+    template <typename T, typename T::LL2Node T::* Link, typename K, K T::* Key, typename Less = std::less<K>>
+    struct PairingHeap
+    {
+        T * pRoot = nullptr;
+        uintptr_t cItem = 0;
+
+        PairingHeap() = default;
+
+        PairingHeap(const PairingHeap &) = delete;
+        PairingHeap & operator=(const PairingHeap &) = delete;
+
+        uintptr_t Count() const { return cItem; }
+        bool IsEmpty() const { return !pRoot; }
+        T * Min() const { return pRoot; }
+
+        // NOTE - Same caveat as LL2IsItemLinked: true for an item on any list or heap through this link
+        static bool IsItemLinked(const T * pItem)
+        {
+            return (pItem->*Link).pPrev != nullptr;
+        }
+
+        void Insert(T * pItem)
+        {
+            if (IsItemLinked(pItem))
+            {
+                LL_ASSERT(false);
+                return;
+            }
+
+            (pItem->*Link).pPrev = (T *)LLEndOfList_;
+            SetRoot(pRoot ? Link2(pRoot, pItem) : pItem);
+            cItem++;
+        }
+
+        // NOTE - Removes every item from list (front to back) and inserts it. O(n).
+        template <typename L>
+        void InsertAll(L & list)
+        {
+            ListRef<T, Link> listRef(list);
+            while (T * pItem = listRef.RemoveHead())
+            {
+                Insert(pItem);
+            }
+        }
+
+        // NOTE - Moves every item of other into this heap. O(1).
+        void Meld(PairingHeap & other)
+        {
+            if (&other == this || !other.pRoot) return;
+
+            SetRoot(pRoot ? Link2(pRoot, other.pRoot) : other.pRoot);
+            cItem += other.cItem;
+            other.pRoot = nullptr;
+            other.cItem = 0;
+        }
+
+        T * PopMin()
+        {
+            T * pMin = pRoot;
+            if (!pMin) return nullptr;
+
+            T * pRootNew = MergePairs(FirstChild(pMin));
+            pRoot = nullptr;
+            if (pRootNew) SetRoot(pRootNew);
+            Unlink(pMin);
+            cItem--;
+            return pMin;
+        }
+
+        // NOTE - keyNew must not be greater than the item's current key. Not O(log n), see Cut.
+        void DecreaseKey(T * pItem, const K & keyNew)
+        {
+            LL_ASSERT(IsItemLinked(pItem));
+            LL_ASSERT(!Less()(pItem->*Key, keyNew));
+
+            pItem->*Key = keyNew;
+            if (pItem == pRoot) return;
+
+            Cut(pItem);
+            SetRoot(Link2(pRoot, pItem));
+        }
+
+        // NOTE - Removes an item from anywhere in the heap. Must be in this heap. Not O(log n), see Cut.
+        void Remove(T * pItem)
+        {
+            LL_ASSERT(IsItemLinked(pItem));
+
+            if (pItem == pRoot)
+            {
+                PopMin();
+                return;
+            }
+
+            Cut(pItem);
+            T * pSub = MergePairs(FirstChild(pItem));
+            if (pSub) SetRoot(Link2(pRoot, pSub));
+            Unlink(pItem);
+            cItem--;
+        }
+
+        // NOTE - Unlinks every item. O(n).
+        void Clear()
+        {
+            // Stack of subtrees still to visit, threaded through pNext
+
+            T * pStack = pRoot;
+            if (pStack) (pStack->*Link).pNext = nullptr;
+
+            while (T * pItem = pStack)
+            {
+                pStack = (pItem->*Link).pNext;
+
+                T * pChild = FirstChild(pItem);
+                while (pChild)
+                {
+                    T * pSibling = NextSibling(pChild);
+                    (pChild->*Link).pNext = pStack;
+                    pStack = pChild;
+                    pChild = pSibling;
+                }
+
+                Unlink(pItem);
+            }
+
+            pRoot = nullptr;
+            cItem = 0;
+        }
+
+        // NOTE - Forgets the items without touching them. Only safe if they'll never be checked for linkage again.
+        void ClearWithoutUnlinking()
+        {
+            pRoot = nullptr;
+            cItem = 0;
+        }
+
+        // Internal
+
+        static bool IsTagged(const T * p)
+        {
+            return ((uintptr_t)p & 1) != 0;
+        }
+
+        static T * FirstChild(const T * pItem)
+        {
+            T * pChild = (pItem->*Link).pPrev;
+            return (pChild == (T *)LLEndOfList_) ? nullptr : pChild;
+        }
+
+        static T * NextSibling(const T * pItem)
+        {
+            T * pNext = (pItem->*Link).pNext;
+            return IsTagged(pNext) ? nullptr : pNext;
+        }
+
+        static void Unlink(T * pItem)
+        {
+            (pItem->*Link).pPrev = nullptr;
+            (pItem->*Link).pNext = nullptr;
+        }
+
+        void SetRoot(T * pItem)
+        {
+            pRoot = pItem;
+            (pItem->*Link).pNext = (T *)LLEndOfList_;
+        }
+
+        // NOTE - Links two subtree roots, the loser becoming the winner's first child. The winner's pNext is left for
+        //  the caller to set. Ties go to pA.
+        static T * Link2(T * pA, T * pB)
+        {
+            if (Less()(pB->*Key, pA->*Key))
+            {
+                T * pSwap = pA;
+                pA = pB;
+                pB = pSwap;
+            }
+
+            T * pChild = (pA->*Link).pPrev;
+            (pB->*Link).pNext = (pChild == (T *)LLEndOfList_) ? (T *)((uintptr_t)pA | 1) : pChild;
+            (pA->*Link).pPrev = pB;
+            return pA;
+        }
+
+        // NOTE - Standard two-pass pairing: link neighbours front to back, then fold the pairs back to front. The
+        //  pairs are kept on a stack threaded through pNext.
+        static T * MergePairs(T * pFirst)
+        {
+            T * pPairs = nullptr;
+            T * pItem = pFirst;
+            while (pItem)
+            {
+                T * pOther = NextSibling(pItem);
+                if (!pOther)
+                {
+                    (pItem->*Link).pNext = pPairs;
+                    pPairs = pItem;
+                    break;
+                }
+
+                T * pRest = NextSibling(pOther);
+                T * pPair = Link2(pItem, pOther);
+                (pPair->*Link).pNext = pPairs;
+                pPairs = pPair;
+                pItem = pRest;
+            }
+
+            if (!pPairs) return nullptr;
+
+            T * pResult = pPairs;
+            pPairs = (pResult->*Link).pNext;
+            while (pPairs)
+            {
+                T * pPairsNext = (pPairs->*Link).pNext;
+                pResult = Link2(pPairs, pResult);
+                pPairs = pPairsNext;
+            }
+            return pResult;
+        }
+
+        // NOTE - Detaches a non-root item (with its subtree) from its parent. The item's pNext is left for the caller.
+        //  O(number of siblings): the parent is only reachable from the last sibling, and the predecessor only from
+        //  the parent's first child.
+        static void Cut(T * pItem)
+        {
+            T * pLast = pItem;
+            while (!IsTagged((pLast->*Link).pNext))
+            {
+                pLast = (pLast->*Link).pNext;
+            }
+            T * pParent = (T *)((uintptr_t)(pLast->*Link).pNext & ~(uintptr_t)1);
+            LL_ASSERT(pParent);
+
+            T * pNext = (pItem->*Link).pNext;
+            T * pChild = (pParent->*Link).pPrev;
+            if (pChild == pItem)
+            {
+                (pParent->*Link).pPrev = IsTagged(pNext) ? (T *)LLEndOfList_ : pNext;
+            }
+            else
+            {
+                while ((pChild->*Link).pNext != pItem)
+                {
+                    pChild = (pChild->*Link).pNext;
+                }
+                (pChild->*Link).pNext = pNext;
+            }
+        }
+    };
+}
+
+
+
+
+//
+// Author: Andrew Smith - alsmith.net
+// License: MIT
+//
+#endif
@@ -0,0 +1,288 @@
+#ifndef ALS_LL_LRU_H
+#define ALS_LL_LRU_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <functional>
+
+#include "ll.h"
+
+//
+// Intrusive LRU cache: an LL2 recency list plus an open-addressing hash index over the same objects
+//
+// Requires:
+//  -ll.h
+//  -calloc/free (only when the index is created or grows, never per item)
+//  -std::hash for the key type, or pass your own Hash
+//
+// The cache never allocates or frees items. Items embed a DefineLL2Node for the recency list and already contain their
+//  key, so the index only stores an item pointer and its hash. Items leave the cache either through Remove (no
+//  callback) or eviction, which calls pfnEvict so the owner can free or recycle them.
+//
+// Usage:
+//      struct Entry { uint64_t key; DefineLL2Node(Entry); LL2Node lruNode; ... };
+//      ll::Lru<Entry, &Entry::lruNode, uint64_t, &Entry::key> lru;
+//      lru.Init(4096, 0, EvictEntry, pUserData);
+//      if (Entry * pEntry = lru.Lookup(key)) ...
+//
+
+namespace ll
+{
+    template <typename T, typename T::LL2Node T::* Link, typename K, K T::* Key, typename Hash = std::hash<K>>
+    struct Lru
+    {
+        typedef void (* PfnEvict)(T * pItem, void * pUserData);
+        typedef uintptr_t (* PfnBytes)(T * pItem);
+
+        struct Slot
+        {
+            T * pItem;          // nullptr = empty
+            uint64_t hash;
+        };
+
+        // NOTE - Head is the most recently used item, tail the least
+        List<T, Link> recency;
+
+        Slot * aSlot = nullptr;
+        uintptr_t cSlot = 0;    // Always a power of 2
+
+        uintptr_t cItem = 0;
+        uintptr_t cItemMax = 0;     // 0 = no count budget
+        uintptr_t cBytes = 0;
+        uintptr_t cBytesMax = 0;    // 0 = no byte budget
+
+        PfnEvict pfnEvict = nullptr;
+        PfnBytes pfnBytes = nullptr;
+        void * pUserData = nullptr;
+
+        uint64_t cHit = 0;
+        uint64_t cMiss = 0;
+
+        Lru() = default;
+
+        // NOTE - Unlinks whatever is still cached, so the items must outlive the cache
+        ~Lru() { Destroy(); }
+
+        Lru(const Lru &) = delete;
+        Lru & operator=(const Lru &) = delete;
+
+        // NOTE - pfnBytes (optional) must keep returning the same size for an item for as long as it is in the cache
+        bool Init(uintptr_t cItemMax_, uintptr_t cBytesMax_ = 0, PfnEvict pfnEvict_ = nullptr, void * pUserData_ = nullptr, PfnBytes pfnBytes_ = nullptr)
+        {
+            LL_ASSERT(!aSlot);
+
+            cItemMax = cItemMax_;
+            cBytesMax = cBytesMax_;
+            pfnEvict = pfnEvict_;
+            pUserData = pUserData_;
+            pfnBytes = pfnBytes_;
+
+            // Keep the load factor at or below 1/2 so probes stay short
+
+            uintptr_t cSlotNeeded = 16;
+            while (cSlotNeeded < cItemMax * 2) cSlotNeeded *= 2;
+
+            return Rehash(cSlotNeeded);
+        }
+
+        // NOTE - Unlinks every item without calling pfnEvict, and frees the index
+        void Destroy()
+        {
+            recency.Clear();
+            free(aSlot);
+            aSlot = nullptr;
+            cSlot = 0;
+            cItem = 0;
+            cBytes = 0;
+        }
+
+        uintptr_t Count() const { return cItem; }
+        uintptr_t Bytes() const { return cBytes; }
+
+        // NOTE - Marks the item as most recently used on a hit
+        T * Lookup(const K & key)
+        {
+            T * pItem = Find(key, HashKey(key));
+            if (pItem)
+            {
+                cHit++;
+                recency.MoveToHead(pItem);
+            }
+            else
+            {
+                cMiss++;
+            }
+            return pItem;
+        }
+
+        // NOTE - Doesn't touch recency or the hit/miss counts
+        T * Peek(const K & key)
+        {
+            return Find(key, HashKey(key));
+        }
+
+        void Touch(T * pItem)
+        {
+            LL_ASSERT(recency.IsItemLinked(pItem));
+            recency.MoveToHead(pItem);
+        }
+
+        // NOTE - Inserts as most recently used, then evicts from the cold end until back under budget. Returns false
+        //  (and doesn't insert) if an item with the same key is already cached, or if the index couldn't grow.
+        bool Insert(T * pItem)
+        {
+            uint64_t hash = HashKey(pItem->*Key);
+            if (Find(pItem->*Key, hash)) return false;
+
+            if ((cItem + 1) * 2 > cSlot && !Rehash(cSlot ? cSlot * 2 : 16))
+            {
+                if (cItem + 1 >= cSlot) return false;
+            }
+
+            uintptr_t mask = cSlot - 1;
+            uintptr_t iSlot = (uintptr_t)hash & mask;
+            while (aSlot[iSlot].pItem) iSlot = (iSlot + 1) & mask;
+            aSlot[iSlot].pItem = pItem;
+            aSlot[iSlot].hash = hash;
+
+            recency.AddHead(pItem);
+            cItem++;
+            if (pfnBytes) cBytes += pfnBytes(pItem);
+
+            while (IsOverBudget() && recency.Tail() != pItem)
+            {
+                EvictLru();
+            }
+
+            return true;
+        }
+
+        // NOTE - Removes without calling pfnEvict. IsItemLinked can't tell this cache's items from ones linked on some
+        //  other list through the same node, so the index is the real membership check, and recency is only touched
+        //  once it has found the item.
+        void Remove(T * pItem)
+        {
+            if (!recency.IsItemLinked(pItem)) return;
+
+            if (!Unindex(pItem))
+            {
+                LL_ASSERT(false);
+                return;
+            }
+
+            recency.Remove(pItem);
+            cItem--;
+            if (pfnBytes) cBytes -= pfnBytes(pItem);
+        }
+
+        // NOTE - Removes the least recently used item and passes it to pfnEvict. Returns it (or nullptr if empty), but
+        //  don't touch it after if pfnEvict freed it.
+        T * EvictLru()
+        {
+            T * pItem = recency.Tail();
+            if (!pItem) return nullptr;
+
+            Remove(pItem);
+            if (pfnEvict) pfnEvict(pItem, pUserData);
+            return pItem;
+        }
+
+        bool IsOverBudget() const
+        {
+            return (cItemMax && cItem > cItemMax) || (cBytesMax && cBytes > cBytesMax);
+        }
+
+        // Internal
+
+        static uint64_t HashKey(const K & key)
+        {
+            // std::hash is the identity for integers on most standard libraries, so mix the bits (murmur3 finalizer)
+
+            uint64_t h = (uint64_t)Hash()(key);
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return h;
+        }
+
+        T * Find(const K & key, uint64_t hash)
+        {
+            if (!cSlot) return nullptr;
+
+            uintptr_t mask = cSlot - 1;
+            for (uintptr_t iSlot = (uintptr_t)hash & mask; aSlot[iSlot].pItem; iSlot = (iSlot + 1) & mask)
+            {
+                if (aSlot[iSlot].hash == hash && aSlot[iSlot].pItem->*Key == key)
+                {
+                    return aSlot[iSlot].pItem;
+                }
+            }
+            return nullptr;
+        }
+
+        // NOTE - Backward shift deletion, so there are no tombstones to clean up later. Returns false if pItem isn't in
+        //  the index. Insert always leaves at least one slot empty, so the probe always ends.
+        bool Unindex(T * pItem)
+        {
+            if (!cSlot) return false;
+
+            uintptr_t mask = cSlot - 1;
+            uintptr_t iSlot = (uintptr_t)HashKey(pItem->*Key) & mask;
+            while (aSlot[iSlot].pItem != pItem)
+            {
+                if (!aSlot[iSlot].pItem) return false;
+                iSlot = (iSlot + 1) & mask;
+            }
+
+            uintptr_t iHole = iSlot;
+            for (uintptr_t iScan = (iHole + 1) & mask; aSlot[iScan].pItem; iScan = (iScan + 1) & mask)
+            {
+                uintptr_t iHome = (uintptr_t)aSlot[iScan].hash & mask;
+
+                // Can the entry at iScan move back into the hole without ending up before its home slot?
+
+                bool canMove = (iHole <= iScan) ? (iHome <= iHole || iHome > iScan) : (iHome <= iHole && iHome > iScan);
+                if (canMove)
+                {
+                    aSlot[iHole] = aSlot[iScan];
+                    iHole = iScan;
+                }
+            }
+            aSlot[iHole].pItem = nullptr;
+            return true;
+        }
+
+        bool Rehash(uintptr_t cSlotNew)
+        {
+            Slot * aSlotNew = (Slot *)calloc(cSlotNew, sizeof(Slot));
+            if (!aSlotNew) return false;
+
+            uintptr_t mask = cSlotNew - 1;
+            for (uintptr_t iSlotOld = 0; iSlotOld < cSlot; iSlotOld++)
+            {
+                if (!aSlot[iSlotOld].pItem) continue;
+
+                uintptr_t iSlot = (uintptr_t)aSlot[iSlotOld].hash & mask;
+                while (aSlotNew[iSlot].pItem) iSlot = (iSlot + 1) & mask;
+                aSlotNew[iSlot] = aSlot[iSlotOld];
+            }
+
+            free(aSlot);
+            aSlot = aSlotNew;
+            cSlot = cSlotNew;
+            return true;
+        }
+    };
+}
+
+
+
+
+//
+// Author: Andrew Smith - alsmith.net
+// License: MIT
+//
+#endif
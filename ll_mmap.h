@@ -0,0 +1,350 @@
+#ifndef ALS_LL_MMAP_H
+#define ALS_LL_MMAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "ll.h"
+
+//
+// Save/load helpers for images of self-relative lists (LL2Rel in ll.h), which are used straight from a memory mapping
+//  of the file with no rebuild or pointer fix-up
+//
+// Requires:
+//  -ll.h
+//  -malloc/free (ImageBuilder only), stdio (SaveImage only)
+//  -mmap (POSIX) or CreateFileMapping/MapViewOfFile (Windows)
+//
+// An image is one contiguous block of memory holding items, the self-relative lists that link them, and a root
+//  object (any struct of the caller's choosing, typically the lists' headers and some counts). ImageBuilder hands out
+//  zeroed, aligned space from such a block. Once the lists are linked, SaveImage writes the block behind a small
+//  header, and MappedImage::Load maps the file and hands back the root. Since every link is relative, the lists are
+//  walkable right away wherever the mapping landed, in every process that maps the file.
+//
+// The default mapping is read-only and shared, so any number of processes share the same physical pages. Loading
+//  with isWritable maps copy-on-write instead: the process may link/unlink items in its own view, which never
+//  reaches the file or other processes.
+//
+// The image stores items bytewise, so they must be trivially copyable and must not hold absolute pointers that
+//  are expected to survive a reload. The format is specific to the writer's pointer size and endianness (checked on
+//  load) and to the layout of the item types (versioned by the caller's userTag).
+//
+// NOTE - The same images work in a shared memory segment: build them in the segment with ImageBuilder::InitInPlace
+//  and hand the other processes the root offset. Creating the segment is left to the platform API.
+//
+// Usage:
+//      struct Node { DefineLL2RelNode(Node); LL2RelNode node; int value; };
+//      DefineLL2Rel(Node, node, Nodes);
+//      struct Root { LL2RelType(Nodes) nodes; };
+//
+//      ll::ImageBuilder builder;
+//      builder.Init(1 << 20);
+//      Root * pRoot = builder.Alloc<Root>();
+//      Node * pNode = builder.Alloc<Node>();
+//      LL2RelAddTail(Node, pRoot->nodes, pNode);
+//      ll::SaveImage("nodes.img", builder, pRoot, kNodesImageTag);
+//
+//      ll::MappedImage image;
+//      if (image.Load("nodes.img", kNodesImageTag))
+//      {
+//          const Root * pRoot = image.Root<Root>();
+//          ForLL2Rel(const Node, pNode, pRoot->nodes) { ... }
+//      }
+//
+
+namespace ll
+{
+    enum
+    {
+        s_nImageMagic = 0x474d494c,         // "LIMG"
+        s_nImageVersion = 1,
+        s_cbImageAlign = 64,
+    };
+
+    // NOTE - Written in front of the image. The image starts at the next multiple of s_cbImageAlign, so the mapping's
+    //  page alignment carries over to the items.
+    struct ImageHeader
+    {
+        uint32_t nMagic;
+        uint32_t nVersion;
+        uint32_t cbPointer;                 // sizeof(void *) of the writer
+        uint32_t nEndian;                   // 0x01020304 as written by the writer
+        uint64_t userTag;
+        uint64_t cbImage;
+        uint64_t offsetRoot;
+        unsigned char aPadding[s_cbImageAlign - 40];
+    };
+
+    static_assert(sizeof(ImageHeader) == s_cbImageAlign, "ImageHeader must fill exactly one alignment unit");
+
+    // NOTE - Bump allocator over one block. Never frees individual allocations.
+    struct ImageBuilder
+    {
+        unsigned char * pBase = nullptr;
+        uintptr_t cbMax = 0;
+        uintptr_t cbUsed = 0;
+        bool isOwned = false;
+
+        ImageBuilder() = default;
+        ~ImageBuilder() { Destroy(); }
+
+        ImageBuilder(const ImageBuilder &) = delete;
+        ImageBuilder & operator=(const ImageBuilder &) = delete;
+
+        bool Init(uintptr_t cbMax_)
+        {
+            LL_ASSERT(!pBase);
+
+            cbMax_ = (cbMax_ + s_cbImageAlign - 1) & ~(uintptr_t)(s_cbImageAlign - 1);
+            void * pBlock = nullptr;
+#if defined(_WIN32)
+            pBlock = _aligned_malloc(cbMax_, s_cbImageAlign);
+#else
+            if (posix_memalign(&pBlock, s_cbImageAlign, cbMax_)) pBlock = nullptr;
+#endif
+            if (!pBlock) return false;
+
+            InitInPlace(pBlock, cbMax_);
+            isOwned = true;
+            return true;
+        }
+
+        // NOTE - Builds into caller-owned memory (e.g. a shared memory segment), which must be s_cbImageAlign aligned
+        void InitInPlace(void * pBlock, uintptr_t cbBlock)
+        {
+            LL_ASSERT(!pBase);
+            LL_ASSERT(!((uintptr_t)pBlock & (s_cbImageAlign - 1)));
+
+            pBase = (unsigned char *)pBlock;
+            cbMax = cbBlock;
+            cbUsed = 0;
+            isOwned = false;
+            memset(pBase, 0, cbBlock);
+        }
+
+        void Destroy()
+        {
+            if (isOwned)
+            {
+#if defined(_WIN32)
+                _aligned_free(pBase);
+#else
+                free(pBase);
+#endif
+            }
+            pBase = nullptr;
+            cbMax = 0;
+            cbUsed = 0;
+            isOwned = false;
+        }
+
+        // NOTE - Zeroed space for cb bytes, or nullptr when the block is full. align must be a power of two no greater
+        //  than s_cbImageAlign.
+        void * AllocBytes(uintptr_t cb, uintptr_t align)
+        {
+            LL_ASSERT(align && !(align & (align - 1)) && align <= s_cbImageAlign);
+
+            uintptr_t ib = (cbUsed + align - 1) & ~(align - 1);
+            if (ib > cbMax || cb > cbMax - ib) return nullptr;
+
+            cbUsed = ib + cb;
+            return pBase + ib;
+        }
+
+        // NOTE - Zeroed, so link nodes and list headers start out unlinked/empty. No constructor is run.
+        template <typename U>
+        U * Alloc(uintptr_t cItem = 1)
+        {
+            return (U *)AllocBytes(sizeof(U) * cItem, alignof(U));
+        }
+
+        uintptr_t OffsetOf(const void * p) const
+        {
+            LL_ASSERT((const unsigned char *)p >= pBase && (const unsigned char *)p < pBase + cbMax);
+            return (uintptr_t)((const unsigned char *)p - pBase);
+        }
+    };
+
+    // NOTE - Writes the header and cbImage bytes at pImage. offsetRoot is where the root object sits in the image.
+    inline bool SaveImage(const char * path, const void * pImage, uintptr_t cbImage, uintptr_t offsetRoot, uint64_t userTag)
+    {
+        LL_ASSERT(offsetRoot < cbImage);
+
+        ImageHeader header;
+        memset(&header, 0, sizeof(header));
+        header.nMagic = s_nImageMagic;
+        header.nVersion = s_nImageVersion;
+        header.cbPointer = (uint32_t)sizeof(void *);
+        header.nEndian = 0x01020304;
+        header.userTag = userTag;
+        header.cbImage = cbImage;
+        header.offsetRoot = offsetRoot;
+
+        FILE * pFile = fopen(path, "wb");
+        if (!pFile) return false;
+
+        bool isOk = fwrite(&header, sizeof(header), 1, pFile) == 1;
+        if (isOk && cbImage) isOk = fwrite(pImage, cbImage, 1, pFile) == 1;
+        isOk = (fclose(pFile) == 0) && isOk;
+        return isOk;
+    }
+
+    inline bool SaveImage(const char * path, const ImageBuilder & builder, const void * pRoot, uint64_t userTag)
+    {
+        return SaveImage(path, builder.pBase, builder.cbUsed, builder.OffsetOf(pRoot), userTag);
+    }
+
+    struct MappedImage
+    {
+        unsigned char * pMapping = nullptr;     // Starts with the ImageHeader
+        uintptr_t cbMapping = 0;
+        unsigned char * pImage = nullptr;
+        uintptr_t cbImage = 0;
+        uintptr_t offsetRoot = 0;
+
+#if defined(_WIN32)
+        HANDLE hFile = INVALID_HANDLE_VALUE;
+        HANDLE hMapping = nullptr;
+#endif
+
+        MappedImage() = default;
+        ~MappedImage() { Unload(); }
+
+        MappedImage(const MappedImage &) = delete;
+        MappedImage & operator=(const MappedImage &) = delete;
+
+        // NOTE - Fails (and leaves nothing mapped) if the file can't be mapped, isn't an image, was written by a
+        //  different pointer size or endianness, is truncated, or has a different userTag
+        bool Load(const char * path, uint64_t userTag, bool isWritable = false)
+        {
+            LL_ASSERT(!pMapping);
+
+            if (!Map(path, isWritable)) return false;
+
+            const ImageHeader * pHeader = (const ImageHeader *)pMapping;
+            bool isValid =
+                cbMapping >= sizeof(ImageHeader) &&
+                pHeader->nMagic == s_nImageMagic &&
+                pHeader->nVersion == s_nImageVersion &&
+                pHeader->cbPointer == sizeof(void *) &&
+                pHeader->nEndian == 0x01020304 &&
+                pHeader->userTag == userTag &&
+                pHeader->cbImage <= cbMapping - sizeof(ImageHeader) &&
+                pHeader->offsetRoot < pHeader->cbImage;
+
+            if (!isValid)
+            {
+                Unload();
+                return false;
+            }
+
+            pImage = pMapping + sizeof(ImageHeader);
+            cbImage = (uintptr_t)pHeader->cbImage;
+            offsetRoot = (uintptr_t)pHeader->offsetRoot;
+            return true;
+        }
+
+        void Unload()
+        {
+#if defined(_WIN32)
+            if (pMapping) UnmapViewOfFile(pMapping);
+            if (hMapping) CloseHandle(hMapping);
+            if (hFile != INVALID_HANDLE_VALUE) CloseHandle(hFile);
+            hMapping = nullptr;
+            hFile = INVALID_HANDLE_VALUE;
+#else
+            if (pMapping) munmap(pMapping, cbMapping);
+#endif
+            pMapping = nullptr;
+            cbMapping = 0;
+            pImage = nullptr;
+            cbImage = 0;
+            offsetRoot = 0;
+        }
+
+        bool IsLoaded() const { return pMapping != nullptr; }
+
+        // NOTE - Non-const access is only valid for writable (copy-on-write) loads
+        template <typename U>
+        U * Root() const
+        {
+            LL_ASSERT(pImage);
+            return (U *)(pImage + offsetRoot);
+        }
+
+        // Internal
+
+        bool Map(const char * path, bool isWritable)
+        {
+#if defined(_WIN32)
+            hFile = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (hFile == INVALID_HANDLE_VALUE) return false;
+
+            LARGE_INTEGER cbFile;
+            if (!GetFileSizeEx(hFile, &cbFile) || cbFile.QuadPart <= 0 || (uint64_t)cbFile.QuadPart > (uintptr_t)-1)
+            {
+                Unload();
+                return false;
+            }
+
+            hMapping = CreateFileMappingA(hFile, nullptr, isWritable ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+            if (!hMapping)
+            {
+                Unload();
+                return false;
+            }
+
+            pMapping = (unsigned char *)MapViewOfFile(hMapping, isWritable ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+            if (!pMapping)
+            {
+                Unload();
+                return false;
+            }
+            cbMapping = (uintptr_t)cbFile.QuadPart;
+            return true;
+#else
+            int fd = open(path, O_RDONLY);
+            if (fd < 0) return false;
+
+            struct stat statFile;
+            if (fstat(fd, &statFile) != 0 || statFile.st_size <= 0)
+            {
+                close(fd);
+                return false;
+            }
+
+            int prot = isWritable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+            int flags = isWritable ? MAP_PRIVATE : MAP_SHARED;
+            void * pMap = mmap(nullptr, (size_t)statFile.st_size, prot, flags, fd, 0);
+            close(fd);      // The mapping keeps the file alive
+
+            if (pMap == MAP_FAILED) return false;
+
+            pMapping = (unsigned char *)pMap;
+            cbMapping = (uintptr_t)statFile.st_size;
+            return true;
+#endif
+        }
+    };
+}
+
+
+
+
+//
+// Author: Andrew Smith - alsmith.net
+// License: MIT
+//
+#endif
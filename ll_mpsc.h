@@ -0,0 +1,172 @@
+#ifndef ALS_LL_MPSC_H
+#define ALS_LL_MPSC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+#include "ll.h"
+
+//
+// Lock-free multi-producer/single-consumer intrusive queue built on the LL1 node (Vyukov-style)
+//
+// Requires:
+//  -ll.h
+//  -std::atomic
+//
+// Any number of threads may push. Only one thread may pop/drain at a time. Pushing never allocates,
+//  the item's embedded LL1Node is the link.
+//
+// A zero-initialized queue is empty and ready for use, like the other lists.
+//
+
+
+// NOTE - The queue needs a stub node that is never handed to the consumer. Rather than requiring the user to
+//  give up one of their items for this, the stub is a fake item address whose LL1Node::pNext aliases the
+//  queue's pStubNext member (same @Hack as LL2RemoveWhileIterating_). A null pTail/pHead means "the stub".
+#define DefineLL1Mpsc(type, linkMember, userId)                         \
+    struct LL1Mpsc_##userId                                             \
+    {                                                                   \
+        alignas(64) std::atomic<struct type *> pTail;                   \
+        alignas(64) struct type * pHead;                                \
+        struct type * pStubNext;                                        \
+        enum Offset { offset = offsetof(type, linkMember) };            \
+    };
+
+#define LL1MpscType(userId) LL1Mpsc_##userId
+
+
+
+#define LL1MpscStub_(type, ppStubNext, listOffset)                      \
+    ((type *)((unsigned char *)(ppStubNext) - (listOffset + offsetof(type::LL1Node, pNext))))
+
+// NOTE - Producers and the consumer race on pNext, so it is accessed through std::atomic. This relies on
+//  std::atomic<T *> having the same representation as T *, which holds on every platform we target.
+#define LL1MpscNextAtomic_(type, pItem, listOffset)                     \
+    ((std::atomic<type *> *)&LL1NodePtr_(type, pItem, listOffset)->pNext)
+
+// NOTE - A zero-initialized stub has pNext == nullptr rather than LLEndOfList_, so treat both as "no next"
+#define LL1MpscIsItem_(pItem)                   \
+    ((uintptr_t)(pItem) > LLEndOfList_)
+
+
+
+#define LL1MpscLink_(type, pTail, ppStubNext, listOffset, pItem)        \
+    do {                                                                \
+        LL1MpscNextAtomic_(type, pItem, listOffset)->store((type *)LLEndOfList_, std::memory_order_relaxed); \
+        type * prev_ = (pTail)->exchange(pItem, std::memory_order_acq_rel); \
+        if (!prev_) prev_ = LL1MpscStub_(type, ppStubNext, listOffset); \
+        LL1MpscNextAtomic_(type, prev_, listOffset)->store(pItem, std::memory_order_release); \
+    } while(0)
+
+#define LL1MpscPush_(type, pTail, ppStubNext, listOffset, pItem)        \
+    do {                                                                \
+        if (LL1IsItemLinked_(type, pItem, listOffset))                  \
+        {                                                               \
+            LL_ASSERT(false);                                           \
+            break;                                                      \
+        }                                                               \
+        LL1MpscLink_(type, pTail, ppStubNext, listOffset, pItem);       \
+    } while(0)
+
+#define LL1MpscPush(type, queue, pItem)                                 \
+    LL1MpscPush_(type, &(queue).pTail, &(queue).pStubNext, (queue).offset, pItem)
+
+
+
+// NOTE - Can return nullptr while the queue is non-empty if a producer is between its exchange and its link
+//  store. The item becomes visible as soon as that producer finishes, so just try again later.
+#define LL1MpscPop_(type, ppHead, pTail, ppStubNext, listOffset, pAssignTo) \
+    do {                                                                \
+        pAssignTo = nullptr;                                            \
+        type * stub_ = LL1MpscStub_(type, ppStubNext, listOffset);      \
+        type * head_ = *(ppHead) ? *(ppHead) : stub_;                   \
+        type * next_ = LL1MpscNextAtomic_(type, head_, listOffset)->load(std::memory_order_acquire); \
+        if (head_ == stub_)                                             \
+        {                                                               \
+            if (!LL1MpscIsItem_(next_)) break;                          \
+            *(ppHead) = next_;                                          \
+            head_ = next_;                                              \
+            next_ = LL1MpscNextAtomic_(type, head_, listOffset)->load(std::memory_order_acquire); \
+        }                                                               \
+        if (!LL1MpscIsItem_(next_))                                     \
+        {                                                               \
+            type * tail_ = (pTail)->load(std::memory_order_acquire);    \
+            if (head_ != tail_) break;                                  \
+            LL1MpscLink_(type, pTail, ppStubNext, listOffset, stub_);   \
+            next_ = LL1MpscNextAtomic_(type, head_, listOffset)->load(std::memory_order_acquire); \
+            if (!LL1MpscIsItem_(next_)) break;                          \
+        }                                                               \
+        *(ppHead) = next_;                                              \
+        LL1NodePtr_(type, head_, listOffset)->pNext = nullptr;          \
+        pAssignTo = head_;                                              \
+    } while(0)
+
+#define LL1MpscPop(type, queue, pAssignTo)                              \
+    LL1MpscPop_(type, &(queue).pHead, &(queue).pTail, &(queue).pStubNext, (queue).offset, pAssignTo)
+
+
+
+// NOTE - Moves everything currently visible in the queue onto the tail of an ordinary LL1 list. The drained items
+//  are already chained together in push order, so this only reads the chain and does O(1) link writes (plus one
+//  to step over the stub if it is in the middle) instead of unlinking and re-adding each item.
+#define LL1MpscDrain_(type, ppHead, pTail, ppStubNext, listOffset, ppListHead, ppListTail, cDrained) \
+    do {                                                                \
+        cDrained = 0;                                                   \
+        type * stub_ = LL1MpscStub_(type, ppStubNext, listOffset);      \
+        type * head_ = *(ppHead) ? *(ppHead) : stub_;                   \
+        type * first_ = nullptr;                                        \
+        type * last_ = nullptr;                                         \
+        for (;;)                                                        \
+        {                                                               \
+            type * next_ = LL1MpscNextAtomic_(type, head_, listOffset)->load(std::memory_order_acquire); \
+            if (head_ == stub_)                                         \
+            {                                                           \
+                if (!LL1MpscIsItem_(next_)) break;                      \
+                if (last_) LL1NodePtr_(type, last_, listOffset)->pNext = next_; \
+                head_ = next_;                                          \
+                continue;                                               \
+            }                                                           \
+            if (!LL1MpscIsItem_(next_))                                 \
+            {                                                           \
+                type * tail_ = (pTail)->load(std::memory_order_acquire); \
+                if (head_ != tail_) break;                              \
+                LL1MpscLink_(type, pTail, ppStubNext, listOffset, stub_); \
+                next_ = LL1MpscNextAtomic_(type, head_, listOffset)->load(std::memory_order_acquire); \
+                if (!LL1MpscIsItem_(next_)) break;                      \
+            }                                                           \
+            if (!first_) first_ = head_;                                \
+            last_ = head_;                                              \
+            cDrained++;                                                 \
+            head_ = next_;                                              \
+        }                                                               \
+        *(ppHead) = head_;                                              \
+        if (first_)                                                     \
+        {                                                               \
+            LL1NodePtr_(type, last_, listOffset)->pNext = (type *)LLEndOfList_; \
+            if (*(ppListTail))                                          \
+            {                                                           \
+                LL1NodePtr_(type, *(ppListTail), listOffset)->pNext = first_; \
+            }                                                           \
+            else                                                        \
+            {                                                           \
+                *(ppListHead) = first_;                                 \
+            }                                                           \
+            *(ppListTail) = last_;                                      \
+        }                                                               \
+    } while(0)
+
+#define LL1MpscDrain(type, queue, list, cDrained)                       \
+    LL1MpscDrain_(type, &(queue).pHead, &(queue).pTail, &(queue).pStubNext, (queue).offset, &list.pHead, &list.pTail, cDrained)
+
+#define LL1MpscRefDrain(type, queue, listRef, cDrained)                 \
+    LL1MpscDrain_(type, &(queue).pHead, &(queue).pTail, &(queue).pStubNext, (queue).offset, listRef.ppHead, listRef.ppTail, cDrained)
+
+
+
+
+//
+// Author: Andrew Smith - alsmith.net
+// License: MIT
+//
+#endif
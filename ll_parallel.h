@@ -0,0 +1,340 @@
+#ifndef ALS_LL_PARALLEL_H
+#define ALS_LL_PARALLEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+
+#include "ll.h"
+#include "ll_sched.h"
+
+//
+// Parallel for-each and reduce over a long LL2 list, using a sparse array of checkpoint pointers to cut the list into
+//  chunks that workers walk independently
+//
+// Requires:
+//  -ll.h, ll_sched.h (ll::Scheduler is the thread pool)
+//  -std::atomic, std::this_thread::yield
+//  -new/delete (Reduce's per-chunk partial results only)
+//
+// Walking a list is inherently serial, so the checkpoints are what make it parallel: chunk 0 runs from the head to
+//  the first checkpoint, chunk i from checkpoint i-1 to checkpoint i, and the last chunk to the end. The checkpoints
+//  are rebuilt lazily (one serial walk) when they have been invalidated or when enough items were added or removed
+//  that the chunks are likely lopsided. In between, they are maintained incrementally:
+//  -Adding items anywhere is always safe, new items just land in whichever chunk they were linked into. Calling
+//   NotifyAdd lets the rebalancing heuristic and the item count know about them.
+//  -Removing an item requires calling NotifyRemove first, in case it is a checkpoint (O(checkpoints) scan).
+//  -Anything that reorders items (MoveToHead, Sort, Rotate, splices...) requires Invalidate.
+//
+// Chunks are handed out dynamically from a shared counter, so uneven chunks or uneven per-item work still balance
+//  across workers. The calling thread works too. Lists shorter than cItemSerialMax are walked serially on the calling
+//  thread, as is everything when no scheduler is given.
+//
+// The per-item function must not add or remove items of this list (writing to the items themselves is fine).
+//
+// Usage:
+//      ll::ParallelList<Particle, &Particle::node> parallel(particleList);
+//      parallel.Init();
+//      parallel.ForEach(&sched, [](Particle * p) { p->Integrate(dt); });
+//      float energy = parallel.Reduce(&sched, 0.0f,
+//                                     [](float & acc, Particle * p) { acc += p->Energy(); },
+//                                     [](float a, float b) { return a + b; });
+//
+
+namespace ll
+{
+    // NOTE - One chunk-processing loop shared by every helper task and the calling thread
+    template <typename T, typename T::LL2Node T::* Link, typename ChunkFn>
+    struct ParallelJob_
+    {
+        enum
+        {
+            s_cHelperMax = 64,
+        };
+
+        struct Helper : Task
+        {
+            ParallelJob_ * pJob;
+        };
+
+        T * const * aBoundary;
+        int cChunk;
+        T * pHead;
+        ChunkFn & chunkFn;
+
+        std::atomic<int> iChunkNext;
+        std::atomic<int> cHelperLive;
+
+        ParallelJob_(T * const * aBoundary_, int cChunk_, T * pHead_, ChunkFn & chunkFn_)
+        : aBoundary(aBoundary_), cChunk(cChunk_), pHead(pHead_), chunkFn(chunkFn_), iChunkNext(0), cHelperLive(0)
+        {
+        }
+
+        void RunChunks()
+        {
+            for (;;)
+            {
+                int iChunk = iChunkNext.fetch_add(1, std::memory_order_relaxed);
+                if (iChunk >= cChunk) return;
+
+                T * pFirst = iChunk ? aBoundary[iChunk - 1] : pHead;
+                T * pEnd = (iChunk + 1 < cChunk) ? aBoundary[iChunk] : nullptr;
+                chunkFn(iChunk, pFirst, pEnd);
+            }
+        }
+
+        static void RunHelper(Task * pTask)
+        {
+            ParallelJob_ * pJob = static_cast<Helper *>(pTask)->pJob;
+            pJob->RunChunks();
+
+            // Last touch of the job, which lives on the caller's stack
+
+            pJob->cHelperLive.fetch_sub(1, std::memory_order_release);
+        }
+
+        void Run(Scheduler * pScheduler, int cHelper)
+        {
+            Helper aHelper[s_cHelperMax];
+            if (cHelper > s_cHelperMax) cHelper = s_cHelperMax;
+
+            cHelperLive.store(cHelper, std::memory_order_relaxed);
+            for (int iHelper = 0; iHelper < cHelper; iHelper++)
+            {
+                aHelper[iHelper].pfnRun = RunHelper;
+                aHelper[iHelper].pJob = this;
+                pScheduler->Submit(&aHelper[iHelper]);
+            }
+
+            RunChunks();
+
+            // Helpers that haven't started yet still point at this frame, so wait for all of them. On a worker,
+            //  run other tasks meanwhile (possibly our own helpers, which then exit right away).
+
+            bool isWorker = pScheduler->CurrentWorker() != nullptr;
+            while (cHelperLive.load(std::memory_order_acquire))
+            {
+                if (!isWorker || !pScheduler->RunOne()) std::this_thread::yield();
+            }
+        }
+    };
+
+    template <typename T, typename T::LL2Node T::* Link>
+    struct ParallelList
+    {
+        typedef List2Ops_<T, Link> Ops;
+
+        enum
+        {
+            s_cChunkMax = 256,
+        };
+
+        ListRef<T, Link> list;
+
+        // NOTE - Chunk boundaries in list order, see above. Between cChunkTarget and 2 * cChunkTarget chunks after a
+        //  rebuild (fewer for short lists).
+        T * aBoundary[s_cChunkMax];
+        int cBoundary = 0;
+
+        int cChunkTarget = 0;
+        uintptr_t cItemSerialMax = 0;
+
+        bool isValid = false;
+        uintptr_t cItem = 0;            // As of the last rebuild, adjusted by NotifyAdd/NotifyRemove
+        uintptr_t cItemAtBuild = 0;
+        uintptr_t cChange = 0;          // NotifyAdd/NotifyRemove calls since the last rebuild
+
+        template <typename L>
+        explicit ParallelList(L & list_) : list(list_) {}
+
+        ParallelList(T ** ppHead, T ** ppTail) : list(ppHead, ppTail) {}
+
+        // NOTE - cChunkTarget_ should be a few times the worker count, so dynamic hand-out can balance
+        void Init(int cChunkTarget_ = 64, uintptr_t cItemSerialMax_ = 4096)
+        {
+            if (cChunkTarget_ < 1) cChunkTarget_ = 1;
+            if (cChunkTarget_ > s_cChunkMax / 2) cChunkTarget_ = s_cChunkMax / 2;
+
+            cChunkTarget = cChunkTarget_;
+            cItemSerialMax = cItemSerialMax_;
+            Invalidate();
+        }
+
+        void Invalidate()
+        {
+            isValid = false;
+        }
+
+        void NotifyAdd(T * pItem)
+        {
+            (void)pItem;
+            cItem++;
+            cChange++;
+        }
+
+        // NOTE - Call before removing pItem from the list. A checkpoint on pItem moves to the next item, or is dropped
+        //  if that is already the next checkpoint (or the end).
+        void NotifyRemove(T * pItem)
+        {
+            if (cItem) cItem--;
+            cChange++;
+            if (!isValid) return;
+
+            for (int iBoundary = 0; iBoundary < cBoundary; iBoundary++)
+            {
+                if (aBoundary[iBoundary] != pItem) continue;
+
+                T * pNext = Ops::Next(pItem);
+                T * pBoundaryNext = (iBoundary + 1 < cBoundary) ? aBoundary[iBoundary + 1] : nullptr;
+                if (pNext && pNext != pBoundaryNext)
+                {
+                    aBoundary[iBoundary] = pNext;
+                }
+                else
+                {
+                    for (int iMove = iBoundary + 1; iMove < cBoundary; iMove++)
+                    {
+                        aBoundary[iMove - 1] = aBoundary[iMove];
+                    }
+                    cBoundary--;
+                }
+                return;
+            }
+        }
+
+        // NOTE - One serial walk. Keeps a boundary every 'stride' items, and when the array fills up, drops every
+        //  other one and doubles the stride, so the list only has to be walked once.
+        void Rebuild()
+        {
+            uintptr_t stride = 1;
+            uintptr_t iItem = 0;
+            int cBoundaryMax = cChunkTarget * 2;
+            cBoundary = 0;
+
+            for (T * pItem = list.Head(); pItem; pItem = Ops::Next(pItem), iItem++)
+            {
+                if (!iItem || iItem % stride) continue;
+
+                if (cBoundary == cBoundaryMax)
+                {
+                    // Keep boundaries at multiples of the doubled stride (odd indices, since index k is item (k+1) * stride)
+
+                    int cKeep = 0;
+                    for (int iBoundary = 1; iBoundary < cBoundary; iBoundary += 2)
+                    {
+                        aBoundary[cKeep++] = aBoundary[iBoundary];
+                    }
+                    cBoundary = cKeep;
+                    stride *= 2;
+                    if (iItem % stride) continue;
+                }
+
+                aBoundary[cBoundary++] = pItem;
+            }
+
+            cItem = iItem;
+            cItemAtBuild = iItem;
+            cChange = 0;
+            isValid = true;
+        }
+
+        // NOTE - Rebuilds when invalid, or when changes since the last rebuild add up to a quarter of the list
+        void EnsureValid()
+        {
+            if (!isValid || cChange > cItemAtBuild / 4 + 64) Rebuild();
+        }
+
+        int ChunkCount() const { return cBoundary + 1; }
+
+        template <typename Fn>
+        void ForEach(Scheduler * pScheduler, Fn fn)
+        {
+            EnsureValid();
+
+            auto chunkFn = [&fn](int iChunk, T * pFirst, T * pEnd)
+            {
+                (void)iChunk;
+                for (T * pItem = pFirst; pItem != pEnd; pItem = Ops::Next(pItem))
+                {
+                    fn(pItem);
+                }
+            };
+
+            if (!ShouldRunParallel(pScheduler))
+            {
+                chunkFn(0, list.Head(), nullptr);
+                return;
+            }
+
+            ParallelJob_<T, Link, decltype(chunkFn)> job(aBoundary, ChunkCount(), list.Head(), chunkFn);
+            job.Run(pScheduler, HelperCount(pScheduler));
+        }
+
+        // NOTE - accumulateFn(R & acc, T * pItem) folds an item into a chunk's partial result, which starts as
+        //  identity. combineFn(R, R) -> R merges partials, always in list order, so it only has to be associative.
+        template <typename R, typename AccumulateFn, typename CombineFn>
+        R Reduce(Scheduler * pScheduler, const R & identity, AccumulateFn accumulateFn, CombineFn combineFn)
+        {
+            EnsureValid();
+
+            if (!ShouldRunParallel(pScheduler))
+            {
+                R result = identity;
+                for (T * pItem = list.Head(); pItem; pItem = Ops::Next(pItem))
+                {
+                    accumulateFn(result, pItem);
+                }
+                return result;
+            }
+
+            int cChunk = ChunkCount();
+            R * aPartial = new R[cChunk];
+
+            auto chunkFn = [&](int iChunk, T * pFirst, T * pEnd)
+            {
+                R partial = identity;
+                for (T * pItem = pFirst; pItem != pEnd; pItem = Ops::Next(pItem))
+                {
+                    accumulateFn(partial, pItem);
+                }
+                aPartial[iChunk] = partial;
+            };
+
+            ParallelJob_<T, Link, decltype(chunkFn)> job(aBoundary, cChunk, list.Head(), chunkFn);
+            job.Run(pScheduler, HelperCount(pScheduler));
+
+            R result = identity;
+            for (int iChunk = 0; iChunk < cChunk; iChunk++)
+            {
+                result = combineFn(result, aPartial[iChunk]);
+            }
+
+            delete[] aPartial;
+            return result;
+        }
+
+        // Internal
+
+        bool ShouldRunParallel(Scheduler * pScheduler) const
+        {
+            return pScheduler && pScheduler->cWorker > 1 && cItem >= cItemSerialMax && cBoundary > 0;
+        }
+
+        // NOTE - The calling thread takes chunks too, so a caller that is itself a worker needs one helper less
+        int HelperCount(Scheduler * pScheduler) const
+        {
+            int cHelper = pScheduler->cWorker - (pScheduler->CurrentWorker() ? 1 : 0);
+            return (cHelper < cBoundary) ? cHelper : cBoundary;
+        }
+    };
+}
+
+
+
+
+//
+// Author: Andrew Smith - alsmith.net
+// License: MIT
+//
+#endif
@@ -0,0 +1,344 @@
+#ifndef ALS_LL_POOL_H
+#define ALS_LL_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <mutex>
+
+#include "ll.h"
+
+//
+// Fixed-size pool allocator whose free lists are LL1 lists threaded through the free blocks themselves
+//
+// Requires:
+//  -ll.h
+//  -malloc/free (slabs only)
+//  -std::mutex (depot only)
+//
+// Each thread allocates and frees through its own ll::PoolCache, which holds up to two batches of free blocks and
+//  never takes a lock. When a cache runs dry or overflows it trades a whole batch with the shared depot, which is a
+//  stack of batches under a mutex. A batch is just an LL1 chain (head, tail, count), so the trade is O(1) no matter
+//  the batch size. Slabs are carved into batches in bulk when the depot is empty.
+//
+// Memory only goes back to the system through Trim (slabs whose blocks are all in the depot) or Destroy.
+//
+// Usage:
+//      ll::Pool pool;
+//      pool.Init(sizeof(Foo));
+//      thread_local ll::PoolCache cache;
+//      Foo * pFoo = new (pool.Alloc(&cache)) Foo;
+//      pFoo->~Foo();
+//      pool.Free(&cache, pFoo);
+//      pool.Flush(&cache);    // Before the thread exits
+//
+
+namespace ll
+{
+    // NOTE - Overlaid on every free block. Only the first block of a batch uses batchNode/pBatchTail/cBatch.
+    struct PoolBlock_
+    {
+        DefineLL1Node(PoolBlock_)
+        LL1Node node;
+        LL1Node batchNode;
+        PoolBlock_ * pBatchTail;
+        uintptr_t cBatch;
+    };
+
+    struct PoolSlab_
+    {
+        DefineLL1Node(PoolSlab_)
+        LL1Node node;
+    };
+
+    typedef List1<PoolBlock_, &PoolBlock_::node> PoolBlockList_;
+    typedef List1<PoolBlock_, &PoolBlock_::batchNode> PoolBatchList_;
+
+    // NOTE - Owned by one thread at a time. A zero-initialized cache is empty and ready for use.
+    struct PoolCache
+    {
+        PoolBlockList_ loaded;
+        uintptr_t cLoaded = 0;
+
+        // NOTE - Either empty or exactly one full batch
+        PoolBlockList_ previous;
+        uintptr_t cPrevious = 0;
+    };
+
+    struct Pool
+    {
+        uintptr_t cbItem = 0;
+        uintptr_t cItemPerBatch = 0;
+        uintptr_t cItemPerSlab = 0;
+        uintptr_t cbSlabHeader = 0;
+
+        // NOTE - Everything below is guarded by mutex
+
+        std::mutex mutex;
+        PoolBatchList_ depot;
+        List1<PoolSlab_, &PoolSlab_::node> slabs;
+        uintptr_t cSlab = 0;
+
+        // NOTE - cbItem is rounded up to hold the free-list bookkeeping and to max_align_t alignment. cItemPerSlab of 0
+        //  picks something around 64KB per slab.
+        bool Init(uintptr_t cbItem_, uintptr_t cItemPerBatch_ = 64, uintptr_t cItemPerSlab_ = 0)
+        {
+            LL_ASSERT(!cSlab);
+            LL_ASSERT(cItemPerBatch_ > 0);
+
+            uintptr_t cbAlign = alignof(max_align_t);
+            cbItem = std::max(cbItem_, (uintptr_t)sizeof(PoolBlock_));
+            cbItem = (cbItem + cbAlign - 1) & ~(cbAlign - 1);
+            cbSlabHeader = (sizeof(PoolSlab_) + cbAlign - 1) & ~(cbAlign - 1);
+
+            cItemPerBatch = cItemPerBatch_;
+            cItemPerSlab = cItemPerSlab_ ? cItemPerSlab_ : std::max(cItemPerBatch * 4, (uintptr_t)(64 * 1024) / cbItem);
+            return true;
+        }
+
+        // NOTE - Frees every slab, including blocks still handed out or sitting in caches. Caches must be reset (or
+        //  discarded) before using them with this pool again.
+        void Destroy()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            while (PoolSlab_ * pSlab = slabs.RemoveHead())
+            {
+                free(pSlab);
+            }
+            cSlab = 0;
+            depot.ClearWithoutUnlinking();
+        }
+
+        void * Alloc(PoolCache * pCache)
+        {
+            if (!pCache->cLoaded)
+            {
+                if (pCache->cPrevious)
+                {
+                    pCache->loaded = pCache->previous;
+                    pCache->cLoaded = pCache->cPrevious;
+                    pCache->previous.ClearWithoutUnlinking();
+                    pCache->cPrevious = 0;
+                }
+                else if (!Refill(pCache))
+                {
+                    return nullptr;
+                }
+            }
+
+            pCache->cLoaded--;
+            return pCache->loaded.RemoveHead();
+        }
+
+        void Free(PoolCache * pCache, void * p)
+        {
+            if (!p) return;
+
+            PoolBlock_ * pBlock = (PoolBlock_ *)p;
+            pBlock->node.pNext = nullptr;
+
+            if (pCache->cLoaded >= cItemPerBatch)
+            {
+                if (pCache->cPrevious)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    PushBatch_(&pCache->previous, pCache->cPrevious);
+                }
+                pCache->previous = pCache->loaded;
+                pCache->cPrevious = pCache->cLoaded;
+                pCache->loaded.ClearWithoutUnlinking();
+                pCache->cLoaded = 0;
+            }
+
+            pCache->loaded.AddHead(pBlock);
+            pCache->cLoaded++;
+        }
+
+        // NOTE - Returns everything in the cache to the depot, e.g. before its thread exits or before Trim
+        void Flush(PoolCache * pCache)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (pCache->cLoaded) PushBatch_(&pCache->loaded, pCache->cLoaded);
+            if (pCache->cPrevious) PushBatch_(&pCache->previous, pCache->cPrevious);
+            pCache->cLoaded = 0;
+            pCache->cPrevious = 0;
+        }
+
+        // NOTE - Frees slabs whose blocks are all in the depot and returns how many were freed. Blocks in thread
+        //  caches count as in use, so flush the caches first to reclaim as much as possible. Takes the lock for
+        //  O(blocks in depot * log slabs), so call it from housekeeping rather than hot paths.
+        uintptr_t Trim()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!cSlab || !depot.pHead) return 0;
+
+            PoolSlab_ ** apSlab = (PoolSlab_ **)malloc(cSlab * sizeof(PoolSlab_ *));
+            uintptr_t * acFree = (uintptr_t *)calloc(cSlab, sizeof(uintptr_t));
+            if (!apSlab || !acFree)
+            {
+                free(apSlab);
+                free(acFree);
+                return 0;
+            }
+
+            uintptr_t iSlab = 0;
+            for (PoolSlab_ * pSlab : slabs)
+            {
+                apSlab[iSlab++] = pSlab;
+            }
+            std::sort(apSlab, apSlab + cSlab);
+
+            for (PoolBlock_ * pBatch : depot)
+            {
+                for (PoolBlock_ * pBlock = pBatch; pBlock; pBlock = PoolBlockList_::Next(pBlock))
+                {
+                    acFree[FindSlab_(apSlab, pBlock)]++;
+                }
+            }
+
+            // Rebuild the depot without the blocks of slabs that are about to be freed
+
+            PoolBatchList_ depotOld = depot;
+            depot.ClearWithoutUnlinking();
+
+            PoolBlockList_ batch;
+            uintptr_t cBatch = 0;
+            for (PoolBlock_ * pBatch = depotOld.pHead; pBatch; )
+            {
+                PoolBlock_ * pBatchNext = PoolBatchList_::Next(pBatch);
+                for (PoolBlock_ * pBlock = pBatch; pBlock; )
+                {
+                    PoolBlock_ * pBlockNext = PoolBlockList_::Next(pBlock);
+                    if (acFree[FindSlab_(apSlab, pBlock)] != cItemPerSlab)
+                    {
+                        pBlock->node.pNext = nullptr;
+                        batch.AddTail(pBlock);
+                        if (++cBatch == cItemPerBatch)
+                        {
+                            PushBatch_(&batch, cBatch);
+                            cBatch = 0;
+                        }
+                    }
+                    pBlock = pBlockNext;
+                }
+                pBatch = pBatchNext;
+            }
+            if (cBatch) PushBatch_(&batch, cBatch);
+
+            uintptr_t cFreed = 0;
+            slabs.ClearWithoutUnlinking();
+            for (iSlab = 0; iSlab < cSlab; iSlab++)
+            {
+                if (acFree[iSlab] == cItemPerSlab)
+                {
+                    free(apSlab[iSlab]);
+                    cFreed++;
+                }
+                else
+                {
+                    apSlab[iSlab]->node.pNext = nullptr;
+                    slabs.AddHead(apSlab[iSlab]);
+                }
+            }
+            cSlab -= cFreed;
+
+            free(apSlab);
+            free(acFree);
+            return cFreed;
+        }
+
+        // Internal
+
+        // NOTE - Turns the whole list into one batch (bookkeeping lives in its first block) and leaves it empty
+        static PoolBlock_ * MakeBatch_(PoolBlockList_ * pList, uintptr_t cBlock)
+        {
+            PoolBlock_ * pHead = pList->pHead;
+            pHead->pBatchTail = pList->pTail;
+            pHead->cBatch = cBlock;
+            pHead->batchNode.pNext = nullptr;
+            pList->ClearWithoutUnlinking();
+            return pHead;
+        }
+
+        // NOTE - Caller holds the lock
+        void PushBatch_(PoolBlockList_ * pList, uintptr_t cBlock)
+        {
+            depot.AddHead(MakeBatch_(pList, cBlock));
+        }
+
+        bool Refill(PoolCache * pCache)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (PoolBlock_ * pHead = depot.RemoveHead())
+                {
+                    pCache->loaded.pHead = pHead;
+                    pCache->loaded.pTail = pHead->pBatchTail;
+                    pCache->cLoaded = pHead->cBatch;
+                    return true;
+                }
+            }
+
+            // Carve a new slab outside the lock. The first batch goes straight to the cache, the rest are spliced onto
+            //  the depot in one step.
+
+            PoolSlab_ * pSlab = (PoolSlab_ *)malloc(cbSlabHeader + cItemPerSlab * cbItem);
+            if (!pSlab) return false;
+
+            pSlab->node.pNext = nullptr;
+            unsigned char * pbItem = (unsigned char *)pSlab + cbSlabHeader;
+
+            PoolBatchList_ batches;
+            PoolBlockList_ batch;
+            uintptr_t cBatch = 0;
+
+            for (uintptr_t iItem = 0; iItem < cItemPerSlab; iItem++)
+            {
+                PoolBlock_ * pBlock = (PoolBlock_ *)(pbItem + iItem * cbItem);
+                pBlock->node.pNext = nullptr;
+                batch.AddTail(pBlock);
+                if (++cBatch == cItemPerBatch || iItem + 1 == cItemPerSlab)
+                {
+                    if (!pCache->cLoaded)
+                    {
+                        pCache->loaded = batch;
+                        pCache->cLoaded = cBatch;
+                        batch.ClearWithoutUnlinking();
+                    }
+                    else
+                    {
+                        batches.AddHead(MakeBatch_(&batch, cBatch));
+                    }
+                    cBatch = 0;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            slabs.AddHead(pSlab);
+            cSlab++;
+            depot.Combine(batches);
+
+            return true;
+        }
+
+        uintptr_t FindSlab_(PoolSlab_ ** apSlab, PoolBlock_ * pBlock)
+        {
+            // Last slab starting at or before the block
+
+            PoolSlab_ ** ppSlab = std::upper_bound(apSlab, apSlab + cSlab, (PoolSlab_ *)pBlock,
+                                                   [](PoolSlab_ * a, PoolSlab_ * b) { return (uintptr_t)a < (uintptr_t)b; });
+            LL_ASSERT(ppSlab != apSlab);
+            return (uintptr_t)(ppSlab - apSlab - 1);
+        }
+    };
+}
+
+
+
+
+//
+// Author: Andrew Smith - alsmith.net
+// License: MIT
+//
+#endif
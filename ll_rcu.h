@@ -0,0 +1,448 @@
+#ifndef ALS_LL_RCU_H
+#define ALS_LL_RCU_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <thread>
+
+#include "ll.h"
+
+//
+// RCU-style LL2 list: wait-free readers walk the list while a writer adds, removes and relocates items, and removed
+//  items are freed after a grace period tracked by a userspace epoch-based reclamation domain
+//
+// Requires:
+//  -ll.h
+//  -std::atomic, std::this_thread::yield (EpochDomain::Synchronize only)
+//  -memcpy (Relocate only)
+//
+// Readers only ever follow pHead and pNext, which the writer publishes with atomic stores after the item is fully
+//  linked, so a reader sees every item either before or after a change, never half-linked. pPrev and pTail are the
+//  writer's own. Removing an item unlinks it from its neighbours but leaves its pNext alone, so a reader standing
+//  on it carries on to the rest of the list. That's also why a removed item can't be reused or freed right away.
+//
+// ll::EpochDomain tracks which readers might still hold such an item. A reader registers an ll::EpochReader once,
+//  then brackets every walk with Enter/Exit (or ll::EpochGuard), which is two stores, so readers never wait on
+//  anything. The domain's epoch only advances once every reader that is inside a walk has seen the current epoch.
+//  The epoch a reader publishes lives in a slot the domain owns, not in the EpochReader, so a reader can sit on its
+//  thread's stack and go away right after Unregister, even while a writer is scanning the slots.
+//  Items retired in epoch e are freed once the epoch reaches e + 2, by which point no reader can still reach them.
+//  Retiring reuses the item's own pPrev as the limbo link, so it doesn't allocate either.
+//
+// Writers must be serialized per list (e.g. a mutex around writes, readers don't take it). Several lists, with
+//  different writers, can share one domain, which must outlive them. A reader stuck inside a walk delays
+//  reclamation, but never blocks the writer. Destroying a list frees whatever it still has retired, waiting for a
+//  grace period if it has to.
+//
+// Usage:
+//      struct Route { DefineLL2Node(Route); LL2Node node; ... };
+//      static void FreeRoute(Route * pRoute, void *) { delete pRoute; }
+//      ll::EpochDomain domain;
+//      ll::RcuList<Route, &Route::node> routes;
+//      routes.Init(&domain, FreeRoute, nullptr);
+//
+//      // Reader thread
+//      ll::EpochReader reader;
+//      domain.Register(&reader);
+//      {
+//          ll::EpochGuard guard(&reader);
+//          for (Route * pRoute = routes.Head(); pRoute; pRoute = routes.Next(pRoute)) { ... }
+//      }
+//      domain.Unregister(&reader);
+//
+//      // Writer thread
+//      routes.AddTail(pRoute);
+//      routes.Remove(pRouteOld);
+//      routes.Retire(pRouteOld);       // Freed by a later Reclaim, once no reader can see it
+//      routes.Reclaim();
+//
+
+namespace ll
+{
+    struct EpochDomain;
+
+    // NOTE - Where one registered reader publishes its epoch. Owned by the domain, see EpochDomain::aSlot.
+    struct EpochSlot_
+    {
+        // NOTE - Epoch seen on Enter, or 0 outside of a walk. Epochs start at 1.
+        std::atomic<uint64_t> epoch;
+        std::atomic<bool> isUsed;
+
+        // NOTE - Keeps readers off each other's cache lines
+        unsigned char aPadding[64 - sizeof(std::atomic<uint64_t>) - sizeof(std::atomic<bool>)];
+    };
+
+    // NOTE - One per reader thread, registered with the domain before its first walk. Only a handle to the
+    //  domain's slot, so it can be destroyed as soon as it is unregistered.
+    struct EpochReader
+    {
+        EpochDomain * pDomain = nullptr;
+        EpochSlot_ * pSlot = nullptr;
+
+        inline void Enter();
+        inline void Exit();
+    };
+
+    struct EpochGuard
+    {
+        EpochReader * pReader;
+
+        explicit EpochGuard(EpochReader * pReader_) : pReader(pReader_) { pReader->Enter(); }
+        ~EpochGuard() { pReader->Exit(); }
+
+        EpochGuard(const EpochGuard &) = delete;
+        EpochGuard & operator=(const EpochGuard &) = delete;
+    };
+
+    struct EpochDomain
+    {
+        enum
+        {
+            s_cReaderMax = 256,
+        };
+
+        std::atomic<uint64_t> epoch;
+
+        // NOTE - Reader slots live as long as the domain, so TryAdvance can read any of them at any time, whatever
+        //  Unregister is doing. Free slots read as outside of a walk. Slots [cSlotScan, s_cReaderMax) have never been
+        //  used, and Register takes the lowest free slot, so scans stay short.
+        EpochSlot_ aSlot[s_cReaderMax];
+        std::atomic<int> cSlotScan;
+
+        EpochDomain() : epoch(1), cSlotScan(0)
+        {
+            for (int iSlot = 0; iSlot < s_cReaderMax; iSlot++)
+            {
+                aSlot[iSlot].epoch.store(0, std::memory_order_relaxed);
+                aSlot[iSlot].isUsed.store(false, std::memory_order_relaxed);
+            }
+        }
+
+        // NOTE - Every reader must be unregistered first
+        ~EpochDomain()
+        {
+            for (int iSlot = 0; iSlot < s_cReaderMax; iSlot++)
+            {
+                LL_ASSERT(!aSlot[iSlot].isUsed.load());
+            }
+        }
+
+        EpochDomain(const EpochDomain &) = delete;
+        EpochDomain & operator=(const EpochDomain &) = delete;
+
+        // NOTE - Fails if s_cReaderMax readers are already registered
+        bool Register(EpochReader * pReader)
+        {
+            LL_ASSERT(!pReader->pDomain);
+
+            for (int iSlot = 0; iSlot < s_cReaderMax; iSlot++)
+            {
+                bool isUsedExpected = false;
+                if (!aSlot[iSlot].isUsed.compare_exchange_strong(isUsedExpected, true)) continue;
+
+                int cSlotScanCur = cSlotScan.load();
+                while (cSlotScanCur <= iSlot && !cSlotScan.compare_exchange_weak(cSlotScanCur, iSlot + 1)) {}
+
+                pReader->pDomain = this;
+                pReader->pSlot = &aSlot[iSlot];
+                return true;
+            }
+
+            LL_ASSERT(false);
+            return false;
+        }
+
+        // NOTE - Must be outside of a walk. The slot is only marked free, a scan still reading it sees epoch 0.
+        void Unregister(EpochReader * pReader)
+        {
+            LL_ASSERT(pReader->pDomain == this && !pReader->pSlot->epoch.load());
+
+            pReader->pSlot->isUsed.store(false);
+            pReader->pDomain = nullptr;
+            pReader->pSlot = nullptr;
+        }
+
+        uint64_t Epoch() const { return epoch.load(); }
+
+        // NOTE - Advances the epoch by one if every reader inside a walk has seen the current one. Returns the
+        //  (possibly new) epoch. Never waits, so writers can call it as often as they like.
+        uint64_t TryAdvance()
+        {
+            uint64_t epochCur = epoch.load();
+            int cSlot = cSlotScan.load();
+            for (int iSlot = 0; iSlot < cSlot; iSlot++)
+            {
+                uint64_t epochReader = aSlot[iSlot].epoch.load();
+                if (epochReader && epochReader != epochCur) return epochCur;
+            }
+
+            // Another writer may have advanced it meanwhile, which is just as good
+
+            epoch.compare_exchange_strong(epochCur, epochCur + 1);
+            return epoch.load();
+        }
+
+        // NOTE - Blocks until every walk that was in progress on entry has finished, i.e. until anything unlinked
+        //  before the call can be reused or freed directly. Must not be called from inside a walk.
+        void Synchronize()
+        {
+            uint64_t epochTarget = epoch.load() + 2;
+            while (TryAdvance() < epochTarget)
+            {
+                std::this_thread::yield();
+            }
+        }
+    };
+
+    // NOTE - The publish, the walk's loads, the writer's unlinking stores and TryAdvance's scan are all seq_cst, so
+    //  either the writer's scan sees this reader, or the walk sees the unlinks. On x86 and ARMv8 that costs readers
+    //  nothing over plain acquire loads, only the publish itself is a full barrier.
+    inline void EpochReader::Enter()
+    {
+        LL_ASSERT(pDomain && !pSlot->epoch.load(std::memory_order_relaxed));
+        pSlot->epoch.store(pDomain->epoch.load());
+    }
+
+    inline void EpochReader::Exit()
+    {
+        pSlot->epoch.store(0, std::memory_order_release);
+    }
+
+    template <typename T, typename T::LL2Node T::* Link>
+    struct RcuList
+    {
+        typedef void (* PfnFree)(T * pItem, void * pUserData);
+
+        enum
+        {
+            s_cLimbo = 3,       // Epochs e - 2, e - 1 and e can have retired items pending at once
+        };
+
+        std::atomic<T *> pHead;
+        T * pTail = nullptr;
+
+        EpochDomain * pDomain = nullptr;
+        PfnFree pfnFree = nullptr;
+        void * pUserData = nullptr;
+
+        // NOTE - Retired items, chained through pPrev (LLEndOfList_ terminated), by epoch % s_cLimbo
+        T * apLimbo[s_cLimbo] = {};
+        uint64_t aEpochLimbo[s_cLimbo] = {};
+        uintptr_t cRetired = 0;
+
+        RcuList() : pHead(nullptr) {}
+
+        // NOTE - Frees anything still retired (see ReclaimAll), so it must not run inside a walk. Linked items are
+        //  left alone, as with every other list.
+        ~RcuList() { ReclaimAll(); }
+
+        RcuList(const RcuList &) = delete;
+        RcuList & operator=(const RcuList &) = delete;
+
+        void Init(EpochDomain * pDomain_, PfnFree pfnFree_, void * pUserData_)
+        {
+            pDomain = pDomain_;
+            pfnFree = pfnFree_;
+            pUserData = pUserData_;
+        }
+
+        // Readers (inside Enter/Exit)
+
+        T * Head() const
+        {
+            return pHead.load();
+        }
+
+        static T * Next(T * pItem)
+        {
+            T * pNext = NextAtomic(pItem)->load();
+            return (pNext == EndOfList()) ? nullptr : pNext;
+        }
+
+        // Writer
+
+        static bool IsItemLinked(T * pItem)
+        {
+            return (pItem->*Link).pPrev != nullptr;
+        }
+
+        T * Tail() const { return pTail; }
+
+        // NOTE - Writer-side only, readers can't walk backwards
+        static T * Prev(T * pItem)
+        {
+            T * pPrev = (pItem->*Link).pPrev;
+            return (pPrev == EndOfList()) ? nullptr : pPrev;
+        }
+
+        void AddHead(T * pItem)
+        {
+            InsertBefore(pItem, Head());
+        }
+
+        void AddTail(T * pItem)
+        {
+            InsertBefore(pItem, nullptr);
+        }
+
+        // NOTE - A null pItemNext adds at the tail
+        void InsertBefore(T * pItem, T * pItemNext)
+        {
+            if (IsItemLinked(pItem))
+            {
+                LL_ASSERT(false);
+                return;
+            }
+
+            T * pItemPrev = pItemNext ? Prev(pItemNext) : pTail;
+
+            // Fully link the new item before it becomes reachable
+
+            (pItem->*Link).pPrev = pItemPrev ? pItemPrev : EndOfList();
+            NextAtomic(pItem)->store(pItemNext ? pItemNext : EndOfList(), std::memory_order_relaxed);
+            Publish(pItemPrev, pItem);
+
+            if (pItemNext) (pItemNext->*Link).pPrev = pItem;
+            else pTail = pItem;
+        }
+
+        // NOTE - Unlinks pItem for new readers. Readers already on it still see its pNext, so it must not be freed or
+        //  relinked until a grace period has passed: hand it to Retire, or call EpochDomain::Synchronize first.
+        void Remove(T * pItem)
+        {
+            if (!IsItemLinked(pItem)) return;
+
+            T * pItemPrev = Prev(pItem);
+            T * pItemNext = Next(pItem);
+            Publish(pItemPrev, pItemNext ? pItemNext : EndOfList());
+
+            if (pItemNext) (pItemNext->*Link).pPrev = pItemPrev ? pItemPrev : EndOfList();
+            else pTail = pItemPrev;
+
+            (pItem->*Link).pPrev = nullptr;
+        }
+
+        // NOTE - Swaps pItemNew in for pItemOld in one step, e.g. to publish an updated copy of an item. pItemNew must
+        //  be unlinked and already hold its new contents. pItemOld is unlinked as if by Remove.
+        void Replace(T * pItemOld, T * pItemNew)
+        {
+            if (!IsItemLinked(pItemOld) || IsItemLinked(pItemNew))
+            {
+                LL_ASSERT(false);
+                return;
+            }
+
+            T * pItemPrev = Prev(pItemOld);
+            T * pItemNext = Next(pItemOld);
+            (pItemNew->*Link).pPrev = (pItemOld->*Link).pPrev;
+            NextAtomic(pItemNew)->store(pItemNext ? pItemNext : EndOfList(), std::memory_order_relaxed);
+            Publish(pItemPrev, pItemNew);
+
+            if (pItemNext) (pItemNext->*Link).pPrev = pItemNew;
+            else pTail = pItemNew;
+
+            (pItemOld->*Link).pPrev = nullptr;
+        }
+
+        // NOTE - Moves pItemOld's bytes to pItemNew (so T must be trivially relocatable) and swaps it in. Unlike
+        //  LL2Relocate_, the old address stays intact for readers still on it, and still has to be retired.
+        void Relocate(T * pItemOld, T * pItemNew)
+        {
+            memcpy((void *)pItemNew, (const void *)pItemOld, sizeof(T));
+            (pItemNew->*Link).pPrev = nullptr;
+            (pItemNew->*Link).pNext = nullptr;
+            Replace(pItemOld, pItemNew);
+        }
+
+        // NOTE - Queues a removed item to be freed (via pfnFree) once no reader can reach it. The item counts as
+        //  linked until then.
+        void Retire(T * pItem)
+        {
+            LL_ASSERT(!IsItemLinked(pItem));
+
+            uint64_t epochCur = pDomain->Epoch();
+            int iLimbo = (int)(epochCur % s_cLimbo);
+            if (apLimbo[iLimbo] && aEpochLimbo[iLimbo] != epochCur)
+            {
+                // Left over from epoch - 3 or earlier, long safe
+
+                FreeLimbo(iLimbo);
+            }
+
+            (pItem->*Link).pPrev = apLimbo[iLimbo] ? apLimbo[iLimbo] : EndOfList();
+            apLimbo[iLimbo] = pItem;
+            aEpochLimbo[iLimbo] = epochCur;
+            cRetired++;
+        }
+
+        // NOTE - Tries to advance the domain's epoch and frees whatever became safe. Returns how many retired items
+        //  are still waiting. Never blocks.
+        uintptr_t Reclaim()
+        {
+            if (!cRetired) return 0;
+
+            uint64_t epochCur = pDomain->TryAdvance();
+            for (int iLimbo = 0; iLimbo < s_cLimbo; iLimbo++)
+            {
+                if (apLimbo[iLimbo] && aEpochLimbo[iLimbo] + 2 <= epochCur) FreeLimbo(iLimbo);
+            }
+            return cRetired;
+        }
+
+        // NOTE - Waits for a grace period and frees everything retired so far. Must not be called from inside a walk.
+        void ReclaimAll()
+        {
+            if (!cRetired) return;
+
+            pDomain->Synchronize();
+            for (int iLimbo = 0; iLimbo < s_cLimbo; iLimbo++)
+            {
+                if (apLimbo[iLimbo]) FreeLimbo(iLimbo);
+            }
+        }
+
+        // Internal
+
+        static T * EndOfList() { return (T *)LLEndOfList_; }
+
+        // NOTE - Same representation assumption as LL1MpscNextAtomic_
+        static std::atomic<T *> * NextAtomic(T * pItem)
+        {
+            return (std::atomic<T *> *)&(pItem->*Link).pNext;
+        }
+
+        // NOTE - Points pItemPrev (or the head, if null) at pItem. This is the one store readers can observe.
+        void Publish(T * pItemPrev, T * pItem)
+        {
+            if (pItemPrev) NextAtomic(pItemPrev)->store(pItem);
+            else pHead.store((pItem == EndOfList()) ? nullptr : pItem);
+        }
+
+        void FreeLimbo(int iLimbo)
+        {
+            T * pItem = apLimbo[iLimbo];
+            apLimbo[iLimbo] = nullptr;
+
+            while (pItem != EndOfList())
+            {
+                T * pLimboNext = (pItem->*Link).pPrev;
+                (pItem->*Link).pPrev = nullptr;
+                (pItem->*Link).pNext = nullptr;
+                cRetired--;
+                if (pfnFree) pfnFree(pItem, pUserData);
+                pItem = pLimboNext;
+            }
+        }
+    };
+}
+
+
+
+
+//
+// Author: Andrew Smith - alsmith.net
+// License: MIT
+//
+#endif
@@ -0,0 +1,405 @@
+#ifndef ALS_LL_SCHED_H
+#define ALS_LL_SCHED_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "ll.h"
+
+//
+// Work-stealing task scheduler where every worker's run-queue is an intrusive LL2 list of tasks
+//
+// Requires:
+//  -ll.h
+//  -std::thread, std::mutex, std::condition_variable, std::atomic
+//  -new/delete (worker array only, once in Init)
+//
+// Tasks embed their own link (derive from ll::Task), so submitting never allocates. A worker pushes and pops at the
+//  head of its own queue (newest first, which keeps spawned subtasks cache-hot). An idle worker steals the older half
+//  of a random victim's queue with a single O(1) LL2 split: every queue keeps a pMid cursor at the start of its back
+//  half, which push/pop nudge by at most two hops. After the split, the victim and the thief each walk half of what
+//  they now hold to find its new midpoint. That is a quarter of the victim's old queue each, paid for by the tasks
+//  that moved.
+//
+// Workers with nothing to run or steal park on a condition variable and are woken by Submit. Shutdown drains: it
+//  waits until every submitted task (including tasks submitted by running tasks) has finished, then stops and joins
+//  the workers.
+//
+// Usage:
+//      struct Job : ll::Task { int i; };
+//      static void RunJob(ll::Task * pTask) { Job * pJob = static_cast<Job *>(pTask); ... }
+//      ll::Scheduler sched;
+//      sched.Init(0);                              // One worker per hardware thread
+//      job.pfnRun = RunJob;
+//      sched.Submit(&job);
+//      sched.WaitIdle();
+//      sched.Shutdown();
+//
+
+namespace ll
+{
+    struct Task
+    {
+        typedef void (* PfnRun)(Task * pTask);
+
+        DefineLL2Node(Task);
+        LL2Node node = {};
+
+        // NOTE - The scheduler doesn't touch the task once pfnRun is called, so pfnRun may free or resubmit it
+        PfnRun pfnRun = nullptr;
+    };
+
+    typedef List<Task, &Task::node> TaskList;
+
+    struct Scheduler;
+
+    // NOTE - Guarded by mutex. Items [pMid, tail] are the back half that thieves take, cBack of them. cBack is always
+    //  ceil(cTask / 2): push/pop keep it there through Rebalance, and steal/adopt find the new midpoint directly.
+    struct SchedWorker_
+    {
+        std::mutex mutex;
+        TaskList queue;
+        Task * pMid = nullptr;
+        uintptr_t cTask = 0;
+        uintptr_t cBack = 0;
+
+        Scheduler * pScheduler = nullptr;
+        int iWorker = 0;
+        uint32_t rng = 0;
+        std::thread thread;
+
+        uint64_t cRun = 0;
+        uint64_t cSteal = 0;
+        uint64_t cStolenTask = 0;
+
+        // NOTE - Keeps neighbouring workers in the array off each other's cache lines (alignas would need C++17
+        //  aligned new)
+        unsigned char aPadding[64];
+
+        void Push(Task * pTask)
+        {
+            queue.AddHead(pTask);
+            cTask++;
+            if (cTask == 1)
+            {
+                pMid = pTask;
+                cBack = 1;
+            }
+            else
+            {
+                Rebalance();
+            }
+        }
+
+        Task * Pop()
+        {
+            Task * pTask = queue.RemoveHead();
+            if (!pTask) return nullptr;
+
+            if (pTask == pMid)
+            {
+                pMid = queue.Head();
+                cBack--;
+            }
+            cTask--;
+            Rebalance();
+            return pTask;
+        }
+
+        // NOTE - Moves the back half onto stolen, which must be empty. Returns how many tasks were taken.
+        uintptr_t StealHalf(TaskList & stolen)
+        {
+            if (!cTask) return 0;
+
+            uintptr_t cStolen = cBack;
+            queue.SplitAt(stolen, pMid);
+            cTask -= cStolen;
+
+            // Otherwise the next thief would only get the one task at the tail
+
+            pMid = BackHalfOf(queue, cTask);
+            cBack = (cTask + 1) / 2;
+            return cStolen;
+        }
+
+        // NOTE - Appends stolen tasks behind our own. The queue is usually empty here, so the midpoint ends up at the
+        //  stolen batch's own midpoint, but Submit from outside may have pushed to it since we last looked.
+        void Adopt(TaskList & stolen, uintptr_t cStolen)
+        {
+            queue.Combine(stolen);
+            cTask += cStolen;
+
+            pMid = BackHalfOf(queue, cTask);
+            cBack = (cTask + 1) / 2;
+        }
+
+        // NOTE - First of the last ceil(cTask / 2) tasks of a list holding cTask, found by walking back from the tail
+        static Task * BackHalfOf(TaskList & list, uintptr_t cTask)
+        {
+            Task * pTask = list.Tail();
+            for (uintptr_t cBackHalf = 1; cBackHalf < (cTask + 1) / 2; cBackHalf++)
+            {
+                pTask = TaskList::Prev(pTask);
+            }
+            return pTask;
+        }
+
+        // NOTE - At most two hops per call, which is enough to keep up with one push/pop
+        void Rebalance()
+        {
+            uintptr_t cBackTarget = (cTask + 1) / 2;
+            for (int cHop = 0; cHop < 2 && cBack != cBackTarget; cHop++)
+            {
+                if (cBack < cBackTarget)
+                {
+                    pMid = TaskList::Prev(pMid);
+                    cBack++;
+                }
+                else
+                {
+                    pMid = TaskList::Next(pMid);
+                    cBack--;
+                }
+            }
+        }
+    };
+
+    struct Scheduler
+    {
+        SchedWorker_ * aWorker = nullptr;
+        int cWorker = 0;
+
+        // NOTE - Tasks sitting in queues (for parking), and tasks submitted but not finished (for draining)
+        std::atomic<intptr_t> cQueued;
+        std::atomic<intptr_t> cPending;
+        std::atomic<uint32_t> iSubmitNext;
+        std::atomic<bool> isStopping;
+
+        std::mutex mutexPark;
+        std::condition_variable cvPark;
+        std::atomic<int> cParked;
+
+        std::mutex mutexIdle;
+        std::condition_variable cvIdle;
+
+        Scheduler() : cQueued(0), cPending(0), iSubmitNext(0), isStopping(false), cParked(0) {}
+        ~Scheduler() { Shutdown(); }
+
+        Scheduler(const Scheduler &) = delete;
+        Scheduler & operator=(const Scheduler &) = delete;
+
+        // NOTE - cWorker_ of 0 starts one worker per hardware thread
+        bool Init(int cWorker_)
+        {
+            LL_ASSERT(!aWorker);
+
+            if (cWorker_ <= 0) cWorker_ = (int)std::thread::hardware_concurrency();
+            if (cWorker_ <= 0) cWorker_ = 1;
+
+            aWorker = new SchedWorker_[cWorker_];
+            cWorker = cWorker_;
+            isStopping.store(false);
+
+            for (int iWorker = 0; iWorker < cWorker; iWorker++)
+            {
+                SchedWorker_ & worker = aWorker[iWorker];
+                worker.pScheduler = this;
+                worker.iWorker = iWorker;
+                worker.rng = 0x9e3779b9u * (uint32_t)(iWorker + 1);
+            }
+
+            for (int iWorker = 0; iWorker < cWorker; iWorker++)
+            {
+                SchedWorker_ * pWorker = &aWorker[iWorker];
+                pWorker->thread = std::thread([this, pWorker]() { WorkerMain(pWorker); });
+            }
+
+            return true;
+        }
+
+        // NOTE - Waits for all submitted tasks to finish, then stops and joins the workers. Safe to call more than
+        //  once. Must not be called from a task.
+        void Shutdown()
+        {
+            if (!aWorker) return;
+
+            WaitIdle();
+
+            {
+                std::lock_guard<std::mutex> lock(mutexPark);
+                isStopping.store(true);
+            }
+            cvPark.notify_all();
+
+            for (int iWorker = 0; iWorker < cWorker; iWorker++)
+            {
+                aWorker[iWorker].thread.join();
+            }
+
+            delete[] aWorker;
+            aWorker = nullptr;
+            cWorker = 0;
+        }
+
+        // NOTE - From a task, goes to the front of the current worker's queue. From any other thread, goes to the
+        //  workers round-robin.
+        void Submit(Task * pTask)
+        {
+            LL_ASSERT(aWorker && pTask->pfnRun);
+            LL_ASSERT(!TaskList::IsItemLinked(pTask));
+
+            SchedWorker_ * pWorker = CurrentWorker();
+            if (!pWorker) pWorker = &aWorker[iSubmitNext.fetch_add(1, std::memory_order_relaxed) % (uint32_t)cWorker];
+
+            cPending.fetch_add(1);
+            {
+                std::lock_guard<std::mutex> lock(pWorker->mutex);
+                pWorker->Push(pTask);
+            }
+            cQueued.fetch_add(1);
+
+            if (cParked.load() > 0)
+            {
+                std::lock_guard<std::mutex> lock(mutexPark);
+                cvPark.notify_one();
+            }
+        }
+
+        // NOTE - Blocks until every submitted task has finished. Must not be called from a task (use RunOne to help
+        //  instead).
+        void WaitIdle()
+        {
+            LL_ASSERT(!CurrentWorker());
+            std::unique_lock<std::mutex> lock(mutexIdle);
+            cvIdle.wait(lock, [this]() { return cPending.load() == 0; });
+        }
+
+        // NOTE - Runs one task (own queue first, then stolen) on the calling worker. Returns false if there was none.
+        //  For tasks that wait on other tasks, so the wait does useful work instead of blocking a worker.
+        bool RunOne()
+        {
+            SchedWorker_ * pWorker = CurrentWorker();
+            if (!pWorker) return false;
+
+            Task * pTask = FindTask(pWorker);
+            if (!pTask) return false;
+
+            Run(pWorker, pTask);
+            return true;
+        }
+
+        // NOTE - The worker the calling thread belongs to, or nullptr if it isn't one of this scheduler's workers
+        SchedWorker_ * CurrentWorker()
+        {
+            SchedWorker_ * pWorker = CurrentWorkerTls();
+            return (pWorker && pWorker->pScheduler == this) ? pWorker : nullptr;
+        }
+
+        // Internal
+
+        static SchedWorker_ *& CurrentWorkerTls()
+        {
+            static thread_local SchedWorker_ * s_pWorker = nullptr;
+            return s_pWorker;
+        }
+
+        void WorkerMain(SchedWorker_ * pWorker)
+        {
+            CurrentWorkerTls() = pWorker;
+
+            for (;;)
+            {
+                if (Task * pTask = FindTask(pWorker))
+                {
+                    Run(pWorker, pTask);
+                    continue;
+                }
+
+                // Park. cParked is raised before cQueued is checked, and Submit raises cQueued before checking
+                //  cParked, so at least one side sees the other and no wakeup is lost.
+
+                std::unique_lock<std::mutex> lock(mutexPark);
+                cParked.fetch_add(1);
+                if (cQueued.load() == 0 && !isStopping.load())
+                {
+                    cvPark.wait(lock);
+                }
+                cParked.fetch_sub(1);
+
+                if (isStopping.load() && cQueued.load() == 0) break;
+            }
+
+            CurrentWorkerTls() = nullptr;
+        }
+
+        Task * FindTask(SchedWorker_ * pWorker)
+        {
+            {
+                std::lock_guard<std::mutex> lock(pWorker->mutex);
+                if (Task * pTask = pWorker->Pop())
+                {
+                    cQueued.fetch_sub(1);
+                    return pTask;
+                }
+            }
+
+            if (cQueued.load(std::memory_order_relaxed) == 0) return nullptr;
+
+            // Start at a random victim so thieves spread out
+
+            uint32_t & rng = pWorker->rng;
+            rng ^= rng << 13;
+            rng ^= rng >> 17;
+            rng ^= rng << 5;
+
+            for (int iTry = 0; iTry < cWorker; iTry++)
+            {
+                SchedWorker_ & victim = aWorker[(rng + (uint32_t)iTry) % (uint32_t)cWorker];
+                if (&victim == pWorker) continue;
+
+                TaskList stolen;
+                uintptr_t cStolen;
+                {
+                    std::lock_guard<std::mutex> lock(victim.mutex);
+                    cStolen = victim.StealHalf(stolen);
+                }
+                if (!cStolen) continue;
+
+                std::lock_guard<std::mutex> lock(pWorker->mutex);
+                pWorker->cSteal++;
+                pWorker->cStolenTask += cStolen;
+                pWorker->Adopt(stolen, cStolen);
+                Task * pTask = pWorker->Pop();
+                cQueued.fetch_sub(1);
+                return pTask;
+            }
+
+            return nullptr;
+        }
+
+        void Run(SchedWorker_ * pWorker, Task * pTask)
+        {
+            pTask->pfnRun(pTask);
+            pWorker->cRun++;
+
+            if (cPending.fetch_sub(1) == 1)
+            {
+                std::lock_guard<std::mutex> lock(mutexIdle);
+                cvIdle.notify_all();
+            }
+        }
+    };
+}
+
+
+
+
+//
+// Author: Andrew Smith - alsmith.net
+// License: MIT
+//
+#endif
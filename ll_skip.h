@@ -0,0 +1,402 @@
+#ifndef ALS_LL_SKIP_H
+#define ALS_LL_SKIP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <functional>
+
+#include "ll.h"
+
+//
+// Indexable skip list layered over a sorted LL2 list
+//
+// Requires:
+//  -ll.h
+//  -malloc/free (express lanes only)
+//
+// The base LL2 list is level 0 and keeps every item in sorted order, so ForLL2/ll::List iteration over it is
+//  unaffected. Items that get promoted (1 in 4, then 1 in 4 of those, ...) also carry a small malloc'd array of
+//  express lanes, pointed to by an intrusive ll::SkipNode. Each lane link stores how many base items it skips, which
+//  gives O(log n) sorted insert, LowerBound, Nth and IndexOf on top of the usual LL2 operations.
+//
+// Insert and remove through the skip list so the lanes stay in sync. Items unlinked from the base list some other
+//  way (e.g. LL2Remove_) leave the lanes stale until Rebuild is called.
+//
+// Usage:
+//      struct Job { uint64_t priority; DefineLL2Node(Job); LL2Node node; ll::SkipNode<Job> skip; };
+//      ll::List<Job, &Job::node> jobs;
+//      ll::SkipList<Job, &Job::node, &Job::skip, uint64_t, &Job::priority> index(jobs);
+//      index.Insert(&job);
+//      Job * pMedian = index.Nth(index.Count() / 2);
+//
+
+namespace ll
+{
+    template <typename T>
+    struct SkipLane_
+    {
+        T * pNext;
+        T * pPrev;          // nullptr = the skip list's head
+        uintptr_t width;    // Base items from this one up to and including pNext (pNext nullptr counts as 1 past the end)
+    };
+
+    // NOTE - Must be zero-initialized, like the LL2Node it sits beside
+    template <typename T>
+    struct SkipNode
+    {
+        SkipLane_<T> * aLane;   // aLane[i] is level i + 1
+        uint32_t cLevel;
+    };
+
+    template <typename T, typename T::LL2Node T::* Link, SkipNode<T> T::* Skip, typename K, K T::* Key, typename Less = std::less<K>>
+    struct SkipList
+    {
+        enum { s_cLevelMax = 24 };
+
+        typedef SkipLane_<T> Lane;
+
+        ListRef<T, Link> list;
+        uintptr_t cItem = 0;
+        uint32_t cLevelTop = 0;
+        uint64_t rngState = 0x9E3779B97F4A7C15ULL;
+
+        Lane aHead[s_cLevelMax] = {};
+
+        // NOTE - baseList should be empty, otherwise call Rebuild before using the index
+        template <typename L>
+        explicit SkipList(L & baseList) : list(baseList) {}
+
+        SkipList(const SkipList &) = delete;
+        SkipList & operator=(const SkipList &) = delete;
+
+        ~SkipList() { ReleaseLanes(); }
+
+        uintptr_t Count() const { return cItem; }
+
+        // NOTE - Inserts after any items with an equal key. O(log n) expected.
+        void Insert(T * pItem)
+        {
+            if (list.IsItemLinked(pItem))
+            {
+                LL_ASSERT(false);
+                return;
+            }
+
+            T * apPred[s_cLevelMax + 1];
+            uintptr_t aRank[s_cLevelMax + 1];
+
+            const K & key = pItem->*Key;
+            T * pCur = nullptr;
+            uintptr_t rank = 0;
+            for (uint32_t iLevel = cLevelTop; iLevel >= 1; iLevel--)
+            {
+                for (;;)
+                {
+                    Lane & lane = LaneOf(pCur, iLevel);
+                    if (!lane.pNext || Less()(key, lane.pNext->*Key)) break;
+
+                    rank += lane.width;
+                    pCur = lane.pNext;
+                }
+                apPred[iLevel] = pCur;
+                aRank[iLevel] = rank;
+            }
+
+            // Finish on the base list, expected to take only a step or two
+
+            T * pNext = pCur ? list.Next(pCur) : list.Head();
+            while (pNext && !Less()(key, pNext->*Key))
+            {
+                rank++;
+                pNext = list.Next(pNext);
+            }
+
+            list.InsertBefore(pItem, pNext);
+            cItem++;
+
+            SkipNode<T> & node = pItem->*Skip;
+            free(node.aLane);
+            node.aLane = nullptr;
+            node.cLevel = 0;
+
+            uint32_t cLevel = RandomLevel();
+            if (cLevel)
+            {
+                node.aLane = (Lane *)malloc(cLevel * sizeof(Lane));
+                if (!node.aLane) cLevel = 0;    // Still a valid base list item, just not promoted
+            }
+            node.cLevel = cLevel;
+
+            for (uint32_t iLevel = cLevelTop + 1; iLevel <= cLevel; iLevel++)
+            {
+                aHead[iLevel - 1].pNext = nullptr;
+                aHead[iLevel - 1].width = cItem;
+                apPred[iLevel] = nullptr;
+                aRank[iLevel] = 0;
+            }
+            if (cLevel > cLevelTop) cLevelTop = cLevel;
+
+            for (uint32_t iLevel = 1; iLevel <= cLevelTop; iLevel++)
+            {
+                Lane & lanePred = LaneOf(apPred[iLevel], iLevel);
+                if (iLevel <= cLevel)
+                {
+                    Lane & lane = node.aLane[iLevel - 1];
+                    lane.pNext = lanePred.pNext;
+                    lane.pPrev = apPred[iLevel];
+                    lane.width = lanePred.width - (rank - aRank[iLevel]);
+                    if (lane.pNext) LaneOf(lane.pNext, iLevel).pPrev = pItem;
+
+                    lanePred.pNext = pItem;
+                    lanePred.width = rank - aRank[iLevel] + 1;
+                }
+                else
+                {
+                    lanePred.width++;
+                }
+            }
+        }
+
+        // NOTE - O(log n) expected. The predecessor on each level above pItem's own lanes is found by walking back
+        //  along the next lane down, which takes a few steps per level on average.
+        void Remove(T * pItem)
+        {
+            if (!list.IsItemLinked(pItem)) return;
+
+            SkipNode<T> & node = pItem->*Skip;
+
+            T * pPred = list.Prev(pItem);
+            for (uint32_t iLevel = 1; iLevel <= cLevelTop; iLevel++)
+            {
+                if (iLevel <= node.cLevel)
+                {
+                    Lane & lane = node.aLane[iLevel - 1];
+                    Lane & lanePred = LaneOf(lane.pPrev, iLevel);
+                    lanePred.pNext = lane.pNext;
+                    lanePred.width += lane.width - 1;
+                    if (lane.pNext) LaneOf(lane.pNext, iLevel).pPrev = lane.pPrev;
+                    pPred = lane.pPrev;
+                }
+                else
+                {
+                    while (pPred && Height(pPred) < iLevel)
+                    {
+                        pPred = (iLevel == 1) ? list.Prev(pPred) : LaneOf(pPred, iLevel - 1).pPrev;
+                    }
+                    LaneOf(pPred, iLevel).width--;
+                }
+            }
+
+            while (cLevelTop && !aHead[cLevelTop - 1].pNext) cLevelTop--;
+
+            list.Remove(pItem);
+            cItem--;
+
+            free(node.aLane);
+            node.aLane = nullptr;
+            node.cLevel = 0;
+        }
+
+        // NOTE - First item whose key is not less than key, or nullptr
+        T * LowerBound(const K & key)
+        {
+            T * pCur = nullptr;
+            for (uint32_t iLevel = cLevelTop; iLevel >= 1; iLevel--)
+            {
+                for (;;)
+                {
+                    Lane & lane = LaneOf(pCur, iLevel);
+                    if (!lane.pNext || !Less()(lane.pNext->*Key, key)) break;
+
+                    pCur = lane.pNext;
+                }
+            }
+
+            T * pNext = pCur ? list.Next(pCur) : list.Head();
+            while (pNext && Less()(pNext->*Key, key))
+            {
+                pNext = list.Next(pNext);
+            }
+            return pNext;
+        }
+
+        // NOTE - Item at 0-based position iItem in sorted order, or nullptr if out of range
+        T * Nth(uintptr_t iItem)
+        {
+            if (iItem >= cItem) return nullptr;
+
+            uintptr_t rankTarget = iItem + 1;
+            uintptr_t rank = 0;
+            T * pCur = nullptr;
+            for (uint32_t iLevel = cLevelTop; iLevel >= 1; iLevel--)
+            {
+                for (;;)
+                {
+                    Lane & lane = LaneOf(pCur, iLevel);
+                    if (!lane.pNext || rank + lane.width > rankTarget) break;
+
+                    rank += lane.width;
+                    pCur = lane.pNext;
+                }
+            }
+
+            while (rank < rankTarget)
+            {
+                pCur = pCur ? list.Next(pCur) : list.Head();
+                rank++;
+            }
+            return pCur;
+        }
+
+        // NOTE - 0-based position of pItem in sorted order. pItem must be on the list.
+        uintptr_t IndexOf(T * pItem)
+        {
+            LL_ASSERT(list.IsItemLinked(pItem));
+
+            // Walk back to the nearest promoted item, then keep climbing to the tallest lane available
+
+            uintptr_t rank = 0;
+            T * pCur = pItem;
+            while (pCur && !Height(pCur))
+            {
+                pCur = list.Prev(pCur);
+                rank++;
+            }
+
+            while (pCur)
+            {
+                uint32_t iLevel = Height(pCur);
+                T * pPrev = LaneOf(pCur, iLevel).pPrev;
+                rank += LaneOf(pPrev, iLevel).width;
+                pCur = pPrev;
+            }
+
+            return rank - 1;
+        }
+
+        // NOTE - Unlinks every item from the base list and frees all lanes
+        void Clear()
+        {
+            ReleaseLanes();
+            list.Clear();
+            cItem = 0;
+        }
+
+        // NOTE - Rebuilds every lane from the current contents of the base list, which must be sorted. Use after
+        //  adopting an existing list or after unlinking items behind the skip list's back. Lanes of items that
+        //  are no longer on the base list are not freed here, see ReleaseNode.
+        void Rebuild()
+        {
+            ReleaseLanes();
+
+            T * apLast[s_cLevelMax + 1];
+            uintptr_t aRankLast[s_cLevelMax + 1];
+            for (uint32_t iLevel = 1; iLevel <= s_cLevelMax; iLevel++)
+            {
+                apLast[iLevel] = nullptr;
+                aRankLast[iLevel] = 0;
+            }
+
+            uintptr_t rank = 0;
+            T * pItemPrev = nullptr;
+            for (T * pItem : list)
+            {
+                LL_ASSERT(!pItemPrev || !Less()(pItem->*Key, pItemPrev->*Key));
+                pItemPrev = pItem;
+                (void)pItemPrev;
+                rank++;
+
+                SkipNode<T> & node = pItem->*Skip;
+                uint32_t cLevel = RandomLevel();
+                if (cLevel)
+                {
+                    node.aLane = (Lane *)malloc(cLevel * sizeof(Lane));
+                    if (!node.aLane) cLevel = 0;
+                }
+                node.cLevel = cLevel;
+                if (cLevel > cLevelTop) cLevelTop = cLevel;
+
+                for (uint32_t iLevel = 1; iLevel <= cLevel; iLevel++)
+                {
+                    Lane & laneLast = LaneOf(apLast[iLevel], iLevel);
+                    laneLast.pNext = pItem;
+                    laneLast.width = rank - aRankLast[iLevel];
+
+                    node.aLane[iLevel - 1].pPrev = apLast[iLevel];
+                    apLast[iLevel] = pItem;
+                    aRankLast[iLevel] = rank;
+                }
+            }
+
+            cItem = rank;
+            for (uint32_t iLevel = 1; iLevel <= cLevelTop; iLevel++)
+            {
+                Lane & laneLast = LaneOf(apLast[iLevel], iLevel);
+                laneLast.pNext = nullptr;
+                laneLast.width = cItem + 1 - aRankLast[iLevel];
+            }
+        }
+
+        // NOTE - Frees the lanes of an item that was unlinked from the base list without going through Remove
+        static void ReleaseNode(T * pItem)
+        {
+            SkipNode<T> & node = pItem->*Skip;
+            free(node.aLane);
+            node.aLane = nullptr;
+            node.cLevel = 0;
+        }
+
+        // Internal
+
+        Lane & LaneOf(T * pItem, uint32_t iLevel)
+        {
+            return pItem ? (pItem->*Skip).aLane[iLevel - 1] : aHead[iLevel - 1];
+        }
+
+        static uint32_t Height(T * pItem)
+        {
+            return (pItem->*Skip).cLevel;
+        }
+
+        // NOTE - Geometric with p = 1/4, from a xorshift64 stream
+        uint32_t RandomLevel()
+        {
+            rngState ^= rngState << 13;
+            rngState ^= rngState >> 7;
+            rngState ^= rngState << 17;
+
+            uint64_t bits = rngState;
+            uint32_t cLevel = 0;
+            while ((bits & 3) == 0 && cLevel < s_cLevelMax)
+            {
+                cLevel++;
+                bits >>= 2;
+            }
+            return cLevel;
+        }
+
+        void ReleaseLanes()
+        {
+            for (T * pItem : list)
+            {
+                ReleaseNode(pItem);
+            }
+            for (uint32_t iLevel = 0; iLevel < s_cLevelMax; iLevel++)
+            {
+                aHead[iLevel].pNext = nullptr;
+                aHead[iLevel].width = 0;
+            }
+            cLevelTop = 0;
+        }
+    };
+}
+
+
+
+
+//
+// Author: Andrew Smith - alsmith.net
+// License: MIT
+//
+#endif
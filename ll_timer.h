@@ -0,0 +1,278 @@
+#ifndef ALS_LL_TIMER_H
+#define ALS_LL_TIMER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ll.h"
+
+//
+// Hierarchical timing wheel where every slot is an intrusive LL2 list
+//
+// Requires:
+//  -ll.h
+//
+// Arm, Cancel and Rearm are O(1) and never allocate. Time is an opaque uint64_t tick count (ms, ns, whatever the
+//  caller uses). The wheel has 11 levels of 64 slots, each level covering 6 more bits of the tick count, so any
+//  expiry fits without overflow handling.
+//
+// A timer lives in the slot picked by (expiry, now): the level is the highest 6-bit group where the two differ, and
+//  the slot is the expiry's bits in that group. Advance moves every slot that the new time passed over onto a single
+//  list with O(1) splices (ll::List::Combine), then re-files those timers against the new time, which either drops
+//  them to a lower level or expires them. Because every armed timer is always in the slot computed from the current
+//  time, Cancel can find its list from the item alone.
+//
+// Usage:
+//      struct Conn { uint64_t expiry; DefineLL2Node(Conn); LL2Node timerNode; ... };
+//      ll::TimerWheel<Conn, &Conn::timerNode, &Conn::expiry> wheel;
+//      wheel.Init(NowMs());
+//      wheel.Arm(pConn, NowMs() + 30000);
+//      ...
+//      ll::List<Conn, &Conn::timerNode> expired;
+//      wheel.Advance(NowMs(), expired);
+//
+
+namespace ll
+{
+    // NOTE - Don't write to the expiry member while the timer is armed, use Rearm
+    template <typename T, typename T::LL2Node T::* Link, uint64_t T::* Expiry>
+    struct TimerWheel
+    {
+        enum
+        {
+            s_cBitLevel = 6,
+            s_cSlot = 1 << s_cBitLevel,
+            s_cLevel = (64 + s_cBitLevel - 1) / s_cBitLevel,
+        };
+
+        uint64_t now = 0;
+        uintptr_t cTimer = 0;
+
+        // NOTE - Timers armed at or before now. They are handed out by the next Advance.
+        List<T, Link> due;
+
+        List<T, Link> aaSlot[s_cLevel][s_cSlot];
+        uint64_t aOccupied[s_cLevel] = {};      // Bit per non-empty slot
+
+        void Init(uint64_t nowStart)
+        {
+            LL_ASSERT(!cTimer);
+            now = nowStart;
+        }
+
+        uintptr_t Count() const { return cTimer; }
+
+        static bool IsArmed(T * pItem) { return List<T, Link>::IsItemLinked(pItem); }
+
+        void Arm(T * pItem, uint64_t expiry)
+        {
+            if (IsArmed(pItem))
+            {
+                LL_ASSERT(false);
+                return;
+            }
+
+            pItem->*Expiry = expiry;
+            File(pItem);
+            cTimer++;
+        }
+
+        // NOTE - Returns false (and does nothing) if the timer isn't armed in this wheel. That includes timers Advance
+        //  already handed out: they stay linked on the caller's expired list until removed from it, and are left there.
+        bool Cancel(T * pItem)
+        {
+            if (!IsArmed(pItem)) return false;
+
+            uint64_t expiry = pItem->*Expiry;
+            if (expiry <= now)
+            {
+                // Expired timers are either still in due or were handed out by Advance, which looks the same from
+                //  the item alone. due only holds timers armed since the last Advance, so checking it is short.
+
+                if (!IsInDue(pItem)) return false;
+                due.Remove(pItem);
+            }
+            else
+            {
+                int iLevel = Level(expiry);
+                int iSlot = Slot(expiry, iLevel);
+                List<T, Link> & slot = aaSlot[iLevel][iSlot];
+                slot.Remove(pItem);
+                if (slot.IsEmpty()) aOccupied[iLevel] &= ~(1ULL << iSlot);
+            }
+            cTimer--;
+            return true;
+        }
+
+        // NOTE - An expired timer has to be removed from the expired list before it can be rearmed
+        void Rearm(T * pItem, uint64_t expiry)
+        {
+            Cancel(pItem);
+            Arm(pItem, expiry);
+        }
+
+        // NOTE - Appends every timer with expiry <= nowNew to expired, in no particular order. Expired timers are
+        //  unlinked from the wheel (IsArmed is false once they are removed from the expired list).
+        void Advance(uint64_t nowNew, ListRef<T, Link> expired)
+        {
+            LL_ASSERT(nowNew >= now);
+            if (nowNew < now) nowNew = now;
+
+            uint64_t nowPrev = now;
+            now = nowNew;
+
+            List<T, Link> refile;
+            refile.Combine(due);
+
+            for (int iLevel = 0; iLevel < s_cLevel; iLevel++)
+            {
+                int cShift = iLevel * s_cBitLevel;
+                uint64_t tickPrev = nowPrev >> cShift;
+                uint64_t tickNew = nowNew >> cShift;
+
+                // Same position at this level means the same at every level above it too
+
+                if (tickPrev == tickNew) break;
+
+                // Slots (tickPrev, tickNew] were passed over. Passing a whole lap (or carrying into the next level)
+                //  passes every occupied slot, since they all lie after tickPrev's slot.
+
+                uint64_t pending;
+                if (tickNew - tickPrev >= s_cSlot)
+                {
+                    pending = ~0ULL;
+                }
+                else
+                {
+                    int iSlotPrev = (int)(tickPrev & (s_cSlot - 1));
+                    int cSlotPassed = (int)(tickNew - tickPrev);
+                    pending = RotateLeft((1ULL << cSlotPassed) - 1, (iSlotPrev + 1) & (s_cSlot - 1));
+                }
+
+                pending &= aOccupied[iLevel];
+                aOccupied[iLevel] &= ~pending;
+                while (pending)
+                {
+                    int iSlot = LowestBit(pending);
+                    pending &= pending - 1;
+                    refile.Combine(aaSlot[iLevel][iSlot]);
+                }
+            }
+
+            while (T * pItem = refile.RemoveHead())
+            {
+                if (pItem->*Expiry <= now)
+                {
+                    expired.AddTail(pItem);
+                    cTimer--;
+                }
+                else
+                {
+                    File(pItem);
+                }
+            }
+        }
+
+        // NOTE - Lower bound on the earliest expiry (UINT64_MAX if nothing is armed). Exact when the earliest timer is
+        //  within 64 ticks, otherwise it is the time its slot will be cascaded, which is still a safe time to wake up
+        //  and call Advance.
+        uint64_t NextExpiry() const
+        {
+            if (due.pHead) return now;
+
+            for (int iLevel = 0; iLevel < s_cLevel; iLevel++)
+            {
+                if (!aOccupied[iLevel]) continue;
+
+                int cShift = iLevel * s_cBitLevel;
+                int iSlotNow = (int)((now >> cShift) & (s_cSlot - 1));
+
+                // Every occupied slot is after iSlotNow at this level
+
+                uint64_t after = aOccupied[iLevel] & ~((iSlotNow == 63) ? ~0ULL : ((2ULL << iSlotNow) - 1));
+                LL_ASSERT(after == aOccupied[iLevel]);
+
+                int iSlot = LowestBit(after);
+                int cShiftUpper = cShift + s_cBitLevel;
+                uint64_t upper = (cShiftUpper < 64) ? ((now >> cShiftUpper) << cShiftUpper) : 0;
+                return upper | ((uint64_t)iSlot << cShift);
+            }
+
+            return UINT64_MAX;
+        }
+
+        // Internal
+
+        bool IsInDue(T * pItem)
+        {
+            for (T * pDue = due.Head(); pDue; pDue = due.Next(pDue))
+            {
+                if (pDue == pItem) return true;
+            }
+            return false;
+        }
+
+        void File(T * pItem)
+        {
+            uint64_t expiry = pItem->*Expiry;
+            if (expiry <= now)
+            {
+                due.AddTail(pItem);
+                return;
+            }
+
+            int iLevel = Level(expiry);
+            int iSlot = Slot(expiry, iLevel);
+            aaSlot[iLevel][iSlot].AddTail(pItem);
+            aOccupied[iLevel] |= 1ULL << iSlot;
+        }
+
+        int Level(uint64_t expiry) const
+        {
+            return HighestBit(expiry ^ now) / s_cBitLevel;
+        }
+
+        static int Slot(uint64_t expiry, int iLevel)
+        {
+            return (int)((expiry >> (iLevel * s_cBitLevel)) & (s_cSlot - 1));
+        }
+
+        static uint64_t RotateLeft(uint64_t x, int c)
+        {
+            return c ? ((x << c) | (x >> (64 - c))) : x;
+        }
+
+        static int LowestBit(uint64_t x)
+        {
+            LL_ASSERT(x);
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(x);
+#else
+            int i = 0;
+            while (!(x & 1)) { x >>= 1; i++; }
+            return i;
+#endif
+        }
+
+        static int HighestBit(uint64_t x)
+        {
+            LL_ASSERT(x);
+#if defined(__GNUC__) || defined(__clang__)
+            return 63 - __builtin_clzll(x);
+#else
+            int i = 0;
+            while (x >>= 1) i++;
+            return i;
+#endif
+        }
+    };
+}
+
+
+
+
+//
+// Author: Andrew Smith - alsmith.net
+// License: MIT
+//
+#endif
@@ -0,0 +1,230 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll.h"
+
+//
+// Randomized test for the circular LL2Circ lists against std::vector models: adds, InsertBefore, Remove,
+//  RemoveHead/Tail, SpliceRange within and across two lists, Combine and Clear, then LL2CircRemoveWhileIterating at
+//  the head, middle and tail, through both the list and Ref macros
+//
+
+struct Item
+{
+    int value;
+
+    DefineLL2CircNode(Item);
+    LL2CircNode node;
+};
+
+DefineLL2Circ(Item, node, Items);
+
+static const int s_cItem = 300;
+
+static bool IsMatch(LL2CircType(Items) & list, const std::vector<int> & aValueModel)
+{
+    size_t iValue = 0;
+    ForLL2Circ(Item, it, list)
+    {
+        if (iValue >= aValueModel.size() || it->value != aValueModel[iValue]) return false;
+        iValue++;
+    }
+    if (iValue != aValueModel.size()) return false;
+
+    for (Item * pItem = LL2CircTail(Item, list); pItem; pItem = LL2CircPrev(Item, list, pItem))
+    {
+        if (!iValue || pItem->value != aValueModel[--iValue]) return false;
+    }
+    return iValue == 0 && LL2CircIsEmpty(list) == aValueModel.empty();
+}
+
+static int ListOf(const std::vector<int> * aModel, int value)
+{
+    for (int iList = 0; iList < 2; iList++)
+    {
+        if (std::find(aModel[iList].begin(), aModel[iList].end(), value) != aModel[iList].end()) return iList;
+    }
+    return -1;
+}
+
+static void TestRandom()
+{
+    std::mt19937 rng(9);
+    std::vector<Item> aItem(s_cItem);
+    for (int iItem = 0; iItem < s_cItem; iItem++)
+    {
+        aItem[iItem].value = iItem;
+        aItem[iItem].node = {};
+    }
+
+    LL2CircType(Items) aList[2];
+    LL2CircInit(aList[0]);
+    LL2CircInit(aList[1]);
+    std::vector<int> aModel[2];
+
+    for (int iStep = 0; iStep < 300000; iStep++)
+    {
+        int iList = rng() % 2;
+        std::vector<int> & model = aModel[iList];
+        Item * pItem = &aItem[rng() % s_cItem];
+        int iListLinked = ListOf(aModel, pItem->value);
+        assert(LL2CircIsItemLinked(Item, aList[0], pItem) == (iListLinked >= 0));
+
+        switch (rng() % 8)
+        {
+        case 0:
+            if (iListLinked >= 0) break;
+            LL2CircAddHead(Item, aList[iList], pItem);
+            model.insert(model.begin(), pItem->value);
+            break;
+
+        case 1:
+            if (iListLinked >= 0) break;
+            LL2CircAddTail(Item, aList[iList], pItem);
+            model.push_back(pItem->value);
+            break;
+
+        case 2:
+            {
+                if (iListLinked < 0) break;
+                LL2CircRemove(Item, aList[iListLinked], pItem);
+                std::vector<int> & modelLinked = aModel[iListLinked];
+                modelLinked.erase(std::find(modelLinked.begin(), modelLinked.end(), pItem->value));
+                assert(!LL2CircIsItemLinked(Item, aList[0], pItem));
+            }
+            break;
+
+        case 3:
+            {
+                if (iListLinked >= 0) break;
+                size_t iInsert = rng() % (model.size() + 1);
+                Item * pItemNext = (iInsert < model.size()) ? &aItem[model[iInsert]] : nullptr;
+                LL2CircInsertBefore(Item, aList[iList], pItem, pItemNext);
+                model.insert(model.begin() + iInsert, pItem->value);
+            }
+            break;
+
+        case 4:
+            {
+                Item * pItemRemoved;
+                if (rng() % 2)
+                {
+                    LL2CircRemoveHead(Item, aList[iList], pItemRemoved);
+                    assert(pItemRemoved == (model.empty() ? nullptr : &aItem[model.front()]));
+                    if (pItemRemoved) model.erase(model.begin());
+                }
+                else
+                {
+                    LL2CircRemoveTail(Item, aList[iList], pItemRemoved);
+                    assert(pItemRemoved == (model.empty() ? nullptr : &aItem[model.back()]));
+                    if (pItemRemoved) model.pop_back();
+                }
+            }
+            break;
+
+        case 5:
+            {
+                if (model.empty()) break;
+
+                // Move a run to either list, possibly back into the one it came from
+
+                size_t iFirst = rng() % model.size();
+                size_t iLast = iFirst + rng() % (model.size() - iFirst);
+                std::vector<int> aValueRun(model.begin() + iFirst, model.begin() + iLast + 1);
+                model.erase(model.begin() + iFirst, model.begin() + iLast + 1);
+
+                int iListDst = rng() % 2;
+                std::vector<int> & modelDst = aModel[iListDst];
+                size_t iInsert = rng() % (modelDst.size() + 1);
+                Item * pItemDstNext = (iInsert < modelDst.size()) ? &aItem[modelDst[iInsert]] : nullptr;
+                LL2CircSpliceRange(Item, aList[iListDst], &aItem[aValueRun.front()], &aItem[aValueRun.back()], pItemDstNext);
+                modelDst.insert(modelDst.begin() + iInsert, aValueRun.begin(), aValueRun.end());
+            }
+            break;
+
+        case 6:
+            {
+                if (rng() % 20) break;
+                std::vector<int> & modelOther = aModel[1 - iList];
+                LL2CircCombine(Item, aList[iList], aList[1 - iList]);
+                model.insert(model.end(), modelOther.begin(), modelOther.end());
+                modelOther.clear();
+                assert(LL2CircIsEmpty(aList[1 - iList]));
+            }
+            break;
+
+        case 7:
+            if (rng() % 500) break;
+            LL2CircClear(Item, aList[iList]);
+            for (int value : model) assert(!LL2CircIsItemLinked(Item, aList[iList], &aItem[value]));
+            model.clear();
+            break;
+        }
+
+        if (iStep % 97 == 0)
+        {
+            assert(IsMatch(aList[0], aModel[0]));
+            assert(IsMatch(aList[1], aModel[1]));
+        }
+    }
+
+    assert(IsMatch(aList[0], aModel[0]) && IsMatch(aList[1], aModel[1]));
+    LL2CircClear(Item, aList[0]);
+    LL2CircClear(Item, aList[1]);
+}
+
+static void TestRemoveWhileIterating()
+{
+    // Covers removing the head, runs of neighbours and the tail, then emptying the list from inside the loop
+
+    std::vector<Item> aItem(50);
+    LL2CircType(Items) list;
+    LL2CircInit(list);
+    std::vector<int> aValueModel;
+    for (int iItem = 0; iItem < 50; iItem++)
+    {
+        aItem[iItem].value = iItem;
+        aItem[iItem].node = {};
+        LL2CircAddTail(Item, list, &aItem[iItem]);
+        aValueModel.push_back(iItem);
+    }
+
+    int cVisit = 0;
+    ForLL2Circ(Item, it, list)
+    {
+        cVisit++;
+        if (it->value % 3 != 1 || it->value == 49) LL2CircRemoveWhileIterating(Item, list, it);
+    }
+    assert(cVisit == 50);
+
+    aValueModel.erase(std::remove_if(aValueModel.begin(), aValueModel.end(), [](int value) { return value % 3 != 1 || value == 49; }), aValueModel.end());
+    assert(IsMatch(list, aValueModel));
+
+    Item::LL2CircRef listRef;
+    LL2CircMakeRef(&listRef, list);
+
+    cVisit = 0;
+    ForLL2CircRef(Item, it, listRef)
+    {
+        cVisit++;
+        LL2CircRefRemoveWhileIterating(Item, listRef, it);
+    }
+    assert(cVisit == (int)aValueModel.size());
+    assert(LL2CircRefIsEmpty(listRef));
+    for (Item & item : aItem) assert(!LL2CircRefIsItemLinked(Item, listRef, &item));
+}
+
+int main()
+{
+    TestRandom();
+    TestRemoveWhileIterating();
+
+    printf("ll_circ_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll.h"
+
+//
+// Randomized test for the LL2Compact macros: one arena, two lists, and a std::vector model of the first list that is
+//  compared after every step, including prev links and the tail
+//
+
+struct Item
+{
+    int id;
+
+    DefineLL2CompactNode(Item);
+    LL2CompactNode nodeA;
+    LL2CompactNode nodeB;
+};
+
+DefineLL2Compact(Item, nodeA, ItemsA);
+DefineLL2Compact(Item, nodeB, ItemsB);
+
+static_assert(sizeof(Item::LL2CompactNode) == 8, "compact nodes are two 32-bit indices");
+
+static const int s_cItem = 300;
+
+static void CheckList(LL2CompactType(ItemsA) & list, const std::vector<Item *> & apItemModel)
+{
+    std::vector<Item *> apItem;
+    Item * pItemPrev = nullptr;
+    ForLL2Compact(Item, it, list)
+    {
+        assert(LL2CompactPrev(Item, list, it) == pItemPrev);
+        pItemPrev = it;
+        apItem.push_back(it);
+    }
+
+    assert(apItem == apItemModel);
+    assert(LL2CompactTail(list) == (apItemModel.empty() ? nullptr : apItemModel.back()));
+    assert(LL2CompactIsEmpty(list) == apItemModel.empty());
+}
+
+// Moves pItem to the spare slot at the end of the arena and back again, patching the list both times
+
+static void RelocateRoundTrip(LL2CompactType(ItemsA) & list, Item * aItem, Item * pItem)
+{
+    Item * pItemSpare = &aItem[s_cItem];
+    if (LL2CompactIsItemLinked(Item, list, pItemSpare)) return;
+
+    *pItemSpare = *pItem;
+    LL2CompactRelocate(Item, list, pItem, pItemSpare);
+    pItem->nodeA = {};
+    assert(!LL2CompactIsItemLinked(Item, list, pItem));
+
+    *pItem = *pItemSpare;
+    LL2CompactRelocate(Item, list, pItemSpare, pItem);
+    pItemSpare->nodeA = {};
+}
+
+static void TestRandom()
+{
+    static Item s_aItem[s_cItem + 1];
+    for (int iItem = 0; iItem <= s_cItem; iItem++)
+    {
+        s_aItem[iItem] = Item();
+        s_aItem[iItem].id = iItem;
+    }
+
+    LL2CompactType(ItemsA) list = {};
+    list.pBase = s_aItem;
+    LL2CompactType(ItemsA) listOther = {};
+    listOther.pBase = s_aItem;
+
+    std::vector<Item *> apItemModel;
+    std::mt19937 rng(3);
+
+    for (int iStep = 0; iStep < 20000; iStep++)
+    {
+        Item * pItem = &s_aItem[rng() % s_cItem];
+        bool isLinked = LL2CompactIsItemLinked(Item, list, pItem);
+        assert(isLinked == (std::find(apItemModel.begin(), apItemModel.end(), pItem) != apItemModel.end()));
+
+        switch (rng() % 8)
+        {
+        case 0:
+            if (isLinked) break;
+            LL2CompactAddHead(Item, list, pItem);
+            apItemModel.insert(apItemModel.begin(), pItem);
+            break;
+
+        case 1:
+            if (isLinked) break;
+            LL2CompactAddTail(Item, list, pItem);
+            apItemModel.push_back(pItem);
+            break;
+
+        case 2:
+            if (!isLinked) break;
+            LL2CompactRemove(Item, list, pItem);
+            apItemModel.erase(std::find(apItemModel.begin(), apItemModel.end(), pItem));
+            break;
+
+        case 3:
+            {
+                if (isLinked) break;
+                size_t iInsert = rng() % (apItemModel.size() + 1);
+                Item * pItemNext = (iInsert < apItemModel.size()) ? apItemModel[iInsert] : nullptr;
+                LL2CompactInsertBefore(Item, list, pItem, pItemNext);
+                apItemModel.insert(apItemModel.begin() + iInsert, pItem);
+            }
+            break;
+
+        case 4:
+            {
+                Item * pItemRemoved;
+                LL2CompactRemoveHead(Item, list, pItemRemoved);
+                assert(pItemRemoved == (apItemModel.empty() ? nullptr : apItemModel.front()));
+                if (pItemRemoved) apItemModel.erase(apItemModel.begin());
+            }
+            break;
+
+        case 5:
+            {
+                Item * pItemRemoved;
+                LL2CompactRemoveTail(Item, list, pItemRemoved);
+                assert(pItemRemoved == (apItemModel.empty() ? nullptr : apItemModel.back()));
+                if (pItemRemoved) apItemModel.pop_back();
+            }
+            break;
+
+        case 6:
+            if (apItemModel.empty() || rng() % 50) break;
+            RelocateRoundTrip(list, s_aItem, apItemModel[rng() % apItemModel.size()]);
+            break;
+
+        case 7:
+            {
+                if (rng() % 100) break;
+
+                ForLL2Compact(Item, it, list)
+                {
+                    if (it->id & 1) LL2CompactRemoveWhileIterating(Item, list, it);
+                }
+
+                apItemModel.erase(
+                    std::remove_if(apItemModel.begin(), apItemModel.end(), [](Item * pItemModel) { return pItemModel->id & 1; }),
+                    apItemModel.end());
+
+                LL2CompactCombine(Item, listOther, list);
+                assert(LL2CompactIsEmpty(list));
+                LL2CompactCombine(Item, list, listOther);
+                assert(LL2CompactIsEmpty(listOther));
+            }
+            break;
+        }
+
+        CheckList(list, apItemModel);
+    }
+
+    LL2CompactClear(Item, list);
+    for (int iItem = 0; iItem <= s_cItem; iItem++)
+    {
+        assert(!LL2CompactIsItemLinked(Item, list, &s_aItem[iItem]));
+    }
+}
+
+int main()
+{
+    TestRandom();
+
+    printf("ll_compact_list_test: ok\n");
+    return 0;
+}
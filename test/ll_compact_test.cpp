@@ -0,0 +1,165 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll.h"
+#include "../ll_compact.h"
+
+//
+// Randomized test for ll_compact.h: arenas of shuffled items on an order list, a second list through another link
+//  member, and free slots that are either zeroed or on a free list. Step runs with a zero budget (one swap batch per
+//  call) and the order list is rotated between steps. At the end the order list must sit in arena order, and every
+//  list must still hold the same items in the same order with valid prev links.
+//
+
+struct Item
+{
+    int id;
+    int payload[6];
+
+    DefineLL2Node(Item);
+    LL2Node node;
+    LL2Node otherNode;
+    LL2Node freeNode;
+};
+
+typedef ll::List<Item, &Item::node> OrderList;
+typedef ll::List<Item, &Item::otherNode> OtherList;
+typedef ll::Compactor<Item, &Item::node> ItemCompactor;
+
+static const int s_idFree = -1;
+
+template <typename L>
+static std::vector<int> IdsOf(L & list)
+{
+    std::vector<int> aId;
+    Item * pItemPrev = nullptr;
+    for (Item * pItem : list)
+    {
+        assert(L::Prev(pItem) == pItemPrev);
+        pItemPrev = pItem;
+        aId.push_back(pItem->id);
+    }
+    assert(list.Tail() == pItemPrev);
+    return aId;
+}
+
+// NOTE - The free list either has its own link member, or shares the order list's (FreeList = OrderList)
+
+template <typename FreeList, typename Item::LL2Node Item::* FreeLink>
+static void TestRandom(unsigned seed)
+{
+    std::mt19937 rng(seed);
+
+    for (int iRound = 0; iRound < 200; iRound++)
+    {
+        const int cItem = 1 + (int)(rng() % 300);
+        std::vector<Item> aItem(cItem);
+        memset((void *)aItem.data(), 0, sizeof(Item) * cItem);
+
+        std::vector<int> aId(cItem);
+        for (int iItem = 0; iItem < cItem; iItem++) aId[iItem] = iItem;
+        std::shuffle(aId.begin(), aId.end(), rng);
+
+        OrderList order;
+        OtherList other;
+        FreeList freeList;
+        int cFree = 0;
+
+        for (int iItem = 0; iItem < cItem; iItem++)
+        {
+            Item * pItem = &aItem[iItem];
+            pItem->id = aId[iItem];
+            pItem->payload[0] = pItem->id * 7;
+
+            switch (rng() % 4)
+            {
+            case 0:
+                if (iRound % 2)
+                {
+                    pItem->id = s_idFree;
+                    freeList.AddTail(pItem);
+                    cFree++;
+                    break;
+                }
+                // Fall through
+
+            case 1:
+                pItem->id = s_idFree;
+                break;
+
+            default:
+                if (rng() % 2) order.AddTail(pItem);
+                else order.AddHead(pItem);
+                if (rng() % 2) other.AddTail(pItem);
+                break;
+            }
+        }
+
+        std::vector<int> aIdOrder = IdsOf(order);
+        std::vector<int> aIdOther = IdsOf(other);
+
+        ItemCompactor compactor;
+        compactor.Init(aItem.data(), cItem, order);
+        compactor.AddList<&Item::otherNode>(other);
+        compactor.AddList<FreeLink>(freeList);
+
+        while (!compactor.Step(std::chrono::nanoseconds(0)))
+        {
+            switch (rng() % 4)
+            {
+            case 0:
+                if (order.Head())
+                {
+                    Item * pItem = order.RemoveHead();
+                    order.AddTail(pItem);
+                    std::rotate(aIdOrder.begin(), aIdOrder.begin() + 1, aIdOrder.end());
+                }
+                break;
+
+            case 1:
+                if (order.Tail() != order.Head())
+                {
+                    Item * pItem = order.RemoveTail();
+                    order.AddHead(pItem);
+                    std::rotate(aIdOrder.begin(), aIdOrder.end() - 1, aIdOrder.end());
+                }
+                break;
+            }
+        }
+
+        int iSlot = 0;
+        for (Item * pItem : order)
+        {
+            assert(pItem == &aItem[iSlot]);
+            assert(pItem->payload[0] == pItem->id * 7);
+            iSlot++;
+        }
+
+        assert(IdsOf(order) == aIdOrder);
+        assert(IdsOf(other) == aIdOther);
+
+        int cFreeFound = 0;
+        for (Item * pItem : freeList)
+        {
+            assert(pItem->id == s_idFree);
+            cFreeFound++;
+        }
+        assert(cFreeFound == cFree);
+    }
+}
+
+int main()
+{
+    TestRandom<ll::List<Item, &Item::freeNode>, &Item::freeNode>(5);
+    TestRandom<OrderList, &Item::node>(6);
+
+    printf("ll_compact_test: ok\n");
+    return 0;
+}
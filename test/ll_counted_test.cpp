@@ -0,0 +1,302 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll.h"
+
+//
+// Randomized tests for the counted LL1/LL2 lists: items move between two lists, and after every step both lists are
+//  compared against std::vector models, along with their counts and every item's owner tag
+//
+
+struct Item
+{
+    int id;
+
+    DefineLL1Node(Item)
+    DefineLL1CountedNode(Item);
+    LL1CountedNode node1;
+
+    DefineLL2Node(Item);
+    DefineLL2CountedNode(Item);
+    LL2CountedNode node2;
+};
+
+DefineLL1Counted(Item, node1, Items1);
+DefineLL2Counted(Item, node2, Items2);
+
+static const int s_cItem = 50;
+
+static int IndexOf(const std::vector<Item *> & apItem, Item * pItem)
+{
+    auto itFound = std::find(apItem.begin(), apItem.end(), pItem);
+    return (itFound == apItem.end()) ? -1 : (int)(itFound - apItem.begin());
+}
+
+static void TestLL1Random()
+{
+    static Item s_aItem[s_cItem];
+    for (int iItem = 0; iItem < s_cItem; iItem++)
+    {
+        s_aItem[iItem] = Item();
+        s_aItem[iItem].id = iItem;
+    }
+
+    LL1CountedType(Items1) aList[2] = {};
+    std::vector<Item *> aapItemModel[2];
+    Item::LL1CountedRef listRef1;
+    LL1CountedMakeRef(&listRef1, aList[1]);
+
+    std::mt19937 rng(11);
+    for (int iStep = 0; iStep < 50000; iStep++)
+    {
+        int iList = (int)(rng() % 2);
+        LL1CountedType(Items1) & list = aList[iList];
+        std::vector<Item *> & apItemModel = aapItemModel[iList];
+
+        Item * pItem = &s_aItem[rng() % s_cItem];
+        int iItemOn = IndexOf(apItemModel, pItem);
+        bool isLinked = iItemOn >= 0 || IndexOf(aapItemModel[1 - iList], pItem) >= 0;
+
+        assert(LL1CountedIsItemOnList(Item, aList[0], pItem) == (IndexOf(aapItemModel[0], pItem) >= 0));
+        assert(LL1CountedRefIsItemOnList(Item, listRef1, pItem) == (IndexOf(aapItemModel[1], pItem) >= 0));
+
+        switch (rng() % 8)
+        {
+        case 0:
+            if (isLinked) break;
+            LL1CountedAddHead(Item, list, pItem);
+            apItemModel.insert(apItemModel.begin(), pItem);
+            break;
+
+        case 1:
+            if (isLinked) break;
+            if (iList) LL1CountedRefAddTail(Item, listRef1, pItem);
+            else LL1CountedAddTail(Item, list, pItem);
+            apItemModel.push_back(pItem);
+            break;
+
+        case 2:
+            {
+                if (isLinked) break;
+                size_t iInsert = rng() % (apItemModel.size() + 1);
+                Item * pItemPrev = iInsert ? apItemModel[iInsert - 1] : nullptr;
+                LL1CountedInsertAfter(Item, list, pItem, pItemPrev);
+                apItemModel.insert(apItemModel.begin() + iInsert, pItem);
+            }
+            break;
+
+        case 3:
+            {
+                size_t iPrev = rng() % (apItemModel.size() + 1);
+                Item * pItemPrev = iPrev ? apItemModel[iPrev - 1] : nullptr;
+                Item * pItemRemoved;
+                LL1CountedRemoveAfter(Item, list, pItemPrev, pItemRemoved);
+
+                if (iPrev == apItemModel.size())
+                {
+                    assert(!pItemRemoved);
+                }
+                else
+                {
+                    assert(pItemRemoved == apItemModel[iPrev]);
+                    assert(!LL1CountedOwner(Item, list, pItemRemoved));
+                    apItemModel.erase(apItemModel.begin() + iPrev);
+                }
+            }
+            break;
+
+        case 4:
+            {
+                // Removing an item that isn't linked anywhere is a no-op. Items on the other list would assert.
+
+                if (isLinked && iItemOn < 0) break;
+                LL1CountedRemove(Item, list, pItem);
+                if (iItemOn >= 0) apItemModel.erase(apItemModel.begin() + iItemOn);
+                assert(!LL1CountedOwner(Item, list, pItem));
+            }
+            break;
+
+        case 5:
+            {
+                Item * pItemRemoved;
+                LL1CountedRemoveHead(Item, list, pItemRemoved);
+                assert(pItemRemoved == (apItemModel.empty() ? nullptr : apItemModel.front()));
+                if (pItemRemoved) apItemModel.erase(apItemModel.begin());
+            }
+            break;
+
+        case 6:
+            {
+                if (rng() % 30) break;
+
+                std::vector<Item *> & apItemModelOther = aapItemModel[1 - iList];
+                LL1CountedCombine(Item, list, aList[1 - iList]);
+                apItemModel.insert(apItemModel.end(), apItemModelOther.begin(), apItemModelOther.end());
+                apItemModelOther.clear();
+            }
+            break;
+
+        case 7:
+            if (rng() % 100) break;
+            LL1CountedClear(Item, list);
+            apItemModel.clear();
+            break;
+        }
+
+        for (int iListCheck = 0; iListCheck < 2; iListCheck++)
+        {
+            std::vector<Item *> apItem;
+            ForLL1Counted(Item, it, aList[iListCheck])
+            {
+                assert(LL1CountedOwner(Item, aList[iListCheck], it) == LL1CountedOwnerTag(aList[iListCheck]));
+                apItem.push_back(it);
+            }
+
+            assert(apItem == aapItemModel[iListCheck]);
+            assert(LL1CountedCount(aList[iListCheck]) == aapItemModel[iListCheck].size());
+            assert(aList[iListCheck].pTail == (apItem.empty() ? nullptr : apItem.back()));
+        }
+    }
+}
+
+static void TestLL2Random()
+{
+    static Item s_aItem[s_cItem];
+    for (int iItem = 0; iItem < s_cItem; iItem++)
+    {
+        s_aItem[iItem] = Item();
+        s_aItem[iItem].id = iItem;
+    }
+
+    LL2CountedType(Items2) aList[2] = {};
+    std::vector<Item *> aapItemModel[2];
+    Item::LL2CountedRef listRef1;
+    LL2CountedMakeRef(&listRef1, aList[1]);
+
+    std::mt19937 rng(9);
+    for (int iStep = 0; iStep < 50000; iStep++)
+    {
+        int iList = (int)(rng() % 2);
+        LL2CountedType(Items2) & list = aList[iList];
+        std::vector<Item *> & apItemModel = aapItemModel[iList];
+
+        Item * pItem = &s_aItem[rng() % s_cItem];
+        int iItemOn = IndexOf(apItemModel, pItem);
+        bool isLinked = iItemOn >= 0 || IndexOf(aapItemModel[1 - iList], pItem) >= 0;
+
+        assert(LL2CountedIsItemOnList(Item, aList[0], pItem) == (IndexOf(aapItemModel[0], pItem) >= 0));
+        assert(LL2CountedRefIsItemOnList(Item, listRef1, pItem) == (IndexOf(aapItemModel[1], pItem) >= 0));
+
+        switch (rng() % 8)
+        {
+        case 0:
+            if (isLinked) break;
+            LL2CountedAddHead(Item, list, pItem);
+            apItemModel.insert(apItemModel.begin(), pItem);
+            break;
+
+        case 1:
+            if (isLinked) break;
+            if (iList) LL2CountedRefAddTail(Item, listRef1, pItem);
+            else LL2CountedAddTail(Item, list, pItem);
+            apItemModel.push_back(pItem);
+            break;
+
+        case 2:
+            {
+                if (isLinked) break;
+                size_t iInsert = rng() % (apItemModel.size() + 1);
+                Item * pItemNext = (iInsert < apItemModel.size()) ? apItemModel[iInsert] : nullptr;
+                LL2CountedInsertBefore(Item, list, pItem, pItemNext);
+                apItemModel.insert(apItemModel.begin() + iInsert, pItem);
+            }
+            break;
+
+        case 3:
+            {
+                Item * pItemRemoved;
+                LL2CountedRemoveTail(Item, list, pItemRemoved);
+                assert(pItemRemoved == (apItemModel.empty() ? nullptr : apItemModel.back()));
+                if (pItemRemoved) apItemModel.pop_back();
+            }
+            break;
+
+        case 4:
+            if (isLinked && iItemOn < 0) break;
+            LL2CountedRemove(Item, list, pItem);
+            if (iItemOn >= 0) apItemModel.erase(apItemModel.begin() + iItemOn);
+            break;
+
+        case 5:
+            {
+                Item * pItemRemoved;
+                LL2CountedRemoveHead(Item, list, pItemRemoved);
+                assert(pItemRemoved == (apItemModel.empty() ? nullptr : apItemModel.front()));
+                if (pItemRemoved) apItemModel.erase(apItemModel.begin());
+            }
+            break;
+
+        case 6:
+            {
+                if (rng() % 30) break;
+
+                std::vector<Item *> & apItemModelOther = aapItemModel[1 - iList];
+                LL2CountedCombine(Item, list, aList[1 - iList]);
+                apItemModel.insert(apItemModel.end(), apItemModelOther.begin(), apItemModelOther.end());
+                apItemModelOther.clear();
+            }
+            break;
+
+        case 7:
+            {
+                if (rng() % 30) break;
+
+                ForLL2Counted(Item, it, list)
+                {
+                    if (it->id % 3 == 0) LL2CountedRemoveWhileIterating(Item, list, it);
+                }
+
+                apItemModel.erase(
+                    std::remove_if(apItemModel.begin(), apItemModel.end(), [](Item * pItemModel) { return pItemModel->id % 3 == 0; }),
+                    apItemModel.end());
+            }
+            break;
+        }
+
+        for (int iListCheck = 0; iListCheck < 2; iListCheck++)
+        {
+            std::vector<Item *> apItem;
+            ForLL2Counted(Item, it, aList[iListCheck])
+            {
+                assert(LL2CountedOwner(Item, aList[iListCheck], it) == LL2CountedOwnerTag(aList[iListCheck]));
+                apItem.push_back(it);
+            }
+
+            assert(apItem == aapItemModel[iListCheck]);
+            assert(LL2CountedCount(aList[iListCheck]) == aapItemModel[iListCheck].size());
+            assert(aList[iListCheck].pTail == (apItem.empty() ? nullptr : apItem.back()));
+        }
+    }
+
+    LL2CountedClear(Item, aList[0]);
+    LL2CountedClear(Item, aList[1]);
+    for (int iItem = 0; iItem < s_cItem; iItem++)
+    {
+        assert(!LL2CountedOwner(Item, aList[0], &s_aItem[iItem]));
+    }
+}
+
+int main()
+{
+    TestLL1Random();
+    TestLL2Random();
+
+    printf("ll_counted_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,246 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll.h"
+
+//
+// Tests for the single-pass filters: LL2RemoveIf, LL2Partition, LL2Unique and LL2UniqueInto (list and Ref forms) and
+//  LL1RemoveIf. Random short lists with few distinct keys, so runs of removed items at the head, middle and tail all
+//  come up, are compared against a std::vector model split by the same predicate. Out lists may already hold items.
+//  Also checks ForLL2 + LL2RemoveWhileIterating, the idiom they replace.
+//
+
+struct Item
+{
+    int key;
+
+    DefineLL1Node(Item)
+    LL1Node node1;
+
+    DefineLL2Node(Item);
+    LL2Node node2;
+};
+
+DefineLL1(Item, node1, Items1);
+DefineLL2(Item, node2, Items2);
+
+static const int s_cItem = 200;
+
+static bool IsMatch(LL2Type(Items2) & list, const std::vector<Item *> & apItemModel)
+{
+    size_t iItem = 0;
+    Item * pItemPrev = nullptr;
+    ForLL2(Item, it, list)
+    {
+        if (iItem >= apItemModel.size() || it != apItemModel[iItem]) return false;
+        if (LL2Prev(Item, list, it) != pItemPrev) return false;
+        pItemPrev = it;
+        iItem++;
+    }
+    return iItem == apItemModel.size() && list.pTail == (apItemModel.empty() ? nullptr : apItemModel.back());
+}
+
+static bool IsMatch(LL1Type(Items1) & list, const std::vector<Item *> & apItemModel)
+{
+    size_t iItem = 0;
+    ForLL1(Item, it, list)
+    {
+        if (iItem >= apItemModel.size() || it != apItemModel[iItem]) return false;
+        iItem++;
+    }
+    return iItem == apItemModel.size() && list.pTail == (apItemModel.empty() ? nullptr : apItemModel.back());
+}
+
+static void TestLL2(std::vector<Item> & aItem)
+{
+    std::mt19937 rng(4);
+    std::vector<int> aiItem(s_cItem);
+    for (int iItem = 0; iItem < s_cItem; iItem++) aiItem[iItem] = iItem;
+
+    for (int iRound = 0; iRound < 20000; iRound++)
+    {
+        for (Item & item : aItem) item.node2 = {};
+
+        LL2Type(Items2) list = {};
+        LL2Type(Items2) outList = {};
+        std::vector<Item *> apItemList;
+        std::vector<Item *> apItemOut;
+
+        std::shuffle(aiItem.begin(), aiItem.end(), rng);
+        int cItemOut = rng() % 4;
+        int cItemList = rng() % 40;
+        for (int iItem = 0; iItem < cItemOut + cItemList; iItem++)
+        {
+            Item * pItem = &aItem[aiItem[iItem]];
+            pItem->key = rng() % 5;
+            if (iItem < cItemOut)
+            {
+                LL2AddTail(Item, outList, pItem);
+                apItemOut.push_back(pItem);
+            }
+            else
+            {
+                LL2AddTail(Item, list, pItem);
+                apItemList.push_back(pItem);
+            }
+        }
+
+        int keyMax = rng() % 6;
+        auto IsBelow = [keyMax](Item * pItem) { return pItem->key < keyMax; };
+        auto IsSameKey = [](Item * pItemA, Item * pItemB) { return pItemA->key == pItemB->key; };
+
+        int iKind = iRound % 4;
+        if (iKind >= 2)
+        {
+            auto IsLess = [](Item * pItemA, Item * pItemB) { return pItemA->key < pItemB->key; };
+            std::stable_sort(apItemList.begin(), apItemList.end(), IsLess);
+            LL2Sort(Item, list, IsLess);
+            assert(IsMatch(list, apItemList));
+        }
+
+        std::vector<Item *> apItemKept;
+        std::vector<Item *> apItemMoved;
+        for (Item * pItem : apItemList)
+        {
+            bool isMove = (iKind < 2) ? IsBelow(pItem) : (!apItemKept.empty() && IsSameKey(apItemKept.back(), pItem));
+            (isMove ? apItemMoved : apItemKept).push_back(pItem);
+        }
+
+        Item::LL2Ref listRef;
+        Item::LL2Ref outListRef;
+        LL2MakeRef(&listRef, list);
+        LL2MakeRef(&outListRef, outList);
+        bool isRef = (rng() % 2) != 0;
+
+        switch (iKind)
+        {
+        case 0:
+            if (isRef) LL2RefRemoveIf(Item, listRef, IsBelow);
+            else LL2RemoveIf(Item, list, IsBelow);
+            break;
+
+        case 1:
+            if (isRef) LL2RefPartition(Item, listRef, outListRef, IsBelow);
+            else LL2Partition(Item, list, outList, IsBelow);
+            break;
+
+        case 2:
+            if (isRef) LL2RefUnique(Item, listRef, IsSameKey);
+            else LL2Unique(Item, list, IsSameKey);
+            break;
+
+        case 3:
+            if (isRef) LL2RefUniqueInto(Item, listRef, outListRef, IsSameKey);
+            else LL2UniqueInto(Item, list, outList, IsSameKey);
+            break;
+        }
+
+        assert(IsMatch(list, apItemKept));
+        if (iKind % 2)
+        {
+            apItemOut.insert(apItemOut.end(), apItemMoved.begin(), apItemMoved.end());
+        }
+        else
+        {
+            for (Item * pItem : apItemMoved) assert(!LL2IsItemLinked(Item, list, pItem));
+        }
+        assert(IsMatch(outList, apItemOut));
+    }
+}
+
+static void TestLL1(std::vector<Item> & aItem)
+{
+    std::mt19937 rng(5);
+
+    for (int iRound = 0; iRound < 20000; iRound++)
+    {
+        for (Item & item : aItem) item.node1 = {};
+
+        LL1Type(Items1) list = {};
+        std::vector<Item *> apItemList;
+        int cItemList = rng() % 40;
+        for (int iItem = 0; iItem < cItemList; iItem++)
+        {
+            Item * pItem = &aItem[rng() % s_cItem];
+            if (LL1IsItemLinked(Item, list, pItem)) continue;
+            pItem->key = rng() % 5;
+            LL1AddTail(Item, list, pItem);
+            apItemList.push_back(pItem);
+        }
+
+        int keyMax = rng() % 6;
+        auto IsBelow = [keyMax](Item * pItem) { return pItem->key < keyMax; };
+
+        std::vector<Item *> apItemKept;
+        for (Item * pItem : apItemList) if (!IsBelow(pItem)) apItemKept.push_back(pItem);
+
+        if (rng() % 2)
+        {
+            Item::LL1Ref listRef;
+            LL1MakeRef(&listRef, list);
+            LL1RefRemoveIf(Item, listRef, IsBelow);
+        }
+        else
+        {
+            LL1RemoveIf(Item, list, IsBelow);
+        }
+
+        assert(IsMatch(list, apItemKept));
+        for (Item * pItem : apItemList)
+        {
+            if (IsBelow(pItem)) assert(!LL1IsItemLinked(Item, list, pItem));
+        }
+    }
+}
+
+static void TestRemoveWhileIterating(std::vector<Item> & aItem)
+{
+    // The idiom RemoveIf replaces must agree with it. A local list also checks that the head case's fake 'it'
+    //  survives the optimizer.
+
+    std::mt19937 rng(6);
+
+    for (int iRound = 0; iRound < 2000; iRound++)
+    {
+        for (Item & item : aItem) item.node2 = {};
+
+        LL2Type(Items2) list = {};
+        std::vector<Item *> apItemKept;
+        int cItemList = rng() % 40;
+        int keyMax = rng() % 6;
+        for (int iItem = 0; iItem < cItemList; iItem++)
+        {
+            Item * pItem = &aItem[iItem];
+            pItem->key = rng() % 5;
+            LL2AddTail(Item, list, pItem);
+            if (pItem->key >= keyMax) apItemKept.push_back(pItem);
+        }
+
+        int cVisit = 0;
+        ForLL2(Item, it, list)
+        {
+            cVisit++;
+            if (it->key < keyMax) LL2RemoveWhileIterating(Item, list, it);
+        }
+
+        assert(cVisit == cItemList);
+        assert(IsMatch(list, apItemKept));
+    }
+}
+
+int main()
+{
+    std::vector<Item> aItem(s_cItem);
+    TestLL2(aItem);
+    TestLL1(aItem);
+    TestRemoveWhileIterating(aItem);
+
+    printf("ll_filter_test: ok\n");
+    return 0;
+}
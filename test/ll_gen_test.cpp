@@ -0,0 +1,304 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll.h"
+
+//
+// Randomized tests for the generation-cleared LL1/LL2 lists: two lists share a set of items and are cleared now and
+//  then, which leaves stale nodes behind. After every step the lists are compared against std::vector models, and
+//  every item's linked/on-list state is checked, stale ones included.
+//
+
+struct Item
+{
+    int id;
+
+    DefineLL1Node(Item)
+    DefineLL1GenNode(Item);
+    LL1GenNode node1;
+
+    DefineLL2Node(Item);
+    DefineLL2GenNode(Item);
+    LL2GenNode node2;
+};
+
+DefineLL1Gen(Item, node1, Items1);
+DefineLL2Gen(Item, node2, Items2);
+
+static const int s_cItem = 64;
+
+static int IndexOf(const std::vector<Item *> & apItem, Item * pItem)
+{
+    auto itFound = std::find(apItem.begin(), apItem.end(), pItem);
+    return (itFound == apItem.end()) ? -1 : (int)(itFound - apItem.begin());
+}
+
+static void TestLL1Random()
+{
+    std::mt19937 rng(7);
+
+    for (int iRound = 0; iRound < 30; iRound++)
+    {
+        std::vector<Item> aItem(s_cItem);
+        for (int iItem = 0; iItem < s_cItem; iItem++)
+        {
+            aItem[iItem] = Item();
+            aItem[iItem].id = iItem;
+        }
+
+        LL1GenType(Items1) aList[2] = {};
+        std::vector<Item *> aapItemModel[2];
+
+        for (int iStep = 0; iStep < 5000; iStep++)
+        {
+            int iList = (int)(rng() % 2);
+            LL1GenType(Items1) & list = aList[iList];
+            std::vector<Item *> & apItemModel = aapItemModel[iList];
+
+            Item * pItem = &aItem[rng() % s_cItem];
+            int iItemOn = IndexOf(apItemModel, pItem);
+            bool isLinked = iItemOn >= 0 || IndexOf(aapItemModel[1 - iList], pItem) >= 0;
+
+            switch (rng() % 8)
+            {
+            case 0:
+                if (isLinked) break;
+                LL1GenAddHead(Item, list, pItem);
+                apItemModel.insert(apItemModel.begin(), pItem);
+                break;
+
+            case 1:
+                if (isLinked) break;
+                LL1GenAddTail(Item, list, pItem);
+                apItemModel.push_back(pItem);
+                break;
+
+            case 2:
+                {
+                    if (isLinked) break;
+                    size_t iInsert = rng() % (apItemModel.size() + 1);
+                    Item * pItemPrev = iInsert ? apItemModel[iInsert - 1] : nullptr;
+                    LL1GenInsertAfter(Item, list, pItem, pItemPrev);
+                    apItemModel.insert(apItemModel.begin() + iInsert, pItem);
+                }
+                break;
+
+            case 3:
+                {
+                    size_t iPrev = rng() % (apItemModel.size() + 1);
+                    Item * pItemPrev = iPrev ? apItemModel[iPrev - 1] : nullptr;
+                    Item * pItemRemoved;
+                    LL1GenRemoveAfter(Item, list, pItemPrev, pItemRemoved);
+                    if (iPrev == apItemModel.size())
+                    {
+                        assert(!pItemRemoved);
+                    }
+                    else
+                    {
+                        assert(pItemRemoved == apItemModel[iPrev]);
+                        apItemModel.erase(apItemModel.begin() + iPrev);
+                    }
+                }
+                break;
+
+            case 4:
+                // Stale and unlinked items are ignored. Items on the other list would assert.
+
+                if (isLinked && iItemOn < 0) break;
+                LL1GenRemove(Item, list, pItem);
+                if (iItemOn >= 0) apItemModel.erase(apItemModel.begin() + iItemOn);
+                break;
+
+            case 5:
+                {
+                    Item * pItemRemoved;
+                    LL1GenRemoveHead(Item, list, pItemRemoved);
+                    assert(pItemRemoved == (apItemModel.empty() ? nullptr : apItemModel.front()));
+                    if (pItemRemoved) apItemModel.erase(apItemModel.begin());
+                }
+                break;
+
+            case 6:
+                if (rng() % 8) break;
+                LL1GenClear(Item, list);
+                apItemModel.clear();
+                break;
+
+            case 7:
+                {
+                    if (rng() % 8) break;
+
+                    std::vector<Item *> & apItemModelOther = aapItemModel[1 - iList];
+                    LL1GenCombine(Item, list, aList[1 - iList]);
+                    apItemModel.insert(apItemModel.end(), apItemModelOther.begin(), apItemModelOther.end());
+                    apItemModelOther.clear();
+                }
+                break;
+            }
+
+            for (int iListCheck = 0; iListCheck < 2; iListCheck++)
+            {
+                std::vector<Item *> apItem;
+                ForLL1Gen(Item, it, aList[iListCheck])
+                {
+                    apItem.push_back(it);
+                }
+                assert(apItem == aapItemModel[iListCheck]);
+                assert(aList[iListCheck].pTail == (apItem.empty() ? nullptr : apItem.back()));
+            }
+
+            for (Item & item : aItem)
+            {
+                bool isOn0 = IndexOf(aapItemModel[0], &item) >= 0;
+                bool isOn1 = IndexOf(aapItemModel[1], &item) >= 0;
+                assert(LL1GenIsItemLinked(Item, aList[0], &item) == (isOn0 || isOn1));
+                assert(LL1GenIsItemOnList(Item, aList[0], &item) == isOn0);
+                assert(LL1GenIsItemOnList(Item, aList[1], &item) == isOn1);
+            }
+        }
+    }
+}
+
+static void TestLL2Random()
+{
+    std::mt19937 rng(5);
+
+    for (int iRound = 0; iRound < 30; iRound++)
+    {
+        std::vector<Item> aItem(s_cItem);
+        for (int iItem = 0; iItem < s_cItem; iItem++)
+        {
+            aItem[iItem] = Item();
+            aItem[iItem].id = iItem;
+        }
+
+        LL2GenType(Items2) aList[2] = {};
+        std::vector<Item *> aapItemModel[2];
+
+        for (int iStep = 0; iStep < 5000; iStep++)
+        {
+            int iList = (int)(rng() % 2);
+            LL2GenType(Items2) & list = aList[iList];
+            std::vector<Item *> & apItemModel = aapItemModel[iList];
+
+            Item * pItem = &aItem[rng() % s_cItem];
+            int iItemOn = IndexOf(apItemModel, pItem);
+            bool isLinked = iItemOn >= 0 || IndexOf(aapItemModel[1 - iList], pItem) >= 0;
+
+            switch (rng() % 9)
+            {
+            case 0:
+                if (isLinked) break;
+                LL2GenAddHead(Item, list, pItem);
+                apItemModel.insert(apItemModel.begin(), pItem);
+                break;
+
+            case 1:
+                if (isLinked) break;
+                LL2GenAddTail(Item, list, pItem);
+                apItemModel.push_back(pItem);
+                break;
+
+            case 2:
+                {
+                    if (isLinked) break;
+                    size_t iInsert = rng() % (apItemModel.size() + 1);
+                    Item * pItemNext = (iInsert < apItemModel.size()) ? apItemModel[iInsert] : nullptr;
+                    LL2GenInsertBefore(Item, list, pItem, pItemNext);
+                    apItemModel.insert(apItemModel.begin() + iInsert, pItem);
+                }
+                break;
+
+            case 3:
+                if (isLinked && iItemOn < 0) break;
+                LL2GenRemove(Item, list, pItem);
+                if (iItemOn >= 0) apItemModel.erase(apItemModel.begin() + iItemOn);
+                break;
+
+            case 4:
+                {
+                    Item * pItemRemoved;
+                    LL2GenRemoveHead(Item, list, pItemRemoved);
+                    assert(pItemRemoved == (apItemModel.empty() ? nullptr : apItemModel.front()));
+                    if (pItemRemoved) apItemModel.erase(apItemModel.begin());
+                }
+                break;
+
+            case 5:
+                {
+                    Item * pItemRemoved;
+                    LL2GenRemoveTail(Item, list, pItemRemoved);
+                    assert(pItemRemoved == (apItemModel.empty() ? nullptr : apItemModel.back()));
+                    if (pItemRemoved) apItemModel.pop_back();
+                }
+                break;
+
+            case 6:
+                if (rng() % 8) break;
+                LL2GenClear(Item, list);
+                apItemModel.clear();
+                break;
+
+            case 7:
+                {
+                    if (rng() % 8) break;
+
+                    std::vector<Item *> & apItemModelOther = aapItemModel[1 - iList];
+                    LL2GenCombine(Item, list, aList[1 - iList]);
+                    apItemModel.insert(apItemModel.end(), apItemModelOther.begin(), apItemModelOther.end());
+                    apItemModelOther.clear();
+                }
+                break;
+
+            case 8:
+                ForLL2Gen(Item, it, list)
+                {
+                    if (it->id % 3 == 0) LL2GenRemoveWhileIterating(Item, list, it);
+                }
+
+                apItemModel.erase(
+                    std::remove_if(apItemModel.begin(), apItemModel.end(), [](Item * pItemModel) { return pItemModel->id % 3 == 0; }),
+                    apItemModel.end());
+                break;
+            }
+
+            for (int iListCheck = 0; iListCheck < 2; iListCheck++)
+            {
+                std::vector<Item *> apItem;
+                Item * pItemPrev = nullptr;
+                ForLL2Gen(Item, it, aList[iListCheck])
+                {
+                    assert(LL2Prev_(Item, it, aList[iListCheck].offset) == pItemPrev);
+                    pItemPrev = it;
+                    apItem.push_back(it);
+                }
+                assert(apItem == aapItemModel[iListCheck]);
+                assert(aList[iListCheck].pTail == pItemPrev);
+            }
+
+            for (Item & item : aItem)
+            {
+                bool isOn0 = IndexOf(aapItemModel[0], &item) >= 0;
+                bool isOn1 = IndexOf(aapItemModel[1], &item) >= 0;
+                assert(LL2GenIsItemLinked(Item, aList[0], &item) == (isOn0 || isOn1));
+                assert(LL2GenIsItemOnList(Item, aList[0], &item) == isOn0);
+                assert(LL2GenIsItemOnList(Item, aList[1], &item) == isOn1);
+            }
+        }
+    }
+}
+
+int main()
+{
+    TestLL1Random();
+    TestLL2Random();
+
+    printf("ll_gen_test: ok\n");
+    return 0;
+}
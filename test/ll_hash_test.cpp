@@ -0,0 +1,176 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll.h"
+#include "../ll_hash.h"
+
+//
+// Randomized test for ll_hash.h against a std::unordered_multimap model: Insert, Remove, Find, RemoveKey, ForEach and
+//  Clear with duplicate keys, growing from the minimum size so most steps run with a resize in progress. Then a
+//  presized table with identity-hashed int keys.
+//
+
+struct Item
+{
+    uint64_t key;
+
+    DefineLL1Node(Item)
+    LL1Node node;
+};
+
+struct IntItem
+{
+    int key;
+
+    DefineLL1Node(IntItem)
+    LL1Node node;
+};
+
+typedef ll::HashTable<Item, &Item::node, uint64_t, &Item::key> ItemTable;
+typedef std::unordered_multimap<uint64_t, Item *> TableModel;
+
+static const int s_cItem = 30000;
+static const uint64_t s_cKey = 20000;
+
+static void EraseFromModel(TableModel & model, Item * pItem)
+{
+    auto range = model.equal_range(pItem->key);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second == pItem)
+        {
+            model.erase(it);
+            return;
+        }
+    }
+    assert(false);
+}
+
+static void TestRandom()
+{
+    std::mt19937_64 rng(11);
+    std::vector<Item> aItem(s_cItem);
+    for (Item & item : aItem)
+    {
+        item.key = rng() % s_cKey;
+        item.node = {};
+    }
+
+    ItemTable table;
+    assert(table.Init());
+    TableModel model;
+    bool wasResizing = false;
+
+    for (int iStep = 0; iStep < 600000; iStep++)
+    {
+        Item * pItem = &aItem[rng() % s_cItem];
+        bool isLinked = ItemTable::IsItemLinked(pItem);
+
+        switch (rng() % 6)
+        {
+        case 0: case 1: case 2:
+            if (isLinked) break;
+            assert(table.Insert(pItem));
+            model.insert(std::make_pair(pItem->key, pItem));
+            break;
+
+        case 3:
+            assert(table.Remove(pItem) == isLinked);
+            assert(!ItemTable::IsItemLinked(pItem));
+            if (isLinked) EraseFromModel(model, pItem);
+            break;
+
+        case 4:
+            {
+                uint64_t key = rng() % s_cKey;
+                Item * pItemFound = table.Find(key);
+                if (pItemFound) assert(pItemFound->key == key && model.count(key));
+                else assert(!model.count(key));
+            }
+            break;
+
+        case 5:
+            {
+                uint64_t key = rng() % s_cKey;
+                Item * pItemRemoved = table.RemoveKey(key);
+                if (!pItemRemoved)
+                {
+                    assert(!model.count(key));
+                    break;
+                }
+
+                assert(pItemRemoved->key == key && !ItemTable::IsItemLinked(pItemRemoved));
+                EraseFromModel(model, pItemRemoved);
+            }
+            break;
+        }
+
+        assert(table.Count() == model.size());
+        wasResizing = wasResizing || table.IsResizing();
+
+        if (iStep % 50000 == 0)
+        {
+            size_t cVisit = 0;
+            table.ForEach([&](Item * pItemVisit)
+                {
+                    assert(ItemTable::IsItemLinked(pItemVisit));
+                    cVisit++;
+                });
+            assert(cVisit == model.size());
+        }
+
+        if (iStep == 300000)
+        {
+            table.Clear();
+            model.clear();
+            for (Item & item : aItem) assert(!ItemTable::IsItemLinked(&item));
+        }
+    }
+    assert(wasResizing);
+
+    while (!table.ResizeStep(1)) {}
+    assert(!table.IsResizing() && table.Count() == model.size());
+    for (const std::pair<const uint64_t, Item *> & entry : model) assert(table.Find(entry.first));
+
+    table.Clear();
+    table.Destroy();
+    assert(!table.Find(0) && table.Count() == 0);
+}
+
+static void TestIdentityHash()
+{
+    // std::hash<int> is the identity, the remix still has to spread consecutive keys
+
+    const int cItem = 100000;
+    std::vector<IntItem> aItem(cItem);
+    ll::HashTable<IntItem, &IntItem::node, int, &IntItem::key> table;
+    assert(table.Init(1000));
+
+    for (int iItem = 0; iItem < cItem; iItem++)
+    {
+        aItem[iItem].key = iItem;
+        aItem[iItem].node = {};
+        assert(table.Insert(&aItem[iItem]));
+    }
+
+    for (int iItem = 0; iItem < cItem; iItem++) assert(table.Find(iItem) == &aItem[iItem]);
+    assert(!table.Find(-1) && !table.Find(cItem));
+
+    table.Clear();
+    for (IntItem & item : aItem) assert(!item.node.pNext);
+}
+
+int main()
+{
+    TestRandom();
+    TestIdentityHash();
+
+    printf("ll_hash_test: ok\n");
+    return 0;
+}
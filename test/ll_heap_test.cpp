@@ -0,0 +1,168 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll.h"
+#include "../ll_heap.h"
+
+//
+// Randomized test for ll_heap.h against a std::set model: Insert, PopMin, DecreaseKey, Remove, Meld and Clear on two
+//  heaps sharing one set of items, then InsertAll from an LL2 list and back
+//
+
+struct Item
+{
+    uint64_t key;
+    int id;
+
+    DefineLL2Node(Item);
+    LL2Node node;
+};
+
+typedef ll::PairingHeap<Item, &Item::node, uint64_t, &Item::key> ItemHeap;
+typedef std::set<std::pair<uint64_t, int>> HeapModel;
+
+static const int s_cItem = 5000;
+
+static void TestRandom()
+{
+    std::mt19937_64 rng(3);
+    std::vector<Item> aItem(s_cItem);
+    for (int iItem = 0; iItem < s_cItem; iItem++)
+    {
+        aItem[iItem].id = iItem;
+        aItem[iItem].node = {};
+    }
+
+    ItemHeap heap;
+    ItemHeap heapOther;
+    HeapModel model;
+    HeapModel modelOther;
+
+    for (int iStep = 0; iStep < 400000; iStep++)
+    {
+        Item * pItem = &aItem[rng() % s_cItem];
+        bool isInHeap = model.count(std::make_pair(pItem->key, pItem->id)) > 0;
+        bool isLinked = ItemHeap::IsItemLinked(pItem);
+        assert(isLinked == (isInHeap || modelOther.count(std::make_pair(pItem->key, pItem->id)) > 0));
+
+        switch (rng() % 8)
+        {
+        case 0: case 1:
+            if (isLinked) break;
+            pItem->key = rng() % 100000;
+            heap.Insert(pItem);
+            model.insert(std::make_pair(pItem->key, pItem->id));
+            break;
+
+        case 2:
+            if (isLinked) break;
+            pItem->key = rng() % 100000;
+            heapOther.Insert(pItem);
+            modelOther.insert(std::make_pair(pItem->key, pItem->id));
+            break;
+
+        case 3:
+            {
+                Item * pItemMin = heap.PopMin();
+                if (!pItemMin)
+                {
+                    assert(model.empty());
+                    break;
+                }
+
+                assert(!model.empty() && pItemMin->key == model.begin()->first);
+                model.erase(std::make_pair(pItemMin->key, pItemMin->id));
+                assert(!ItemHeap::IsItemLinked(pItemMin));
+            }
+            break;
+
+        case 4:
+            {
+                if (!isInHeap) break;
+                uint64_t keyNew = pItem->key ? rng() % (pItem->key + 1) : 0;
+                model.erase(std::make_pair(pItem->key, pItem->id));
+                heap.DecreaseKey(pItem, keyNew);
+                model.insert(std::make_pair(keyNew, pItem->id));
+            }
+            break;
+
+        case 5:
+            if (!isInHeap) break;
+            heap.Remove(pItem);
+            model.erase(std::make_pair(pItem->key, pItem->id));
+            assert(!ItemHeap::IsItemLinked(pItem));
+            break;
+
+        case 6:
+            if (rng() % 50) break;
+            heap.Meld(heapOther);
+            model.insert(modelOther.begin(), modelOther.end());
+            modelOther.clear();
+            assert(heapOther.IsEmpty() && heapOther.Count() == 0);
+            break;
+
+        case 7:
+            if (rng() % 2000) break;
+            heap.Clear();
+            for (const std::pair<uint64_t, int> & entry : model) assert(!ItemHeap::IsItemLinked(&aItem[entry.second]));
+            model.clear();
+            break;
+        }
+
+        assert(heap.Count() == model.size());
+        assert(heapOther.Count() == modelOther.size());
+        if (model.empty()) assert(!heap.Min());
+        else assert(heap.Min()->key == model.begin()->first);
+    }
+
+    uint64_t keyPrev = 0;
+    while (Item * pItemMin = heap.PopMin())
+    {
+        assert(pItemMin->key >= keyPrev);
+        keyPrev = pItemMin->key;
+    }
+    heapOther.Clear();
+}
+
+static void TestInsertAll()
+{
+    // The same LL2Node goes from a list to the heap and back
+
+    std::vector<Item> aItem(100);
+    ll::List<Item, &Item::node> list;
+    for (int iItem = 0; iItem < 100; iItem++)
+    {
+        aItem[iItem].key = 100 - iItem;
+        aItem[iItem].node = {};
+        list.AddTail(&aItem[iItem]);
+    }
+
+    ItemHeap heap;
+    heap.InsertAll(list);
+    assert(list.IsEmpty() && heap.Count() == 100);
+
+    uint64_t keyExpected = 1;
+    while (Item * pItemMin = heap.PopMin())
+    {
+        assert(pItemMin->key == keyExpected++);
+        list.AddTail(pItemMin);
+    }
+    assert(keyExpected == 101);
+    list.Clear();
+}
+
+int main()
+{
+    TestRandom();
+    TestInsertAll();
+
+    printf("ll_heap_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define ALS_ASSERT assert
+#define LL_INSTRUMENT
+#define LL_VALIDATE
+#include "../ll.h"
+
+//
+// Tests for LL_INSTRUMENT / LL_VALIDATE: every bulk operation (sort, merge, filter, relocate, clear without
+//  unlinking) is counted under its own op, and the validator runs after each one without firing
+//
+
+struct Item
+{
+    int key;
+
+    DefineLL1Node(Item)
+    LL1Node node1;
+
+    DefineLL2Node(Item);
+    LL2Node node2;
+};
+
+DefineLL1(Item, node1, Items1);
+DefineLL2(Item, node2, Items2);
+
+static const int s_cItem = 32;
+
+static bool IsLess(Item * pA, Item * pB)
+{
+    return pA->key < pB->key;
+}
+
+static bool IsEqual(Item * pA, Item * pB)
+{
+    return pA->key == pB->key;
+}
+
+static bool IsOdd(Item * pItem)
+{
+    return pItem->key & 1;
+}
+
+static LLInstrumentStats StatsFor(uintptr_t offset)
+{
+    LLInstrumentStats aStats[16];
+    int cStats = LLInstrumentSnapshot(aStats, 16);
+    for (int iStats = 0; iStats < cStats; iStats++)
+    {
+        if (aStats[iStats].offset == offset && strcmp(aStats[iStats].typeName, "Item") == 0) return aStats[iStats];
+    }
+
+    assert(false);
+    return LLInstrumentStats();
+}
+
+static void TestLL1()
+{
+    static Item s_aItem[s_cItem];
+    LLInstrumentReset();
+
+    LL1Type(Items1) list0 = {};
+    LL1Type(Items1) list1 = {};
+    for (int iItem = 0; iItem < s_cItem; iItem++)
+    {
+        s_aItem[iItem] = Item();
+        s_aItem[iItem].key = (iItem * 7) % 11;
+        if (iItem % 2) LL1AddTail(Item, list0, &s_aItem[iItem]);
+        else LL1AddTail(Item, list1, &s_aItem[iItem]);
+    }
+
+    LL1Sort(Item, list0, IsLess);
+    LL1Sort(Item, list1, IsLess);
+    LL1MergeSorted(Item, list0, list1, IsLess);
+    LL1MergeSorted(Item, list0, list1, IsLess);
+    LL1RemoveIf(Item, list0, IsOdd);
+    LL1ClearWithoutUnlinking(Item, list1);
+
+    LLInstrumentStats stats = StatsFor(offsetof(Item, node1));
+    assert(stats.aOp[LLInstrumentOp_AddTail] == s_cItem);
+    assert(stats.aOp[LLInstrumentOp_Sort] == 2);
+    assert(stats.aOp[LLInstrumentOp_Merge] == 2);
+    assert(stats.aOp[LLInstrumentOp_Filter] == 1);
+    assert(stats.aOp[LLInstrumentOp_Clear] == 1);
+
+    int keyPrev = -1;
+    ForLL1(Item, it, list0)
+    {
+        assert(!IsOdd(it) && it->key >= keyPrev);
+        keyPrev = it->key;
+    }
+}
+
+static void TestLL2()
+{
+    static Item s_aItem[s_cItem];
+    static Item s_itemMoved;
+    LLInstrumentReset();
+
+    LL2Type(Items2) list0 = {};
+    LL2Type(Items2) list1 = {};
+    for (int iItem = 0; iItem < s_cItem; iItem++)
+    {
+        s_aItem[iItem] = Item();
+        s_aItem[iItem].key = (iItem * 7) % 11;
+        if (iItem % 2) LL2AddTail(Item, list0, &s_aItem[iItem]);
+        else LL2AddTail(Item, list1, &s_aItem[iItem]);
+    }
+
+    LL2Sort(Item, list0, IsLess);
+    LL2Sort(Item, list1, IsLess);
+    LL2MergeSorted(Item, list0, list1, IsLess);
+    LL2MergeSorted(Item, list0, list1, IsLess);
+
+    // Bitwise move of the head, as if the item had been reallocated
+
+    Item * pItemOld = list0.pHead;
+    s_itemMoved = *pItemOld;
+    LL2Relocate(Item, list0, pItemOld, &s_itemMoved);
+    assert(list0.pHead == &s_itemMoved);
+
+    LL2Unique(Item, list0, IsEqual);
+    LL2Partition(Item, list0, list1, IsOdd);
+    LL2RemoveIf(Item, list1, IsOdd);
+    LL2ClearWithoutUnlinking(Item, list1);
+
+    LLInstrumentStats stats = StatsFor(offsetof(Item, node2));
+    assert(stats.aOp[LLInstrumentOp_AddTail] == s_cItem);
+    assert(stats.aOp[LLInstrumentOp_Sort] == 2);
+    assert(stats.aOp[LLInstrumentOp_Merge] == 2);
+    assert(stats.aOp[LLInstrumentOp_Relocate] == 1);
+    assert(stats.aOp[LLInstrumentOp_Filter] == 3);
+    assert(stats.aOp[LLInstrumentOp_Clear] == 1);
+
+    int keyPrev = -1;
+    ForLL2(Item, it, list0)
+    {
+        assert(!IsOdd(it) && it->key > keyPrev);
+        keyPrev = it->key;
+    }
+}
+
+int main()
+{
+    TestLL1();
+    TestLL2();
+
+    printf("ll_instrument_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,194 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll.h"
+
+//
+// Randomized test for the LL1 operations that mirror LL2: InsertAfter, RemoveAfter, Remove, Prev, Combine,
+//  RemoveIf and ForLL1WithPrev with RemoveWhileIterating. Two lists are compared against std::vector models after
+//  every step, including the tail and every item's linked state.
+//
+
+struct Item
+{
+    int id;
+
+    DefineLL1Node(Item)
+    LL1Node node;
+};
+
+DefineLL1(Item, node, Items);
+
+static std::vector<Item *> ToVector(LL1Type(Items) & list)
+{
+    std::vector<Item *> apItem;
+    ForLL1(Item, it, list)
+    {
+        apItem.push_back(it);
+    }
+
+    if (apItem.empty())
+    {
+        assert(!list.pTail);
+    }
+    else
+    {
+        assert(list.pTail == apItem.back());
+        assert(LL1NodePtr(Item, list, list.pTail)->pNext == (Item *)LLEndOfList_);
+    }
+
+    return apItem;
+}
+
+static int IndexOf(const std::vector<Item *> & apItem, Item * pItem)
+{
+    auto itFound = std::find(apItem.begin(), apItem.end(), pItem);
+    return (itFound == apItem.end()) ? -1 : (int)(itFound - apItem.begin());
+}
+
+static void TestRandom()
+{
+    const int cItem = 40;
+    static Item s_aItem[cItem];
+    for (int iItem = 0; iItem < cItem; iItem++)
+    {
+        s_aItem[iItem].id = iItem;
+    }
+
+    LL1Type(Items) aList[2] = {};
+    std::vector<Item *> aapItemModel[2];
+
+    std::mt19937 rng(11);
+    for (int iStep = 0; iStep < 100000; iStep++)
+    {
+        int iList = (int)(rng() % 2);
+        LL1Type(Items) & list = aList[iList];
+        std::vector<Item *> & apItemModel = aapItemModel[iList];
+
+        Item * pItem = &s_aItem[rng() % cItem];
+        int iListOn = (IndexOf(aapItemModel[0], pItem) >= 0) ? 0 : (IndexOf(aapItemModel[1], pItem) >= 0) ? 1 : -1;
+        assert(LL1IsItemLinked(Item, list, pItem) == (iListOn >= 0));
+
+        switch (rng() % 8)
+        {
+        case 0:
+            {
+                if (iListOn >= 0) break;
+                size_t iInsert = rng() % (apItemModel.size() + 1);
+                Item * pItemPrev = iInsert ? apItemModel[iInsert - 1] : nullptr;
+                LL1InsertAfter(Item, list, pItem, pItemPrev);
+                apItemModel.insert(apItemModel.begin() + iInsert, pItem);
+            }
+            break;
+
+        case 1:
+            {
+                size_t iPrev = rng() % (apItemModel.size() + 1);
+                Item * pItemPrev = iPrev ? apItemModel[iPrev - 1] : nullptr;
+                Item * pItemRemoved;
+                LL1RemoveAfter(Item, list, pItemPrev, pItemRemoved);
+
+                if (iPrev == apItemModel.size())
+                {
+                    assert(!pItemRemoved);
+                }
+                else
+                {
+                    assert(pItemRemoved == apItemModel[iPrev]);
+                    apItemModel.erase(apItemModel.begin() + iPrev);
+                }
+            }
+            break;
+
+        case 2:
+            {
+                if (iListOn < 0) break;
+                std::vector<Item *> & apItemModelOn = aapItemModel[iListOn];
+                LL1Remove(Item, aList[iListOn], pItem);
+                apItemModelOn.erase(apItemModelOn.begin() + IndexOf(apItemModelOn, pItem));
+            }
+            break;
+
+        case 3:
+            {
+                if (rng() % 20) break;
+
+                std::vector<Item *> & apItemModelOther = aapItemModel[1 - iList];
+                LL1Combine(Item, list, aList[1 - iList]);
+                apItemModel.insert(apItemModel.end(), apItemModelOther.begin(), apItemModelOther.end());
+                apItemModelOther.clear();
+            }
+            break;
+
+        case 4:
+            {
+                if (rng() % 10) break;
+
+                int modulus = (int)(rng() % 3) + 2;
+                ForLL1WithPrev(Item, it, itPrev, list)
+                {
+                    if (it->id % modulus == 0) LL1RemoveWhileIterating(Item, list, it, itPrev);
+                }
+
+                apItemModel.erase(
+                    std::remove_if(apItemModel.begin(), apItemModel.end(), [modulus](Item * pItemModel) { return pItemModel->id % modulus == 0; }),
+                    apItemModel.end());
+            }
+            break;
+
+        case 5:
+            {
+                if (rng() % 10) break;
+
+                int modulus = (int)(rng() % 3) + 2;
+                auto isRemoved = [modulus](Item * pItemTest) { return pItemTest->id % modulus == 1; };
+                LL1RemoveIf(Item, list, isRemoved);
+                apItemModel.erase(std::remove_if(apItemModel.begin(), apItemModel.end(), isRemoved), apItemModel.end());
+            }
+            break;
+
+        case 6:
+            {
+                if (iListOn < 0) break;
+                std::vector<Item *> & apItemModelOn = aapItemModel[iListOn];
+                int iItem = IndexOf(apItemModelOn, pItem);
+
+                Item * pItemPrev;
+                LL1Prev(Item, aList[iListOn], pItem, pItemPrev);
+                assert(pItemPrev == (iItem ? apItemModelOn[iItem - 1] : nullptr));
+            }
+            break;
+
+        case 7:
+            if (iListOn >= 0) break;
+            LL1AddTail(Item, list, pItem);
+            apItemModel.push_back(pItem);
+            break;
+        }
+
+        for (int iListCheck = 0; iListCheck < 2; iListCheck++)
+        {
+            assert(ToVector(aList[iListCheck]) == aapItemModel[iListCheck]);
+        }
+
+        for (int iItem = 0; iItem < cItem; iItem++)
+        {
+            bool isInModel = IndexOf(aapItemModel[0], &s_aItem[iItem]) >= 0 || IndexOf(aapItemModel[1], &s_aItem[iItem]) >= 0;
+            assert(LL1IsItemLinked(Item, aList[0], &s_aItem[iItem]) == isInModel);
+        }
+    }
+}
+
+int main()
+{
+    TestRandom();
+
+    printf("ll_ll1_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll_mpsc.h"
+
+//
+// Stress test for ll_mpsc.h: several producers push concurrently while the consumer alternates between Pop and Drain,
+//  checking that every item arrives exactly once and that each producer's items arrive in push order
+//
+
+struct Job
+{
+    int iProducer;
+    int seq;
+
+    DefineLL1Node(Job)
+    LL1Node node;
+};
+
+DefineLL1Mpsc(Job, node, Jobs);
+DefineLL1(Job, node, JobList);
+
+static void Consume(Job * pJob, std::vector<int> & aSeqLast)
+{
+    assert(pJob->seq == aSeqLast[pJob->iProducer] + 1);
+    aSeqLast[pJob->iProducer] = pJob->seq;
+}
+
+static void RunRound(int cProducer, int cJobPerProducer)
+{
+    static LL1MpscType(Jobs) s_queue;
+    s_queue.pTail.store(nullptr);
+    s_queue.pHead = nullptr;
+    s_queue.pStubNext = nullptr;
+
+    std::vector<Job> aJob((size_t)cProducer * cJobPerProducer);
+    for (Job & job : aJob) job.node.pNext = nullptr;
+
+    std::vector<std::thread> aThread;
+    for (int iProducer = 0; iProducer < cProducer; iProducer++)
+    {
+        aThread.emplace_back([&aJob, iProducer, cJobPerProducer]()
+        {
+            for (int seq = 0; seq < cJobPerProducer; seq++)
+            {
+                Job * pJob = &aJob[(size_t)iProducer * cJobPerProducer + seq];
+                pJob->iProducer = iProducer;
+                pJob->seq = seq;
+                LL1MpscPush(Job, s_queue, pJob);
+            }
+        });
+    }
+
+    std::vector<int> aSeqLast(cProducer, -1);
+    long cConsumed = 0;
+    long cTotal = (long)cProducer * cJobPerProducer;
+    for (unsigned iIter = 0; cConsumed < cTotal; iIter++)
+    {
+        if (iIter % 3)
+        {
+            Job * pJob;
+            LL1MpscPop(Job, s_queue, pJob);
+            if (!pJob) continue;
+
+            assert(!LL1IsItemLinked(Job, s_queue, pJob));
+            Consume(pJob, aSeqLast);
+            cConsumed++;
+        }
+        else
+        {
+            LL1Type(JobList) list = {};
+            int cDrained;
+            LL1MpscDrain(Job, s_queue, list, cDrained);
+
+            int cRemoved = 0;
+            Job * pJob;
+            for (;;)
+            {
+                LL1RemoveHead(Job, list, pJob);
+                if (!pJob) break;
+
+                Consume(pJob, aSeqLast);
+                cRemoved++;
+            }
+            assert(cRemoved == cDrained);
+            cConsumed += cRemoved;
+        }
+    }
+
+    for (std::thread & thread : aThread) thread.join();
+
+    for (int iProducer = 0; iProducer < cProducer; iProducer++)
+    {
+        assert(aSeqLast[iProducer] == cJobPerProducer - 1);
+    }
+
+    Job * pJob;
+    LL1MpscPop(Job, s_queue, pJob);
+    assert(!pJob);
+}
+
+int main()
+{
+    RunRound(1, 100000);
+    RunRound(4, 100000);
+    RunRound(8, 50000);
+
+    printf("ll_mpsc_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,174 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <random>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll.h"
+#include "../ll_parallel.h"
+
+//
+// Randomized test for ll_parallel.h on 4 workers: lists of assorted lengths are mutated between passes (notified
+//  adds and removes, occasional Invalidate), then ForEach must visit every linked item exactly once, and Reduce must
+//  match a serial sum and keep chunk order for a non-commutative combine. Also runs ForEach from inside a task.
+//
+
+struct Item
+{
+    long value;
+    std::atomic<int> cVisit;
+
+    DefineLL2Node(Item);
+    LL2Node node;
+
+    Item() : value(0), cVisit(0), node() {}
+};
+
+typedef ll::List<Item, &Item::node> ItemList;
+typedef ll::ParallelList<Item, &Item::node> ItemParallelList;
+
+// NOTE - First and last value seen, which only comes out right if partial results are combined in list order
+
+struct Span
+{
+    long first;
+    long last;
+    long cItem;
+};
+
+static void TestRandom(ll::Scheduler & scheduler)
+{
+    std::mt19937 rng(9);
+
+    for (int iRound = 0; iRound < 60; iRound++)
+    {
+        int cItemLinked = (iRound % 3 == 0) ? (int)(rng() % 100) : 1000 + (int)(rng() % 40000);
+        std::vector<Item> aItem(cItemLinked + 2000);
+        std::vector<bool> aIsLinked(aItem.size(), false);
+
+        ItemList list;
+        for (int iItem = 0; iItem < cItemLinked; iItem++)
+        {
+            aItem[iItem].value = iItem;
+            list.AddTail(&aItem[iItem]);
+            aIsLinked[iItem] = true;
+        }
+
+        ItemParallelList parallel(list);
+        parallel.Init(1 + (int)(rng() % 64), (iRound % 2) ? 0 : 4096);
+
+        for (int iPass = 0; iPass < 6; iPass++)
+        {
+            int cMutate = (int)(rng() % 500);
+            for (int iMutate = 0; iMutate < cMutate; iMutate++)
+            {
+                size_t iItem = rng() % aItem.size();
+                Item * pItem = &aItem[iItem];
+                if (aIsLinked[iItem])
+                {
+                    parallel.NotifyRemove(pItem);
+                    list.Remove(pItem);
+                    aIsLinked[iItem] = false;
+                    continue;
+                }
+
+                pItem->value = (long)iItem;
+                Item * pItemHead = list.Head();
+                if (rng() % 2) list.AddHead(pItem);
+                else if (pItemHead && rng() % 2) list.InsertBefore(pItem, ItemList::Next(pItemHead) ? ItemList::Next(pItemHead) : pItemHead);
+                else list.AddTail(pItem);
+                parallel.NotifyAdd(pItem);
+                aIsLinked[iItem] = true;
+            }
+
+            if (rng() % 5 == 0) parallel.Invalidate();
+
+            for (Item & item : aItem) item.cVisit = 0;
+            parallel.ForEach(&scheduler, [](Item * pItem) { pItem->cVisit.fetch_add(1); });
+
+            long sumExpected = 0;
+            for (size_t iItem = 0; iItem < aItem.size(); iItem++)
+            {
+                assert(aItem[iItem].cVisit == (aIsLinked[iItem] ? 1 : 0));
+                if (aIsLinked[iItem]) sumExpected += aItem[iItem].value;
+            }
+
+            long sum = parallel.Reduce(&scheduler, 0L,
+                                       [](long & acc, Item * pItem) { acc += pItem->value; },
+                                       [](long a, long b) { return a + b; });
+            assert(sum == sumExpected);
+
+            std::vector<long> aValue;
+            for (Item * pItem : list) aValue.push_back(pItem->value);
+
+            Span spanEmpty = { -1, -1, 0 };
+            Span span = parallel.Reduce(&scheduler, spanEmpty,
+                                        [](Span & acc, Item * pItem)
+                                        {
+                                            if (!acc.cItem) acc.first = pItem->value;
+                                            acc.last = pItem->value;
+                                            acc.cItem++;
+                                        },
+                                        [](Span a, Span b)
+                                        {
+                                            if (!a.cItem) return b;
+                                            if (!b.cItem) return a;
+                                            Span spanCombined = { a.first, b.last, a.cItem + b.cItem };
+                                            return spanCombined;
+                                        });
+            assert(span.cItem == (long)aValue.size());
+            if (!aValue.empty()) assert(span.first == aValue.front() && span.last == aValue.back());
+        }
+
+        list.Clear();
+    }
+}
+
+struct NestedJob : ll::Task
+{
+    ItemParallelList * pParallel;
+    ll::Scheduler * pScheduler;
+};
+
+static void RunNestedJob(ll::Task * pTask)
+{
+    NestedJob * pJob = static_cast<NestedJob *>(pTask);
+    pJob->pParallel->ForEach(pJob->pScheduler, [](Item * pItem) { pItem->cVisit.fetch_add(1); });
+}
+
+static void TestNested(ll::Scheduler & scheduler)
+{
+    std::vector<Item> aItem(20000);
+    ItemList list;
+    for (Item & item : aItem) list.AddTail(&item);
+
+    ItemParallelList parallel(list);
+    parallel.Init(32, 0);
+
+    NestedJob job;
+    job.pfnRun = RunNestedJob;
+    job.pParallel = &parallel;
+    job.pScheduler = &scheduler;
+    scheduler.Submit(&job);
+    scheduler.WaitIdle();
+
+    for (Item & item : aItem) assert(item.cVisit == 1);
+    list.Clear();
+}
+
+int main()
+{
+    ll::Scheduler scheduler;
+    scheduler.Init(4);
+
+    TestRandom(scheduler);
+    TestNested(scheduler);
+
+    scheduler.Shutdown();
+
+    printf("ll_parallel_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,307 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll.h"
+#include "../ll_rcu.h"
+
+//
+// Tests for ll_rcu.h: writer-side InsertBefore, Remove, Relocate, Retire and Reclaim against a std::vector model;
+//  readers checking that every item they reach is still alive while a writer churns the list; readers that register,
+//  walk and unregister over and over from short-lived threads (their EpochReader dies with them) while the writer
+//  keeps scanning; and a list destroyed with items still retired.
+//
+
+struct Item
+{
+    int value;
+    int magic;
+
+    DefineLL2Node(Item);
+    LL2Node node;
+};
+
+typedef ll::RcuList<Item, &Item::node> ItemList;
+
+static const int s_magicAlive = 7;
+static std::atomic<int> s_cFreed(0);
+
+static void FreeItem(Item * pItem, void *)
+{
+    pItem->magic = 0;
+    delete pItem;
+    s_cFreed++;
+}
+
+static Item * NewItem(int value)
+{
+    Item * pItem = new Item();
+    pItem->value = value;
+    pItem->magic = s_magicAlive;
+    return pItem;
+}
+
+static bool IsMatch(ItemList & list, const std::vector<Item *> & apItemModel)
+{
+    size_t iItem = 0;
+    for (Item * pItem = list.Head(); pItem; pItem = ItemList::Next(pItem))
+    {
+        if (iItem >= apItemModel.size() || pItem != apItemModel[iItem]) return false;
+        iItem++;
+    }
+    if (iItem != apItemModel.size()) return false;
+
+    for (Item * pItem = list.Tail(); pItem; pItem = ItemList::Prev(pItem))
+    {
+        if (!iItem || pItem != apItemModel[--iItem]) return false;
+    }
+    return iItem == 0;
+}
+
+static void RemoveAll(ItemList & list)
+{
+    while (Item * pItem = list.Head())
+    {
+        list.Remove(pItem);
+        list.Retire(pItem);
+    }
+    list.ReclaimAll();
+}
+
+static void TestWriter()
+{
+    ll::EpochDomain domain;
+    ItemList list;
+    list.Init(&domain, FreeItem, nullptr);
+    std::vector<Item *> apItemModel;
+    std::mt19937 rng(1);
+
+    for (int iStep = 0; iStep < 20000; iStep++)
+    {
+        switch (apItemModel.empty() ? 0 : rng() % 5)
+        {
+        case 0: case 1:
+            {
+                Item * pItem = NewItem(iStep);
+                size_t iInsert = rng() % (apItemModel.size() + 1);
+                list.InsertBefore(pItem, (iInsert < apItemModel.size()) ? apItemModel[iInsert] : nullptr);
+                apItemModel.insert(apItemModel.begin() + iInsert, pItem);
+            }
+            break;
+
+        case 2:
+            {
+                size_t iRemove = rng() % apItemModel.size();
+                Item * pItem = apItemModel[iRemove];
+                list.Remove(pItem);
+                assert(!ItemList::IsItemLinked(pItem));
+                list.Retire(pItem);
+                apItemModel.erase(apItemModel.begin() + iRemove);
+            }
+            break;
+
+        case 3:
+            {
+                size_t iRelocate = rng() % apItemModel.size();
+                Item * pItemNew = new Item();
+                list.Relocate(apItemModel[iRelocate], pItemNew);
+                assert(pItemNew->magic == s_magicAlive);
+                list.Retire(apItemModel[iRelocate]);
+                apItemModel[iRelocate] = pItemNew;
+            }
+            break;
+
+        case 4:
+            list.Reclaim();
+            break;
+        }
+
+        assert(IsMatch(list, apItemModel));
+    }
+
+    // With no readers, every retired item is freed within a few Reclaims
+
+    for (int iReclaim = 0; iReclaim < 3; iReclaim++) list.Reclaim();
+    assert(list.cRetired == 0);
+
+    RemoveAll(list);
+    assert(!list.Head() && !list.Tail());
+}
+
+static void TestReaders()
+{
+    ll::EpochDomain domain;
+    ItemList list;
+    list.Init(&domain, FreeItem, nullptr);
+
+    std::vector<Item *> apItemModel;
+    for (int iItem = 0; iItem < 64; iItem++)
+    {
+        apItemModel.push_back(NewItem(iItem));
+        list.AddTail(apItemModel.back());
+    }
+
+    std::atomic<bool> isDone(false);
+    std::atomic<long> cVisit(0);
+    std::vector<std::thread> aThreadReader;
+    for (int iReader = 0; iReader < 3; iReader++)
+    {
+        aThreadReader.emplace_back([&]()
+            {
+                ll::EpochReader reader;
+                assert(domain.Register(&reader));
+
+                long cVisitReader = 0;
+                while (!isDone.load())
+                {
+                    ll::EpochGuard guard(&reader);
+                    for (Item * pItem = list.Head(); pItem; pItem = ItemList::Next(pItem))
+                    {
+                        assert(pItem->magic == s_magicAlive);
+                        cVisitReader++;
+                    }
+                }
+
+                domain.Unregister(&reader);
+                cVisit += cVisitReader;
+            });
+    }
+
+    std::mt19937 rng(2);
+    for (int iStep = 0; iStep < 100000; iStep++)
+    {
+        switch (apItemModel.empty() ? 0 : rng() % 4)
+        {
+        case 0:
+            {
+                Item * pItem = NewItem(iStep);
+                size_t iInsert = rng() % (apItemModel.size() + 1);
+                list.InsertBefore(pItem, (iInsert < apItemModel.size()) ? apItemModel[iInsert] : nullptr);
+                apItemModel.insert(apItemModel.begin() + iInsert, pItem);
+            }
+            break;
+
+        case 1:
+            {
+                size_t iRemove = rng() % apItemModel.size();
+                list.Remove(apItemModel[iRemove]);
+                list.Retire(apItemModel[iRemove]);
+                apItemModel.erase(apItemModel.begin() + iRemove);
+            }
+            break;
+
+        case 2:
+            {
+                size_t iRelocate = rng() % apItemModel.size();
+                Item * pItemNew = new Item();
+                list.Relocate(apItemModel[iRelocate], pItemNew);
+                list.Retire(apItemModel[iRelocate]);
+                apItemModel[iRelocate] = pItemNew;
+            }
+            break;
+
+        case 3:
+            list.Reclaim();
+            break;
+        }
+
+        if (iStep % 1000 == 0) std::this_thread::yield();
+    }
+
+    isDone = true;
+    for (std::thread & thread : aThreadReader) thread.join();
+
+    assert(cVisit.load() > 0);
+    assert(IsMatch(list, apItemModel));
+    RemoveAll(list);
+}
+
+static void TestShortLivedReaders()
+{
+    // Each reader thread's EpochReader is gone right after Unregister, while the writer keeps calling TryAdvance
+
+    ll::EpochDomain domain;
+    ItemList list;
+    list.Init(&domain, FreeItem, nullptr);
+    for (int iItem = 0; iItem < 16; iItem++) list.AddTail(NewItem(iItem));
+
+    std::atomic<bool> isDone(false);
+    std::thread threadWriter([&]()
+        {
+            int iStep = 0;
+            while (!isDone.load())
+            {
+                Item * pItemHead = list.Head();
+                list.Remove(pItemHead);
+                list.Retire(pItemHead);
+                list.AddTail(NewItem(iStep++));
+                list.Reclaim();
+            }
+        });
+
+    for (int iRound = 0; iRound < 200; iRound++)
+    {
+        std::vector<std::thread> aThreadReader;
+        for (int iReader = 0; iReader < 4; iReader++)
+        {
+            aThreadReader.emplace_back([&]()
+                {
+                    ll::EpochReader reader;
+                    assert(domain.Register(&reader));
+                    {
+                        ll::EpochGuard guard(&reader);
+                        for (Item * pItem = list.Head(); pItem; pItem = ItemList::Next(pItem))
+                        {
+                            assert(pItem->magic == s_magicAlive);
+                        }
+                    }
+                    domain.Unregister(&reader);
+                });
+        }
+        for (std::thread & thread : aThreadReader) thread.join();
+    }
+
+    isDone = true;
+    threadWriter.join();
+
+    // Slots are reused lowest first, so the scan never grew past the most readers registered at once
+
+    assert(domain.cSlotScan.load() <= 4);
+    RemoveAll(list);
+}
+
+static void TestDestroyWithRetired()
+{
+    ll::EpochDomain domain;
+    int cFreedBefore = s_cFreed.load();
+    {
+        ItemList list;
+        list.Init(&domain, FreeItem, nullptr);
+        for (int iItem = 0; iItem < 10; iItem++)
+        {
+            Item * pItem = NewItem(iItem);
+            list.AddTail(pItem);
+            list.Remove(pItem);
+            list.Retire(pItem);
+        }
+        assert(list.cRetired == 10);
+    }
+    assert(s_cFreed.load() == cFreedBefore + 10);
+}
+
+int main()
+{
+    TestWriter();
+    TestReaders();
+    TestShortLivedReaders();
+    TestDestroyWithRetired();
+
+    printf("ll_rcu_test: ok\n");
+    return 0;
+}
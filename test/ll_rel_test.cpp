@@ -0,0 +1,209 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll.h"
+#include "../ll_mmap.h"
+
+//
+// Tests for the self-relative LL2Rel lists and ll_mmap.h: random operations against a std::vector model, removal
+//  while walking by hand, and the same image walked after a memcpy to another address, after a save/load round trip,
+//  and in a copy-on-write mapping whose changes must not reach the file
+//
+
+struct Item
+{
+    DefineLL2RelNode(Item);
+    LL2RelNode node;
+    LL2RelNode otherNode;
+
+    int value;
+};
+
+DefineLL2Rel(Item, node, Items);
+DefineLL2Rel(Item, otherNode, OtherItems);
+
+struct Root
+{
+    LL2RelType(Items) items;
+    LL2RelType(OtherItems) otherItems;
+};
+
+static const int s_cItem = 2000;
+static const uint64_t s_userTag = 42;
+static const char * s_pathImage = "ll_rel_test.img";
+
+static bool IsMatch(const Root * pRoot, const std::vector<int> & aValueModel)
+{
+    size_t iValue = 0;
+    ForLL2Rel(const Item, it, pRoot->items)
+    {
+        if (iValue >= aValueModel.size() || it->value != aValueModel[iValue]) return false;
+        iValue++;
+    }
+    if (iValue != aValueModel.size()) return false;
+
+    for (const Item * pItem = LL2RelTail(const Item, pRoot->items); pItem; pItem = LL2RelPrev(const Item, pRoot->items, pItem))
+    {
+        if (!iValue || pItem->value != aValueModel[--iValue]) return false;
+    }
+    return iValue == 0;
+}
+
+static void TestRandom(Root * pRoot, Item * aItem, std::vector<int> & aValueModel)
+{
+    std::mt19937 rng(7);
+
+    for (int iStep = 0; iStep < 100000; iStep++)
+    {
+        Item * pItem = &aItem[rng() % s_cItem];
+        bool isLinked = LL2RelIsItemLinked(Item, pRoot->items, pItem);
+
+        switch (rng() % 6)
+        {
+        case 0:
+            if (isLinked) break;
+            LL2RelAddHead(Item, pRoot->items, pItem);
+            aValueModel.insert(aValueModel.begin(), pItem->value);
+            break;
+
+        case 1:
+            if (isLinked) break;
+            LL2RelAddTail(Item, pRoot->items, pItem);
+            aValueModel.push_back(pItem->value);
+            break;
+
+        case 2:
+            if (!isLinked) break;
+            LL2RelRemove(Item, pRoot->items, pItem);
+            aValueModel.erase(std::find(aValueModel.begin(), aValueModel.end(), pItem->value));
+            break;
+
+        case 3:
+            {
+                if (isLinked) break;
+                size_t iInsert = rng() % (aValueModel.size() + 1);
+                Item * pItemNext = (iInsert < aValueModel.size()) ? &aItem[aValueModel[iInsert]] : nullptr;
+                LL2RelInsertBefore(Item, pRoot->items, pItem, pItemNext);
+                aValueModel.insert(aValueModel.begin() + iInsert, pItem->value);
+            }
+            break;
+
+        case 4:
+            {
+                Item * pItemRemoved;
+                LL2RelRemoveHead(Item, pRoot->items, pItemRemoved);
+                assert(pItemRemoved == (aValueModel.empty() ? nullptr : &aItem[aValueModel.front()]));
+                if (pItemRemoved) aValueModel.erase(aValueModel.begin());
+            }
+            break;
+
+        case 5:
+            if (iStep % 1000) break;
+            LL2RelClear(Item, pRoot->items);
+            aValueModel.clear();
+            assert(LL2RelIsEmpty(pRoot->items));
+            for (int iItem = 0; iItem < s_cItem; iItem++) assert(!LL2RelIsItemLinked(Item, pRoot->items, &aItem[iItem]));
+            break;
+        }
+
+        if (iStep % 5000 == 0) assert(IsMatch(pRoot, aValueModel));
+    }
+
+    assert(IsMatch(pRoot, aValueModel));
+}
+
+static void TestRemoveWhileWalking(Root * pRoot, std::vector<int> & aValueModel)
+{
+    // ForLL2Rel can't remove 'it', so take the next item first
+
+    Item * pItemNext;
+    for (Item * pItem = LL2RelHead(Item, pRoot->items); pItem; pItem = pItemNext)
+    {
+        pItemNext = LL2RelNext(Item, pRoot->items, pItem);
+        if (pItem->value % 5 == 0) LL2RelRemove(Item, pRoot->items, pItem);
+    }
+
+    aValueModel.erase(std::remove_if(aValueModel.begin(), aValueModel.end(), [](int value) { return value % 5 == 0; }), aValueModel.end());
+    assert(IsMatch(pRoot, aValueModel));
+}
+
+static void TestImage(ll::ImageBuilder & builder, Root * pRoot, const std::vector<int> & aValueModel)
+{
+    // A plain copy of the block is valid wherever it lands
+
+    ll::ImageBuilder builderCopy;
+    assert(builderCopy.Init(builder.cbUsed));
+    memcpy(builderCopy.pBase, builder.pBase, builder.cbUsed);
+    builderCopy.cbUsed = builder.cbUsed;
+    assert(IsMatch((const Root *)(builderCopy.pBase + builder.OffsetOf(pRoot)), aValueModel));
+
+    assert(ll::SaveImage(s_pathImage, builder, pRoot, s_userTag));
+
+    ll::MappedImage image;
+    assert(!image.Load(s_pathImage, s_userTag + 1));
+    assert(image.Load(s_pathImage, s_userTag));
+    assert(IsMatch(image.Root<const Root>(), aValueModel));
+
+    int cOther = 0;
+    ForLL2Rel(const Item, it, image.Root<const Root>()->otherItems)
+    {
+        assert(it->value % 3 == 0);
+        cOther++;
+    }
+    assert(cOther == (s_cItem + 2) / 3);
+    image.Unload();
+
+    // Changes to a copy-on-write mapping stay in this process
+
+    assert(image.Load(s_pathImage, s_userTag, true));
+    Root * pRootWritable = image.Root<Root>();
+    Item * pItemRemoved;
+    LL2RelRemoveHead(Item, pRootWritable->items, pItemRemoved);
+    if (pItemRemoved)
+    {
+        std::vector<int> aValueRest(aValueModel.begin() + 1, aValueModel.end());
+        assert(IsMatch(pRootWritable, aValueRest));
+    }
+    image.Unload();
+
+    assert(image.Load(s_pathImage, s_userTag));
+    assert(IsMatch(image.Root<const Root>(), aValueModel));
+    image.Unload();
+
+    // A truncated file is rejected
+
+    FILE * pFile = fopen(s_pathImage, "wb");
+    assert(pFile);
+    fwrite(builder.pBase, 1, 16, pFile);
+    fclose(pFile);
+    assert(!image.Load(s_pathImage, s_userTag));
+
+    remove(s_pathImage);
+}
+
+int main()
+{
+    ll::ImageBuilder builder;
+    assert(builder.Init(1 << 20));
+
+    Root * pRoot = builder.Alloc<Root>();
+    Item * aItem = builder.Alloc<Item>(s_cItem);
+    for (int iItem = 0; iItem < s_cItem; iItem++) aItem[iItem].value = iItem;
+
+    std::vector<int> aValueModel;
+    TestRandom(pRoot, aItem, aValueModel);
+    TestRemoveWhileWalking(pRoot, aValueModel);
+
+    for (int iItem = 0; iItem < s_cItem; iItem += 3) LL2RelAddHead(Item, pRoot->otherItems, &aItem[iItem]);
+    TestImage(builder, pRoot, aValueModel);
+
+    printf("ll_rel_test: ok\n");
+    return 0;
+}
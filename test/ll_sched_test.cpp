@@ -0,0 +1,182 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <random>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll.h"
+#include "../ll_sched.h"
+
+//
+// Tests for ll_sched.h: the run-queue midpoint bookkeeping against a std::vector model (push, pop, steal, adopt, with
+//  the midpoint exact after every one), and recursive task trees on 1 to 8 workers, drained both by WaitIdle and by
+//  Shutdown
+//
+
+static const int s_cTask = 500;
+
+static void CheckQueue(ll::SchedWorker_ & worker, const std::vector<ll::Task *> & apTaskModel)
+{
+    assert(worker.cTask == apTaskModel.size());
+
+    size_t iTask = 0;
+    uintptr_t cBack = 0;
+    bool isPastMid = false;
+    for (ll::Task * pTask : worker.queue)
+    {
+        assert(pTask == apTaskModel[iTask]);
+        if (pTask == worker.pMid) isPastMid = true;
+        if (isPastMid) cBack++;
+        iTask++;
+    }
+    assert(isPastMid == (worker.cTask > 0));
+    assert(cBack == worker.cBack);
+    assert(cBack == (worker.cTask + 1) / 2);
+}
+
+static void TestQueue()
+{
+    std::mt19937 rng(3);
+    static ll::Task s_aTask[s_cTask];
+    ll::SchedWorker_ worker;
+    std::vector<ll::Task *> apTaskModel;
+
+    for (int iStep = 0; iStep < 200000; iStep++)
+    {
+        switch (rng() % 10)
+        {
+        case 0: case 1: case 2: case 3: case 4:
+            {
+                ll::Task * pTask = &s_aTask[rng() % s_cTask];
+                if (ll::TaskList::IsItemLinked(pTask)) break;
+                worker.Push(pTask);
+                apTaskModel.insert(apTaskModel.begin(), pTask);
+            }
+            break;
+
+        case 5: case 6: case 7: case 8:
+            {
+                ll::Task * pTask = worker.Pop();
+                assert(pTask == (apTaskModel.empty() ? nullptr : apTaskModel.front()));
+                if (pTask) apTaskModel.erase(apTaskModel.begin());
+            }
+            break;
+
+        case 9:
+            {
+                ll::TaskList stolen;
+                uintptr_t cStolen = worker.StealHalf(stolen);
+                assert(cStolen == (apTaskModel.size() + 1) / 2);
+
+                std::vector<ll::Task *> apTaskStolen(apTaskModel.end() - cStolen, apTaskModel.end());
+                apTaskModel.resize(apTaskModel.size() - cStolen);
+
+                size_t iTask = 0;
+                for (ll::Task * pTask : stolen) assert(pTask == apTaskStolen[iTask++]);
+                assert(iTask == cStolen);
+
+                // What's left is split in half again (checked by CheckQueue), so the next thief gets a fair share too
+
+                CheckQueue(worker, apTaskModel);
+
+                if (rng() % 2)
+                {
+                    worker.Adopt(stolen, cStolen);
+                    apTaskModel.insert(apTaskModel.end(), apTaskStolen.begin(), apTaskStolen.end());
+                }
+                else
+                {
+                    while (stolen.RemoveHead()) {}
+                }
+            }
+            break;
+        }
+
+        CheckQueue(worker, apTaskModel);
+    }
+
+    while (worker.Pop()) {}
+
+    // Adopting into an empty queue splits the batch at its own midpoint
+
+    ll::SchedWorker_ victim;
+    for (int iTask = 0; iTask < 100; iTask++) victim.Push(&s_aTask[iTask]);
+    assert(victim.cBack == 50);
+
+    ll::TaskList stolen;
+    assert(victim.StealHalf(stolen) == 50);
+    assert(victim.cTask == 50 && victim.cBack == 25);
+
+    worker.Adopt(stolen, 50);
+    assert(worker.cTask == 50 && worker.cBack == 25);
+
+    while (worker.Pop()) {}
+    while (victim.Pop()) {}
+}
+
+struct Job : ll::Task
+{
+    ll::Scheduler * pScheduler;
+    int depth;
+    std::atomic<long> * pCount;
+};
+
+static void RunJob(ll::Task * pTask)
+{
+    Job * pJob = static_cast<Job *>(pTask);
+    pJob->pCount->fetch_add(1);
+
+    for (int iChild = 0; pJob->depth > 0 && iChild < 2; iChild++)
+    {
+        Job * pJobChild = new Job;
+        pJobChild->pfnRun = RunJob;
+        pJobChild->pScheduler = pJob->pScheduler;
+        pJobChild->depth = pJob->depth - 1;
+        pJobChild->pCount = pJob->pCount;
+        pJob->pScheduler->Submit(pJobChild);
+    }
+
+    delete pJob;
+}
+
+static void SubmitTree(ll::Scheduler & scheduler, int depth, std::atomic<long> & count)
+{
+    Job * pJob = new Job;
+    pJob->pfnRun = RunJob;
+    pJob->pScheduler = &scheduler;
+    pJob->depth = depth;
+    pJob->pCount = &count;
+    scheduler.Submit(pJob);
+}
+
+static void TestTrees()
+{
+    for (int cWorker = 1; cWorker <= 8; cWorker *= 2)
+    {
+        ll::Scheduler scheduler;
+        scheduler.Init(cWorker);
+        std::atomic<long> count(0);
+
+        for (int iTree = 0; iTree < 4; iTree++) SubmitTree(scheduler, 12, count);
+        scheduler.WaitIdle();
+        assert(count.load() == 4 * ((1 << 13) - 1));
+
+        // Shutdown without WaitIdle still runs everything
+
+        for (int iTree = 0; iTree < 2; iTree++) SubmitTree(scheduler, 10, count);
+        scheduler.Shutdown();
+        assert(count.load() == 4 * ((1 << 13) - 1) + 2 * ((1 << 11) - 1));
+    }
+}
+
+int main()
+{
+    TestQueue();
+    TestTrees();
+
+    printf("ll_sched_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll.h"
+#include "../ll_skip.h"
+
+//
+// Randomized test for ll_skip.h against a sorted std::vector model: Insert, Remove, LowerBound, Nth and IndexOf, with
+//  both a narrow key range (lots of equal keys, which must stay in insertion order) and a wide one. Also checks that
+//  Rebuild recovers after an item is unlinked from the base list directly.
+//
+
+struct Item
+{
+    int key;
+    int id;
+
+    DefineLL2Node(Item);
+    LL2Node node;
+
+    ll::SkipNode<Item> skip;
+};
+
+typedef ll::List<Item, &Item::node> ItemList;
+typedef ll::SkipList<Item, &Item::node, &Item::skip, int, &Item::key> ItemSkipList;
+
+static const int s_cItem = 2000;
+
+static void CheckAll(ItemSkipList & skipList, ItemList & list, const std::vector<Item *> & apItemModel)
+{
+    size_t iItem = 0;
+    for (Item * pItem : list)
+    {
+        assert(iItem < apItemModel.size() && pItem == apItemModel[iItem]);
+        iItem++;
+    }
+    assert(iItem == apItemModel.size());
+
+    for (size_t iNth = 0; iNth < apItemModel.size(); iNth++)
+    {
+        assert(skipList.Nth(iNth) == apItemModel[iNth]);
+        assert(skipList.IndexOf(apItemModel[iNth]) == iNth);
+    }
+}
+
+static void TestRandom()
+{
+    std::mt19937 rng(9);
+
+    for (int iRound = 0; iRound < 20; iRound++)
+    {
+        std::vector<Item> aItem(s_cItem);
+        for (int iItem = 0; iItem < s_cItem; iItem++)
+        {
+            aItem[iItem] = Item();
+            aItem[iItem].id = iItem;
+        }
+
+        ItemList list;
+        ItemSkipList skipList(list);
+        std::vector<Item *> apItemModel;
+
+        int keyRange = (iRound % 2) ? 50 : 100000;
+        auto lessKeyItem = [](int key, Item * pItem) { return key < pItem->key; };
+        auto lessItemKey = [](Item * pItem, int key) { return pItem->key < key; };
+
+        for (int iStep = 0; iStep < 20000; iStep++)
+        {
+            Item * pItem = &aItem[rng() % s_cItem];
+            bool isLinked = list.IsItemLinked(pItem);
+
+            switch (rng() % 10)
+            {
+            case 0: case 1: case 2: case 3: case 4:
+                {
+                    if (isLinked) break;
+                    pItem->key = (int)(rng() % keyRange);
+                    skipList.Insert(pItem);
+                    apItemModel.insert(std::upper_bound(apItemModel.begin(), apItemModel.end(), pItem->key, lessKeyItem), pItem);
+                }
+                break;
+
+            case 5: case 6: case 7:
+                if (!isLinked) break;
+                skipList.Remove(pItem);
+                apItemModel.erase(std::find(apItemModel.begin(), apItemModel.end(), pItem));
+                break;
+
+            case 8:
+                {
+                    if (apItemModel.empty()) break;
+                    size_t iNth = rng() % apItemModel.size();
+                    assert(skipList.Nth(iNth) == apItemModel[iNth]);
+                    assert(skipList.IndexOf(apItemModel[iNth]) == iNth);
+                }
+                break;
+
+            case 9:
+                {
+                    int key = (int)(rng() % keyRange);
+                    auto itFound = std::lower_bound(apItemModel.begin(), apItemModel.end(), key, lessItemKey);
+                    assert(skipList.LowerBound(key) == ((itFound == apItemModel.end()) ? nullptr : *itFound));
+                }
+                break;
+            }
+
+            if (iStep == 10000) skipList.Rebuild();
+
+            assert(skipList.Count() == apItemModel.size());
+            assert(skipList.Nth(apItemModel.size()) == nullptr);
+            if (iStep % 500 == 0) CheckAll(skipList, list, apItemModel);
+        }
+
+        // Unlink the first item behind the skip list's back, then bring the lanes up to date
+
+        if (!apItemModel.empty())
+        {
+            Item * pItem = apItemModel.front();
+            list.Remove(pItem);
+            ItemSkipList::ReleaseNode(pItem);
+            apItemModel.erase(apItemModel.begin());
+
+            skipList.Rebuild();
+            assert(skipList.Count() == apItemModel.size());
+            CheckAll(skipList, list, apItemModel);
+        }
+
+        skipList.Clear();
+        assert(list.IsEmpty());
+        assert(skipList.Count() == 0);
+    }
+}
+
+int main()
+{
+    TestRandom();
+
+    printf("ll_skip_test: ok\n");
+    return 0;
+}
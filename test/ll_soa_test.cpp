@@ -0,0 +1,246 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll.h"
+
+//
+// Tests for the side-table list LL2Soa: three lists sharing one link table, driven by random AddHead, AddTail,
+//  InsertBefore, Remove, RemoveHead, RemoveTail, MoveToHead, Combine, SpliceRange (within a list and across lists)
+//  and Clear, checked after every step against a std::vector model per list. Each check walks both directions and
+//  compares IsEmpty, Count, Find and IsItemLinked. The table arrays start out as garbage, so TableInit has to zero
+//  them.
+//
+
+static const uint32_t s_cItem = 200;
+static const int s_cList = 3;
+
+static bool IsOdd(uint32_t iItem)
+{
+    return (iItem & 1) != 0;
+}
+
+static bool IsMatch(LL2Soa & list, const std::vector<uint32_t> & aiItemModel)
+{
+    size_t iModel = 0;
+    ForLL2Soa(iItem, list)
+    {
+        if (iModel >= aiItemModel.size() || iItem != aiItemModel[iModel]) return false;
+        iModel++;
+    }
+    if (iModel != aiItemModel.size()) return false;
+
+    for (uint32_t iItem = LL2SoaTail(list); iItem != LL2SoaNil; iItem = LL2SoaPrev(list, iItem))
+    {
+        if (!iModel || iItem != aiItemModel[--iModel]) return false;
+    }
+    if (iModel != 0) return false;
+
+    if (LL2SoaIsEmpty(list) != aiItemModel.empty()) return false;
+
+    uint32_t cItem;
+    LL2SoaCount(list, cItem);
+    if (cItem != aiItemModel.size()) return false;
+
+    uint32_t iItemOdd;
+    LL2SoaFind(list, IsOdd, iItemOdd);
+    std::vector<uint32_t>::const_iterator itOdd = std::find_if(aiItemModel.begin(), aiItemModel.end(), IsOdd);
+    return iItemOdd == ((itOdd == aiItemModel.end()) ? LL2SoaNil : *itOdd);
+}
+
+static void Erase(std::vector<uint32_t> & aiItem, uint32_t iItem)
+{
+    aiItem.erase(std::find(aiItem.begin(), aiItem.end(), iItem));
+}
+
+static void TestModel()
+{
+    static uint32_t s_aiPrev[s_cItem];
+    static uint32_t s_aiNext[s_cItem];
+    memset(s_aiPrev, 0xAB, sizeof(s_aiPrev));
+    memset(s_aiNext, 0xCD, sizeof(s_aiNext));
+
+    LL2SoaTable table;
+    LL2SoaTableInit(table, s_aiPrev, s_aiNext, s_cItem);
+
+    LL2Soa aList[s_cList];
+    for (int iList = 0; iList < s_cList; iList++) LL2SoaInit(aList[iList], &table);
+
+    std::vector<uint32_t> aaiItemModel[s_cList];
+    int aiListOwner[s_cItem];
+    for (uint32_t iItem = 0; iItem < s_cItem; iItem++) aiListOwner[iItem] = -1;
+
+    std::mt19937 rng(7);
+    for (int iStep = 0; iStep < 200000; iStep++)
+    {
+        int iList = rng() % s_cList;
+        uint32_t iItem = rng() % s_cItem;
+        LL2Soa & list = aList[iList];
+        std::vector<uint32_t> & aiItemModel = aaiItemModel[iList];
+
+        switch (rng() % 10)
+        {
+        case 0:
+            if (aiListOwner[iItem] >= 0) break;
+            LL2SoaAddHead(list, iItem);
+            aiItemModel.insert(aiItemModel.begin(), iItem);
+            aiListOwner[iItem] = iList;
+            break;
+
+        case 1:
+            if (aiListOwner[iItem] >= 0) break;
+            LL2SoaAddTail(list, iItem);
+            aiItemModel.push_back(iItem);
+            aiListOwner[iItem] = iList;
+            break;
+
+        case 2:
+            if (aiListOwner[iItem] != iList) break;
+            LL2SoaRemove(list, iItem);
+            Erase(aiItemModel, iItem);
+            aiListOwner[iItem] = -1;
+            break;
+
+        case 3:
+            {
+                if (aiListOwner[iItem] >= 0) break;
+                uint32_t iItemNext = (aiItemModel.empty() || rng() % 4 == 0) ? LL2SoaNil : aiItemModel[rng() % aiItemModel.size()];
+                LL2SoaInsertBefore(list, iItem, iItemNext);
+                aiItemModel.insert(
+                    (iItemNext == LL2SoaNil) ? aiItemModel.end() : std::find(aiItemModel.begin(), aiItemModel.end(), iItemNext),
+                    iItem);
+                aiListOwner[iItem] = iList;
+            }
+            break;
+
+        case 4:
+            {
+                uint32_t iItemRemoved;
+                LL2SoaRemoveHead(list, iItemRemoved);
+                if (aiItemModel.empty())
+                {
+                    assert(iItemRemoved == LL2SoaNil);
+                    break;
+                }
+                assert(iItemRemoved == aiItemModel.front());
+                aiItemModel.erase(aiItemModel.begin());
+                aiListOwner[iItemRemoved] = -1;
+            }
+            break;
+
+        case 5:
+            {
+                uint32_t iItemRemoved;
+                LL2SoaRemoveTail(list, iItemRemoved);
+                if (aiItemModel.empty())
+                {
+                    assert(iItemRemoved == LL2SoaNil);
+                    break;
+                }
+                assert(iItemRemoved == aiItemModel.back());
+                aiItemModel.pop_back();
+                aiListOwner[iItemRemoved] = -1;
+            }
+            break;
+
+        case 6:
+            if (aiListOwner[iItem] != iList) break;
+            LL2SoaMoveToHead(list, iItem);
+            Erase(aiItemModel, iItem);
+            aiItemModel.insert(aiItemModel.begin(), iItem);
+            break;
+
+        case 7:
+            {
+                int iListOther = rng() % s_cList;
+                if (iListOther == iList) break;
+                LL2SoaCombine(list, aList[iListOther]);
+                for (uint32_t iItemMoved : aaiItemModel[iListOther])
+                {
+                    aiItemModel.push_back(iItemMoved);
+                    aiListOwner[iItemMoved] = iList;
+                }
+                aaiItemModel[iListOther].clear();
+            }
+            break;
+
+        case 8:
+            {
+                // Splice a run from a random list (possibly this one) before a random item of this list, or its tail
+
+                int iListSrc = rng() % s_cList;
+                std::vector<uint32_t> & aiItemSrc = aaiItemModel[iListSrc];
+                if (aiItemSrc.empty()) break;
+
+                size_t iFirst = rng() % aiItemSrc.size();
+                size_t iLast = iFirst + rng() % (aiItemSrc.size() - iFirst);
+                std::vector<uint32_t> aiItemRun(aiItemSrc.begin() + iFirst, aiItemSrc.begin() + iLast + 1);
+                aiItemSrc.erase(aiItemSrc.begin() + iFirst, aiItemSrc.begin() + iLast + 1);
+
+                uint32_t iItemDstNext = (aiItemModel.empty() || rng() % 3 == 0) ? LL2SoaNil : aiItemModel[rng() % aiItemModel.size()];
+                LL2SoaSpliceRange(aList[iListSrc], list, aiItemRun.front(), aiItemRun.back(), iItemDstNext);
+                aiItemModel.insert(
+                    (iItemDstNext == LL2SoaNil) ? aiItemModel.end() : std::find(aiItemModel.begin(), aiItemModel.end(), iItemDstNext),
+                    aiItemRun.begin(),
+                    aiItemRun.end());
+                for (uint32_t iItemMoved : aiItemRun) aiListOwner[iItemMoved] = iList;
+            }
+            break;
+
+        case 9:
+            if (rng() % 50 != 0) break;
+            LL2SoaClear(list);
+            for (uint32_t iItemCleared : aiItemModel) aiListOwner[iItemCleared] = -1;
+            aiItemModel.clear();
+            break;
+        }
+
+        for (int iListCheck = 0; iListCheck < s_cList; iListCheck++)
+        {
+            assert(IsMatch(aList[iListCheck], aaiItemModel[iListCheck]));
+        }
+        for (uint32_t iItemCheck = 0; iItemCheck < s_cItem; iItemCheck++)
+        {
+            assert(LL2SoaIsItemLinked_(&table, iItemCheck) == (aiListOwner[iItemCheck] >= 0));
+        }
+    }
+}
+
+static void TestSingleItem()
+{
+    // A one-item list has no neighbours either way, and ClearWithoutUnlinking leaves the table untouched
+
+    uint32_t aiPrev[4];
+    uint32_t aiNext[4];
+    LL2SoaTable table;
+    LL2SoaTableInit(table, aiPrev, aiNext, 4);
+    LL2Soa list;
+    LL2SoaInit(list, &table);
+
+    assert(LL2SoaIsEmpty(list));
+    assert(LL2SoaHead(list) == LL2SoaNil && LL2SoaTail(list) == LL2SoaNil);
+    for (uint32_t iItem = 0; iItem < 4; iItem++) assert(!LL2SoaIsItemLinked(list, iItem));
+
+    LL2SoaAddTail(list, 3);
+    assert(LL2SoaHead(list) == 3 && LL2SoaTail(list) == 3);
+    assert(LL2SoaNext(list, 3) == LL2SoaNil && LL2SoaPrev(list, 3) == LL2SoaNil);
+
+    LL2SoaClearWithoutUnlinking(list);
+    assert(LL2SoaIsEmpty(list));
+    assert(LL2SoaIsItemLinked(list, 3));
+}
+
+int main()
+{
+    TestModel();
+    TestSingleItem();
+
+    printf("ll_soa_test: ok\n");
+    return 0;
+}
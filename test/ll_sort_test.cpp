@@ -0,0 +1,158 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll.h"
+
+//
+// Tests for LL1Sort/LL2Sort and LL1MergeSorted/LL2MergeSorted: random lists with many equal keys are sorted and
+//  merged, and the result is compared against std::stable_sort and std::merge, which also checks stability
+//
+
+struct Item
+{
+    int key;
+
+    DefineLL1Node(Item)
+    LL1Node node1;
+
+    DefineLL2Node(Item);
+    LL2Node node2;
+};
+
+DefineLL1(Item, node1, Items1);
+DefineLL2(Item, node2, Items2);
+
+static bool IsLess(Item * pItemA, Item * pItemB)
+{
+    return pItemA->key < pItemB->key;
+}
+
+static std::vector<Item *> ToVector(LL1Type(Items1) & list)
+{
+    std::vector<Item *> apItem;
+    ForLL1(Item, it, list)
+    {
+        apItem.push_back(it);
+    }
+
+    if (apItem.empty())
+    {
+        assert(!list.pTail);
+    }
+    else
+    {
+        assert(list.pTail == apItem.back());
+        assert(LL1NodePtr(Item, list, list.pTail)->pNext == (Item *)LLEndOfList_);
+    }
+
+    return apItem;
+}
+
+static std::vector<Item *> ToVector(LL2Type(Items2) & list)
+{
+    std::vector<Item *> apItem;
+    Item * pItemPrev = (Item *)LLEndOfList_;
+    ForLL2(Item, it, list)
+    {
+        assert(LL2NodePtr(Item, list, it)->pPrev == pItemPrev);
+        pItemPrev = it;
+        apItem.push_back(it);
+    }
+
+    if (apItem.empty())
+    {
+        assert(!list.pHead && !list.pTail);
+    }
+    else
+    {
+        assert(list.pTail == apItem.back());
+    }
+
+    return apItem;
+}
+
+static void MakeItems(std::vector<Item> & aItem, int cItem, std::mt19937 & rng)
+{
+    aItem.assign(cItem, Item());
+    for (Item & item : aItem)
+    {
+        item.key = (int)(rng() % 10);
+    }
+}
+
+static void TestSortAndMerge()
+{
+    std::mt19937 rng(1);
+
+    for (int cItem : { 0, 1, 2, 3, 5, 8, 17, 100, 1000, 4097 })
+    {
+        for (int iRep = 0; iRep < 5; iRep++)
+        {
+            std::vector<Item> aItem;
+            MakeItems(aItem, cItem, rng);
+
+            LL1Type(Items1) list1 = {};
+            LL2Type(Items2) list2 = {};
+            std::vector<Item *> apItemExpected;
+            for (Item & item : aItem)
+            {
+                LL1AddTail(Item, list1, &item);
+                LL2AddTail(Item, list2, &item);
+                apItemExpected.push_back(&item);
+            }
+
+            LL1Sort(Item, list1, IsLess);
+            LL2Sort(Item, list2, IsLess);
+
+            std::stable_sort(apItemExpected.begin(), apItemExpected.end(), IsLess);
+            assert(ToVector(list1) == apItemExpected);
+            assert(ToVector(list2) == apItemExpected);
+
+            // Merge in a second sorted list. On equal keys the items already in list1/list2 come first.
+
+            std::vector<Item> aItemOther;
+            MakeItems(aItemOther, (int)(rng() % 50), rng);
+            std::stable_sort(aItemOther.begin(), aItemOther.end(), [](const Item & a, const Item & b) { return a.key < b.key; });
+
+            LL1Type(Items1) listOther1 = {};
+            LL2Type(Items2) listOther2 = {};
+            std::vector<Item *> apItemOther;
+            for (Item & item : aItemOther)
+            {
+                LL1AddTail(Item, listOther1, &item);
+                LL2AddTail(Item, listOther2, &item);
+                apItemOther.push_back(&item);
+            }
+
+            std::vector<Item *> apItemMerged;
+            std::merge(
+                apItemExpected.begin(), apItemExpected.end(),
+                apItemOther.begin(), apItemOther.end(),
+                std::back_inserter(apItemMerged),
+                IsLess);
+
+            LL1MergeSorted(Item, list1, listOther1, IsLess);
+            LL2MergeSorted(Item, list2, listOther2, IsLess);
+
+            assert(ToVector(list1) == apItemMerged);
+            assert(ToVector(list2) == apItemMerged);
+            assert(!listOther1.pHead && !listOther1.pTail);
+            assert(!listOther2.pHead && !listOther2.pTail);
+        }
+    }
+}
+
+int main()
+{
+    TestSortAndMerge();
+
+    printf("ll_sort_test: ok\n");
+    return 0;
+}
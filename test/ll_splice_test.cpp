@@ -0,0 +1,135 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll.h"
+
+//
+// Randomized test for LL2SpliceRange, LL2SplitAt and LL2Rotate: items move between two lists (and within one list),
+//  and both lists are compared against std::vector models after every step
+//
+
+struct Item
+{
+    int id;
+
+    DefineLL2Node(Item);
+    LL2Node node;
+};
+
+DefineLL2(Item, node, Items);
+
+static std::vector<Item *> ToVector(LL2Type(Items) & list)
+{
+    std::vector<Item *> apItem;
+    Item * pItemPrev = (Item *)LLEndOfList_;
+    ForLL2(Item, it, list)
+    {
+        assert(LL2NodePtr(Item, list, it)->pPrev == pItemPrev);
+        pItemPrev = it;
+        apItem.push_back(it);
+    }
+
+    if (apItem.empty())
+    {
+        assert(!list.pHead && !list.pTail);
+    }
+    else
+    {
+        assert(list.pTail == apItem.back());
+    }
+
+    return apItem;
+}
+
+static void TestRandom()
+{
+    const int cItem = 60;
+    static Item s_aItem[cItem];
+
+    LL2Type(Items) aList[2] = {};
+    std::vector<Item *> aapItemModel[2];
+
+    std::mt19937 rng(7);
+    for (int iItem = 0; iItem < cItem; iItem++)
+    {
+        s_aItem[iItem].id = iItem;
+        int iList = (int)(rng() % 2);
+        LL2AddTail(Item, aList[iList], &s_aItem[iItem]);
+        aapItemModel[iList].push_back(&s_aItem[iItem]);
+    }
+
+    for (int iStep = 0; iStep < 100000; iStep++)
+    {
+        int iSrc = (int)(rng() % 2);
+        int iDst = (int)(rng() % 2);
+        std::vector<Item *> & apItemSrc = aapItemModel[iSrc];
+        if (apItemSrc.empty()) continue;
+
+        switch (rng() % 3)
+        {
+        case 0:
+            {
+                // Move the run [iFirst, iLast] of src before a random item of dst (or to its tail). src and dst may
+                //  be the same list, in which case the destination is picked from the items outside the run.
+
+                size_t iFirst = rng() % apItemSrc.size();
+                size_t iLast = iFirst + rng() % (apItemSrc.size() - iFirst);
+
+                std::vector<Item *> apItemRun(apItemSrc.begin() + iFirst, apItemSrc.begin() + iLast + 1);
+                std::vector<Item *> apItemRest = apItemSrc;
+                apItemRest.erase(apItemRest.begin() + iFirst, apItemRest.begin() + iLast + 1);
+
+                std::vector<Item *> apItemDst = (iSrc == iDst) ? apItemRest : aapItemModel[iDst];
+                size_t iInsert = rng() % (apItemDst.size() + 1);
+                Item * pItemDstNext = (iInsert < apItemDst.size()) ? apItemDst[iInsert] : nullptr;
+
+                LL2SpliceRange(Item, aList[iSrc], aList[iDst], apItemRun.front(), apItemRun.back(), pItemDstNext);
+
+                apItemDst.insert(apItemDst.begin() + iInsert, apItemRun.begin(), apItemRun.end());
+                if (iSrc != iDst) aapItemModel[iSrc] = apItemRest;
+                aapItemModel[iDst] = apItemDst;
+            }
+            break;
+
+        case 1:
+            {
+                int iOther = 1 - iSrc;
+                if (!aapItemModel[iOther].empty()) break;
+
+                size_t iSplit = rng() % apItemSrc.size();
+                LL2SplitAt(Item, aList[iSrc], aList[iOther], apItemSrc[iSplit]);
+
+                aapItemModel[iOther].assign(apItemSrc.begin() + iSplit, apItemSrc.end());
+                apItemSrc.resize(iSplit);
+            }
+            break;
+
+        case 2:
+            {
+                size_t iNewHead = rng() % apItemSrc.size();
+                LL2Rotate(Item, aList[iSrc], apItemSrc[iNewHead]);
+                std::rotate(apItemSrc.begin(), apItemSrc.begin() + iNewHead, apItemSrc.end());
+            }
+            break;
+        }
+
+        for (int iList = 0; iList < 2; iList++)
+        {
+            assert(ToVector(aList[iList]) == aapItemModel[iList]);
+        }
+    }
+}
+
+int main()
+{
+    TestRandom();
+
+    printf("ll_splice_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,309 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll.h"
+
+//
+// Randomized tests for the ll:: template layer. ll::List and an ll::ListRef onto a DefineLL2 list share items, and
+//  the macro list is also walked with ForLL2, so the two APIs are checked against each other as well as against
+//  std::vector models. ll::List1/List1Ref get the same treatment.
+//
+
+struct Item
+{
+    int id;
+
+    DefineLL2Node(Item);
+    LL2Node node;
+
+    DefineLL1Node(Item)
+    LL1Node node1;
+};
+
+DefineLL2(Item, node, Items);
+DefineLL1(Item, node1, Items1);
+
+typedef ll::List<Item, &Item::node> ItemList;
+typedef ll::ListRef<Item, &Item::node> ItemListRef;
+typedef ll::List1<Item, &Item::node1> ItemList1;
+typedef ll::List1Ref<Item, &Item::node1> ItemList1Ref;
+
+static const int s_cItem = 50;
+
+static int IndexOf(const std::vector<Item *> & apItem, Item * pItem)
+{
+    auto itFound = std::find(apItem.begin(), apItem.end(), pItem);
+    return (itFound == apItem.end()) ? -1 : (int)(itFound - apItem.begin());
+}
+
+template <typename L>
+static std::vector<Item *> ToVector(L & list)
+{
+    std::vector<Item *> apItem;
+    for (Item * pItem : list)
+    {
+        apItem.push_back(pItem);
+    }
+
+    assert(list.Tail() == (apItem.empty() ? nullptr : apItem.back()));
+    assert(list.IsEmpty() == apItem.empty());
+    return apItem;
+}
+
+static void TestList2Random()
+{
+    static Item s_aItem[s_cItem];
+    for (int iItem = 0; iItem < s_cItem; iItem++)
+    {
+        s_aItem[iItem] = Item();
+        s_aItem[iItem].id = iItem;
+    }
+
+    ItemList list;
+    LL2Type(Items) listMacro = {};
+    ItemListRef aListRef[2] = { ItemListRef(list), ItemListRef(listMacro) };
+    std::vector<Item *> aapItemModel[2];
+
+    std::mt19937 rng(13);
+    for (int iStep = 0; iStep < 50000; iStep++)
+    {
+        int iList = (int)(rng() % 2);
+        ItemListRef & listRef = aListRef[iList];
+        std::vector<Item *> & apItemModel = aapItemModel[iList];
+
+        Item * pItem = &s_aItem[rng() % s_cItem];
+        int iItemOn = IndexOf(apItemModel, pItem);
+        bool isLinked = iItemOn >= 0 || IndexOf(aapItemModel[1 - iList], pItem) >= 0;
+        assert(ItemList::IsItemLinked(pItem) == isLinked);
+
+        switch (rng() % 9)
+        {
+        case 0:
+            if (isLinked) break;
+            listRef.AddHead(pItem);
+            apItemModel.insert(apItemModel.begin(), pItem);
+            break;
+
+        case 1:
+            if (isLinked) break;
+            listRef.AddTail(pItem);
+            apItemModel.push_back(pItem);
+            break;
+
+        case 2:
+            if (iItemOn < 0) break;
+            listRef.Remove(pItem);
+            apItemModel.erase(apItemModel.begin() + iItemOn);
+            break;
+
+        case 3:
+            {
+                if (isLinked) break;
+                size_t iInsert = rng() % (apItemModel.size() + 1);
+                listRef.InsertBefore(pItem, (iInsert < apItemModel.size()) ? apItemModel[iInsert] : nullptr);
+                apItemModel.insert(apItemModel.begin() + iInsert, pItem);
+            }
+            break;
+
+        case 4:
+            {
+                bool isHead = (rng() % 2) != 0;
+                Item * pItemRemoved = isHead ? listRef.RemoveHead() : listRef.RemoveTail();
+                if (apItemModel.empty())
+                {
+                    assert(!pItemRemoved);
+                }
+                else if (isHead)
+                {
+                    assert(pItemRemoved == apItemModel.front());
+                    apItemModel.erase(apItemModel.begin());
+                }
+                else
+                {
+                    assert(pItemRemoved == apItemModel.back());
+                    apItemModel.pop_back();
+                }
+            }
+            break;
+
+        case 5:
+            if (iItemOn < 0) break;
+            listRef.MoveToHead(pItem);
+            apItemModel.erase(apItemModel.begin() + iItemOn);
+            apItemModel.insert(apItemModel.begin(), pItem);
+            break;
+
+        case 6:
+            {
+                if (rng() % 20) break;
+
+                std::vector<Item *> & apItemModelOther = aapItemModel[1 - iList];
+                listRef.Combine(aListRef[1 - iList]);
+                apItemModel.insert(apItemModel.end(), apItemModelOther.begin(), apItemModelOther.end());
+                apItemModelOther.clear();
+            }
+            break;
+
+        case 7:
+            {
+                std::vector<Item *> & apItemModelOther = aapItemModel[1 - iList];
+                if (apItemModel.empty() || !apItemModelOther.empty() || rng() % 10) break;
+
+                size_t iSplit = rng() % apItemModel.size();
+                listRef.SplitAt(aListRef[1 - iList], apItemModel[iSplit]);
+                apItemModelOther.assign(apItemModel.begin() + iSplit, apItemModel.end());
+                apItemModel.resize(iSplit);
+            }
+            break;
+
+        case 8:
+            {
+                // Move the item to a scratch copy and back, the way a container reallocating would
+
+                if (iItemOn < 0) break;
+
+                Item itemMoved = *pItem;
+                listRef.Relocate(pItem, &itemMoved);
+                *pItem = itemMoved;
+                listRef.Relocate(&itemMoved, pItem);
+            }
+            break;
+        }
+
+        assert(ToVector(list) == aapItemModel[0]);
+        assert(ToVector(aListRef[1]) == aapItemModel[1]);
+
+        std::vector<Item *> apItemMacro;
+        ForLL2(Item, it, listMacro)
+        {
+            assert(ItemList::Prev(it) == (apItemMacro.empty() ? nullptr : apItemMacro.back()));
+            apItemMacro.push_back(it);
+        }
+        assert(apItemMacro == aapItemModel[1]);
+    }
+
+    list.Clear();
+    aListRef[1].Clear();
+    for (int iItem = 0; iItem < s_cItem; iItem++)
+    {
+        assert(!ItemList::IsItemLinked(&s_aItem[iItem]));
+    }
+}
+
+static void TestList1Random()
+{
+    static Item s_aItem[s_cItem];
+    for (int iItem = 0; iItem < s_cItem; iItem++)
+    {
+        s_aItem[iItem] = Item();
+        s_aItem[iItem].id = iItem;
+    }
+
+    ItemList1 list;
+    LL1Type(Items1) listMacro = {};
+    ItemList1Ref aListRef[2] = { ItemList1Ref(list), ItemList1Ref(listMacro) };
+    std::vector<Item *> aapItemModel[2];
+
+    std::mt19937 rng(17);
+    for (int iStep = 0; iStep < 50000; iStep++)
+    {
+        int iList = (int)(rng() % 2);
+        ItemList1Ref & listRef = aListRef[iList];
+        std::vector<Item *> & apItemModel = aapItemModel[iList];
+
+        Item * pItem = &s_aItem[rng() % s_cItem];
+        bool isLinked = IndexOf(aapItemModel[0], pItem) >= 0 || IndexOf(aapItemModel[1], pItem) >= 0;
+        assert(ItemList1::IsItemLinked(pItem) == isLinked);
+
+        switch (rng() % 6)
+        {
+        case 0:
+            if (isLinked) break;
+            listRef.AddHead(pItem);
+            apItemModel.insert(apItemModel.begin(), pItem);
+            break;
+
+        case 1:
+            if (isLinked) break;
+            listRef.AddTail(pItem);
+            apItemModel.push_back(pItem);
+            break;
+
+        case 2:
+            {
+                if (isLinked) break;
+                size_t iInsert = rng() % (apItemModel.size() + 1);
+                listRef.InsertAfter(pItem, iInsert ? apItemModel[iInsert - 1] : nullptr);
+                apItemModel.insert(apItemModel.begin() + iInsert, pItem);
+            }
+            break;
+
+        case 3:
+            {
+                size_t iPrev = rng() % (apItemModel.size() + 1);
+                Item * pItemRemoved = listRef.RemoveAfter(iPrev ? apItemModel[iPrev - 1] : nullptr);
+                if (iPrev == apItemModel.size())
+                {
+                    assert(!pItemRemoved);
+                }
+                else
+                {
+                    assert(pItemRemoved == apItemModel[iPrev]);
+                    apItemModel.erase(apItemModel.begin() + iPrev);
+                }
+            }
+            break;
+
+        case 4:
+            {
+                Item * pItemRemoved = listRef.RemoveHead();
+                assert(pItemRemoved == (apItemModel.empty() ? nullptr : apItemModel.front()));
+                if (pItemRemoved) apItemModel.erase(apItemModel.begin());
+            }
+            break;
+
+        case 5:
+            {
+                if (rng() % 20) break;
+
+                std::vector<Item *> & apItemModelOther = aapItemModel[1 - iList];
+                listRef.Combine(aListRef[1 - iList]);
+                apItemModel.insert(apItemModel.end(), apItemModelOther.begin(), apItemModelOther.end());
+                apItemModelOther.clear();
+            }
+            break;
+        }
+
+        assert(ToVector(list) == aapItemModel[0]);
+        assert(ToVector(aListRef[1]) == aapItemModel[1]);
+
+        std::vector<Item *> apItemMacro;
+        ForLL1(Item, it, listMacro)
+        {
+            apItemMacro.push_back(it);
+        }
+        assert(apItemMacro == aapItemModel[1]);
+    }
+
+    list.Clear();
+    aListRef[1].Clear();
+    for (int iItem = 0; iItem < s_cItem; iItem++)
+    {
+        assert(!ItemList1::IsItemLinked(&s_aItem[iItem]));
+    }
+}
+
+int main()
+{
+    TestList2Random();
+    TestList1Random();
+
+    printf("ll_template_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <random>
+#include <vector>
+
+#define ALS_ASSERT assert
+#include "../ll.h"
+#include "../ll_timer.h"
+
+//
+// Tests for ll_timer.h: cancelling timers that Advance already handed out, and a randomized run against a model
+//
+
+struct Timer
+{
+    uint64_t expiry;
+    bool isExpired;
+
+    DefineLL2Node(Timer);
+    LL2Node node;
+};
+
+typedef ll::TimerWheel<Timer, &Timer::node, &Timer::expiry> Wheel;
+typedef ll::List<Timer, &Timer::node> TimerList;
+
+static void TestCancelAfterExpire()
+{
+    static Wheel s_wheel;
+    s_wheel.Init(0);
+
+    Timer a = {};
+    Timer b = {};
+    Timer c = {};
+    s_wheel.Arm(&a, 5);
+    s_wheel.Arm(&b, 5);
+    s_wheel.Arm(&c, 100);
+
+    TimerList expired;
+    s_wheel.Advance(10, expired);
+    assert(s_wheel.Count() == 1);
+
+    // a was handed out, so cancelling it must leave both the wheel and the expired list alone
+
+    assert(!s_wheel.Cancel(&a));
+    assert(s_wheel.Count() == 1);
+    assert(s_wheel.due.IsEmpty());
+
+    int cExpired = 0;
+    while (Timer * pTimer = expired.RemoveHead())
+    {
+        assert(pTimer == &a || pTimer == &b);
+        cExpired++;
+    }
+    assert(cExpired == 2);
+
+    // Timers armed already expired sit in due until the next Advance, and can still be cancelled there
+
+    Timer d = {};
+    s_wheel.Arm(&d, 3);
+    assert(s_wheel.Cancel(&d));
+    assert(!Wheel::IsArmed(&d));
+
+    assert(s_wheel.Cancel(&c));
+    assert(s_wheel.Count() == 0);
+    assert(s_wheel.NextExpiry() == UINT64_MAX);
+}
+
+static void TestRandom()
+{
+    static Wheel s_wheel;
+    s_wheel.Init(1000);
+
+    const int cTimer = 512;
+    std::vector<Timer> aTimer(cTimer);
+    std::vector<bool> aIsArmed(cTimer, false);
+    for (Timer & timer : aTimer) timer = Timer();
+
+    std::mt19937_64 rng(1);
+    TimerList expired;
+    uintptr_t cArmed = 0;
+
+    for (int iStep = 0; iStep < 200000; iStep++)
+    {
+        int iTimer = (int)(rng() % cTimer);
+        Timer * pTimer = &aTimer[iTimer];
+
+        switch (rng() % 3)
+        {
+        case 0:
+            if (!aIsArmed[iTimer] && !pTimer->isExpired)
+            {
+                uint64_t delay = (rng() % 8 == 0) ? 0 : (rng() % 4) ? rng() % 200 : rng() % 100000;
+                s_wheel.Arm(pTimer, s_wheel.now + delay);
+                aIsArmed[iTimer] = true;
+                cArmed++;
+            }
+            break;
+
+        case 1:
+            {
+                bool isCancelled = s_wheel.Cancel(pTimer);
+                assert(isCancelled == aIsArmed[iTimer]);
+                if (isCancelled)
+                {
+                    aIsArmed[iTimer] = false;
+                    cArmed--;
+                }
+            }
+            break;
+
+        case 2:
+            {
+                s_wheel.Advance(s_wheel.now + rng() % 300, expired);
+
+                for (Timer * pExpired = expired.Head(); pExpired; pExpired = expired.Next(pExpired))
+                {
+                    int iExpired = (int)(pExpired - aTimer.data());
+                    assert(pExpired->expiry <= s_wheel.now);
+                    if (!aIsArmed[iExpired]) continue;
+
+                    aIsArmed[iExpired] = false;
+                    pExpired->isExpired = true;
+                    cArmed--;
+                }
+
+                // Some expired timers are handled right away, the rest stay on the expired list for a while, where
+                //  Cancel must leave them alone
+
+                while (Timer * pExpired = expired.Head())
+                {
+                    if (rng() % 2) break;
+
+                    expired.RemoveHead();
+                    pExpired->isExpired = false;
+                }
+            }
+            break;
+        }
+
+        assert(s_wheel.Count() == cArmed);
+    }
+
+    while (Timer * pExpired = expired.RemoveHead()) pExpired->isExpired = false;
+    for (int iTimer = 0; iTimer < cTimer; iTimer++)
+    {
+        if (aIsArmed[iTimer]) assert(s_wheel.Cancel(&aTimer[iTimer]));
+    }
+    assert(s_wheel.Count() == 0);
+}
+
+int main()
+{
+    TestCancelAfterExpire();
+    TestRandom();
+
+    printf("ll_timer_test: ok\n");
+    return 0;
+}